@@ -1,4 +1,30 @@
 ﻿#include "BulletTracker.h"
+#include "Snapshot.h"
+#include "Managers/Telemetry.h"
+
+namespace
+{
+    const GameEngine::MetricId g_ShotsFiredMetric{ GameEngine::Telemetry::GetInstance().RegisterGauge("shots fired") };
+    const GameEngine::MetricId g_ShotsHitMetric{ GameEngine::Telemetry::GetInstance().RegisterGauge("shots hit") };
+}
 
 int BulletTracker::m_BulletsFired = 0;
-int BulletTracker::m_BulletsHit = 0;
\ No newline at end of file
+int BulletTracker::m_BulletsHit = 0;
+
+void BulletTracker::SaveState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Write(m_BulletsFired);
+    snapshot.Write(m_BulletsHit);
+}
+void BulletTracker::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_BulletsFired);
+    snapshot.Read(m_BulletsHit);
+    PublishTotals();
+}
+void BulletTracker::PublishTotals()
+{
+    auto& telemetry = GameEngine::Telemetry::GetInstance();
+    telemetry.Set(g_ShotsFiredMetric, m_BulletsFired);
+    telemetry.Set(g_ShotsHitMetric, m_BulletsHit);
+}
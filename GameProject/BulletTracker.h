@@ -1,14 +1,22 @@
 ﻿#pragma once
+namespace GameEngine
+{
+    class Snapshot;
+}
 
 class BulletTracker final
 {
 public:
-    static void BulletFired() { ++m_BulletsFired; }
-    static void BulletHit() { ++m_BulletsHit; }
-    static void Reset() { m_BulletsFired = 0; m_BulletsHit = 0; }
+    static void BulletFired() { ++m_BulletsFired; PublishTotals(); }
+    static void BulletHit() { ++m_BulletsHit; PublishTotals(); }
+    static void Reset() { m_BulletsFired = 0; m_BulletsHit = 0; PublishTotals(); }
     static int GetBulletsFired() { return m_BulletsFired; }
     static int GetBulletsHit() { return m_BulletsHit; }
+    static void SaveState(GameEngine::Snapshot& snapshot);
+    static void LoadState(GameEngine::Snapshot& snapshot);
 private:
+    //published as gauges rather than counters, so frames resimulated by a rollback aren't counted twice
+    static void PublishTotals();
     static int m_BulletsFired;
     static int m_BulletsHit;
 };
@@ -2,28 +2,15 @@
 #include "EventData.h"
 #include "Sound/DerivedSoundSystems.h"
 
-enum class ObserverIdentifier
-{
-    health,
-    bullet,
-    enemyAttack,
-    collision,
-    formation
-};
-enum class GameEvent
-{
-    collision, //must be the first one since its in the engine too
-    hasBeenHit, 
-    died,
-    bulletShot,
-    bulletOutOfBounds,
-    gotInFormation,
-    leftFormation,
-    bossShotBeam,
-    beamRetracted,
-    fighterCaptured,
-    event = -1//for when smth generic happens
-};
+//Events game objects emit to the observers connected to them, collisions come from the engine (CollisionEvent)
+struct DiedEvent {};
+struct BulletShotEvent {};
+struct BulletOutOfBoundsEvent {};
+struct GotInFormationEvent {};
+struct LeftFormationEvent {};
+struct BossShotBeamEvent {};
+struct BeamRetractedEvent {};
+struct FighterCapturedEvent {};
 
 enum class GameId
 {
@@ -60,12 +47,6 @@ enum class SoundId : GameEngine::SoundId
     tractorBeam
 };
 
-struct ScoreData : GameEngine::EventData
-{
-    int playerId;
-    int enemyId;
-};
-
 enum class SceneId
 {
     startMenu,
@@ -73,7 +54,8 @@ enum class SceneId
     levelTwo,
     levelThree,
     gameOver,
-    chooseName
+    chooseName,
+    stressLevel
 };
 
 enum class GameMode
@@ -83,3 +65,13 @@ enum class GameMode
     versus
 };
 
+//Bits of the input word exchanged with a network peer. What they do depends on the player
+//sending them: in versus, fire and special of the second player drive the enemies' attacks
+enum class NetInput : uint16_t
+{
+    left = 1 << 0,
+    right = 1 << 1,
+    fire = 1 << 2,
+    special = 1 << 3
+};
+
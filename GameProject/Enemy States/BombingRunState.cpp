@@ -1,50 +1,41 @@
 ﻿#include "BombingRunState.h"
-#include <queue>
+#include <array>
 #include "DataStructs.h"
-#include "IdleState.h"
 #include "Game components/Enemy components/EnemyComponent.h"
+#include "Game observers/EnemyAIManager.h"
+#include "Managers/TimeManager.h"
+#include "Snapshot.h"
 
 void BombingRunState::Enter(EnemyComponent* enemyComponent)
 {
-    std::queue<PathData> pathDataQueue;
-    PathData pathData;
+    std::array<PathData, 5> pathData{};
 
-    enemyComponent->GetGameObjParent()->Notify(static_cast<int>(GameEvent::bulletShot),
-        static_cast<int>(ObserverIdentifier::enemyAttack));
+    enemyComponent->GetGameObjParent()->Emit(BulletShotEvent{});
     // Initial upward movement
-    pathData.destination = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2(0, -50);
-    pathDataQueue.push(pathData);
+    pathData[0].destination = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2(0, -50);
 
     // Loop movement
-    pathData = {};
-    pathData.isRotating = true;
-    pathData.isRotatingClockwise = static_cast<bool>(rand() % 2);
-    pathData.centerOfRotation = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2{ 0,20 };
-    pathData.totalRotationAngle = 3.49066f;
-    pathDataQueue.push(pathData);
+    pathData[1].isRotating = true;
+    pathData[1].isRotatingClockwise = EnemyAIManager::GetRandomBool();
+    pathData[1].centerOfRotation = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2{ 0,20 };
+    pathData[1].totalRotationAngle = 3.49066f;
 
     // Dive towards the player
-    pathData = {};
     const glm::vec2 playerPos = enemyComponent->GetPlayerComponent()->GetGameObjParent()->GetPosition();
-    pathData.destination = playerPos + glm::vec2{ 0,-50 };
-    pathDataQueue.push(pathData);
+    pathData[2].destination = playerPos + glm::vec2{ 0,-50 };
 
     // Loop movement
-    pathData = {};
-    pathData.isRotating = true;
-    pathData.isRotatingClockwise = static_cast<bool>(rand() % 2);
-    pathData.centerOfRotation = playerPos;
-    pathData.totalRotationAngle = 4.88692f;
-    pathDataQueue.push(pathData);
+    pathData[3].isRotating = true;
+    pathData[3].isRotatingClockwise = EnemyAIManager::GetRandomBool();
+    pathData[3].centerOfRotation = playerPos;
+    pathData[3].totalRotationAngle = 4.88692f;
 
-    pathData = {};
-    pathData.destination = glm::vec2(enemyComponent->GetFormationPosition());
-    pathDataQueue.push(pathData);
+    pathData[4].destination = glm::vec2(enemyComponent->GetFormationPosition());
 
     // Set the trajectory
-    m_BombingTrajectory->SetPathData(pathDataQueue, enemyComponent->GetGameObjParent()->GetPosition());
+    enemyComponent->GetStateTrajectory().SetPathData(pathData, enemyComponent->GetGameObjParent()->GetPosition());
 }
-std::unique_ptr<EnemyState> BombingRunState::Update(EnemyComponent* enemyComponent)
+EnemyStateId BombingRunState::Update(EnemyComponent* enemyComponent)
 {
     if (!m_NextBulletShot)
     {
@@ -52,10 +43,19 @@ std::unique_ptr<EnemyState> BombingRunState::Update(EnemyComponent* enemyCompone
         if (m_AccumTime >= m_TimeTillNextBulletShot)
         {
             m_NextBulletShot = true;
-            enemyComponent->GetGameObjParent()->Notify(static_cast<int>(GameEvent::bulletShot),
-                static_cast<int>(ObserverIdentifier::enemyAttack));
+            enemyComponent->GetGameObjParent()->Emit(BulletShotEvent{});
         }
     }
-    if (enemyComponent->UpdateTrajectory(*m_BombingTrajectory)) return std::make_unique<IdleState>();
-    return nullptr;
+    if (enemyComponent->UpdateTrajectory(enemyComponent->GetStateTrajectory())) return EnemyStateId::idle;
+    return EnemyStateId::none;
+}
+void BombingRunState::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_NextBulletShot);
+    snapshot.Write(m_AccumTime);
+}
+void BombingRunState::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_NextBulletShot);
+    snapshot.Read(m_AccumTime);
 }
@@ -1,15 +1,14 @@
 ﻿#pragma once
 #include "EnemyState.h"
-#include "Trajectory Logic/Trajectory.h"
 
-class BombingRunState: public EnemyState
+class BombingRunState
 {
 public:
-    virtual void Enter(EnemyComponent* enemyComponent) override;
-    virtual std::unique_ptr<EnemyState> Update(EnemyComponent* enemyComponent) override;
-    virtual bool IsDiving() const override { return true; }
-protected:
-    std::unique_ptr<Trajectory> m_BombingTrajectory{ std::make_unique<Trajectory>() };
+    void Enter(EnemyComponent* enemyComponent);
+    EnemyStateId Update(EnemyComponent* enemyComponent);
+    bool IsDiving() const { return true; }
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    void LoadState(GameEngine::Snapshot& snapshot);
 private:
     bool m_NextBulletShot = false;
     const float m_TimeTillNextBulletShot = .6f;
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <variant>
 
 class EnemyComponent;
 namespace GameEngine
@@ -19,23 +20,17 @@ namespace GameEngine
 //                         ├────────────────┤                             
 //                         │ score increases│                             
 //                         └────────────────┘                             
-class BossHealthStage
+//HasBeenHit returns whether the boss survived the hit and moves on to the next stage
+class BossStageOne final
 {
 public:
-    virtual BossHealthStage* HasBeenHit(EnemyComponent* bossObj) = 0;
-    virtual ~BossHealthStage() = default;
+    bool HasBeenHit(EnemyComponent* bossObj);
 };
 
-class BossStageOne final : public BossHealthStage
+class BossStageTwo final
 {
 public:
-    virtual BossHealthStage* HasBeenHit(EnemyComponent* bossObj) override;
-    virtual ~BossStageOne() = default;
+    bool HasBeenHit(EnemyComponent* bossObj);
 };
 
-class BossStageTwo final : public BossHealthStage
-{
-public:
-    virtual BossHealthStage* HasBeenHit(EnemyComponent* bossObj) override;
-    virtual ~BossStageTwo() = default;
-};
+using BossHealthStage = std::variant<BossStageOne, BossStageTwo>;
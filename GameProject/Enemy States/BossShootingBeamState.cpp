@@ -1,51 +1,54 @@
 ﻿#include "BossShootingBeamState.h"
+#include <array>
 
 #include "Galaga.h"
 #include "Minigin.h"
 #include "Game components/Enemy components/EnemyComponent.h"
+#include "Game observers/EnemyAIManager.h"
+#include "Snapshot.h"
 #include "Sound/ServiceLocator.h"
 
 void BossShootingBeamState::Enter(EnemyComponent* enemyComponent)
 {
-    std::queue<PathData> pathDataQueue;
-    PathData pathData;
+    std::array<PathData, 3> pathData{};
 
     const auto enemyPos = enemyComponent->GetGameObjParent()->GetPosition();
 
-    enemyComponent->GetGameObjParent()->Notify(static_cast<int>(GameEvent::bulletShot),
-        static_cast<int>(ObserverIdentifier::enemyAttack));
+    enemyComponent->GetGameObjParent()->Emit(BulletShotEvent{});
     // Initial upward movement
-    pathData.destination = glm::vec2(enemyPos) + glm::vec2(0, -50);
-    pathDataQueue.push(pathData);
+    pathData[0].destination = glm::vec2(enemyPos) + glm::vec2(0, -50);
 
     // Loop movement
-    pathData = {};
-    pathData.isRotating = true;
-    pathData.isRotatingClockwise = static_cast<bool>(rand() % 2);
-    pathData.centerOfRotation = glm::vec2(enemyPos) + glm::vec2{ 0,20 };
-    pathData.totalRotationAngle = 3.49066f;
-    pathDataQueue.push(pathData);
+    pathData[1].isRotating = true;
+    pathData[1].isRotatingClockwise = EnemyAIManager::GetRandomBool();
+    pathData[1].centerOfRotation = glm::vec2(enemyPos) + glm::vec2{ 0,20 };
+    pathData[1].totalRotationAngle = 3.49066f;
 
     // Dive towards the player
-    pathData = {};
     const glm::vec2 playerPos = enemyComponent->GetPlayerComponent()->GetGameObjParent()->GetPosition();
-    pathData.destination = playerPos + glm::vec2{ 0,(enemyPos.y - playerPos.y) / 2 + 100 };
-    pathDataQueue.push(pathData);
+    pathData[2].destination = playerPos + glm::vec2{ 0,(enemyPos.y - playerPos.y) / 2 + 100 };
 
     // Set the trajectory
-    m_BeamTrajectory->SetPathData(pathDataQueue, enemyComponent->GetGameObjParent()->GetPosition());
+    enemyComponent->GetStateTrajectory().SetPathData(pathData, enemyComponent->GetGameObjParent()->GetPosition());
 }
-std::unique_ptr<EnemyState> BossShootingBeamState::Update(EnemyComponent* enemyComponent)
+EnemyStateId BossShootingBeamState::Update(EnemyComponent* enemyComponent)
 {
-    if (m_IsShootingBeam) return nullptr;
-    if (enemyComponent->UpdateTrajectory(*m_BeamTrajectory))
+    if (m_IsShootingBeam) return EnemyStateId::none;
+    if (enemyComponent->UpdateTrajectory(enemyComponent->GetStateTrajectory()))
     {
-        enemyComponent->GetGameObjParent()->Notify(static_cast<int>(GameEvent::bossShotBeam),
-            static_cast<int>(ObserverIdentifier::enemyAttack));
+        enemyComponent->GetGameObjParent()->Emit(BossShotBeamEvent{});
         enemyComponent->GetRotatingSprite()->RotateSpriteInDirection({ 0,1 });
         enemyComponent->SetCurDirection({ 0,1 });
         GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::tractorBeam), Galaga::volume);
         m_IsShootingBeam = true;
     }
-    return nullptr;
+    return EnemyStateId::none;
+}
+void BossShootingBeamState::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsShootingBeam);
+}
+void BossShootingBeamState::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_IsShootingBeam);
 }
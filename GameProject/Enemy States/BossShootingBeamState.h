@@ -1,14 +1,14 @@
 ﻿#pragma once
 #include "EnemyState.h"
-#include "Trajectory Logic/Trajectory.h"
 
-class BossShootingBeamState final : public EnemyState
+class BossShootingBeamState final
 {
 public:
-    virtual void Enter([[maybe_unused]] EnemyComponent* enemyComponent) override;
-    virtual std::unique_ptr<EnemyState> Update(EnemyComponent* enemyComponent) override;
-    virtual bool IsDiving() const override { return true; }
+    void Enter(EnemyComponent* enemyComponent);
+    EnemyStateId Update(EnemyComponent* enemyComponent);
+    bool IsDiving() const { return true; }
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    void LoadState(GameEngine::Snapshot& snapshot);
 private:
     bool m_IsShootingBeam = false;
-    std::unique_ptr<Trajectory> m_BeamTrajectory{ std::make_unique<Trajectory>() };
 };
\ No newline at end of file
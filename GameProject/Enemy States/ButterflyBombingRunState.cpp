@@ -1,90 +1,59 @@
 ﻿#include "ButterflyBombingRunState.h"
+#include <array>
 
 #include "Minigin.h"
 #include "Game components/Enemy components/EnemyComponent.h"
+#include "Game observers/EnemyAIManager.h"
 
 void ButterflyBombingRunState::Enter(EnemyComponent* enemyComponent)
 {
-    std::queue<PathData> pathDataQueue;
-    PathData pathData;
+    std::array<PathData, 10> pathData{};
+    const glm::vec2 enemyPos = enemyComponent->GetGameObjParent()->GetPosition();
 
-    enemyComponent->GetGameObjParent()->Notify(static_cast<int>(GameEvent::bulletShot),
-        static_cast<int>(ObserverIdentifier::enemyAttack));
+    enemyComponent->GetGameObjParent()->Emit(BulletShotEvent{});
     // Initial upward movement
-    pathData.destination = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2(0, -50);
-    pathDataQueue.push(pathData);
+    pathData[0].destination = enemyPos + glm::vec2(0, -50);
 
     // Loop movement
-    pathData = {};
-    pathData.isRotating = true;
-    pathData.isRotatingClockwise = static_cast<bool>(rand() % 2);
-    pathData.centerOfRotation = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition())+ glm::vec2{ 0,20 };
-    pathData.totalRotationAngle = 2.49066f;
-    pathDataQueue.push(pathData);
+    pathData[1].isRotating = true;
+    pathData[1].isRotatingClockwise = EnemyAIManager::GetRandomBool();
+    pathData[1].centerOfRotation = enemyPos + glm::vec2{ 0,20 };
+    pathData[1].totalRotationAngle = 2.49066f;
 
-    pathData = {};
-    pathData.destination = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2(0, 100);
-    pathDataQueue.push(pathData);
+    pathData[2].destination = enemyPos + glm::vec2(0, 100);
 
-    pathData = {};
-    pathData.destination = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2(50, 150);
-    pathDataQueue.push(pathData);
+    pathData[3].destination = enemyPos + glm::vec2(50, 150);
 
-    pathData = {};
-    pathData.isRotating = true;
-    pathData.isRotatingClockwise = static_cast<bool>(rand() % 2);
-    pathData.centerOfRotation = glm::vec2(enemyComponent->GetGameObjParent()->GetPosition()) + glm::vec2(70, 170);
-    pathData.totalRotationAngle = 2.49066f;
-    pathDataQueue.push(pathData);
+    pathData[4].isRotating = true;
+    pathData[4].isRotatingClockwise = EnemyAIManager::GetRandomBool();
+    pathData[4].centerOfRotation = enemyPos + glm::vec2(70, 170);
+    pathData[4].totalRotationAngle = 2.49066f;
 
     // Dive towards the player
-    pathData = {};
     const glm::vec2 playerPos = enemyComponent->GetPlayerComponent()->GetGameObjParent()->GetPosition();
-    pathData.destination = playerPos + glm::vec2{ 0,-50 };
-    pathDataQueue.push(pathData);
+    pathData[5].destination = playerPos + glm::vec2{ 0,-50 };
+
+    // Loop movement
+    pathData[6].isRotating = true;
+    pathData[6].centerOfRotation = playerPos;
+    pathData[6].totalRotationAngle = 4.7f;
 
     // Dive outside of the screen
     if(playerPos.x >= GameEngine::g_WindowRect.w/2)
     {
-        // Loop movement
-        pathData = {};
-        pathData.isRotating = true;
-        pathData.isRotatingClockwise = false;
-        pathData.centerOfRotation = playerPos;
-        pathData.totalRotationAngle = 4.7f;
-        pathDataQueue.push(pathData);
-        
-        pathData = {};
-        pathData.destination = {GameEngine::g_WindowRect.w + 100, playerPos.y};
-        pathDataQueue.push(pathData);
-        
-        pathData = {};
-        pathData.destination = {GameEngine::g_WindowRect.w + 100, - 100};
-        pathDataQueue.push(pathData);
+        pathData[6].isRotatingClockwise = false;
+        pathData[7].destination = {GameEngine::g_WindowRect.w + 100, playerPos.y};
+        pathData[8].destination = {GameEngine::g_WindowRect.w + 100, - 100};
     }
     else
     {
-        // Loop movement
-        pathData = {};
-        pathData.isRotating = true;
-        pathData.isRotatingClockwise = true;
-        pathData.centerOfRotation = playerPos;
-        pathData.totalRotationAngle = 4.7f;
-        pathDataQueue.push(pathData);
-        
-        pathData = {};
-        pathData.destination = {-100, playerPos.y};
-        pathDataQueue.push(pathData);
-        
-        pathData = {};
-        pathData.destination = {- 100, - 100};
-        pathDataQueue.push(pathData);
+        pathData[6].isRotatingClockwise = true;
+        pathData[7].destination = {-100, playerPos.y};
+        pathData[8].destination = {- 100, - 100};
     }
 
-    pathData = {};
-    pathData.destination = glm::vec2(enemyComponent->GetFormationPosition());
-    pathDataQueue.push(pathData);
+    pathData[9].destination = glm::vec2(enemyComponent->GetFormationPosition());
 
     // Set the trajectory
-    m_BombingTrajectory->SetPathData(pathDataQueue, enemyComponent->GetGameObjParent()->GetPosition());
+    enemyComponent->GetStateTrajectory().SetPathData(pathData, enemyPos);
 }
\ No newline at end of file
@@ -1,8 +1,9 @@
 ﻿#pragma once
 #include "BombingRunState.h"
 
+//Same run as BombingRunState, along a longer path that dives off screen
 class ButterflyBombingRunState final : public BombingRunState
 {
 public:
-    virtual void Enter([[maybe_unused]] EnemyComponent* enemyComponent) override;
+    void Enter(EnemyComponent* enemyComponent);
 };
@@ -1,16 +1,23 @@
 ﻿#pragma once
-#include <memory>
 
 class EnemyComponent;
+namespace GameEngine
+{
+    class Snapshot;
+}
 
-class EnemyState
+//States are plain classes stored by value in EnemyComponent's state variant. States that fly a path
+//re-target the enemy's state trajectory instead of owning one, so switching states never allocates.
+//Each state can have Enter/Exit(EnemyComponent*), and needs IsDiving() and Update(EnemyComponent*),
+//which returns the state to switch to (none to stay). States with data to restore also have
+//SaveState(Snapshot&) and LoadState(Snapshot&), or LoadState(Snapshot&, EnemyComponent*).
+//The order matches the alternatives of EnemyStateVariant
+enum class EnemyStateId
 {
-public:
-    virtual void Enter([[maybe_unused]] EnemyComponent* enemyComponent) {}
-    virtual void Exit([[maybe_unused]] EnemyComponent* enemyComponent) {}
-    virtual bool IsDiving() const = 0;
-    virtual std::unique_ptr<EnemyState> Update(EnemyComponent* enemyComponent) = 0;
-    virtual ~EnemyState() = default;
+    none,
+    getInFormation,
+    idle,
+    bombingRun,
+    butterflyBombingRun,
+    bossShootingBeam
 };
-
-
@@ -1,17 +1,29 @@
 ﻿#include "GetInFormationState.h"
 
-#include "IdleState.h"
 #include "Game components/Enemy components/EnemyComponent.h"
 #include "Managers/TimeManager.h"
+#include "Snapshot.h"
 
 const float GetInFormationState::m_TimeInBetween = 0.14f;
 
-std::unique_ptr<EnemyState> GetInFormationState::Update(EnemyComponent* enemyComponent)
+EnemyStateId GetInFormationState::Update(EnemyComponent* enemyComponent)
 {
     m_WaitTime = m_TimeInBetween * enemyComponent->m_SetOutTurn;
     m_AccumWaitTime += GameEngine::TimeManager::GetElapsed();
-    if (m_AccumWaitTime < m_WaitTime) return nullptr;
+    if (m_AccumWaitTime < m_WaitTime) return EnemyStateId::none;
     m_HasSetOut = true;
-    if (enemyComponent->UpdateTrajectory(enemyComponent->GetFormationTrajectory())) return std::make_unique<IdleState>();
-    return nullptr;
-}
\ No newline at end of file
+    if (enemyComponent->UpdateTrajectory(enemyComponent->GetFormationTrajectory())) return EnemyStateId::idle;
+    return EnemyStateId::none;
+}
+void GetInFormationState::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_HasSetOut);
+    snapshot.Write(m_AccumWaitTime);
+    snapshot.Write(m_WaitTime);
+}
+void GetInFormationState::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_HasSetOut);
+    snapshot.Read(m_AccumWaitTime);
+    snapshot.Read(m_WaitTime);
+}
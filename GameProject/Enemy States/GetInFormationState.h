@@ -1,12 +1,18 @@
 ﻿#pragma once
 #include "EnemyState.h"
+namespace GameEngine
+{
+    class Snapshot;
+}
 
-class GetInFormationState final : public EnemyState
+class GetInFormationState final
 {
 public:
-    virtual std::unique_ptr<EnemyState> Update(EnemyComponent* enemyComponent) override;
-    virtual bool IsDiving() const override { return true; }
-    virtual bool HasSetOut() const { return m_HasSetOut; }
+    EnemyStateId Update(EnemyComponent* enemyComponent);
+    bool IsDiving() const { return true; }
+    bool HasSetOut() const { return m_HasSetOut; }
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    void LoadState(GameEngine::Snapshot& snapshot);
 private:
     bool m_HasSetOut{false};
     float m_AccumWaitTime{};
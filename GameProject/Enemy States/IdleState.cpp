@@ -2,17 +2,18 @@
 
 #include "Game components/FormationComponent.h"
 #include "Game components/Enemy components/EnemyComponent.h"
+#include "Snapshot.h"
+#include "Trajectory Logic/TrajectoryMath.h"
 
-void IdleState::UpdateBackToFormationTrajectory(EnemyComponent* enemyComponent) const
+void IdleState::UpdateBackToFormationTrajectory(EnemyComponent* enemyComponent)
 {
-    std::queue<PathData> pathDataQueue;
+    m_TargetOffset = FormationComponent::GetOffset();
     PathData pathData;
-    pathData.destination = glm::vec2(enemyComponent->GetFormationPosition()) + glm::vec2(FormationComponent::GetOffset(),0);
-    pathDataQueue.push(pathData);
-    m_BackToFormationTrajectory->SetPathData(pathDataQueue, enemyComponent->GetGameObjParent()->GetPosition());
+    pathData.destination = glm::vec2(enemyComponent->GetFormationPosition()) + glm::vec2(m_TargetOffset,0);
+    enemyComponent->GetStateTrajectory().SetPathData({ &pathData, 1 }, enemyComponent->GetGameObjParent()->GetPosition());
 }
 void IdleState::GotInFormation(EnemyComponent* enemyComponent) {
-    enemyComponent->GetGameObjParent()->NotifyAll(static_cast<int>(GameEvent::gotInFormation));
+    enemyComponent->GetGameObjParent()->Emit(GotInFormationEvent{});
     enemyComponent->GetRotatingSprite()->RotateSpriteInDirection({0,1});
 
 }
@@ -21,32 +22,43 @@ void IdleState::Enter(EnemyComponent* enemyComponent)
     if(!TrajectoryMath::ArePositionsEqual(enemyComponent->GetGameObjParent()->GetPosition(),
         enemyComponent->GetFormationPosition()+glm::ivec2{FormationComponent::GetOffset(),0}))
     {
-        m_BackToFormationTrajectory = std::make_unique<Trajectory>();
+        m_IsGettingBackToFormation = true;
         UpdateBackToFormationTrajectory(enemyComponent);
         return;
     }
     GotInFormation(enemyComponent);
 }
-std::unique_ptr<EnemyState> IdleState::Update(EnemyComponent* enemyComponent)
+EnemyStateId IdleState::Update(EnemyComponent* enemyComponent)
 {
-    if(m_BackToFormationTrajectory != nullptr)
+    if(m_IsGettingBackToFormation)
     {
-        if (enemyComponent->UpdateTrajectory(*m_BackToFormationTrajectory))
+        if (enemyComponent->UpdateTrajectory(enemyComponent->GetStateTrajectory()))
         {
-            m_BackToFormationTrajectory = nullptr;
+            m_IsGettingBackToFormation = false;
             GotInFormation(enemyComponent);
-            return nullptr;
+            return EnemyStateId::none;
         }
-        UpdateBackToFormationTrajectory(enemyComponent);
+        //the formation sways while the enemy flies back, so the slot it heads for keeps moving
+        if (FormationComponent::GetOffset() != m_TargetOffset) UpdateBackToFormationTrajectory(enemyComponent);
 
-        return nullptr;
+        return EnemyStateId::none;
     }
     glm::vec2 formationPos = enemyComponent->GetFormationPosition();
     formationPos.x += FormationComponent::GetOffset();
     enemyComponent->GetGameObjParent()->SetPosition({ formationPos,0 });
-    return nullptr;
+    return EnemyStateId::none;
 }
 void IdleState::Exit(EnemyComponent* enemyComponent)
 {
-    enemyComponent->GetGameObjParent()->NotifyAll(static_cast<int>(GameEvent::leftFormation));
-}
\ No newline at end of file
+    enemyComponent->GetGameObjParent()->Emit(LeftFormationEvent{});
+}
+void IdleState::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsGettingBackToFormation);
+    snapshot.Write(m_TargetOffset);
+}
+void IdleState::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_IsGettingBackToFormation);
+    snapshot.Read(m_TargetOffset);
+}
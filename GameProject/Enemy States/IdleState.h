@@ -1,16 +1,19 @@
 ﻿#pragma once
 #include "EnemyState.h"
-#include "Trajectory Logic/Trajectory.h"
 
-class IdleState final : public EnemyState
+class IdleState final
 {
 public:
-    void Enter([[maybe_unused]] EnemyComponent* enemyComponent) override;
-    virtual std::unique_ptr<EnemyState> Update(EnemyComponent* enemyComponent) override;
-    void Exit([[maybe_unused]] EnemyComponent* enemyComponent) override;
-    virtual bool IsDiving() const override { return false; }
+    void Enter(EnemyComponent* enemyComponent);
+    EnemyStateId Update(EnemyComponent* enemyComponent);
+    void Exit(EnemyComponent* enemyComponent);
+    bool IsDiving() const { return false; }
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    void LoadState(GameEngine::Snapshot& snapshot);
 private:
-    void UpdateBackToFormationTrajectory(EnemyComponent* enemyComponent) const;
+    void UpdateBackToFormationTrajectory(EnemyComponent* enemyComponent);
     static void GotInFormation(EnemyComponent* enemyComponent);
-    std::unique_ptr<Trajectory> m_BackToFormationTrajectory{ nullptr };
+    bool m_IsGettingBackToFormation{ false };
+    //formation offset the way back was planned for, the path is only re-targeted once it moved
+    float m_TargetOffset{};
 };
@@ -1,5 +1,7 @@
 ﻿#include "Galaga.h"
 
+#include <filesystem>
+
 #include <SDL_rect.h>
 
 #include "BulletTracker.h"
@@ -8,13 +10,13 @@
 #include "Initializers.h"
 #include "Minigin.h"
 #include "Scene.h"
+#include "SceneBlob.h"
+#include "SceneCompiler.h"
+#include "SceneTypes.h"
 #include "Components/TextComponent.h"
 #include "Components/TextureComponent.h"
-#include "Game components/BackgroundComponent.h"
-#include "Game components/FormationComponent.h"
-#include "Game components/ModeSelectionComp.h"
-#include "Game components/NameSelectionComp.h"
-#include "Game components/ScoreComponent.h"
+#include "Game components/SoakStatsComponent.h"
+#include "Game components/TrajectoryReloadComponent.h"
 #include "Game observers/BulletObserver.h"
 #include "Game observers/EnemyAIManager.h"
 #include "Game observers/EnemyAttacksObserver.h"
@@ -22,14 +24,18 @@
 #include "Game observers/ExplosionObserver.h"
 #include "Game observers/FighterObserver.h"
 #include "Game observers/FormationObserver.h"
+#include "Game observers/HighScoreStore.h"
 #include "Game observers/ScoreManager.h"
 #include "Managers/InputManager.h"
 #include "Managers/ResourceManager.h"
 #include "Managers/SceneManager.h"
+#include "Network/ITransport.h"
+#include "Network/RollbackSession.h"
 #include "Sound/DerivedSoundSystems.h"
 #include "Sound/ServiceLocator.h"
 #include "Subjects/GameObject.h"
 #include "Trajectory Logic/Parsers.h"
+#include "Trajectory Logic/StageGenerator.h"
 
 #ifndef NDEBUG
 #include "Game components/FPSComponent.h"
@@ -37,6 +43,13 @@
 
 int Galaga::volume = baseVolume;
 
+Galaga::Galaga() :
+    m_pSceneTypes(std::make_unique<GameEngine::SceneTypeRegistry>())
+{
+    RegisterSceneTypes(*m_pSceneTypes);
+}
+Galaga::~Galaga() = default;
+
 void Galaga::LoadStartScene()
 {
     //----------SOUND----------------
@@ -49,7 +62,15 @@ void Galaga::LoadStartScene()
     GameEngine::ServiceLocator::GetSoundSystem().FillSoundPaths("../Data/Audio/SoundPaths.txt");
     GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::start), Galaga::volume);
 
-    GameEngine::SceneManager::GetInstance().AddScene(static_cast<int>(SceneId::startMenu), LoadStartScreen());
+    if (!m_StartSceneFile.empty())
+    {
+        auto instance = InstantiateScene(m_StartSceneFile);
+        InitStarfield(instance.scene->GetParticleSystem());
+        m_KeyboardSceneKeys = std::move(instance.keyboardKeys);
+        m_ControllerSceneKeys = std::move(instance.controllerKeys);
+        GameEngine::SceneManager::GetInstance().AddScene(static_cast<int>(SceneId::startMenu), std::move(instance.scene));
+    }
+    else GameEngine::SceneManager::GetInstance().AddScene(static_cast<int>(SceneId::startMenu), LoadStartScreen());
     m_CurrentScene = SceneId::startMenu;
     GameEngine::SceneManager::GetInstance().SetCurrentScene(static_cast<int>(SceneId::startMenu));
 
@@ -62,13 +83,14 @@ void Galaga::LevelCleared()
     switch(m_CurrentScene)
     {
     case SceneId::levelOne:
-        ChangeScene(SceneId::levelTwo, LoadLevel("../Data/Formations/EnemyInfo2.json", "../Data/Formations/FormationTrajectories2.json"));
-           break;
+        LoadScene(SceneId::levelTwo);
+        break;
     case SceneId::levelTwo:
-        ChangeScene(SceneId::levelThree, LoadLevel("../Data/Formations/EnemyInfo3.json", "../Data/Formations/FormationTrajectories3.json"));
+        LoadScene(SceneId::levelThree);
         break;
     case SceneId::levelThree:
-        ChangeScene(SceneId::gameOver, LoadGameOverScene());
+    case SceneId::stressLevel:
+        LoadScene(SceneId::gameOver);
         break;
     default: break;
     }
@@ -76,48 +98,27 @@ void Galaga::LevelCleared()
 void Galaga::SetPlayerName(const std::string& name)
 {
     m_PlayerName = name;
-    auto score = ScoreManager::GetPlayerScore();
-    
-    std::ifstream inFile("../Data/HighestScores.txt");
-    std::map<int,std::string> scores;
-
-    std::string line;
-    while (std::getline(inFile, line))
-    {
-        std::istringstream iss(line);
-        std::string playerName;
-        int playerScore;
-        iss >> playerName >> playerScore;
-        scores[playerScore] = playerName;
-    }
-    inFile.close();
-
-    scores[score] = name;
-    if(scores.size() > 10) scores.erase(scores.begin());
-
-    std::ofstream outFile("../Data/HighestScores.txt");
-    //write to the output file in descending order
-    for(auto it = scores.rbegin(); it != scores.rend(); ++it)
-    {
-        outFile << it->second << " " << it->first << "\n";
-    }
-
-    if(scores.size() < 10)
-    {
-        int scoresLeft = 10 - static_cast<int>(std::ssize(scores));
-        for(int i{}; i < scoresLeft; ++i)
-            outFile << "AAA 0" << "\n";
-    }
-    outFile.close();
-    
+    HighScoreStore::GetInstance().Submit(name, ScoreManager::GetPlayerScore());
 }
 void Galaga::GameLost()
 {
-    ChangeScene(SceneId::gameOver, LoadGameOverScene());
+    LoadScene(SceneId::gameOver);
 }
 void Galaga::ChooseName()
 {
-    ChangeScene(SceneId::chooseName, LoadChooseNameScene());
+    LoadScene(SceneId::chooseName);
+}
+void Galaga::LoadStressLevel(const StressStageSettings& settings)
+{
+    const std::string enemyInfoPath{ "../Data/Formations/EnemyInfoStress.json" };
+    const std::string trajectoryInfoPath{ "../Data/Formations/FormationTrajectoriesStress.json" };
+    StageGenerator::GenerateStage(settings, enemyInfoPath, trajectoryInfoPath);
+
+    auto scene = LoadLevel(enemyInfoPath, trajectoryInfoPath, settings.maxConcurrentDivers);
+    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
+    gameObject->AddComponent<SoakStatsComponent>();
+    scene->AddObject(std::move(gameObject));
+    ChangeScene(SceneId::stressLevel, std::move(scene));
 }
 void Galaga::ChangeScene(SceneId sceneId, std::unique_ptr<GameEngine::Scene>&& scene)
 {
@@ -129,38 +130,125 @@ void Galaga::ChangeScene(SceneId sceneId, std::unique_ptr<GameEngine::Scene>&& s
     GameEngine::SceneManager::GetInstance().RemoveScene(static_cast<int>(m_CurrentScene));
     GameEngine::SceneManager::GetInstance().AddScene(static_cast<int>(sceneId), std::move(scene));
     GameEngine::SceneManager::GetInstance().SetCurrentScene(static_cast<int>(sceneId));
+    if (m_pPendingSession) GameEngine::SceneManager::GetInstance().SetRollbackSession(static_cast<int>(sceneId), std::move(m_pPendingSession));
     m_CurrentScene = sceneId;
 }
+void Galaga::LoadScene(SceneId sceneId)
+{
+    switch(sceneId)
+    {
+    case SceneId::levelOne:
+        ChangeScene(sceneId, LoadLevel("../Data/Formations/EnemyInfo1.json", "../Data/Formations/FormationTrajectories1.json"));
+        break;
+    case SceneId::levelTwo:
+        ChangeScene(sceneId, LoadLevel("../Data/Formations/EnemyInfo2.json", "../Data/Formations/FormationTrajectories2.json"));
+        break;
+    case SceneId::levelThree:
+        ChangeScene(sceneId, LoadLevel("../Data/Formations/EnemyInfo3.json", "../Data/Formations/FormationTrajectories3.json"));
+        break;
+    case SceneId::gameOver:
+        ChangeScene(sceneId, LoadGameOverScene());
+        break;
+    case SceneId::chooseName:
+        ChangeScene(sceneId, LoadChooseNameScene());
+        break;
+    case SceneId::stressLevel:
+        LoadStressLevel(StressStageSettings{});
+        break;
+    default: break;
+    }
+}
 void Galaga::SetGameMode(GameMode mode)
 {
     if(m_HasGameModeBeenSet) return;
     m_CurrentGameMode = mode;
     m_HasGameModeBeenSet = true;
-    ChangeScene(SceneId::levelOne, LoadLevel("../Data/Formations/EnemyInfo1.json", "../Data/Formations/FormationTrajectories1.json"));
+    LoadScene(SceneId::levelOne);
+}
+void Galaga::SetNetworkPeer(std::unique_ptr<GameEngine::ITransport>&& transport, int localPlayer)
+{
+    m_pTransport = std::move(transport);
+    m_LocalPlayer = localPlayer;
+}
+bool Galaga::IsNetworked() const
+{
+    return m_pTransport != nullptr && m_HasGameModeBeenSet && m_CurrentGameMode != GameMode::singlePlayer;
+}
+void Galaga::BindNetworkInput(GameEngine::Scene* scene, GameEngine::GameObject* attacksObject)
+{
+    //both peers load the levels in the same order, so the level count tells their sessions apart
+    ++m_NrOfNetworkSessions;
+    m_pPendingSession = std::make_unique<GameEngine::RollbackSession>(scene, m_pTransport.get(), m_LocalPlayer, m_NrOfNetworkSessions);
+    auto session = m_pPendingSession.get();
+
+    //attacks have to be ordered the same on both ends, so they can't depend on how long a frame took
+    EnemyAIManager::SetFrameBudget(std::chrono::hours{ 1 });
+    EnemyAIManager::SetSeed(m_NrOfNetworkSessions);
+
+    const auto bit = [](NetInput input) { return static_cast<GameEngine::RollbackSession::InputWord>(input); };
+    session->BindAction(0, bit(NetInput::left),
+        std::make_unique<GameEngine::Move>(m_pPlayer, glm::vec2{ -1.f,0.f }, PlayerComponent::m_PlayerSpeed));
+    session->BindAction(0, bit(NetInput::right),
+        std::make_unique<GameEngine::Move>(m_pPlayer, glm::vec2{ 1.f,0.f }, PlayerComponent::m_PlayerSpeed));
+    if(m_CurrentGameMode == GameMode::versus)
+    {
+        session->BindAction(0, bit(NetInput::fire), std::make_unique<ShootBulletCommand>(m_pPlayer));
+        session->BindAction(1, bit(NetInput::fire), std::make_unique<BombingRunCommand>(attacksObject));
+        session->BindAction(1, bit(NetInput::special), std::make_unique<ShootBeamCommand>(attacksObject));
+    }
+    else session->BindAction(1, bit(NetInput::fire), std::make_unique<ShootBulletCommand>(m_pPlayer));
+
+    //the local keys only record the input, the session plays it on both ends
+    auto& input = GameEngine::InputManager::GetInstance();
+    input.BindCommand(GameEngine::KeyboardInputKey::A, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::left)));
+    input.BindCommand(GameEngine::KeyboardInputKey::D, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::right)));
+    input.BindCommand(GameEngine::KeyboardInputKey::SPACE, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::fire)));
+    input.BindCommand(GameEngine::KeyboardInputKey::W, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::special)));
+    input.BindCommand(GameEngine::ControllerInputKey::dpadLeft, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::left)), 0);
+    input.BindCommand(GameEngine::ControllerInputKey::dpadRight, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::right)), 0);
+    input.BindCommand(GameEngine::ControllerInputKey::X, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::fire)), 0);
+    input.BindCommand(GameEngine::ControllerInputKey::Y, std::make_unique<GameEngine::RecordInputCommand>(session, bit(NetInput::special)), 0);
+    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::W);
+    m_ControllerSceneKeys.push_back({ GameEngine::ControllerInputKey::Y, 0 });
 }
-std::unique_ptr<GameEngine::Scene> Galaga::LoadLevel(const std::string& enemyInfoPath, const std::string& trajectoryInfoPath)
+const GameEngine::SceneBlob& Galaga::GetSceneBlob(const std::string& scenePath)
 {
-    auto scene = std::make_unique<GameEngine::Scene>();
+    auto& blob = m_SceneBlobs[scenePath];
+    if (blob) return *blob;
+
+    const std::string blobPath = std::filesystem::path(scenePath).replace_extension(".scene").string();
+    if (GameEngine::SceneCompiler::IsOutOfDate(scenePath, blobPath)) GameEngine::SceneCompiler::Compile(scenePath, blobPath);
+    blob = std::make_unique<GameEngine::SceneBlob>();
+    blob->LoadFromFile(blobPath);
+    return *blob;
+}
+GameEngine::InstantiatedScene Galaga::InstantiateScene(const std::string& scenePath)
+{
+    return GameEngine::SceneManager::GetInstance().InstantiateScene(GetSceneBlob(scenePath), *m_pSceneTypes);
+}
+std::unique_ptr<GameEngine::Scene> Galaga::LoadLevel(const std::string& enemyInfoPath, const std::string& trajectoryInfoPath,
+    int maxConcurrentDivers)
+{
+    const auto& blob = GetSceneBlob("../Data/Scenes/Level.json");
+    auto instance = GameEngine::SceneManager::GetInstance().InstantiateScene(blob, *m_pSceneTypes);
+    auto& scene = instance.scene;
     
     m_PrevKeyboardSceneKeys = std::move(m_KeyboardSceneKeys);
     m_KeyboardSceneKeys = { GameEngine::KeyboardInputKey::A, GameEngine::KeyboardInputKey::D, GameEngine::KeyboardInputKey::SPACE };
+    m_KeyboardSceneKeys.insert(m_KeyboardSceneKeys.end(), instance.keyboardKeys.begin(), instance.keyboardKeys.end());
 
     //do the same for controller keys
     m_PrevControllerSceneKeys = std::move(m_ControllerSceneKeys);
     m_ControllerSceneKeys = { {GameEngine::ControllerInputKey::dpadLeft, 0}, {GameEngine::ControllerInputKey::dpadRight, 0}, {GameEngine::ControllerInputKey::X, 0} };
+    m_ControllerSceneKeys.insert(m_ControllerSceneKeys.end(), instance.controllerKeys.begin(), instance.controllerKeys.end());
     
     //------BACKGROUND--------
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::texture));
-    SDL_Rect& destRect = gameObject->AddComponent<GameEngine::TextureComponent>("Background.png")->m_DestRect;
-    destRect.w = GameEngine::g_WindowRect.w;
-    destRect.h = GameEngine::g_WindowRect.h;
-    gameObject->AddComponent<BackgroundComponent>(gameObject->GetComponent<GameEngine::TextureComponent>(), 700);
-    scene->AddObject(std::move(gameObject));
+    InitStarfield(scene->GetParticleSystem());
 
-    auto font = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 16);
-    auto smallerFont = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 10);
+    std::unique_ptr<GameEngine::GameObject> gameObject;
     //------FPS--------
     #ifndef NDEBUG
+    auto smallerFont = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 10);
     gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
     gameObject->AddComponent<GameEngine::TextureComponent>();
     gameObject->AddComponent<FPSComponent>(gameObject->AddComponent<GameEngine::TextComponent>(smallerFont, "160 FPS"));
@@ -168,104 +256,76 @@ std::unique_ptr<GameEngine::Scene> Galaga::LoadLevel(const std::string& enemyInf
     scene->AddObject(std::move(gameObject));
     #endif
 
-    //----------NR OF PLAYERS---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    std::string text{};
-    if(m_CurrentGameMode == GameMode::singlePlayer) text = "1UP";
-    else text = "2UP";
-    gameObject->AddComponent<GameEngine::TextComponent>(font, text, SDL_Color{ 255,0,0 });
-    gameObject->SetPosition(30, 10);
-    scene->AddObject(std::move(gameObject));
+    //the labels, score and level wide components come from the scene file, only the values are filled in here
+    if(m_CurrentGameMode != GameMode::singlePlayer)
+        instance.objects[blob.GetObjectIndex("players")]->GetComponent<GameEngine::TextComponent>()->SetText("2UP");
+    instance.objects[blob.GetObjectIndex("highestScore")]->GetComponent<GameEngine::TextComponent>()->SetText(
+        std::to_string(ScoreManager::GetHighestScore()));
 
-    //----------SCORE---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<ScoreComponent>(gameObject->AddComponent<GameEngine::TextComponent>(font));
-    gameObject->SetPosition(10, 30);
-    scene->AddObject(std::move(gameObject));
-
-    //----------HIGHEST SCORE---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextComponent>(font,"HIGHEST SCORE", SDL_Color{ 255,0,0 });
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->SetPosition(200, 10);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextComponent>(font,std::to_string(ScoreManager::GetHighestScore()));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->SetPosition(200, 30);
-    scene->AddObject(std::move(gameObject));
+    auto explosionObserver = instance.GetObserver<ExplosionObserver>();
+    auto enemyObserver = instance.GetObserver<EnemyObserver>();
+    auto enemyAttackObserver = instance.GetObserver<EnemyAttacksObserver>();
+    auto formationObserver = instance.GetObserver<FormationObserver>();
+    auto enemyAIObserver = instance.objects[blob.GetObjectIndex("enemyAI")]->GetComponent<EnemyAIManager>();
+    EnemyAIManager::SetMaxConcurrentDivers(maxConcurrentDivers);
 
     //--------FIGHTER--------
-    auto explosionObserverUnique = std::make_unique<ExplosionObserver>(scene.get());
-    auto explosionObserver = scene->AddObserver(-1, std::move(explosionObserverUnique), nullptr);
-
     gameObject = InitFighter();
-    auto fighterObserver = std::make_unique<FighterObserver>();
-    auto bulletObserver = std::make_unique<BulletObserver>(scene.get());
-    scene->AddObserver(static_cast<int>(ObserverIdentifier::bullet), std::move(bulletObserver), gameObject.get());
-    scene->AddObserver(-1, std::move(fighterObserver), gameObject.get());
-    gameObject->AddObserver(-1, explosionObserver);
+    instance.GetObserver<BulletObserver>()->ObserveFighter(gameObject.get());
+    instance.GetObserver<FighterObserver>()->Observe(gameObject.get());
+    explosionObserver->Observe(gameObject.get());
     auto playerComp = gameObject->GetComponent<PlayerComponent>();
     m_pPlayer = scene->AddObject(std::move(gameObject));
     m_pPlayer->GetComponent<PlayerComponent>()->BindCommands();
 
-    //----------------ENEMIES--------------------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    auto enemyAIObserver = gameObject->AddComponent<EnemyAIManager>();
-    scene->AddObject(std::move(gameObject));
-
-    auto enemyObserverUnique = std::make_unique<EnemyObserver>();
-    auto enemyObserver = scene->AddObserver(-1, std::move(enemyObserverUnique), nullptr);
-    auto enemyAttackObserverUnique = std::make_unique<EnemyAttacksObserver>(scene.get());
-    auto enemyAttackObserver = scene->AddObserver(static_cast<int>(ObserverIdentifier::enemyAttack), std::move(enemyAttackObserverUnique), nullptr);
-
-    //--------- Enemy formation------------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    gameObject->AddComponent<FormationComponent>();
-    scene->AddObject(std::move(gameObject));
-
-    auto formationObserverUnique = std::make_unique<FormationObserver>();
-    auto formationObserver = scene->AddObserver(static_cast<int>(ObserverIdentifier::formation),
-        std::move(formationObserverUnique), nullptr);
-
     //--------- Enemy creation------------
     auto enemyVec = Parser::ParseEnemyInfoByStage(enemyInfoPath,
         trajectoryInfoPath, playerComp);
     for (auto& enemy : enemyVec)
     {
-        enemy->AddObserver(-1, enemyObserver);
-        enemy->AddObserver(static_cast<int>(ObserverIdentifier::formation), formationObserver);
-        enemy->AddObserver(static_cast<int>(ObserverIdentifier::enemyAttack), enemyAttackObserver);
-        enemy->AddObserver(-1, enemyAIObserver);
-        enemy->AddObserver(-1, explosionObserver);
+        enemyObserver->Observe(enemy.get());
+        formationObserver->Observe(enemy.get());
+        enemyAttackObserver->ObserveEnemy(enemy.get());
+        enemyAIObserver->Observe(enemy.get());
+        explosionObserver->Observe(enemy.get());
         scene->AddObject(std::move(enemy));
     }
 
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
+    auto attacksObject = instance.objects[blob.GetObjectIndex("attacks")];
     auto& input = GameEngine::InputManager::GetInstance();
-    if(m_CurrentGameMode == GameMode::versus)
+    if(IsNetworked()) BindNetworkInput(scene.get(), attacksObject);
+    else if(m_CurrentGameMode == GameMode::versus)
     {
         input.BindCommand(GameEngine::ControllerInputKey::X,
-            std::make_unique<BombingRunCommand>(gameObject.get()),0);
+            std::make_unique<BombingRunCommand>(attacksObject),0);
         m_ControllerSceneKeys.push_back({ GameEngine::ControllerInputKey::X, 0 });
         input.BindCommand(GameEngine::ControllerInputKey::Y,
-            std::make_unique<ShootBeamCommand>(gameObject.get()),0);
+            std::make_unique<ShootBeamCommand>(attacksObject),0);
         m_ControllerSceneKeys.push_back({ GameEngine::ControllerInputKey::Y, 0 });
     }
-    input.BindCommand(GameEngine::KeyboardInputKey::M,
-        std::make_unique<MuteCommand>(gameObject.get()));
-    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::M);
-    
-    scene->AddObject(std::move(gameObject));
 
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    input.BindCommand(GameEngine::KeyboardInputKey::F1,
-        std::make_unique<SkipLevelCommand>(gameObject.get()));
-    scene->AddObject(std::move(gameObject));
-    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::F1);
+    //skipping a level on one end only would leave the peers in different scenes
+    if(!IsNetworked())
+    {
+        gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
+        input.BindCommand(GameEngine::KeyboardInputKey::F1,
+            std::make_unique<SkipLevelCommand>(gameObject.get()));
+        scene->AddObject(std::move(gameObject));
+        m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::F1);
+
+        //edits to the stage files reach the enemies that haven't set out yet, a rollback would undo them on one end only
+        gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
+        gameObject->AddComponent<TrajectoryReloadComponent>(enemyInfoPath, trajectoryInfoPath);
+        scene->AddObject(std::move(gameObject));
+
+#ifndef NDEBUG
+        gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
+        input.BindCommand(GameEngine::KeyboardInputKey::F2,
+            std::make_unique<LoadStressLevelCommand>(gameObject.get()));
+        scene->AddObject(std::move(gameObject));
+        m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::F2);
+#endif
+    }
     
     //erase everything from the previous keyboard scene keys that match the current keyboard scene keys
     for(auto key : m_KeyboardSceneKeys)
@@ -273,104 +333,31 @@ std::unique_ptr<GameEngine::Scene> Galaga::LoadLevel(const std::string& enemyInf
     for(auto [key, controllerIdx] : m_ControllerSceneKeys)
         std::erase(m_PrevControllerSceneKeys, std::pair{key, controllerIdx});
     
-    return scene;
+    return std::move(instance.scene);
 }
 std::unique_ptr<GameEngine::Scene> Galaga::LoadStartScreen()
 {
-    auto scene = std::make_unique<GameEngine::Scene>();
+    auto instance = InstantiateScene("../Data/Scenes/StartScreen.json");
 
     //------BACKGROUND--------
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::texture));
-    SDL_Rect& destRect = gameObject->AddComponent<GameEngine::TextureComponent>("Background.png")->m_DestRect;
-    destRect.w = GameEngine::g_WindowRect.w;
-    destRect.h = GameEngine::g_WindowRect.h;
-    gameObject->AddComponent<BackgroundComponent>(gameObject->GetComponent<GameEngine::TextureComponent>(), 700);
-    scene->AddObject(std::move(gameObject));
-
-    //------TITLE--------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::texture));
-    gameObject->AddComponent<GameEngine::TextureComponent>("Title.png");
-    gameObject->SetPosition(200, 50);
-    scene->AddObject(std::move(gameObject));
-
-    auto font = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 20);
-
-    //------SWITCH MODES OBJ--------
-    auto switchModesObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    auto switchModeComp = switchModesObject->AddComponent<ModeSelectionComp>();
-
-    //----------Play modes---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    auto textComp = gameObject->AddComponent<GameEngine::TextComponent>(font, "Single player");
-    switchModeComp->AddTextComponent(textComp, GameMode::singlePlayer);
-    gameObject->SetPosition(200, 250);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    textComp = gameObject->AddComponent<GameEngine::TextComponent>(font, "Coop");
-    switchModeComp->AddTextComponent(textComp, GameMode::coop);
-    gameObject->SetPosition(200, 300);
-    scene->AddObject(std::move(gameObject));
+    InitStarfield(instance.scene->GetParticleSystem());
 
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    textComp = gameObject->AddComponent<GameEngine::TextComponent>(font, "Versus");
-    switchModeComp->AddTextComponent(textComp, GameMode::versus);
-    gameObject->SetPosition(200, 350);
-    scene->AddObject(std::move(gameObject));
-
-    auto& input = GameEngine::InputManager::GetInstance();
-    input.BindCommand(GameEngine::KeyboardInputKey::UP,
-        std::make_unique<SwitchModesCommand>(switchModesObject.get(), true));
-    input.BindCommand(GameEngine::KeyboardInputKey::DOWN,
-        std::make_unique<SwitchModesCommand>(switchModesObject.get(), false));
-    input.BindCommand(GameEngine::KeyboardInputKey::ENTER,
-        std::make_unique<SelectModeCommand>(switchModesObject.get()));
-
-    input.BindCommand(GameEngine::ControllerInputKey::dpadUp,
-        std::make_unique<SwitchModesCommand>(switchModesObject.get(), true),0);
-    input.BindCommand(GameEngine::ControllerInputKey::dpadDown,
-        std::make_unique<SwitchModesCommand>(switchModesObject.get(), false),0);
-    input.BindCommand(GameEngine::ControllerInputKey::A,
-        std::make_unique<SelectModeCommand>(switchModesObject.get()),0);
-    scene->AddObject(std::move(switchModesObject));
+    m_KeyboardSceneKeys = std::move(instance.keyboardKeys);
+    m_ControllerSceneKeys = std::move(instance.controllerKeys);
     
-    m_KeyboardSceneKeys = { GameEngine::KeyboardInputKey::UP, GameEngine::KeyboardInputKey::DOWN, GameEngine::KeyboardInputKey::ENTER };
-    m_ControllerSceneKeys = { {GameEngine::ControllerInputKey::dpadUp, 0}, {GameEngine::ControllerInputKey::dpadDown, 0}, {GameEngine::ControllerInputKey::A, 0} };
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    input.BindCommand(GameEngine::KeyboardInputKey::M,
-        std::make_unique<MuteCommand>(gameObject.get()));
-    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::M);
-    scene->AddObject(std::move(gameObject));
-    
-    return scene;
+    return std::move(instance.scene);
 }
 std::unique_ptr<GameEngine::Scene> Galaga::LoadGameOverScene()
 {
-    auto scene = std::make_unique<GameEngine::Scene>();
+    const auto& blob = GetSceneBlob("../Data/Scenes/GameOver.json");
+    auto instance = GameEngine::SceneManager::GetInstance().InstantiateScene(blob, *m_pSceneTypes);
     m_PrevKeyboardSceneKeys = std::move(m_KeyboardSceneKeys);
     m_PrevControllerSceneKeys = std::move(m_ControllerSceneKeys);
+    m_KeyboardSceneKeys = std::move(instance.keyboardKeys);
+    m_ControllerSceneKeys = std::move(instance.controllerKeys);
 
     //------BACKGROUND--------
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::texture));
-    SDL_Rect& destRect = gameObject->AddComponent<GameEngine::TextureComponent>("Background.png")->m_DestRect;
-    destRect.w = GameEngine::g_WindowRect.w;
-    destRect.h = GameEngine::g_WindowRect.h;
-    gameObject->AddComponent<BackgroundComponent>(gameObject->GetComponent<GameEngine::TextureComponent>(), 700);
-    scene->AddObject(std::move(gameObject));
-
-    auto font = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 20);
-    auto smallerFont = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 16);
-
-    //------TITLE--------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<GameEngine::TextComponent>(font, "- RESULT -")->SetColor({255, 0, 0,255});
-    gameObject->SetPosition(200, 150);
-    scene->AddObject(std::move(gameObject));
+    InitStarfield(instance.scene->GetParticleSystem());
 
     auto bulletsFired = BulletTracker::GetBulletsFired();
     auto bulletsHit = BulletTracker::GetBulletsHit();
@@ -378,56 +365,13 @@ std::unique_ptr<GameEngine::Scene> Galaga::LoadGameOverScene()
     if(bulletsFired == 0) hitMissRatio = 0;
     std::stringstream hitMissStr{};
     hitMissStr << std::fixed << std::setprecision(1) << hitMissRatio<<"%";
-    //------SHOTS FIRED--------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<GameEngine::TextComponent>(font, "SHOTS FIRED       "+ std::to_string(bulletsFired))->SetColor({0, 0, 255,255});
-    gameObject->SetPosition(50, 200);
-    scene->AddObject(std::move(gameObject));
-
-    //------NUMBER OF HITS--------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<GameEngine::TextComponent>(font, "NUMBER OF HITS    "+ std::to_string(bulletsHit));
-    gameObject->SetPosition(50, 250);
-    scene->AddObject(std::move(gameObject));
-
-    //------HIT-MISS RATIO--------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<GameEngine::TextComponent>(font, "HIT-MISS RATIO    "+ hitMissStr.str())->SetColor({255, 255, 0,255});
-    gameObject->SetPosition(50, 300);
-    scene->AddObject(std::move(gameObject));
-
-    //----------NR OF PLAYERS---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    std::string text{};
-    if(m_CurrentGameMode == GameMode::singlePlayer) text = "1UP";
-    else text = "2UP";
-    gameObject->AddComponent<GameEngine::TextComponent>(smallerFont, text, SDL_Color{ 255,0,0 });
-    gameObject->SetPosition(30, 10);
-    scene->AddObject(std::move(gameObject));
-
-    //----------SCORE---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<ScoreComponent>(gameObject->AddComponent<GameEngine::TextComponent>(smallerFont));
-    gameObject->SetPosition(10, 30);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    auto& input = GameEngine::InputManager::GetInstance();
-    input.BindCommand(GameEngine::KeyboardInputKey::M,
-        std::make_unique<MuteCommand>(gameObject.get()));
-    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::M);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    input.BindCommand(GameEngine::KeyboardInputKey::ENTER,
-        std::make_unique<LoadChooseNameCommand>(gameObject.get()));
-    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::ENTER);
-    scene->AddObject(std::move(gameObject));
+    const auto setText = [&](std::string_view name, const std::string& text) {
+        instance.objects[blob.GetObjectIndex(name)]->GetComponent<GameEngine::TextComponent>()->SetText(text);
+    };
+    setText("shotsFired", "SHOTS FIRED       " + std::to_string(bulletsFired));
+    setText("hits", "NUMBER OF HITS    " + std::to_string(bulletsHit));
+    setText("hitMissRatio", "HIT-MISS RATIO    " + hitMissStr.str());
+    if(m_CurrentGameMode != GameMode::singlePlayer) setText("players", "2UP");
 
     //erase everything from the previous keyboard scene keys that match the current keyboard scene keys
     for(auto key : m_KeyboardSceneKeys)
@@ -437,109 +381,32 @@ std::unique_ptr<GameEngine::Scene> Galaga::LoadGameOverScene()
     for(auto [key, controllerIdx] : m_ControllerSceneKeys)
         std::erase(m_PrevControllerSceneKeys, std::pair{key, controllerIdx});
     
-    return scene;
+    return std::move(instance.scene);
 }
 
 std::unique_ptr<GameEngine::Scene> Galaga::LoadChooseNameScene()
 {
-    auto scene = std::make_unique<GameEngine::Scene>();
+    auto instance = InstantiateScene("../Data/Scenes/ChooseName.json");
+    auto& scene = instance.scene;
+    m_KeyboardSceneKeys.insert(m_KeyboardSceneKeys.end(), instance.keyboardKeys.begin(), instance.keyboardKeys.end());
+    m_ControllerSceneKeys.insert(m_ControllerSceneKeys.end(), instance.controllerKeys.begin(), instance.controllerKeys.end());
 
     //------BACKGROUND--------
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::texture));
-    SDL_Rect& destRect = gameObject->AddComponent<GameEngine::TextureComponent>("Background.png")->m_DestRect;
-    destRect.w = GameEngine::g_WindowRect.w;
-    destRect.h = GameEngine::g_WindowRect.h;
-    gameObject->AddComponent<BackgroundComponent>(gameObject->GetComponent<GameEngine::TextureComponent>(), 700);
-    scene->AddObject(std::move(gameObject));
+    InitStarfield(scene->GetParticleSystem());
 
     auto font = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 20);
-    auto smallerFont = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 16);
-
-    //------TITLE--------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<GameEngine::TextComponent>(font, "HIGHEST SCORES");
-    gameObject->SetPosition(200, 50);
-    scene->AddObject(std::move(gameObject));
-    
-
-    //----------SCORE---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    gameObject->AddComponent<ScoreComponent>(gameObject->AddComponent<GameEngine::TextComponent>(smallerFont));
-    gameObject->SetPosition(10, 30);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    auto& input = GameEngine::InputManager::GetInstance();
-    input.BindCommand(GameEngine::KeyboardInputKey::M,
-        std::make_unique<MuteCommand>(gameObject.get()));
-    m_KeyboardSceneKeys.push_back(GameEngine::KeyboardInputKey::M);
-    scene->AddObject(std::move(gameObject));
-
-    //-----------------NAME SELECTION----------------
-    auto nameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    auto nameSelectionComp = nameObject->AddComponent<NameSelectionComp>();
-    
-    //----------Play modes---------
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    auto textComp = gameObject->AddComponent<GameEngine::TextComponent>(font, "A");
-    nameSelectionComp->AddTextComponent(textComp);
-    gameObject->SetPosition(200, 500);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    textComp = gameObject->AddComponent<GameEngine::TextComponent>(font, "A");
-    nameSelectionComp->AddTextComponent(textComp);
-    gameObject->SetPosition(220, 500);
-    scene->AddObject(std::move(gameObject));
-
-    gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
-    gameObject->AddComponent<GameEngine::TextureComponent>();
-    textComp = gameObject->AddComponent<GameEngine::TextComponent>(font, "A");
-    nameSelectionComp->AddTextComponent(textComp);
-    gameObject->SetPosition(240, 500);
-    scene->AddObject(std::move(gameObject));
-
-    std::ifstream inFile("../Data/HighestScores.txt");
-    std::string line;
     float yPosition = 100.f; // starting y position for the scores
-    int index = 0; // index for the scores
-
-    while (std::getline(inFile, line) && index < 10)
+    for (const HighScoreEntry& entry : HighScoreStore::GetInstance().GetEntries())
     {
-        std::istringstream iss(line);
-        std::string playerName;
-        int playerScore;
-        iss >> playerName >> playerScore;
-
-        gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
+        auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::text));
+        gameObject->SetRenderLayer(GameEngine::RenderLayer::ui);
         gameObject->AddComponent<GameEngine::TextureComponent>();
-        gameObject->AddComponent<GameEngine::TextComponent>(font, playerName + " " + std::to_string(playerScore));
+        gameObject->AddComponent<GameEngine::TextComponent>(font, entry.name + " " + std::to_string(entry.score));
         gameObject->SetPosition(200, yPosition);
         scene->AddObject(std::move(gameObject));
 
         yPosition += 30; // increment y position for the next score
-        ++index; // increment the index
     }
-    inFile.close();
-
-    input.BindCommand(GameEngine::KeyboardInputKey::UP,
-        std::make_unique<SwitchNameCommand>(nameObject.get(), true));
-    input.BindCommand(GameEngine::KeyboardInputKey::DOWN,
-        std::make_unique<SwitchNameCommand>(nameObject.get(), false));
-    input.BindCommand(GameEngine::KeyboardInputKey::ENTER,
-        std::make_unique<SelectNameCommand>(nameObject.get()));
-
-    input.BindCommand(GameEngine::ControllerInputKey::dpadUp,
-        std::make_unique<SwitchNameCommand>(nameObject.get(), true),0);
-    input.BindCommand(GameEngine::ControllerInputKey::dpadDown,
-        std::make_unique<SwitchNameCommand>(nameObject.get(), false),0);
-    input.BindCommand(GameEngine::ControllerInputKey::A,
-        std::make_unique<SelectNameCommand>(nameObject.get()),0);
-    scene->AddObject(std::move(nameObject));
     
-    return scene;
+    return std::move(instance.scene);
 }
@@ -1,6 +1,8 @@
 ﻿#pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Managers/Singleton.h"
@@ -15,14 +17,20 @@ namespace GameEngine
 }
 enum class SceneId;
 enum class GameMode;
+struct StressStageSettings;
 namespace GameEngine
 {
     class Scene;
+    class ITransport;
+    class RollbackSession;
+    class SceneBlob;
+    class SceneTypeRegistry;
+    struct InstantiatedScene;
 }
 class Galaga final : public GameEngine::Singleton<Galaga>
 {
 public:
-    ~Galaga() = default;
+    ~Galaga();
     Galaga(const Galaga& other) = delete;
     Galaga(Galaga&& other) noexcept = delete;
     Galaga& operator=(const Galaga& other) = delete;
@@ -33,15 +41,27 @@ public:
     void SetPlayerName(const std::string& name);
     void GameLost();
     void ChooseName();
+    //Generates a stage with the given settings and replaces the current scene with it
+    void LoadStressLevel(const StressStageSettings& settings);
     void ChangeScene(SceneId sceneId, std::unique_ptr<GameEngine::Scene>&& scene);
+    //Builds the scene and replaces the current one with it, the stress level uses the default settings.
+    //The start menu is only loaded by LoadStartScene and the levels need the game mode to be set
+    void LoadScene(SceneId sceneId);
+    [[nodiscard]] SceneId GetCurrentScene() const { return m_CurrentScene; }
     void SetGameMode(GameMode mode);
     GameMode GetGameMode() const { return m_CurrentGameMode; }
+    //Coop and versus levels are then played against the peer on the other end of the transport,
+    //both peers have to pick the same mode
+    void SetNetworkPeer(std::unique_ptr<GameEngine::ITransport>&& transport, int localPlayer);
+    [[nodiscard]] bool IsNetworked() const;
+    //The start scene is then built from this scene file instead of the start menu, handy for stress scenes
+    void SetStartSceneFile(const std::string& scenePath) { m_StartSceneFile = scenePath; }
     static constexpr int baseVolume = 50;
     static int volume;
     GameEngine::GameObject* m_pPlayer;
 private:
     friend class Singleton<Galaga>;
-    Galaga() = default;
+    Galaga();
 
     std::string m_PlayerName{};
     bool m_HasGameModeBeenSet{ false };
@@ -51,7 +71,21 @@ private:
     std::vector<std::pair<GameEngine::ControllerInputKey, int>> m_ControllerSceneKeys;
     std::vector<GameEngine::KeyboardInputKey> m_PrevKeyboardSceneKeys;
     std::vector<std::pair<GameEngine::ControllerInputKey, int>> m_PrevControllerSceneKeys;
-    std::unique_ptr<GameEngine::Scene> LoadLevel(const std::string& enemyInfoPath, const std::string& trajectoryInfoPath);
+    std::unique_ptr<GameEngine::ITransport> m_pTransport;
+    int m_LocalPlayer{};
+    uint16_t m_NrOfNetworkSessions{};
+    //created by LoadLevel, handed to the scene manager once the scene is added
+    std::unique_ptr<GameEngine::RollbackSession> m_pPendingSession;
+    std::unique_ptr<GameEngine::SceneTypeRegistry> m_pSceneTypes;
+    //compiled scenes by scene file, every scene is compiled and read once per run
+    std::unordered_map<std::string, std::unique_ptr<GameEngine::SceneBlob>> m_SceneBlobs;
+    std::string m_StartSceneFile{};
+    //Compiles the scene file next to itself if the compiled scene is missing or older
+    const GameEngine::SceneBlob& GetSceneBlob(const std::string& scenePath);
+    GameEngine::InstantiatedScene InstantiateScene(const std::string& scenePath);
+    void BindNetworkInput(GameEngine::Scene* scene, GameEngine::GameObject* attacksObject);
+    std::unique_ptr<GameEngine::Scene> LoadLevel(const std::string& enemyInfoPath, const std::string& trajectoryInfoPath,
+        int maxConcurrentDivers = 1);
     std::unique_ptr<GameEngine::Scene> LoadStartScreen();
     std::unique_ptr<GameEngine::Scene> LoadGameOverScene();
     std::unique_ptr<GameEngine::Scene> LoadChooseNameScene();
@@ -4,6 +4,7 @@
 #include "Components/SpriteComponent.h"
 #include "Subjects/GameObject.h"
 #include "Managers/TimeManager.h"
+#include "Snapshot.h"
 
 BulletComponent::BulletComponent(GameEngine::GameObject* gameObj, int playerID,
     GameEngine::SpriteComponent* spriteComponent):
@@ -18,10 +19,17 @@ void BulletComponent::Update()
     
     if (bulletYPos <= 0)
     {
-        GetGameObjParent()->Notify( static_cast<int>(GameEvent::bulletOutOfBounds),
-            static_cast<int>(ObserverIdentifier::bullet));
+        GetGameObjParent()->Emit(BulletOutOfBoundsEvent{});
         return;
     }
 
     GetGameObjParent()->GetLocalTransform().Translate(GameEngine::TimeManager::GetElapsed() * m_Velocity);
 }
+void BulletComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_Velocity);
+}
+void BulletComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_Velocity);
+}
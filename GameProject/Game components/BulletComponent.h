@@ -19,6 +19,8 @@ public:
     ~BulletComponent() override = default;
     
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
     [[nodiscard]] int GetPlayerID() const { return m_PlayerID; }
 private:
     int m_PlayerID{-1};
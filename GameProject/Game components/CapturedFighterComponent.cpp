@@ -2,6 +2,7 @@
 
 #include "FormationComponent.h"
 #include "Enemy components/BossGalagaComponent.h"
+#include "Snapshot.h"
 
 CapturedFighterComponent::CapturedFighterComponent(GameEngine::GameObject* gameObj, BossGalagaComponent* parent, GameEngine::SpriteComponent* spriteComponent):
     Component(gameObj),
@@ -12,15 +13,13 @@ CapturedFighterComponent::CapturedFighterComponent(GameEngine::GameObject* gameO
 
 void CapturedFighterComponent::UploadGetBackTrajectory() const
 {
-    std::queue<PathData> pathDataQueue;
     PathData pathData;
 
     // Initial movement to get behind the boss
     auto sprite = m_Parent->GetGameObjParent()->GetComponent<GameEngine::SpriteComponent>();
     pathData.destination = glm::vec2(0, -sprite->m_DestRect.h);
-    pathDataQueue.push(pathData);
     auto localPos = GetGameObjParent()->GetLocalTransform().GetPosition();
-    m_GetBackTrajectory->SetPathData(pathDataQueue, localPos);
+    m_GetBackTrajectory->SetPathData({ &pathData, 1 }, localPos);
 }
 void CapturedFighterComponent::Update()
 {
@@ -31,11 +30,8 @@ void CapturedFighterComponent::Update()
             m_GetBackTrajectory = nullptr;
             return;
         }
-        auto newPos = m_GetBackTrajectory->
-        Update(m_Speed, GetGameObjParent()->GetLocalTransform().GetPosition()).first;
-        
-        m_RotatingSprite->RotateSpriteInDirection(m_GetBackTrajectory->GetDirection());
-        GetGameObjParent()->SetPosition({ newPos,0 });
+        m_GetBackTrajectory->Update(m_Speed, GetGameObjParent());
+        m_RotatingSprite->QueueRotation(*m_GetBackTrajectory);
     }
     else
     {
@@ -43,3 +39,20 @@ void CapturedFighterComponent::Update()
         else m_RotatingSprite->RotateSpriteInDirection({ FormationComponent::GetDirection(),0 });
     }
 }
+void CapturedFighterComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    m_RotatingSprite->SaveState(snapshot);
+    snapshot.Write(m_GetBackTrajectory != nullptr);
+    if (m_GetBackTrajectory) m_GetBackTrajectory->SaveState(snapshot);
+}
+void CapturedFighterComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    m_RotatingSprite->LoadState(snapshot);
+    if (!snapshot.Read<bool>())
+    {
+        m_GetBackTrajectory = nullptr;
+        return;
+    }
+    if (!m_GetBackTrajectory) m_GetBackTrajectory = std::make_unique<Trajectory>();
+    m_GetBackTrajectory->LoadState(snapshot, GetGameObjParent());
+}
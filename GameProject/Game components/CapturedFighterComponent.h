@@ -13,6 +13,8 @@ public:
     explicit CapturedFighterComponent(GameEngine::GameObject* gameObj,BossGalagaComponent* parent,GameEngine::SpriteComponent* spriteComponent);
     void UploadGetBackTrajectory() const;
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
 private:
     std::unique_ptr<RotatingSprite> m_RotatingSprite{};
     std::unique_ptr<Trajectory> m_GetBackTrajectory{nullptr};
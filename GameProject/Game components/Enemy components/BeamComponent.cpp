@@ -2,6 +2,7 @@
 
 #include "DataStructs.h"
 #include "Components/SpriteComponent.h"
+#include "Snapshot.h"
 #include "Subjects/GameObject.h"
 
 BeamComponent::BeamComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, EnemyComponent* parentComp):
@@ -17,8 +18,7 @@ void BeamComponent::Update()
         {
             if (m_CurrentRow == 0)
             {
-                GetGameObjParent()->Notify(static_cast<int>(GameEvent::beamRetracted),
-                    static_cast<int>(ObserverIdentifier::enemyAttack));
+                GetGameObjParent()->Emit(BeamRetractedEvent{});
                 return;
             }
             m_SpriteComponent->m_SpriteInfo.m_CurrentCol = 0;
@@ -43,3 +43,13 @@ bool BeamComponent::IsBeamActive() const
     BossGalagaComponent* bossComp = dynamic_cast<BossGalagaComponent*>(m_ParentComp);
     return bossComp->HasCapturedFighter();
 }
+void BeamComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsBeamRetracting);
+    snapshot.Write(m_CurrentRow);
+}
+void BeamComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_IsBeamRetracting);
+    snapshot.Read(m_CurrentRow);
+}
@@ -6,6 +6,8 @@ class BeamComponent : public GameEngine::Component
 public:
     explicit BeamComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, EnemyComponent* parentComp);
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
     EnemyComponent* GetParentComp() const { return m_ParentComp; }
     bool IsBeamRetracting() const { return m_IsBeamRetracting; }
     bool IsBeamActive() const;
@@ -1,7 +1,7 @@
 ﻿#pragma once
 #include "EnemyComponent.h"
 
-class BeeComponent final : public EnemyComponent
+class BeeComponent final : public EnemyComponent, public GameEngine::PooledComponent<BeeComponent>
 {
 public:
     explicit BeeComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, PlayerComponent* playerComponent);
@@ -1,43 +1,47 @@
 ﻿#include "BossGalagaComponent.h"
-
-#include "Enemy States/BombingRunState.h"
-#include "Enemy States/BossShootingBeamState.h"
-#include "Enemy States/IdleState.h"
+#include "Snapshot.h"
 
 BossGalagaComponent::BossGalagaComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, PlayerComponent* playerComponent):
-    EnemyComponent(gameObj, spriteComponent, playerComponent),
-    m_BossStage(std::make_unique<BossStageOne>())
+    EnemyComponent(gameObj, spriteComponent, playerComponent, EnemyId::bossGalaga)
 {}
 
 bool BossGalagaComponent::HasBeenHit()
 {
-    if (BossHealthStage* bossStage = m_BossStage->HasBeenHit(this))
+    if (std::visit([this](auto& bossStage) { return bossStage.HasBeenHit(this); }, m_BossStage))
     {
-        m_BossStage.reset(bossStage);
+        m_BossStage = BossStageTwo{};
         return false;
     }
     return true;
 }
 EnemyId BossGalagaComponent::GetEnemyID() const
 {
-    if(!m_CurrentState) return EnemyId::bossGalaga;
-    if (m_CurrentState->IsDiving()) return EnemyId::bossGalagaDiving;
+    if (IsInDivingState()) return EnemyId::bossGalagaDiving;
     return EnemyId::bossGalaga;
 }
+void BossGalagaComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    EnemyComponent::SaveState(snapshot);
+    snapshot.Write(m_HasCapturedFighter);
+    snapshot.Write(static_cast<int>(m_BossStage.index()));
+}
+void BossGalagaComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    EnemyComponent::LoadState(snapshot);
+    snapshot.Read(m_HasCapturedFighter);
+    //the sprite of the damaged boss is restored by its SpriteComponent
+    if (snapshot.Read<int>() == 0) m_BossStage = BossStageOne{};
+    else m_BossStage = BossStageTwo{};
+}
 void BossGalagaComponent::GetInAttackState()
 {
-    m_CurrentState->Exit(this);
-    m_CurrentState = std::make_unique<BombingRunState>();
-    m_CurrentState->Enter(this);
+    ChangeState(EnemyStateId::bombingRun);
 }
 void BossGalagaComponent::GetInBeamAttackState()
 {
-    m_CurrentState->Exit(this);
-    m_CurrentState = std::make_unique<BossShootingBeamState>();
-    m_CurrentState->Enter(this);
+    ChangeState(EnemyStateId::bossShootingBeam);
 }
 bool BossGalagaComponent::CanAttack() const
 {
-    if(dynamic_cast<IdleState*>(m_CurrentState.get())) return true;
-    return false;
+    return IsIdle();
 }
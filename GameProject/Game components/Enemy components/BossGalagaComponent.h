@@ -2,7 +2,7 @@
 #include "EnemyComponent.h"
 #include "Enemy States/BossHealthStage.h"
 
-class BossGalagaComponent final : public EnemyComponent
+class BossGalagaComponent final : public EnemyComponent, public GameEngine::PooledComponent<BossGalagaComponent>
 {
 public:
     explicit BossGalagaComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, PlayerComponent* playerComponent);
@@ -13,10 +13,12 @@ public:
     BossGalagaComponent& operator=(BossGalagaComponent&& other) noexcept = delete;
     ~BossGalagaComponent() override = default;
 
-    bool IsDiving() const { return m_CurrentState->IsDiving(); }
+    bool IsDiving() const { return IsInDivingState(); }
     //returns true if boss is destroyed
     virtual bool HasBeenHit() override;
     virtual EnemyId GetEnemyID() const override;
+    virtual void SaveState(GameEngine::Snapshot& snapshot) const override;
+    virtual void LoadState(GameEngine::Snapshot& snapshot) override;
     virtual void GetInAttackState() override;
     virtual void GetInBeamAttackState();
     bool CanAttack() const;
@@ -24,5 +26,5 @@ public:
     bool HasCapturedFighter() const { return m_HasCapturedFighter; }
 private:
     bool m_HasCapturedFighter{ false };
-    std::unique_ptr<BossHealthStage> m_BossStage;
+    BossHealthStage m_BossStage{};
 };
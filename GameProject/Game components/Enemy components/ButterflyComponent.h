@@ -1,7 +1,7 @@
 ﻿#pragma once
 #include "EnemyComponent.h"
 
-class ButterflyComponent final : public EnemyComponent
+class ButterflyComponent final : public EnemyComponent, public GameEngine::PooledComponent<ButterflyComponent>
 {
 public:
     explicit ButterflyComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, PlayerComponent* playerComponent);
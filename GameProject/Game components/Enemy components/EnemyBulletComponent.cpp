@@ -3,6 +3,7 @@
 #include "DataStructs.h"
 #include "Minigin.h"
 #include "Managers/TimeManager.h"
+#include "Snapshot.h"
 #include "Subjects/GameObject.h"
 
 EnemyBulletComponent::EnemyBulletComponent(GameEngine::GameObject* gameObj, const glm::vec2& direction):
@@ -13,10 +14,17 @@ void EnemyBulletComponent::Update()
     
     if (bulletYPos > GameEngine::g_WindowRect.h)
     {
-        GetGameObjParent()->Notify( static_cast<int>(GameEvent::bulletOutOfBounds),
-            static_cast<int>(ObserverIdentifier::enemyAttack));
+        GetGameObjParent()->Emit(BulletOutOfBoundsEvent{});
         return;
     }
 
     GetGameObjParent()->GetLocalTransform().Translate(GameEngine::TimeManager::GetElapsed() * m_Direction * m_Speed);
 }
+void EnemyBulletComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_Direction);
+}
+void EnemyBulletComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_Direction);
+}
@@ -8,6 +8,8 @@ class EnemyBulletComponent final : public GameEngine::Component
 public:
     EnemyBulletComponent(GameEngine::GameObject* gameObj,const glm::vec2& direction);
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
 private:
     const float m_Speed{ 500.0f };
     glm::vec2 m_Direction{};
@@ -1,62 +1,137 @@
 ﻿#include "EnemyComponent.h"
-#include "Enemy States/GetInFormationState.h"
-#include "Enemy States/IdleState.h"
 #include "Game components/FormationComponent.h"
 #include "Game observers/EnemyAIManager.h"
 #include "Game observers/FormationObserver.h"
+#include "Snapshot.h"
 #include "Subjects/GameObject.h"
 
-EnemyComponent::EnemyComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, PlayerComponent* playerComponent):
+EnemyComponent::EnemyComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent,
+    PlayerComponent* playerComponent, EnemyId enemyType):
     Component(gameObj),
     m_PlayerComponent(playerComponent),
-    m_CurrentState(nullptr),
-    m_RotatingSprite(std::make_unique<RotatingSprite>(spriteComponent))
+    m_RotatingSprite(std::make_unique<RotatingSprite>(spriteComponent)),
+    m_EnemyType(enemyType)
 {
     EnemyAIManager::AddEnemy(this);
 }
+EnemyComponent::~EnemyComponent()
+{
+    //enemies that did not die, e.g. when the scene is unloaded
+    EnemyAIManager::RemoveEnemy(this);
+}
 void EnemyComponent::GetInIdleState()
 {
     m_CurDirection = { 0,1 };
-    m_CurrentState->Exit(this);
-    m_CurrentState = std::make_unique<IdleState>();
-    m_CurrentState->Enter(this);
+    ChangeState(EnemyStateId::idle);
 }
 void EnemyComponent::SetFormationPosition(const glm::ivec2& formationPos)
 {
     m_FormationPosition = formationPos;
 }
-void EnemyComponent::SetFormationTrajectory(const std::queue<PathData>& pathDataQueue)
+void EnemyComponent::SetFormationTrajectory(std::shared_ptr<const CompiledPath> stagePath, bool isMirrored)
 {
-    m_FormationTrajectory.SetPathData(pathDataQueue, GetGameObjParent()->GetPosition());
+    m_FormationTrajectory.SetPath(std::move(stagePath), isMirrored, glm::vec2(m_FormationPosition));
 }
 bool EnemyComponent::HasSetOut() const
 {
-    if(auto getInFormationState = dynamic_cast<GetInFormationState*>(m_CurrentState.get()))
+    if(auto getInFormationState = std::get_if<GetInFormationState>(&m_CurrentState))
         return getInFormationState->HasSetOut();
     return false;
 }
+void EnemyComponent::ChangeState(EnemyStateId state)
+{
+    ExitState();
+    EmplaceState(state);
+    EnemyAIManager::EnemyChangedState(this);
+    std::visit([this](auto& currentState)
+    {
+        if constexpr (requires { currentState.Enter(this); }) currentState.Enter(this);
+    }, m_CurrentState);
+}
+void EnemyComponent::EmplaceState(EnemyStateId state)
+{
+    switch (state)
+    {
+    case EnemyStateId::getInFormation: m_CurrentState.emplace<GetInFormationState>(); break;
+    case EnemyStateId::idle: m_CurrentState.emplace<IdleState>(); break;
+    case EnemyStateId::bombingRun: m_CurrentState.emplace<BombingRunState>(); break;
+    case EnemyStateId::butterflyBombingRun: m_CurrentState.emplace<ButterflyBombingRunState>(); break;
+    case EnemyStateId::bossShootingBeam: m_CurrentState.emplace<BossShootingBeamState>(); break;
+    case EnemyStateId::none: m_CurrentState.emplace<std::monostate>(); break;
+    }
+}
+void EnemyComponent::ExitState()
+{
+    std::visit([this](auto& currentState)
+    {
+        if constexpr (requires { currentState.Exit(this); }) currentState.Exit(this);
+    }, m_CurrentState);
+}
+bool EnemyComponent::IsInDivingState() const
+{
+    return std::visit([](const auto& currentState)
+    {
+        if constexpr (requires { currentState.IsDiving(); }) return currentState.IsDiving();
+        else return false;
+    }, m_CurrentState);
+}
 
 void EnemyComponent::Update()
 {
-    if (m_CurrentState)
+    if (HasCurrentState())
     {
-        if (auto nextState = m_CurrentState->Update(this))
+        //the state is only replaced after its update returned
+        const EnemyStateId nextState = std::visit([this](auto& currentState)
         {
-            m_CurrentState->Exit(this);
-            m_CurrentState = std::move(nextState);
-            m_CurrentState->Enter(this);
-        }
+            if constexpr (requires { currentState.Update(this); }) return currentState.Update(this);
+            else return EnemyStateId::none;
+        }, m_CurrentState);
+        if (nextState != EnemyStateId::none) ChangeState(nextState);
     }
     else if (FormationObserver::GetCurrentStage() == m_Stage)
     {
         FormationObserver::EnemySetOut();
-        m_CurrentState = std::make_unique<GetInFormationState>();
-        m_CurrentState->Enter(this);
+        ChangeState(EnemyStateId::getInFormation);
     }
 }
+void EnemyComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_CurDirection);
+    snapshot.Write(m_CurrentTime);
+    snapshot.Write(m_CurrentRotationStage);
+    snapshot.Write(m_LastAttackTime);
+    m_RotatingSprite->SaveState(snapshot);
+    m_FormationTrajectory.SaveState(snapshot);
+    m_StateTrajectory.SaveState(snapshot);
+    snapshot.Write(static_cast<EnemyStateId>(m_CurrentState.index()));
+    std::visit([&snapshot](const auto& currentState)
+    {
+        if constexpr (requires { currentState.SaveState(snapshot); }) currentState.SaveState(snapshot);
+    }, m_CurrentState);
+}
+void EnemyComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_CurDirection);
+    snapshot.Read(m_CurrentTime);
+    snapshot.Read(m_CurrentRotationStage);
+    snapshot.Read(m_LastAttackTime);
+    m_RotatingSprite->LoadState(snapshot);
+    m_FormationTrajectory.LoadState(snapshot, GetGameObjParent());
+    m_StateTrajectory.LoadState(snapshot, GetGameObjParent());
+    const auto state = snapshot.Read<EnemyStateId>();
+    if (static_cast<size_t>(state) != m_CurrentState.index()) EmplaceState(state);
+    std::visit([&snapshot, this](auto& currentState)
+    {
+        if constexpr (requires { currentState.LoadState(snapshot, this); }) currentState.LoadState(snapshot, this);
+        else if constexpr (requires { currentState.LoadState(snapshot); }) currentState.LoadState(snapshot);
+    }, m_CurrentState);
+    //only living enemies are saved, so the enemy may have to come back after dying
+    EnemyAIManager::AddEnemy(this);
+    EnemyAIManager::EnemyChangedState(this);
+}
 void EnemyComponent::Died()
 {
-    if(m_CurrentState) m_CurrentState->Exit(this);
+    ExitState();
     EnemyAIManager::RemoveEnemy(this);
     GetGameObjParent()->SetDestroyedFlag();
 }
@@ -64,13 +139,9 @@ void EnemyComponent::Died()
 bool EnemyComponent::UpdateTrajectory(Trajectory& trajectory) 
 {
     if (trajectory.IsComplete()) return true;
-    const glm::vec2 currentPos = GetGameObjParent()->GetPosition();
-    auto [newPos, hasDirectionChanged] = trajectory.Update(GetSpeed(), currentPos);
-    if (hasDirectionChanged)
-    {
-        m_CurDirection = trajectory.GetDirection();
-        m_RotatingSprite->RotateSpriteInDirection(trajectory.GetDirection());
-    }
-    GetGameObjParent()->SetPosition({ newPos,0 });
+    trajectory.Update(GetSpeed(), GetGameObjParent());
+    //the sprite turns once the batch has stepped the lane, unchanged rotation stages cost no more than the lookup
+    m_CurDirection = trajectory.GetDirection();
+    m_RotatingSprite->QueueRotation(trajectory);
     return false;
 }
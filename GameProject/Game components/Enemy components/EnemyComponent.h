@@ -1,9 +1,15 @@
 ﻿#pragma once
 #include <queue>
+#include <variant>
 #include "Trajectory Logic/Trajectory.h"
 #include "DataStructs.h"
 #include "Components/Component.h"
+#include "Enemy States/BombingRunState.h"
+#include "Enemy States/BossShootingBeamState.h"
+#include "Enemy States/ButterflyBombingRunState.h"
 #include "Enemy States/EnemyState.h"
+#include "Enemy States/GetInFormationState.h"
+#include "Enemy States/IdleState.h"
 #include "Game components/PlayerComponent.h"
 #include "RotatingSprite.h"
 
@@ -12,31 +18,47 @@ namespace GameEngine
     class SpriteComponent;
 }
 
+//monostate until the enemy sets out for the first time
+using EnemyStateVariant = std::variant<std::monostate, GetInFormationState, IdleState, BombingRunState,
+    ButterflyBombingRunState, BossShootingBeamState>;
+static_assert(std::variant_size_v<EnemyStateVariant> == static_cast<size_t>(EnemyStateId::bossShootingBeam) + 1);
+
 class EnemyComponent : public GameEngine::Component
 {
 public:
-    explicit EnemyComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent, PlayerComponent* playerComponent);
+    explicit EnemyComponent(GameEngine::GameObject* gameObj, GameEngine::SpriteComponent* spriteComponent,
+        PlayerComponent* playerComponent, EnemyId enemyType);
 
     EnemyComponent(const EnemyComponent& other) = delete;
     EnemyComponent(EnemyComponent&& other) noexcept = delete;
     EnemyComponent& operator=(const EnemyComponent& other) = delete;
     EnemyComponent& operator=(EnemyComponent&& other) noexcept = delete;
-    ~EnemyComponent() override = default;
+    ~EnemyComponent() override;
 
     virtual void GetInAttackState() = 0;
     virtual void GetInIdleState();
     void SetFormationPosition(const glm::ivec2& formationPos);
-    void SetFormationTrajectory(const std::queue<PathData>& pathDataQueue);
-    bool HasCurrentState() const { return m_CurrentState != nullptr; }
+    void SetFormationTrajectory(std::shared_ptr<const CompiledPath> stagePath, bool isMirrored);
+    bool HasCurrentState() const { return !std::holds_alternative<std::monostate>(m_CurrentState); }
     bool HasSetOut() const;
+    bool IsIdle() const { return std::holds_alternative<IdleState>(m_CurrentState); }
+    //Not flying in yet, so its formation trajectory can still be replaced
+    bool IsWaitingToSetOut() const { return !HasCurrentState() || (std::holds_alternative<GetInFormationState>(m_CurrentState) && !HasSetOut()); }
     Trajectory& GetFormationTrajectory() { return m_FormationTrajectory; }
+    //The path of the current state when it flies one of its own
+    Trajectory& GetStateTrajectory() { return m_StateTrajectory; }
     
     [[nodiscard]] glm::ivec2 GetFormationPosition() const { return m_FormationPosition; }
     [[nodiscard]] float GetSpeed() const { return m_Speed; }
     virtual void Update() override;
+    //Restoring a state skips its Enter/Exit, they only run on actual state changes
+    virtual void SaveState(GameEngine::Snapshot& snapshot) const override;
+    virtual void LoadState(GameEngine::Snapshot& snapshot) override;
     virtual bool HasBeenHit() {Died();return true;}
     virtual void Died();
     [[nodiscard]] virtual EnemyId GetEnemyID() const = 0;
+    //Type of the enemy regardless of whether it is diving
+    [[nodiscard]] EnemyId GetEnemyType() const { return m_EnemyType; }
 
     bool UpdateTrajectory(Trajectory& trajectory);
     glm::vec2 GetCurDirection() const { return m_CurDirection; }
@@ -46,17 +68,33 @@ public:
     
     int m_SetOutTurn{};
     int m_Stage{};
+    //position in the enemy info file, -1 for enemies that weren't spawned from one
+    int m_SpawnIndex{ -1 };
+    //set by the EnemyAIManager, 0 if the enemy never attacked
+    float m_LastAttackTime{};
 protected:
+    //Exits the current state and enters the given one in place
+    void ChangeState(EnemyStateId state);
+    [[nodiscard]] bool IsInDivingState() const;
     PlayerComponent* m_PlayerComponent{};
-    std::unique_ptr<EnemyState> m_CurrentState;
+    EnemyStateVariant m_CurrentState{};
     float m_Speed{ 300.f };
     std::unique_ptr<RotatingSprite> m_RotatingSprite{};
     glm::ivec2 m_FormationPosition{};
     float m_CurrentTime{};
     int m_CurrentRotationStage{};
 private:
-    //TODO: make trajectories unique ptrs 
+    friend class EnemyRegistry;
+    void ExitState();
+    void EmplaceState(EnemyStateId state);
+    EnemyId m_EnemyType;
+    //positions in the EnemyRegistry lists, -1 when not registered
+    int m_RegistryIndex{ -1 };
+    int m_BucketIndex{ -1 };
+    int m_Bucket{ -1 };
     Trajectory m_FormationTrajectory{};
+    //outlives the states, so re-targeting it reuses the storage of the previous state's path
+    Trajectory m_StateTrajectory{};
     glm::vec2 m_CurDirection{};
 };
 
@@ -3,6 +3,7 @@
 
 #include "Subjects/GameObject.h"
 #include "Managers/TimeManager.h"
+#include "Snapshot.h"
 
 bool FormationComponent::m_IsUpdating = false;
 float FormationComponent::m_Offset = 0;
@@ -26,3 +27,15 @@ float FormationComponent::GetOffset()
 {
      return m_Offset;
 }
+void FormationComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsUpdating);
+    snapshot.Write(m_Offset);
+    snapshot.Write(m_Direction);
+}
+void FormationComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_IsUpdating);
+    snapshot.Read(m_Offset);
+    snapshot.Read(m_Direction);
+}
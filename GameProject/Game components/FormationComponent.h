@@ -1,5 +1,4 @@
 ﻿#pragma once
-#include "IObserver.h"
 #include "Components/Component.h"
 
 class FormationComponent final : public GameEngine::Component
@@ -7,6 +6,8 @@ class FormationComponent final : public GameEngine::Component
 public:
     explicit FormationComponent(GameEngine::GameObject* gameObj);
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
     ~FormationComponent() override = default;
     static float GetOffset();
     static void ToggleUpdate() { m_IsUpdating = !m_IsUpdating; }
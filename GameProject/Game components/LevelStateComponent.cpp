@@ -0,0 +1,17 @@
+﻿#include "LevelStateComponent.h"
+#include "BulletTracker.h"
+#include "Game observers/FormationObserver.h"
+#include "Game observers/ScoreManager.h"
+
+void LevelStateComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    ScoreManager::SaveState(snapshot);
+    BulletTracker::SaveState(snapshot);
+    FormationObserver::SaveState(snapshot);
+}
+void LevelStateComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    ScoreManager::LoadState(snapshot);
+    BulletTracker::LoadState(snapshot);
+    FormationObserver::LoadState(snapshot);
+}
@@ -0,0 +1,12 @@
+﻿#pragma once
+#include "Components/Component.h"
+
+//Carries the level wide statics no other component of the scene owns (score, bullet counters,
+//formation stage) into scene snapshots
+class LevelStateComponent final : public GameEngine::Component
+{
+public:
+    explicit LevelStateComponent(GameEngine::GameObject* gameObj) : Component(gameObj) {}
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
+};
@@ -5,6 +5,7 @@
 #include "PlayerHealthComponent.h"
 #include "Enemy components/BossGalagaComponent.h"
 #include "Managers/InputManager.h"
+#include "Snapshot.h"
 
 PlayerComponent::PlayerComponent(GameEngine::GameObject* gameObject, GameEngine::SpriteComponent* spriteComponent, int playerID):
     Component(gameObject),
@@ -14,22 +15,32 @@ PlayerComponent::PlayerComponent(GameEngine::GameObject* gameObject, GameEngine:
 
 void PlayerComponent::GetCaptured(const glm::vec2& enemyPos)
 {
-    std::queue<PathData> pathDataQueue;
     PathData pathData{};
 
     pathData.destination = glm::vec2(enemyPos);
     pathData.destination.x += 30;
-    pathDataQueue.push(pathData);
 
     // Set the trajectory
     m_CapturedTrajectory = std::make_unique<Trajectory>();
-    m_CapturedTrajectory->SetPathData(pathDataQueue, GetGameObjParent()->GetPosition());
+    m_CapturedTrajectory->SetPathData({ &pathData, 1 }, GetGameObjParent()->GetPosition());
 
     m_IsGettingCaptured = true;
 }
 
+bool PlayerComponent::TryShoot()
+{
+    if (m_IsGettingCaptured) return false;
+    if (m_ShootsAvailable < m_MaxShootCount && m_TimeSinceShot > m_ShootCooldown) m_ShootsAvailable = m_MaxShootCount;
+    if (m_ShootsAvailable <= 0) return false;
+
+    --m_ShootsAvailable;
+    m_TimeSinceShot = 0.f;
+    return true;
+}
 void PlayerComponent::BindCommands() const
 {
+    //a networked game routes the keys through its rollback session instead
+    if (Galaga::GetInstance().IsNetworked()) return;
     auto& input = GameEngine::InputManager::GetInstance();
     switch(Galaga::GetInstance().GetGameMode())
     {
@@ -75,11 +86,12 @@ void PlayerComponent::BindCommands() const
 }
 void PlayerComponent::Update()
 {
+    m_TimeSinceShot += GameEngine::TimeManager::GetElapsed();
     if (!m_IsGettingCaptured) return;
     
     if (m_CapturedTrajectory->IsComplete())
     {
-        m_EnemyCapturing->GetGameObjParent()->NotifyAll(static_cast<int>(GameEvent::fighterCaptured));
+        m_EnemyCapturing->GetGameObjParent()->Emit(FighterCapturedEvent{});
         m_EnemyCapturing = nullptr;
         auto healthComp = GetGameObjParent()->GetComponent<PlayerHealthComponent>();
         GetGameObjParent()->SetPosition(m_RespawnPos);
@@ -89,9 +101,7 @@ void PlayerComponent::Update()
         m_RotatingSprite->RotateSpriteInDirection({0,-1});
         return;
     }
-    const glm::vec2 currentPos = GetGameObjParent()->GetPosition();
-    auto newPos = m_CapturedTrajectory->Update(m_Speed, currentPos).first;
-    GetGameObjParent()->SetPosition({ newPos,0 });
+    m_CapturedTrajectory->Update(m_Speed, GetGameObjParent());
 
     //rotate the sprite
     m_AccumTime += GameEngine::TimeManager::GetElapsed();
@@ -100,3 +110,33 @@ void PlayerComponent::Update()
     m_RotatingSprite->UpdateSprite(m_CurrentRotationStage);
     m_AccumTime -= m_TimeBetweenStages;
 }
+void PlayerComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsGettingCaptured);
+    snapshot.Write(m_AccumTime);
+    snapshot.Write(m_ShootsAvailable);
+    snapshot.Write(m_TimeSinceShot);
+    snapshot.Write(m_CurrentRotationStage);
+    m_RotatingSprite->SaveState(snapshot);
+    snapshot.WriteObject(m_EnemyCapturing ? m_EnemyCapturing->GetGameObjParent() : nullptr);
+    snapshot.Write(m_CapturedTrajectory != nullptr);
+    if (m_CapturedTrajectory) m_CapturedTrajectory->SaveState(snapshot);
+}
+void PlayerComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_IsGettingCaptured);
+    snapshot.Read(m_AccumTime);
+    snapshot.Read(m_ShootsAvailable);
+    snapshot.Read(m_TimeSinceShot);
+    snapshot.Read(m_CurrentRotationStage);
+    m_RotatingSprite->LoadState(snapshot);
+    const GameEngine::GameObject* enemyCapturing = snapshot.ReadObject();
+    m_EnemyCapturing = enemyCapturing ? enemyCapturing->GetComponent<BossGalagaComponent>() : nullptr;
+    if (!snapshot.Read<bool>())
+    {
+        m_CapturedTrajectory = nullptr;
+        return;
+    }
+    if (!m_CapturedTrajectory) m_CapturedTrajectory = std::make_unique<Trajectory>();
+    m_CapturedTrajectory->LoadState(snapshot, GetGameObjParent());
+}
@@ -24,8 +24,12 @@ public:
     static constexpr int m_PlayerSpeed{ 200 };
     void GetCaptured(const glm::vec2& enemyPos);
     [[nodiscard]] bool IsCaptured() const { return m_IsGettingCaptured; }
+    //Uses up one of the available shots, they refill once the fighter hasn't shot for a while
+    [[nodiscard]] bool TryShoot();
     void BindCommands() const;
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
 private:
     std::unique_ptr<Trajectory> m_CapturedTrajectory{nullptr};
     std::unique_ptr<RotatingSprite> m_RotatingSprite;
@@ -36,6 +40,10 @@ private:
     bool m_IsGettingCaptured{ false };
     const float m_Speed{ 100 };
     int m_PlayerID{ -1 };
+    static constexpr float m_ShootCooldown{ .5f };
+    static constexpr int m_MaxShootCount{ 2 };
+    int m_ShootsAvailable{ m_MaxShootCount };
+    float m_TimeSinceShot{};
 };
 
 
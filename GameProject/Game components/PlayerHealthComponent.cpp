@@ -3,6 +3,7 @@
 #include "DataStructs.h"
 #include "Galaga.h"
 #include "Renderable/Renderer.h"
+#include "Snapshot.h"
 #include "Subjects/GameObject.h"
 
 PlayerHealthComponent::PlayerHealthComponent(GameEngine::GameObject* gameObject, int health,
@@ -28,7 +29,15 @@ void PlayerHealthComponent::Hit()
 {
     if (m_Health <= 0) Galaga::GetInstance().GameLost(); 
 
-    GetGameObjParent()->NotifyAll(static_cast<int>(GameEvent::died));
+    GetGameObjParent()->Emit(DiedEvent{});
 
     --m_Health;
 }
+void PlayerHealthComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_Health);
+}
+void PlayerHealthComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_Health);
+}
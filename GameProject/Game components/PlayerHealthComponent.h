@@ -15,6 +15,8 @@ public:
 
     void Render() override;
     void Hit();
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
     [[nodiscard]] int GetHealth() const { return m_Health; }
 private:
     const glm::vec2 m_HealthPosition{ 10, 570 };
@@ -1,6 +1,7 @@
 ﻿#include "ScoreComponent.h"
 
 #include "Game observers/ScoreManager.h"
+#include "Snapshot.h"
 ScoreComponent::ScoreComponent(GameEngine::GameObject* gameObj, GameEngine::TextComponent* textComp)
 : Component(gameObj), m_TextComponent(textComp)
 {
@@ -17,3 +18,11 @@ void ScoreComponent::Update()
         m_TextComponent->SetText(std::to_string(m_LastScore));
     }
 }
+void ScoreComponent::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_LastScore);
+}
+void ScoreComponent::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_LastScore);
+}
@@ -7,6 +7,8 @@ class ScoreComponent final : public GameEngine::Component
 public:
     explicit ScoreComponent(GameEngine::GameObject* gameObj,GameEngine::TextComponent* textComp);
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
 private:
     GameEngine::TextComponent* m_TextComponent{};
     int m_LastScore{};
@@ -0,0 +1,45 @@
+﻿#include "SoakStatsComponent.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Game observers/EnemyAIManager.h"
+#include "Managers/TimeManager.h"
+#include "Trajectory Logic/TrajectoryBatch.h"
+
+namespace
+{
+    //sorts the samples
+    float GetPercentile(std::vector<float>& samples, float percentile)
+    {
+        if (samples.empty()) return 0.f;
+        const auto index = static_cast<size_t>(percentile * static_cast<float>(samples.size() - 1));
+        std::ranges::nth_element(samples, samples.begin() + index);
+        return samples[index];
+    }
+}
+
+void SoakStatsComponent::Update()
+{
+    const float elapsed = GameEngine::TimeManager::GetElapsed();
+    m_FrameTimes.emplace_back(elapsed * 1000.f);
+    m_TrajectoryCosts.emplace_back(static_cast<float>(TrajectoryBatch::GetLastStepCost().count()) / 1000.f);
+    m_AICosts.emplace_back(static_cast<float>(EnemyAIManager::GetLastUpdateCost().count()) / 1000.f);
+
+    m_TimeSinceReport += elapsed;
+    if (m_TimeSinceReport < m_ReportInterval) return;
+    m_TimeSinceReport -= m_ReportInterval;
+    PrintReport();
+}
+void SoakStatsComponent::PrintReport()
+{
+    std::cout << "Soak stats over " << m_FrameTimes.size() << " frames, p50/p95/p99 in ms\n";
+    for (auto [name, samples] : { std::pair{ "frame", &m_FrameTimes }, std::pair{ "trajectories", &m_TrajectoryCosts },
+        std::pair{ "enemy AI", &m_AICosts } })
+    {
+        std::cout << "  " << name << ": " << GetPercentile(*samples, .5f) << " / " << GetPercentile(*samples, .95f)
+            << " / " << GetPercentile(*samples, .99f) << "\n";
+        samples->clear();
+    }
+    std::cout << "  pending attack orders: " << EnemyAIManager::GetNrOfPendingOrders() << std::endl;
+}
@@ -0,0 +1,19 @@
+﻿#pragma once
+#include <vector>
+#include "Components/Component.h"
+
+//Samples the frame time and the cost of the enemy subsystems every frame and
+//prints their percentiles to the console, used to soak test generated stress stages
+class SoakStatsComponent final : public GameEngine::Component
+{
+public:
+    explicit SoakStatsComponent(GameEngine::GameObject* gameObj) : Component(gameObj) {}
+    void Update() override;
+private:
+    void PrintReport();
+    std::vector<float> m_FrameTimes;
+    std::vector<float> m_TrajectoryCosts;
+    std::vector<float> m_AICosts;
+    float m_TimeSinceReport{};
+    static constexpr float m_ReportInterval{ 10.f };
+};
@@ -0,0 +1,8 @@
+﻿#include "SpriteRotationComponent.h"
+
+#include "RotatingSprite.h"
+
+void SpriteRotationComponent::LateUpdate()
+{
+    RotatingSprite::ResolveQueuedRotations();
+}
@@ -0,0 +1,11 @@
+﻿#pragma once
+#include "Components/Component.h"
+
+//Resolves the rotations queued by the moving enemies this frame in one pass. It late updates,
+//so it should be added to the scene after the TrajectoryBatch whose stepped directions it reads
+class SpriteRotationComponent final : public GameEngine::Component
+{
+public:
+    explicit SpriteRotationComponent(GameEngine::GameObject* gameObj) : Component(gameObj) { EnableLateUpdate(); }
+    void LateUpdate() override;
+};
@@ -0,0 +1,155 @@
+﻿#include "TrajectoryReloadComponent.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Game observers/EnemyAIManager.h"
+#include "Managers/Telemetry.h"
+#include "Subjects/GameObject.h"
+#include "Trajectory Logic/CompiledPath.h"
+#include "Trajectory Logic/Parsers.h"
+
+using namespace std::chrono;
+
+namespace
+{
+    //from noticing the change on disk to the new data flying in the live enemies
+    const GameEngine::MetricId g_ReloadLatencyMetric{ GameEngine::Telemetry::GetInstance().RegisterHistogram("data reload latency us") };
+}
+
+TrajectoryReloadComponent::TrajectoryReloadComponent(GameEngine::GameObject* gameObj, std::string enemyInfoPath, std::string trajectoryPath) :
+    Component(gameObj),
+    m_EnemyInfoPath(std::move(enemyInfoPath)),
+    m_TrajectoryPath(std::move(trajectoryPath))
+{
+    std::vector<PathData> pathDataVec;
+    for (const auto& element : Parser::ReadJson(m_TrajectoryPath))
+    {
+        m_StagePaths.emplace_back(Parser::ParseStagePath(element, pathDataVec));
+        m_StageSources.emplace_back(element);
+    }
+    m_Spawns = Parser::ParseEnemySpawns(m_EnemyInfoPath);
+
+    auto& fileWatcher = GameEngine::FileWatcher::GetInstance();
+    m_TrajectoryWatch = fileWatcher.Watch(m_TrajectoryPath, [this](const std::string&, steady_clock::time_point changeTime) {
+        ReloadTrajectories(changeTime);
+    });
+    m_EnemyInfoWatch = fileWatcher.Watch(m_EnemyInfoPath, [this](const std::string&, steady_clock::time_point changeTime) {
+        ReloadEnemyInfo(changeTime);
+    });
+}
+TrajectoryReloadComponent::~TrajectoryReloadComponent()
+{
+    auto& fileWatcher = GameEngine::FileWatcher::GetInstance();
+    fileWatcher.Unwatch(m_TrajectoryWatch);
+    fileWatcher.Unwatch(m_EnemyInfoWatch);
+}
+void TrajectoryReloadComponent::ReloadTrajectories(steady_clock::time_point changeTime)
+{
+    const auto parseStart = steady_clock::now();
+    const nlohmann::json trajectoryJsonData = Parser::ReadJson(m_TrajectoryPath);
+    if (trajectoryJsonData.size() != m_StageSources.size())
+    {
+        std::cerr << m_TrajectoryPath << " has a different number of stages now, load the level again to use it\n";
+        return;
+    }
+
+    //only kept once every changed stage compiled, a half edited file changes nothing
+    Reload reload{};
+    reload.stagePaths = m_StagePaths;
+    std::vector<PathData> pathDataVec;
+    for (size_t stage = 0; stage < m_StageSources.size(); ++stage)
+    {
+        if (trajectoryJsonData[stage] == m_StageSources[stage]) continue;
+        reload.stagePaths[stage] = Parser::ParseStagePath(trajectoryJsonData[stage], pathDataVec);
+        reload.changedStages.emplace_back(static_cast<int>(stage));
+    }
+    if (reload.changedStages.empty()) return;
+
+    for (const int stage : reload.changedStages) m_StageSources[stage] = trajectoryJsonData[stage];
+    m_StagePaths = reload.stagePaths;
+    reload.path = m_TrajectoryPath;
+    reload.spawns = m_Spawns;
+    reload.changeTime = changeTime;
+    reload.parseTime = duration_cast<microseconds>(steady_clock::now() - parseStart);
+    QueueReload(std::move(reload));
+}
+void TrajectoryReloadComponent::ReloadEnemyInfo(steady_clock::time_point changeTime)
+{
+    const auto parseStart = steady_clock::now();
+    auto spawns = Parser::ParseEnemySpawns(m_EnemyInfoPath);
+    //the enemies of the level and the formation's stage counts were made for the old spawns
+    const bool isSameFormation = spawns.size() == m_Spawns.size() && std::ranges::equal(spawns, m_Spawns,
+        [](const Parser::EnemySpawn& lhs, const Parser::EnemySpawn& rhs) { return lhs.enemyId == rhs.enemyId && lhs.stage == rhs.stage; });
+    if (!isSameFormation)
+    {
+        std::cerr << m_EnemyInfoPath << " adds, removes or moves enemies between stages, load the level again to use it\n";
+        return;
+    }
+
+    Reload reload{};
+    for (size_t i = 0; i < spawns.size(); ++i)
+    {
+        if (spawns[i] != m_Spawns[i]) reload.changedSpawns.emplace_back(static_cast<int>(i));
+    }
+    if (reload.changedSpawns.empty()) return;
+
+    m_Spawns = std::move(spawns);
+    reload.path = m_EnemyInfoPath;
+    reload.stagePaths = m_StagePaths;
+    reload.spawns = m_Spawns;
+    reload.changeTime = changeTime;
+    reload.parseTime = duration_cast<microseconds>(steady_clock::now() - parseStart);
+    QueueReload(std::move(reload));
+}
+void TrajectoryReloadComponent::QueueReload(Reload&& reload)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_PendingReloads.emplace_back(std::move(reload));
+    m_HasPendingReloads.store(true, std::memory_order_release);
+}
+void TrajectoryReloadComponent::Update()
+{
+    if (!m_HasPendingReloads.load(std::memory_order_acquire)) return;
+    std::vector<Reload> reloads;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        reloads.swap(m_PendingReloads);
+        m_HasPendingReloads.store(false, std::memory_order_relaxed);
+    }
+    for (const Reload& reload : reloads) Apply(reload);
+}
+void TrajectoryReloadComponent::Apply(const Reload& reload) const
+{
+    int nrOfSwappedEnemies{};
+    const EnemyRegistry& registry = EnemyAIManager::GetRegistry();
+    for (size_t i = 0; i < registry.GetNrOfEnemies(); ++i)
+    {
+        //enemies that are flying or in the formation finish on the data they started with
+        EnemyComponent* enemy = registry.GetEnemy(i);
+        if (enemy->m_SpawnIndex == -1 || !enemy->IsWaitingToSetOut()) continue;
+        const bool isSpawnChanged = std::ranges::find(reload.changedSpawns, enemy->m_SpawnIndex) != reload.changedSpawns.end();
+        const bool isStageChanged = std::ranges::find(reload.changedStages, enemy->m_Stage) != reload.changedStages.end();
+        if (!isSpawnChanged && !isStageChanged) continue;
+
+        const Parser::EnemySpawn& spawn = reload.spawns[enemy->m_SpawnIndex];
+        const auto& stagePath = reload.stagePaths[spawn.stage];
+        enemy->SetFormationPosition(spawn.formationPosition);
+        enemy->m_SetOutTurn = spawn.turn;
+        enemy->SetFormationTrajectory(stagePath, spawn.isXReversed);
+        enemy->GetGameObjParent()->SetPosition({ stagePath->GetStartPosition(spawn.isXReversed),0 });
+        ++nrOfSwappedEnemies;
+    }
+
+    const auto latency = duration_cast<microseconds>(steady_clock::now() - reload.changeTime);
+    GameEngine::Telemetry::GetInstance().Record(g_ReloadLatencyMetric, static_cast<uint64_t>(latency.count()));
+    std::cout << "Reloaded " << reload.path << ": ";
+    if (!reload.changedStages.empty())
+    {
+        std::cout << "stages";
+        for (int stage : reload.changedStages) std::cout << ' ' << stage;
+    }
+    else std::cout << reload.changedSpawns.size() << " spawns";
+    std::cout << " parsed in " << static_cast<float>(reload.parseTime.count()) / 1000.f << " ms, swapped into " << nrOfSwappedEnemies
+        << " waiting enemies " << static_cast<float>(latency.count()) / 1000.f << " ms after the change\n";
+}
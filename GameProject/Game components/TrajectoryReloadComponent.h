@@ -0,0 +1,64 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+#include "Components/Component.h"
+#include "Managers/FileWatcher.h"
+
+class CompiledPath;
+namespace Parser
+{
+    struct EnemySpawn;
+}
+
+//Reloads the enemy info and trajectory files of a level while it is played. A changed trajectory file only
+//compiles the stages whose trajectory changed, on the file watcher thread. The new paths and changed spawns
+//are swapped into the enemies that haven't set out yet on the next update, the rest of the level keeps running.
+//Formation positions, turns and mirroring can be changed, other changes need the level to be loaded again
+class TrajectoryReloadComponent final : public GameEngine::Component
+{
+public:
+    TrajectoryReloadComponent(GameEngine::GameObject* gameObj, std::string enemyInfoPath, std::string trajectoryPath);
+    ~TrajectoryReloadComponent() override;
+
+    TrajectoryReloadComponent(const TrajectoryReloadComponent& other) = delete;
+    TrajectoryReloadComponent(TrajectoryReloadComponent&& other) noexcept = delete;
+    TrajectoryReloadComponent& operator=(const TrajectoryReloadComponent& other) = delete;
+    TrajectoryReloadComponent& operator=(TrajectoryReloadComponent&& other) noexcept = delete;
+
+    void Update() override;
+private:
+    //Made on the watcher thread, applied by the next update
+    struct Reload
+    {
+        std::string path;
+        std::vector<std::shared_ptr<const CompiledPath>> stagePaths;
+        std::vector<Parser::EnemySpawn> spawns;
+        std::vector<int> changedStages;
+        std::vector<int> changedSpawns;
+        std::chrono::steady_clock::time_point changeTime;
+        std::chrono::microseconds parseTime;
+    };
+    void ReloadTrajectories(std::chrono::steady_clock::time_point changeTime);
+    void ReloadEnemyInfo(std::chrono::steady_clock::time_point changeTime);
+    void QueueReload(Reload&& reload);
+    void Apply(const Reload& reload) const;
+
+    std::string m_EnemyInfoPath;
+    std::string m_TrajectoryPath;
+    //what the files held at the last reload, only the watcher thread touches them once watching started
+    std::vector<nlohmann::json> m_StageSources;
+    std::vector<std::shared_ptr<const CompiledPath>> m_StagePaths;
+    std::vector<Parser::EnemySpawn> m_Spawns;
+
+    std::mutex m_Mutex;
+    std::vector<Reload> m_PendingReloads;
+    std::atomic<bool> m_HasPendingReloads{ false };
+    GameEngine::FileWatcher::WatchId m_EnemyInfoWatch{};
+    GameEngine::FileWatcher::WatchId m_TrajectoryWatch{};
+};
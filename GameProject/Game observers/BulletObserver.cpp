@@ -1,7 +1,6 @@
 ﻿#include "BulletObserver.h"
 
 #include "BulletTracker.h"
-#include "DataStructs.h"
 #include "Galaga.h"
 #include "Initializers.h"
 #include "Components/SpriteComponent.h"
@@ -10,41 +9,33 @@
 
 BulletObserver::BulletObserver(GameEngine::Scene* scene):
     m_Scene(scene) {}
-void BulletObserver::Notify(GameEngine::Subject* subject, int event
-    , [[maybe_unused]] GameEngine::EventData* eventData)
+void BulletObserver::ObserveFighter(GameEngine::GameObject* fighter)
 {
-    // add the bullet game obj
-    GameEngine::GameObject* actor = dynamic_cast<GameEngine::GameObject*>(subject);
-    switch (static_cast<GameEvent>(event))
-    {
-    case GameEvent::collision:
-    {
-        const auto collisionData = reinterpret_cast<GameEngine::CollisionData*>(eventData);
-        int otherId = collisionData->pOtherCollider->GetID();
-        if (otherId == static_cast<int>(GameId::enemy) && actor->GetID() == static_cast<int>(GameId::bullet))
-        {
-            BulletTracker::BulletHit();
-            actor->SetDestroyedFlag();
-        }
-    }
-        break;
-    case GameEvent::bulletShot:
-    {
-        GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::playerShoot), Galaga::volume);
-        auto bullet = InitBullet(actor->GetComponent<PlayerComponent>()->GetPlayerID());
+    fighter->Connect<BulletShotEvent, &BulletObserver::OnBulletShot>(this);
+}
+void BulletObserver::OnBulletShot(GameEngine::GameObject& fighter, const BulletShotEvent&)
+{
+    GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::playerShoot), Galaga::volume);
+    auto bullet = InitBullet(fighter.GetComponent<PlayerComponent>()->GetPlayerID());
 
-        glm::vec3 pos = actor->GetPosition();
-        pos.y -= bullet->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
-        bullet->SetPosition(pos);
+    glm::vec3 pos = fighter.GetPosition();
+    pos.y -= bullet->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
+    bullet->SetPosition(pos);
 
-        bullet->AddObserver(static_cast<int>(ObserverIdentifier::bullet), this);
+    bullet->Connect<GameEngine::CollisionEvent, &BulletObserver::OnCollision>(this);
+    bullet->Connect<BulletOutOfBoundsEvent, &BulletObserver::OnBulletOutOfBounds>(this);
 
-        m_Scene->AddObject(std::move(bullet));
-    }
-        break;
-    case GameEvent::bulletOutOfBounds:
-        actor->SetDestroyedFlag();
-        break;
-    default: break;
+    m_Scene->AddObject(std::move(bullet));
+}
+void BulletObserver::OnCollision(GameEngine::GameObject& bullet, const GameEngine::CollisionEvent& event)
+{
+    if (event.pOtherCollider->GetID() == static_cast<int>(GameId::enemy))
+    {
+        BulletTracker::BulletHit();
+        bullet.SetDestroyedFlag();
     }
-}
\ No newline at end of file
+}
+void BulletObserver::OnBulletOutOfBounds(GameEngine::GameObject& bullet, const BulletOutOfBoundsEvent&)
+{
+    bullet.SetDestroyedFlag();
+}
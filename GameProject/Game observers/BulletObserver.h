@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "DataStructs.h"
 #include "IObserver.h"
 #include "Scene.h"
 
@@ -6,8 +7,11 @@ class BulletObserver final : public GameEngine::IObserver
 {
 public:
     explicit BulletObserver( GameEngine::Scene* scene);
-    virtual void Notify(GameEngine::Subject* subject, int event
-        , GameEngine::EventData* eventData) override;
+    //Spawns a bullet every time the fighter shoots
+    void ObserveFighter(GameEngine::GameObject* fighter);
 private:
+    void OnBulletShot(GameEngine::GameObject& fighter, const BulletShotEvent&);
+    void OnCollision(GameEngine::GameObject& bullet, const GameEngine::CollisionEvent& event);
+    void OnBulletOutOfBounds(GameEngine::GameObject& bullet, const BulletOutOfBoundsEvent&);
     GameEngine::Scene* m_Scene{nullptr};
-};
\ No newline at end of file
+};
@@ -1,77 +1,206 @@
 ﻿#include "EnemyAIManager.h"
 
+#include <algorithm>
+#include <execution>
+#include <limits>
+
 #include "Galaga.h"
+#include "Game components/FormationComponent.h"
 #include "Game components/Enemy components/BossGalagaComponent.h"
+#include "Managers/Telemetry.h"
+#include "Managers/TimeManager.h"
+#include "Snapshot.h"
+
+EnemyRegistry EnemyAIManager::m_Registry{};
+std::minstd_rand EnemyAIManager::m_Random{ std::random_device{}() };
+std::deque<EnemyAIManager::AttackOrder> EnemyAIManager::m_PendingOrders{};
+int EnemyAIManager::m_MaxConcurrentDivers{ 1 };
+std::chrono::microseconds EnemyAIManager::m_FrameBudget{ 500 };
+std::chrono::microseconds EnemyAIManager::m_LastUpdateCost{};
+
+namespace
+{
+    const GameEngine::MetricId g_EnemiesMetric{ GameEngine::Telemetry::GetInstance().RegisterGauge("enemies") };
+    const GameEngine::MetricId g_DiversMetric{ GameEngine::Telemetry::GetInstance().RegisterGauge("diving enemies") };
+    const GameEngine::MetricId g_UpdateCostMetric{ GameEngine::Telemetry::GetInstance().RegisterHistogram("enemy ai us") };
+}
 
-std::vector<EnemyComponent*> EnemyAIManager::m_Enemies;
 void EnemyAIManager::AddEnemy(EnemyComponent* enemy)
 {
-    m_Enemies.emplace_back(enemy);
+    m_Registry.Add(enemy);
 }
 void EnemyAIManager::RemoveEnemy(EnemyComponent* enemy)
 {
-    std::erase(m_Enemies, enemy);
+    m_Registry.Remove(enemy);
+}
+void EnemyAIManager::EnemyChangedState(EnemyComponent* enemy)
+{
+    m_Registry.UpdateState(enemy);
 }
 void EnemyAIManager::ShootBeam()
 {
-    auto it = std::ranges::find_if(m_Enemies,
-                    [](EnemyComponent* enemy) { return enemy->GetEnemyID() == EnemyId::bossGalaga; });
-    if (it != m_Enemies.end())
-    {
-        const auto bossGalagaComponent = dynamic_cast<BossGalagaComponent*>(*it);
-        if(bossGalagaComponent->CanAttack()) bossGalagaComponent->GetInBeamAttackState();
-    }
+    if (BossGalagaComponent* bossGalagaComponent = m_Registry.GetIdleBoss())
+        bossGalagaComponent->GetInBeamAttackState();
 }
 void EnemyAIManager::BombingRun()
 {
-    auto it = std::ranges::find_if(m_Enemies,
-                [](EnemyComponent* enemy) { return enemy->GetEnemyID() == EnemyId::bossGalaga; });
-    if (it != m_Enemies.end())
-    {
-        const auto bossGalagaComponent = dynamic_cast<BossGalagaComponent*>(*it);
-        if(bossGalagaComponent->CanAttack()) (*it)->GetInAttackState();
-    }
+    if (BossGalagaComponent* bossGalagaComponent = m_Registry.GetIdleBoss())
+        bossGalagaComponent->GetInAttackState();
 }
-void EnemyAIManager::Notify([[maybe_unused]] GameEngine::Subject* subject, int event, [[maybe_unused]] GameEngine::EventData* eventData)
+void EnemyAIManager::Observe(GameEngine::GameObject* enemy)
 {
-    switch (static_cast<GameEvent>(event))
-    {
-    case GameEvent::gotInFormation:
-        ++m_EnemiesInFormation;
-        break;
-    case GameEvent::leftFormation:
-        --m_EnemiesInFormation;
-        break;
-    default: break;
-    }
+    enemy->Connect<GotInFormationEvent, &EnemyAIManager::OnGotInFormation>(this);
+    enemy->Connect<LeftFormationEvent, &EnemyAIManager::OnLeftFormation>(this);
+}
+void EnemyAIManager::OnGotInFormation(GameEngine::GameObject&, const GotInFormationEvent&)
+{
+    ++m_EnemiesInFormation;
+}
+void EnemyAIManager::OnLeftFormation(GameEngine::GameObject&, const LeftFormationEvent&)
+{
+    --m_EnemiesInFormation;
 }
 void EnemyAIManager::Update()
 {
-    if (m_EnemiesInFormation != static_cast<int>(m_Enemies.size())) return;
-    if (m_Enemies.empty())
+    using clock = std::chrono::high_resolution_clock;
+    const auto start = clock::now();
+    m_Time += GameEngine::TimeManager::GetElapsed();
+
+    const auto nrOfEnemies = static_cast<int>(m_Registry.GetNrOfEnemies());
+    auto& telemetry = GameEngine::Telemetry::GetInstance();
+    telemetry.Set(g_EnemiesMetric, nrOfEnemies);
+    telemetry.Set(g_DiversMetric, nrOfEnemies - m_EnemiesInFormation);
+    if (nrOfEnemies == 0 && m_EnemiesInFormation == 0)
     {
+        m_PendingOrders.clear();
         Galaga::GetInstance().LevelCleared();
         return;
     }
 
-    int enemyToSetOut = rand() % m_Enemies.size();
-    if (m_Enemies[enemyToSetOut]->GetEnemyID() == EnemyId::bossGalaga)
+    //an order is always executed once started, the budget is checked in between orders
+    while (clock::now() - start < m_FrameBudget)
     {
-        auto boss = dynamic_cast<BossGalagaComponent*>(m_Enemies[enemyToSetOut]);
-        if (rand() % 2 == 0 && !boss->HasCapturedFighter())
+        if (m_PendingOrders.empty())
         {
-            boss->GetInBeamAttackState();
-            return;
+            const int nrOfDivers = static_cast<int>(m_Registry.GetNrOfEnemies()) - m_EnemiesInFormation;
+            if (nrOfDivers >= m_MaxConcurrentDivers || m_Registry.GetNrOfIdleEnemies() == 0) break;
+            PlanWave();
         }
-        boss->GetInAttackState();
-        //set out butterfly
-        auto it = std::ranges::find_if(m_Enemies,
-            [](EnemyComponent* enemy) { return enemy->GetEnemyID() == EnemyId::butterfly; });
-        if (it != m_Enemies.end()) (*it)->GetInAttackState();
+        //the order stays at the front while every candidate is on cooldown or diving and is tried again next frame,
+        //it is only dropped once no enemy of its type is left
+        const AttackOrder order = m_PendingOrders.front();
+        if (!ExecuteOrder(order) && m_Registry.HasEnemies(order.type)) break;
+        m_PendingOrders.pop_front();
+    }
+    m_LastUpdateCost = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+    telemetry.Record(g_UpdateCostMetric, static_cast<uint64_t>(m_LastUpdateCost.count()));
+}
+
+void EnemyAIManager::PlanWave()
+{
+    //the type of a random enemy, so larger groups attack more often
+    const EnemyId type = m_Registry.GetEnemy(GetRandomIndex(m_Registry.GetNrOfEnemies()))->GetEnemyType();
+    if (type == EnemyId::bossGalaga)
+    {
+        m_PendingOrders.emplace_back(GetRandomIndex(2) == 0 ? AttackBehaviour::beam : AttackBehaviour::escortedDive, type);
         return;
     }
-    m_Enemies[enemyToSetOut]->GetInAttackState();
-    if (m_Enemies.size() == 1) return;
+    m_PendingOrders.emplace_back(AttackBehaviour::dive, type);
     //set out a second enemy
-    if (rand() % 3 <= 1) m_Enemies[enemyToSetOut == 0 ? 1 : enemyToSetOut - 1]->GetInAttackState();
+    if (GetRandomIndex(3) <= 1)
+    {
+        const EnemyId secondType = m_Registry.GetEnemy(GetRandomIndex(m_Registry.GetNrOfEnemies()))->GetEnemyType();
+        m_PendingOrders.emplace_back(AttackBehaviour::dive, secondType);
+    }
+}
+bool EnemyAIManager::ExecuteOrder(const AttackOrder& order)
+{
+    EnemyComponent* attacker = SelectAttacker(order.type, order.behaviour);
+    //a boss holding a fighter can't shoot another beam, it dives instead
+    if (attacker == nullptr && order.behaviour == AttackBehaviour::beam)
+        attacker = SelectAttacker(order.type, AttackBehaviour::escortedDive);
+    if (attacker == nullptr) return false;
+
+    attacker->m_LastAttackTime = m_Time;
+    if (order.behaviour == AttackBehaviour::beam && attacker->GetEnemyType() == EnemyId::bossGalaga
+        && !static_cast<BossGalagaComponent*>(attacker)->HasCapturedFighter())
+    {
+        static_cast<BossGalagaComponent*>(attacker)->GetInBeamAttackState();
+        return true;
+    }
+    attacker->GetInAttackState();
+    if (order.behaviour != AttackBehaviour::dive)
+    {
+        if (EnemyComponent* escort = SelectAttacker(EnemyId::butterfly, AttackBehaviour::dive))
+        {
+            escort->m_LastAttackTime = m_Time;
+            escort->GetInAttackState();
+        }
+    }
+    return true;
+}
+EnemyComponent* EnemyAIManager::SelectAttacker(EnemyId type, AttackBehaviour behaviour)
+{
+    const auto& candidates = m_Registry.GetEnemies(type, true);
+    if (candidates.empty()) return nullptr;
+
+    //idle enemies sit in their formation slot, so the slots are read instead of the
+    //game objects, whose transforms are not safe to update from several threads
+    const float playerX = candidates.front()->GetPlayerComponent()->GetGameObjParent()->GetPosition().x;
+    const float formationOffset = FormationComponent::GetOffset();
+    const float time = m_Time;
+    const auto seed = static_cast<unsigned int>(m_Random());
+    const EnemyComponent* const* pCandidates = candidates.data();
+
+    const auto scoreCandidate = [=](size_t index)
+    {
+        const EnemyComponent* candidate = pCandidates[index];
+        if (time - candidate->m_LastAttackTime < m_AttackCooldown && candidate->m_LastAttackTime > 0.f)
+            return std::numeric_limits<float>::max();
+        if (behaviour == AttackBehaviour::beam && static_cast<const BossGalagaComponent*>(candidate)->HasCapturedFighter())
+            return std::numeric_limits<float>::max();
+        const glm::ivec2 formationPos = candidate->GetFormationPosition();
+        const glm::vec2 slot = glm::vec2(formationPos) + glm::vec2{ formationOffset, 0 };
+        //cheap stateless hash of the slot, so neither the scoring order nor the registry order matters
+        const auto slotKey = static_cast<unsigned int>(formationPos.x) * 73856093u ^ static_cast<unsigned int>(formationPos.y) * 19349663u;
+        const unsigned int hash = (slotKey + 1) * 2654435761u ^ seed;
+        const float jitter = static_cast<float>(hash % 1024) / 1024.f;
+        return std::abs(slot.x - playerX) * m_DistanceWeight - slot.y * m_RowWeight + jitter * m_RandomWeight;
+    };
+
+    m_CandidateScores.resize(candidates.size());
+    for (size_t i = m_CandidateIndices.size(); i < candidates.size(); ++i) m_CandidateIndices.emplace_back(i);
+    const auto indicesEnd = m_CandidateIndices.begin() + candidates.size();
+    if (candidates.size() >= m_ParallelEvaluationThreshold)
+        std::transform(std::execution::par_unseq, m_CandidateIndices.begin(), indicesEnd, m_CandidateScores.begin(), scoreCandidate);
+    else std::transform(m_CandidateIndices.begin(), indicesEnd, m_CandidateScores.begin(), scoreCandidate);
+
+    const auto best = std::ranges::min_element(m_CandidateScores);
+    if (*best == std::numeric_limits<float>::max()) return nullptr;
+    return candidates[best - m_CandidateScores.begin()];
+}
+bool EnemyAIManager::GetRandomBool()
+{
+    return std::bernoulli_distribution{}(m_Random);
+}
+void EnemyAIManager::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    static_assert(GameEngine::SnapshotValue<std::minstd_rand>);
+    snapshot.Write(m_EnemiesInFormation);
+    snapshot.Write(m_Time);
+    snapshot.Write(m_Random);
+    snapshot.Write(static_cast<uint32_t>(m_PendingOrders.size()));
+    for (const AttackOrder& order : m_PendingOrders) snapshot.Write(order);
+}
+void EnemyAIManager::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_EnemiesInFormation);
+    snapshot.Read(m_Time);
+    snapshot.Read(m_Random);
+    m_PendingOrders.resize(snapshot.Read<uint32_t>());
+    for (AttackOrder& order : m_PendingOrders) snapshot.Read(order);
+}
+size_t EnemyAIManager::GetRandomIndex(size_t size)
+{
+    return std::uniform_int_distribution<size_t>{ 0, size - 1 }(m_Random);
 }
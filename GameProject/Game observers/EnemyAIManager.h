@@ -1,20 +1,79 @@
 ﻿#pragma once
+#include <chrono>
+#include <deque>
+#include <random>
 #include <vector>
 
-#include "IObserver.h"
+#include "EnemyRegistry.h"
 #include "Game components/Enemy components/EnemyComponent.h"
 
-class EnemyAIManager final : public GameEngine::IObserver, public GameEngine::Component
+//Plans attack waves into a queue of orders and works through it under a per frame time budget.
+//An order only names a behaviour and an enemy type, the attacker is picked when the order is
+//executed by scoring the idle enemies of that type (distance to the player, formation row, cooldown)
+class EnemyAIManager final : public GameEngine::Component
 {
 public:
     explicit EnemyAIManager(GameEngine::GameObject* gameObj) : Component(gameObj) {}
     static void AddEnemy(EnemyComponent* enemy);
     static void RemoveEnemy(EnemyComponent* enemy);
+    static void EnemyChangedState(EnemyComponent* enemy);
     static void ShootBeam();
     static void BombingRun();
-    void Notify(GameEngine::Subject* subject, int event, GameEngine::EventData* eventData) override;
+    //Makes the attacker selection and the dive paths reproducible
+    static void SetSeed(unsigned int seed) { m_Random.seed(seed); }
+    //Dive states draw from the same engine, so a restored snapshot replays the same paths
+    [[nodiscard]] static bool GetRandomBool();
+    //New waves are planned while fewer enemies are out of formation, 1 waits for the whole formation
+    static void SetMaxConcurrentDivers(int maxDivers) { m_MaxConcurrentDivers = maxDivers; }
+    static void SetFrameBudget(std::chrono::microseconds frameBudget) { m_FrameBudget = frameBudget; }
+    //Profiling counters of the last update, the cost is also recorded as the "enemy ai us" histogram
+    [[nodiscard]] static std::chrono::microseconds GetLastUpdateCost() { return m_LastUpdateCost; }
+    [[nodiscard]] static size_t GetNrOfPendingOrders() { return m_PendingOrders.size(); }
+    //Every enemy that is alive
+    [[nodiscard]] static const EnemyRegistry& GetRegistry() { return m_Registry; }
+    //Keeps count of the enemies sitting in the formation
+    void Observe(GameEngine::GameObject* enemy);
     void Update() override;
+    void SaveState(GameEngine::Snapshot& snapshot) const override;
+    void LoadState(GameEngine::Snapshot& snapshot) override;
 private:
+    enum class AttackBehaviour
+    {
+        dive,
+        beam,
+        //boss dive together with a butterfly
+        escortedDive
+    };
+    struct AttackOrder
+    {
+        AttackBehaviour behaviour;
+        EnemyId type;
+    };
+    void OnGotInFormation(GameEngine::GameObject& enemy, const GotInFormationEvent&);
+    void OnLeftFormation(GameEngine::GameObject& enemy, const LeftFormationEvent&);
+    void PlanWave();
+    //returns false if no enemy could carry out the order
+    bool ExecuteOrder(const AttackOrder& order);
+    //nullptr if no idle enemy of the type can carry out the behaviour
+    [[nodiscard]] EnemyComponent* SelectAttacker(EnemyId type, AttackBehaviour behaviour);
+    [[nodiscard]] static size_t GetRandomIndex(size_t size);
+
     int m_EnemiesInFormation{};
-    static std::vector<EnemyComponent*> m_Enemies;
+    float m_Time{};
+    std::vector<size_t> m_CandidateIndices;
+    std::vector<float> m_CandidateScores;
+    static EnemyRegistry m_Registry;
+    static std::minstd_rand m_Random;
+    static std::deque<AttackOrder> m_PendingOrders;
+    static int m_MaxConcurrentDivers;
+    static std::chrono::microseconds m_FrameBudget;
+    static std::chrono::microseconds m_LastUpdateCost;
+
+    //seconds an enemy stays out of the candidates after it attacked
+    static constexpr float m_AttackCooldown{ 4.f };
+    static constexpr float m_DistanceWeight{ 1.f };
+    static constexpr float m_RowWeight{ 0.5f };
+    static constexpr float m_RandomWeight{ 200.f };
+    //below this many candidates scoring them in parallel costs more than it saves
+    static constexpr size_t m_ParallelEvaluationThreshold{ 256 };
 };
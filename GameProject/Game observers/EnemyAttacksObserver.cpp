@@ -3,6 +3,7 @@
 #include "DataStructs.h"
 #include "Galaga.h"
 #include "Initializers.h"
+#include "Trajectory Logic/TrajectoryMath.h"
 #include "Components/CollisionComponent.h"
 #include "Components/SpriteComponent.h"
 #include "Game components/CapturedFighterComponent.h"
@@ -11,90 +12,81 @@
 #include "Sound/ServiceLocator.h"
 #include "Subjects/GameObject.h"
 EnemyAttacksObserver::EnemyAttacksObserver(GameEngine::Scene* scene): m_Scene(scene) {}
-void EnemyAttacksObserver::Notify(GameEngine::Subject* subject, int event,
-    [[maybe_unused]] GameEngine::EventData* eventData)
+void EnemyAttacksObserver::ObserveEnemy(GameEngine::GameObject* enemy)
 {
-    GameEngine::GameObject* actor = dynamic_cast<GameEngine::GameObject*>(subject);
-    switch (static_cast<GameEvent>(event))
-    {
-    case GameEvent::collision:
-    {
-        const auto collisionData = reinterpret_cast<GameEngine::CollisionData*>(eventData);
-        int otherId = collisionData->pOtherCollider->GetID();
-        if (otherId == static_cast<int>(GameId::player))
-        {
-            if (actor->GetID() == static_cast<int>(GameId::enemyBullet)) actor->SetDestroyedFlag();
-            if (actor->GetID() == static_cast<int>(GameId::bossBeam))
-            {
-                BossGalagaComponent* bossComp = dynamic_cast<BossGalagaComponent*>(actor->GetComponent<BeamComponent>()->GetParentComp());
-                if (!bossComp->HasCapturedFighter()) bossComp->CapturedFighter();
-                collisionData->pOtherCollider->GetComponent<PlayerComponent>()->SetEnemyCapturing(bossComp);
-            }
-        }
-    }
-    break;
-    case GameEvent::fighterCaptured:
-    {
-        GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::capturedShip), Galaga::volume);
-        BossGalagaComponent* bossComp = dynamic_cast<BossGalagaComponent*>(actor->GetComponent<EnemyComponent>());
-        auto capturedFighter = InitCapturedFighter(bossComp);
-        capturedFighter->SetParent(actor, false);
-        auto sprite = actor->GetComponent<GameEngine::SpriteComponent>();
-        capturedFighter->SetPosition(glm::vec3{ 0,sprite->m_DestRect.h,0 });
-        capturedFighter->GetComponent<CapturedFighterComponent>()->UploadGetBackTrajectory();
-        capturedFighter->AddObserver(static_cast<int>(ObserverIdentifier::enemyAttack), this);
-        m_Scene->AddObject(std::move(capturedFighter));
-    }
-    break;
-    case GameEvent::bulletShot:
-    {
-        const auto playerPos = actor->GetComponent<EnemyComponent>()->GetPlayerComponent()->GetGameObjParent()->GetPosition();
-        auto enemyPos = actor->GetPosition();
-        auto bullet = InitEnemyBullet(TrajectoryMath::CalculateDirection(enemyPos, playerPos));
+    enemy->Connect<FighterCapturedEvent, &EnemyAttacksObserver::OnFighterCaptured>(this);
+    enemy->Connect<BulletShotEvent, &EnemyAttacksObserver::OnBulletShot>(this);
+    enemy->Connect<BossShotBeamEvent, &EnemyAttacksObserver::OnBossShotBeam>(this);
+}
+void EnemyAttacksObserver::OnFighterCaptured(GameEngine::GameObject& enemy, const FighterCapturedEvent&)
+{
+    GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::capturedShip), Galaga::volume);
+    BossGalagaComponent* bossComp = dynamic_cast<BossGalagaComponent*>(enemy.GetComponent<EnemyComponent>());
+    auto capturedFighter = InitCapturedFighter(bossComp);
+    capturedFighter->SetParent(&enemy, false);
+    auto sprite = enemy.GetComponent<GameEngine::SpriteComponent>();
+    capturedFighter->SetPosition(glm::vec3{ 0,sprite->m_DestRect.h,0 });
+    capturedFighter->GetComponent<CapturedFighterComponent>()->UploadGetBackTrajectory();
+    m_Scene->AddObject(std::move(capturedFighter));
+}
+void EnemyAttacksObserver::OnBulletShot(GameEngine::GameObject& enemy, const BulletShotEvent&)
+{
+    const auto playerPos = enemy.GetComponent<EnemyComponent>()->GetPlayerComponent()->GetGameObjParent()->GetPosition();
+    auto enemyPos = enemy.GetPosition();
+    auto bullet = InitEnemyBullet(TrajectoryMath::CalculateDirection(enemyPos, playerPos));
+
+    enemyPos.y += bullet->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
+    bullet->SetPosition(enemyPos);
+    bullet->Connect<GameEngine::CollisionEvent, &EnemyAttacksObserver::OnBulletCollision>(this);
+    bullet->Connect<BulletOutOfBoundsEvent, &EnemyAttacksObserver::OnBulletOutOfBounds>(this);
+    m_Scene->AddObject(std::move(bullet));
 
-        enemyPos.y += bullet->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
+    //shoot a second bullet if the enemy is a boss that has a fighter captured
+    auto bossComp = dynamic_cast<BossGalagaComponent*>(enemy.GetComponent<EnemyComponent>());
+    if (bossComp && bossComp->HasCapturedFighter())
+    {
+        bullet = InitEnemyBullet(TrajectoryMath::CalculateDirection(enemyPos, playerPos));
+        enemyPos.y -= bullet->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
         bullet->SetPosition(enemyPos);
-        bullet->AddObserver(static_cast<int>(ObserverIdentifier::enemyAttack), this);
+        bullet->Connect<GameEngine::CollisionEvent, &EnemyAttacksObserver::OnBulletCollision>(this);
+        bullet->Connect<BulletOutOfBoundsEvent, &EnemyAttacksObserver::OnBulletOutOfBounds>(this);
         m_Scene->AddObject(std::move(bullet));
-
-        //shoot a second bullet if the enemy is a boss that has a fighter captured
-        auto bossComp = dynamic_cast<BossGalagaComponent*>(actor->GetComponent<EnemyComponent>());
-        if (bossComp && bossComp->HasCapturedFighter())
-        {
-            bullet = InitEnemyBullet(TrajectoryMath::CalculateDirection(enemyPos, playerPos));
-            enemyPos.y -= bullet->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
-            bullet->SetPosition(enemyPos);
-            bullet->AddObserver(static_cast<int>(ObserverIdentifier::enemyAttack), this);
-            m_Scene->AddObject(std::move(bullet));
-        }
     }
-    break;
-    case GameEvent::bulletOutOfBounds:
-        actor->SetDestroyedFlag();
-        break;
-    case GameEvent::bossShotBeam:
-    {
-        auto enemyComp = actor->GetComponent<EnemyComponent>();
-        auto beam = InitBossBeam(enemyComp);
-        beam->SetParent(actor, false);
+}
+void EnemyAttacksObserver::OnBossShotBeam(GameEngine::GameObject& enemy, const BossShotBeamEvent&)
+{
+    auto enemyComp = enemy.GetComponent<EnemyComponent>();
+    auto beam = InitBossBeam(enemyComp);
+    beam->SetParent(&enemy, false);
 
-        glm::vec2 posOffset{};
-        posOffset.y += actor->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
-        posOffset.x += actor->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.w / 2.f;
-        posOffset.x -= beam->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.w / 2.f;
+    glm::vec2 posOffset{};
+    posOffset.y += enemy.GetComponent<GameEngine::SpriteComponent>()->m_DestRect.h;
+    posOffset.x += enemy.GetComponent<GameEngine::SpriteComponent>()->m_DestRect.w / 2.f;
+    posOffset.x -= beam->GetComponent<GameEngine::SpriteComponent>()->m_DestRect.w / 2.f;
 
-        beam->SetPosition({ posOffset,0 });
-        beam->AddObserver(static_cast<int>(ObserverIdentifier::enemyAttack), this);
-        m_Scene->AddObject(std::move(beam));
-    }
-    break;
-    case GameEvent::beamRetracted:
-    {
-        actor->SetDestroyedFlag();
-        auto parentComp = actor->GetComponent<BeamComponent>()->GetParentComp();
-        parentComp->GetInIdleState();
-    }
-    break;
-    default: break;
-    }
+    beam->SetPosition({ posOffset,0 });
+    beam->Connect<GameEngine::CollisionEvent, &EnemyAttacksObserver::OnBeamCollision>(this);
+    beam->Connect<BeamRetractedEvent, &EnemyAttacksObserver::OnBeamRetracted>(this);
+    m_Scene->AddObject(std::move(beam));
+}
+void EnemyAttacksObserver::OnBulletCollision(GameEngine::GameObject& bullet, const GameEngine::CollisionEvent& event)
+{
+    if (event.pOtherCollider->GetID() == static_cast<int>(GameId::player)) bullet.SetDestroyedFlag();
+}
+void EnemyAttacksObserver::OnBulletOutOfBounds(GameEngine::GameObject& bullet, const BulletOutOfBoundsEvent&)
+{
+    bullet.SetDestroyedFlag();
+}
+void EnemyAttacksObserver::OnBeamCollision(GameEngine::GameObject& beam, const GameEngine::CollisionEvent& event)
+{
+    if (event.pOtherCollider->GetID() != static_cast<int>(GameId::player)) return;
+    BossGalagaComponent* bossComp = dynamic_cast<BossGalagaComponent*>(beam.GetComponent<BeamComponent>()->GetParentComp());
+    if (!bossComp->HasCapturedFighter()) bossComp->CapturedFighter();
+    event.pOtherCollider->GetComponent<PlayerComponent>()->SetEnemyCapturing(bossComp);
+}
+void EnemyAttacksObserver::OnBeamRetracted(GameEngine::GameObject& beam, const BeamRetractedEvent&)
+{
+    beam.SetDestroyedFlag();
+    auto parentComp = beam.GetComponent<BeamComponent>()->GetParentComp();
+    parentComp->GetInIdleState();
 }
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "DataStructs.h"
 #include "IObserver.h"
 #include "Scene.h"
 
@@ -6,8 +7,15 @@ class EnemyAttacksObserver final : public GameEngine::IObserver
 {
 public:
     explicit EnemyAttacksObserver( GameEngine::Scene* scene);
-    virtual void Notify(GameEngine::Subject* subject, int event
-        , GameEngine::EventData* eventData) override;
+    //Spawns the enemy's bullets and beams and captures the fighter its beam caught
+    void ObserveEnemy(GameEngine::GameObject* enemy);
 private:
+    void OnFighterCaptured(GameEngine::GameObject& enemy, const FighterCapturedEvent&);
+    void OnBulletShot(GameEngine::GameObject& enemy, const BulletShotEvent&);
+    void OnBossShotBeam(GameEngine::GameObject& enemy, const BossShotBeamEvent&);
+    void OnBulletCollision(GameEngine::GameObject& bullet, const GameEngine::CollisionEvent& event);
+    void OnBulletOutOfBounds(GameEngine::GameObject& bullet, const BulletOutOfBoundsEvent&);
+    void OnBeamCollision(GameEngine::GameObject& beam, const GameEngine::CollisionEvent& event);
+    void OnBeamRetracted(GameEngine::GameObject& beam, const BeamRetractedEvent&);
     GameEngine::Scene* m_Scene{nullptr};
 };
\ No newline at end of file
@@ -1,12 +1,14 @@
 ﻿#pragma once
+#include "EventData.h"
 #include "IObserver.h"
 
 class EnemyObserver final : public GameEngine::IObserver
 {
 public:
     EnemyObserver() = default;
-    virtual void Notify(GameEngine::Subject* subject, int event
-        , GameEngine::EventData* eventData) override;
+    //Scores the enemy and makes it emit DiedEvent once a bullet killed it
+    void Observe(GameEngine::GameObject* enemy);
 private:
+    void OnCollision(GameEngine::GameObject& enemy, const GameEngine::CollisionEvent& event);
 };
 
@@ -0,0 +1,58 @@
+﻿#include "EnemyRegistry.h"
+
+#include "Game components/Enemy components/BossGalagaComponent.h"
+
+void EnemyRegistry::Add(EnemyComponent* enemy)
+{
+    if (enemy->m_RegistryIndex != -1) return;
+    Push(m_Enemies, enemy, &EnemyComponent::m_RegistryIndex);
+    enemy->m_Bucket = GetBucket(enemy->GetEnemyType(), enemy->IsIdle());
+    Push(m_Buckets[enemy->m_Bucket], enemy, &EnemyComponent::m_BucketIndex);
+}
+void EnemyRegistry::Remove(EnemyComponent* enemy)
+{
+    if (enemy->m_RegistryIndex == -1) return;
+    SwapRemove(m_Enemies, enemy, &EnemyComponent::m_RegistryIndex);
+    SwapRemove(m_Buckets[enemy->m_Bucket], enemy, &EnemyComponent::m_BucketIndex);
+    enemy->m_Bucket = -1;
+}
+void EnemyRegistry::UpdateState(EnemyComponent* enemy)
+{
+    if (enemy->m_RegistryIndex == -1) return;
+    const int bucket = GetBucket(enemy->GetEnemyType(), enemy->IsIdle());
+    if (bucket == enemy->m_Bucket) return;
+    SwapRemove(m_Buckets[enemy->m_Bucket], enemy, &EnemyComponent::m_BucketIndex);
+    enemy->m_Bucket = bucket;
+    Push(m_Buckets[bucket], enemy, &EnemyComponent::m_BucketIndex);
+}
+
+size_t EnemyRegistry::GetNrOfIdleEnemies() const
+{
+    size_t nrOfIdleEnemies{};
+    for (int type = 0; type < m_NrOfTypes; ++type) nrOfIdleEnemies += m_Buckets[type * 2 + 1].size();
+    return nrOfIdleEnemies;
+}
+EnemyComponent* EnemyRegistry::GetIdleEnemy(EnemyId type) const
+{
+    const auto& idleEnemies = GetEnemies(type, true);
+    return idleEnemies.empty() ? nullptr : idleEnemies.back();
+}
+BossGalagaComponent* EnemyRegistry::GetIdleBoss() const
+{
+    //only boss galagas are registered in the boss buckets
+    return static_cast<BossGalagaComponent*>(GetIdleEnemy(EnemyId::bossGalaga));
+}
+
+void EnemyRegistry::Push(std::vector<EnemyComponent*>& enemies, EnemyComponent* enemy, int EnemyComponent::* index)
+{
+    enemy->*index = static_cast<int>(enemies.size());
+    enemies.emplace_back(enemy);
+}
+void EnemyRegistry::SwapRemove(std::vector<EnemyComponent*>& enemies, EnemyComponent* enemy, int EnemyComponent::* index)
+{
+    EnemyComponent* lastEnemy = enemies.back();
+    enemies[enemy->*index] = lastEnemy;
+    lastEnemy->*index = enemy->*index;
+    enemies.pop_back();
+    enemy->*index = -1;
+}
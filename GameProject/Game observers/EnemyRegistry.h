@@ -0,0 +1,42 @@
+﻿#pragma once
+#include <array>
+#include <vector>
+
+#include "DataStructs.h"
+
+class EnemyComponent;
+class BossGalagaComponent;
+
+//Keeps every enemy in one flat list and in a bucket per type and per idle/busy state.
+//Each enemy stores its own positions in these lists, so removing it swaps the last
+//enemy into its place instead of searching and shifting the list
+class EnemyRegistry final
+{
+public:
+    void Add(EnemyComponent* enemy);
+    void Remove(EnemyComponent* enemy);
+    //Moves the enemy to the bucket of its current state
+    void UpdateState(EnemyComponent* enemy);
+
+    [[nodiscard]] size_t GetNrOfEnemies() const { return m_Enemies.size(); }
+    [[nodiscard]] EnemyComponent* GetEnemy(size_t index) const { return m_Enemies[index]; }
+    [[nodiscard]] const std::vector<EnemyComponent*>& GetEnemies(EnemyId type, bool isIdle) const
+    {
+        return m_Buckets[GetBucket(type, isIdle)];
+    }
+    [[nodiscard]] size_t GetNrOfIdleEnemies() const;
+    //Whether an enemy of the type is alive, idle or not
+    [[nodiscard]] bool HasEnemies(EnemyId type) const { return !GetEnemies(type, true).empty() || !GetEnemies(type, false).empty(); }
+    //nullptr if there is none
+    [[nodiscard]] EnemyComponent* GetIdleEnemy(EnemyId type) const;
+    [[nodiscard]] BossGalagaComponent* GetIdleBoss() const;
+private:
+    static constexpr int m_NrOfTypes{ 3 };
+    //diving ids share the bucket of their type
+    [[nodiscard]] static int GetBucket(EnemyId type, bool isIdle) { return static_cast<int>(type) / 2 * 2 + isIdle; }
+    static void Push(std::vector<EnemyComponent*>& enemies, EnemyComponent* enemy, int EnemyComponent::* index);
+    static void SwapRemove(std::vector<EnemyComponent*>& enemies, EnemyComponent* enemy, int EnemyComponent::* index);
+
+    std::vector<EnemyComponent*> m_Enemies;
+    std::array<std::vector<EnemyComponent*>, m_NrOfTypes * 2> m_Buckets;
+};
@@ -1,11 +1,44 @@
 ﻿#include "ExplosionObserver.h"
 
-#include "DataStructs.h"
-#include "Initializers.h"
 #include "Scene.h"
-void ExplosionObserver::Notify(GameEngine::Subject* subject, int event,[[maybe_unused]] GameEngine::EventData* eventData)
+#include "Components/SpriteComponent.h"
+#include "Managers/ResourceManager.h"
+#include "Subjects/GameObject.h"
+
+namespace
+{
+    constexpr int g_NrOfDebrisParticles{ 12 };
+}
+ExplosionObserver::ExplosionObserver(GameEngine::Scene* scene) :
+    m_ParticleSystem(scene->GetParticleSystem())
+{
+    GameEngine::EmitterSettings explosion{};
+    explosion.texture = GameEngine::ResourceManager::GetInstance().LoadTexture("GalagaUpdated.png");
+    explosion.srcRect = { 91, 19, 32, 32 };
+    explosion.nrOfFrames = 5;
+    explosion.frameSpacing = 2;
+    explosion.size = { 64.f, 64.f };
+    explosion.minLifeTime = explosion.maxLifeTime = 0.25f;
+    m_ExplosionEmitter = m_ParticleSystem->AddEmitter(explosion);
+
+    GameEngine::EmitterSettings debris{};
+    debris.size = { 3.f, 3.f };
+    debris.minLifeTime = 0.3f;
+    debris.maxLifeTime = 0.6f;
+    debris.minSpeed = 80.f;
+    debris.maxSpeed = 220.f;
+    debris.color = { 255, 210, 90, 255 };
+    debris.isFadingOut = true;
+    m_DebrisEmitter = m_ParticleSystem->AddEmitter(debris);
+}
+void ExplosionObserver::Observe(GameEngine::GameObject* gameObject)
+{
+    gameObject->Connect<DiedEvent, &ExplosionObserver::OnDied>(this);
+}
+void ExplosionObserver::OnDied(GameEngine::GameObject& gameObject, const DiedEvent&)
 {
-    if (static_cast<GameEvent>(event) != GameEvent::died) return;
-    auto explosion = InitExplosion(dynamic_cast<GameEngine::GameObject*>(subject));
-    m_Scene->AddObject(std::move(explosion));
+    const auto parentRect = gameObject.GetComponent<GameEngine::SpriteComponent>()->m_DestRect;
+    const glm::vec2 center{ parentRect.x + parentRect.w / 2.f, parentRect.y + parentRect.h / 2.f };
+    m_ParticleSystem->Burst(m_ExplosionEmitter, center, 1);
+    m_ParticleSystem->Burst(m_DebrisEmitter, center, g_NrOfDebrisParticles);
 }
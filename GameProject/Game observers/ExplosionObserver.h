@@ -1,15 +1,22 @@
 ﻿#pragma once
+#include "DataStructs.h"
 #include "IObserver.h"
 
 namespace GameEngine
 {
+    class ParticleSystem;
     class Scene;
 }
 class ExplosionObserver final : public GameEngine::IObserver
 {
 public:
-    explicit ExplosionObserver(GameEngine::Scene* scene) : m_Scene(scene) {}
-    void Notify(GameEngine::Subject* subject, int event, GameEngine::EventData* eventData) override;
+    //Adds the explosion and debris emitters to the scene's particle system
+    explicit ExplosionObserver(GameEngine::Scene* scene);
+    //Bursts an explosion where the object dies
+    void Observe(GameEngine::GameObject* gameObject);
 private:
-    GameEngine::Scene* m_Scene;
+    void OnDied(GameEngine::GameObject& gameObject, const DiedEvent&);
+    GameEngine::ParticleSystem* m_ParticleSystem;
+    int m_ExplosionEmitter;
+    int m_DebrisEmitter;
 };
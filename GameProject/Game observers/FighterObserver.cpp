@@ -10,28 +10,26 @@
 #include "Sound/ServiceLocator.h"
 #include "Subjects/GameObject.h"
 
-void FighterObserver::Notify(GameEngine::Subject* subject, int event,
-    [[maybe_unused]] GameEngine::EventData* eventData)
+void FighterObserver::Observe(GameEngine::GameObject* fighter)
 {
-    switch (static_cast<GameEvent>(event))
+    fighter->Connect<GameEngine::CollisionEvent, &FighterObserver::OnCollision>(this);
+}
+void FighterObserver::OnCollision(GameEngine::GameObject& fighter, const GameEngine::CollisionEvent& event)
+{
+    if (event.pOtherCollider->GetID() == static_cast<int>(GameId::enemy) ||
+        event.pOtherCollider->GetID() == static_cast<int>(GameId::enemyBullet))
     {
-    case GameEvent::collision:
+        auto healthComp = fighter.GetComponent<PlayerHealthComponent>();
+        fighter.SetPosition(PlayerComponent::m_RespawnPos);
+        GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::playerDeath), Galaga::volume);
+        healthComp->Hit();
+    }
+    else if (event.pOtherCollider->GetID() == static_cast<int>(GameId::bossBeam) &&
+        !event.pOtherCollider->GetComponent<BeamComponent>()->IsBeamActive())
     {
-        const auto collisionData = reinterpret_cast<GameEngine::CollisionData*>(eventData);
-        if (collisionData->pOtherCollider->GetID() == static_cast<int>(GameId::enemy) ||
-            collisionData->pOtherCollider->GetID() == static_cast<int>(GameId::enemyBullet))
+        if(fighter.GetComponent<PlayerComponent>()->IsCaptured()) return;
+        if(!Galaga::GetInstance().IsNetworked())
         {
-            GameEngine::GameObject* actor = dynamic_cast<GameEngine::GameObject*>(subject);
-            auto healthComp = actor->GetComponent<PlayerHealthComponent>();
-            actor->SetPosition(PlayerComponent::m_RespawnPos);
-            GameEngine::ServiceLocator::GetSoundSystem().PlaySound(static_cast<GameEngine::SoundId>(SoundId::playerDeath), Galaga::volume);
-            healthComp->Hit();
-        }
-        else if (collisionData->pOtherCollider->GetID() == static_cast<int>(GameId::bossBeam) &&
-            !collisionData->pOtherCollider->GetComponent<BeamComponent>()->IsBeamActive())
-        {
-            auto actor = dynamic_cast<GameEngine::GameObject*>(subject);
-            if(actor->GetComponent<PlayerComponent>()->IsCaptured()) return;
             auto& input = GameEngine::InputManager::GetInstance();
             input.UnbindCommand(GameEngine::KeyboardInputKey::A);
             input.UnbindCommand(GameEngine::KeyboardInputKey::D);
@@ -39,11 +37,8 @@ void FighterObserver::Notify(GameEngine::Subject* subject, int event,
             input.UnbindCommand(GameEngine::ControllerInputKey::dpadLeft, 0);
             input.UnbindCommand(GameEngine::ControllerInputKey::dpadRight, 0);
             input.UnbindCommand(GameEngine::ControllerInputKey::X, 0);
-            
-            actor->GetComponent<PlayerComponent>()->GetCaptured(collisionData->pOtherCollider->GetPosition());
         }
-    }
-    break;
-    default: break;
+        
+        fighter.GetComponent<PlayerComponent>()->GetCaptured(event.pOtherCollider->GetPosition());
     }
 }
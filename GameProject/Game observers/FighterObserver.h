@@ -1,11 +1,13 @@
 ﻿#pragma once
+#include "EventData.h"
 #include "IObserver.h"
 
 class FighterObserver final : public GameEngine::IObserver
 {
 public:
     FighterObserver() = default;
-    virtual void Notify(GameEngine::Subject* subject, int event
-        , GameEngine::EventData* eventData) override;
+    //Handles the fighter getting hit or caught in a beam
+    void Observe(GameEngine::GameObject* fighter);
 private:
+    void OnCollision(GameEngine::GameObject& fighter, const GameEngine::CollisionEvent& event);
 };
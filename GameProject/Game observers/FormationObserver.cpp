@@ -5,6 +5,7 @@
 #include "DataStructs.h"
 #include "Game components/FormationComponent.h"
 #include "Game components/Enemy components/EnemyComponent.h"
+#include "Snapshot.h"
 #include "Subjects/GameObject.h"
 
 int FormationObserver::m_CurrentStage = 0;
@@ -12,28 +13,26 @@ int FormationObserver::m_CurrentEnemiesSetOut = 0;
 int FormationObserver::m_CurrentEnemiesGotInFormation = 0;
 int FormationObserver::m_NrOfStages;
 
-void FormationObserver::Notify([[maybe_unused]] GameEngine::Subject* subject, int event,
-    [[maybe_unused]] GameEngine::EventData* eventData)
+void FormationObserver::Observe(GameEngine::GameObject* enemy)
 {
-    switch (static_cast<GameEvent>(event))
-    {
-    case GameEvent::died:
-    {
-        GameEngine::GameObject* actor = dynamic_cast<GameEngine::GameObject*>(subject);
-        if (actor->GetComponent<EnemyComponent>()->HasSetOut() && m_CurrentEnemiesSetOut)
-        {
-            --m_CurrentEnemiesSetOut;
-        }
-        
-    }
-        break;
-    case GameEvent::gotInFormation:
+    enemy->Connect<DiedEvent, &FormationObserver::OnDied>(this);
+    enemy->Connect<GotInFormationEvent, &FormationObserver::OnGotInFormation>(this);
+}
+void FormationObserver::OnDied(GameEngine::GameObject& enemy, const DiedEvent&)
+{
+    if (enemy.GetComponent<EnemyComponent>()->HasSetOut() && m_CurrentEnemiesSetOut)
     {
-        ++m_CurrentEnemiesGotInFormation;
-    }
-    break;
-    default: break;
+        --m_CurrentEnemiesSetOut;
     }
+    CheckStageFinished();
+}
+void FormationObserver::OnGotInFormation(GameEngine::GameObject&, const GotInFormationEvent&)
+{
+    ++m_CurrentEnemiesGotInFormation;
+    CheckStageFinished();
+}
+void FormationObserver::CheckStageFinished()
+{
     if (m_CurrentEnemiesGotInFormation == m_CurrentEnemiesSetOut && m_CurrentEnemiesGotInFormation != 0)
     {
         m_CurrentEnemiesGotInFormation = 0;
@@ -47,3 +46,15 @@ void FormationObserver::Notify([[maybe_unused]] GameEngine::Subject* subject, in
         }
     }
 }
+void FormationObserver::SaveState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Write(m_CurrentStage);
+    snapshot.Write(m_CurrentEnemiesSetOut);
+    snapshot.Write(m_CurrentEnemiesGotInFormation);
+}
+void FormationObserver::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_CurrentStage);
+    snapshot.Read(m_CurrentEnemiesSetOut);
+    snapshot.Read(m_CurrentEnemiesGotInFormation);
+}
@@ -1,14 +1,26 @@
 ﻿#pragma once
+#include "DataStructs.h"
 #include "IObserver.h"
+namespace GameEngine
+{
+    class Snapshot;
+}
 
 class FormationObserver : public GameEngine::IObserver
 {
 public:
-    void Notify(GameEngine::Subject* subject, int event, GameEngine::EventData* eventData = nullptr) override;
+    //Tracks the enemy arriving in the formation or dying on its way there
+    void Observe(GameEngine::GameObject* enemy);
     static int GetCurrentStage() { return m_CurrentStage; }
     static void EnemySetOut() { ++m_CurrentEnemiesSetOut; }
     static void SetNrOfStages(int nrOfStages) { m_NrOfStages = nrOfStages; }
+    static void SaveState(GameEngine::Snapshot& snapshot);
+    static void LoadState(GameEngine::Snapshot& snapshot);
 private:
+    void OnDied(GameEngine::GameObject& enemy, const DiedEvent&);
+    void OnGotInFormation(GameEngine::GameObject& enemy, const GotInFormationEvent&);
+    //starts the next stage once every enemy that set out either arrived or died
+    static void CheckStageFinished();
     static int m_NrOfStages;
     static int m_CurrentStage;
     static int m_CurrentEnemiesSetOut;
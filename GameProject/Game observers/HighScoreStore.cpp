@@ -0,0 +1,181 @@
+﻿#include "HighScoreStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace std::chrono;
+
+namespace
+{
+    //a lock that is older than this was left behind by a game that stopped mid-write
+    constexpr milliseconds g_StaleLockTime{ 1000 };
+
+    [[nodiscard]] std::vector<HighScoreEntry> ReadTable(const std::string& path, size_t nrOfEntries)
+    {
+        std::vector<HighScoreEntry> entries;
+        std::ifstream inFile(path);
+        std::string line;
+        for (uint64_t lineNr = 1; std::getline(inFile, line) && entries.size() < nrOfEntries; ++lineNr)
+        {
+            std::istringstream iss(line);
+            HighScoreEntry entry{};
+            if (!(iss >> entry.name >> entry.score)) continue;
+            //rows written before ids existed are told apart by their line, which every store reads the same
+            if (!(iss >> entry.id)) entry.id = lineNr;
+            //id 0 marks the filler rows of a table that isn't full yet
+            else if (entry.id == 0) continue;
+            entries.emplace_back(std::move(entry));
+        }
+        std::ranges::stable_sort(entries, std::greater{}, &HighScoreEntry::score);
+        return entries;
+    }
+
+    //Two game instances starting at the same time still get different ids, 0 is kept for rows without one
+    [[nodiscard]] uint32_t CreateInstanceId()
+    {
+        std::random_device device{};
+        std::uniform_int_distribution<uint32_t> distribution{ 1 };
+        return distribution(device);
+    }
+
+    //Adds the entries of other that entries is missing, an entry both tables have has the same id
+    void MergeTable(std::vector<HighScoreEntry>& entries, const std::vector<HighScoreEntry>& other, size_t nrOfEntries)
+    {
+        const auto nrOfOwnEntries = static_cast<std::ptrdiff_t>(entries.size());
+        for (const auto& otherEntry : other)
+        {
+            if (std::none_of(entries.begin(), entries.begin() + nrOfOwnEntries, [&otherEntry](const HighScoreEntry& entry) { return entry.id == otherEntry.id; }))
+                entries.emplace_back(otherEntry);
+        }
+        std::ranges::stable_sort(entries, std::greater{}, &HighScoreEntry::score);
+        if (entries.size() > nrOfEntries) entries.resize(nrOfEntries);
+    }
+}
+
+HighScoreStore::HighScoreStore() :
+    HighScoreStore("../Data/HighestScores.txt")
+{}
+HighScoreStore::HighScoreStore(std::string filePath) :
+    m_FilePath(std::move(filePath)),
+    m_InstanceId(CreateInstanceId())
+{
+    Load();
+    m_WorkerThread = std::thread(&HighScoreStore::ProcessWrites, this);
+}
+HighScoreStore::~HighScoreStore()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_IsRunning = false;
+    }
+    m_ConditionVariable.notify_one();
+    //the worker writes what is still pending before it stops
+    m_WorkerThread.join();
+}
+
+void HighScoreStore::Submit(const std::string& name, int score)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        const auto it = std::ranges::upper_bound(m_Entries, score, std::greater{}, &HighScoreEntry::score);
+        if (static_cast<size_t>(it - m_Entries.begin()) >= m_NrOfEntries) return;
+        const uint64_t id = (static_cast<uint64_t>(m_InstanceId) << 32) | ++m_NrOfSubmissions;
+        m_Entries.insert(it, { name, score, id });
+        if (m_Entries.size() > m_NrOfEntries) m_Entries.pop_back();
+        ++m_Version;
+    }
+    m_ConditionVariable.notify_one();
+}
+int HighScoreStore::GetHighestScore()
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Entries.empty() ? 0 : m_Entries.front().score;
+}
+std::vector<HighScoreEntry> HighScoreStore::GetEntries()
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Entries;
+}
+void HighScoreStore::Flush()
+{
+    std::unique_lock lock(m_Mutex);
+    m_WrittenConditionVariable.wait(lock, [this] { return m_WrittenVersion == m_Version; });
+}
+
+void HighScoreStore::Load()
+{
+    m_Entries = ReadTable(m_FilePath, m_NrOfEntries);
+}
+std::vector<HighScoreEntry> HighScoreStore::Write(std::vector<HighScoreEntry> entries) const
+{
+    //creating a directory either succeeds or finds it already there, on every platform
+    const std::string lockPath = m_FilePath + ".lock";
+    std::error_code error;
+    auto lockStart = steady_clock::now();
+    while (!std::filesystem::create_directory(lockPath, error))
+    {
+        if (error)
+        {
+            std::cerr << "Failed to lock " << m_FilePath << ": " << error.message() << '\n';
+            return entries;
+        }
+        if (steady_clock::now() - lockStart > g_StaleLockTime)
+        {
+            std::filesystem::remove(lockPath, error);
+            lockStart = steady_clock::now();
+            continue;
+        }
+        std::this_thread::sleep_for(milliseconds{ 1 });
+    }
+    //what other stores wrote since this one loaded the table
+    MergeTable(entries, ReadTable(m_FilePath, m_NrOfEntries), m_NrOfEntries);
+    WriteTable(entries);
+    std::filesystem::remove(lockPath, error);
+    return entries;
+}
+void HighScoreStore::WriteTable(const std::vector<HighScoreEntry>& entries) const
+{
+    const std::string tempPath = m_FilePath + ".tmp";
+    {
+        std::ofstream outFile(tempPath, std::ios::trunc);
+        for (const auto& [name, score, id] : entries) outFile << name << " " << score << " " << id << "\n";
+        //the table is always shown with all of its rows
+        for (size_t i = entries.size(); i < m_NrOfEntries; ++i) outFile << "AAA 0 0" << "\n";
+        if (!outFile.flush())
+        {
+            std::cerr << "Failed to write high scores to " << tempPath << '\n';
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, m_FilePath, error);
+    if (error) std::cerr << "Failed to replace " << m_FilePath << ": " << error.message() << '\n';
+}
+void HighScoreStore::ProcessWrites()
+{
+    std::unique_lock lock(m_Mutex);
+    while (true)
+    {
+        m_ConditionVariable.wait(lock, [this] { return !m_IsRunning || m_WrittenVersion != m_Version; });
+        if (m_WrittenVersion == m_Version)
+        {
+            if (!m_IsRunning) return;
+            continue;
+        }
+        //write a snapshot without holding the lock, submits during the write are picked up next loop
+        const int version = m_Version;
+        std::vector<HighScoreEntry> entries = m_Entries;
+        lock.unlock();
+        entries = Write(std::move(entries));
+        lock.lock();
+        //the scores other stores wrote show up in this table too
+        MergeTable(m_Entries, entries, m_NrOfEntries);
+        m_WrittenVersion = version;
+        m_WrittenConditionVariable.notify_all();
+    }
+}
@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Managers/Singleton.h"
+
+struct HighScoreEntry
+{
+    std::string name;
+    int score{};
+    //Tells submissions with the same name and score apart, the submitting store's instance id in the high half
+    //and its sequence number in the low half. Rows of a table written before ids existed get instance 0
+    uint64_t id{};
+};
+
+//Keeps the high score table in memory after loading it once. Submitting a score only updates
+//the table, a worker thread writes it to a temporary file that then replaces the table file,
+//so a crash mid-write never leaves a half written table behind. Other stores on the same file,
+//e.g. of a second game instance, are merged in: every write locks the file and adds the entries
+//it holds to the table, so scores submitted to either store are kept. Only a row with an id the table
+//already has counts as the same entry, two submissions of the same name and score both stay
+class HighScoreStore final : public GameEngine::Singleton<HighScoreStore>
+{
+public:
+    HighScoreStore(const HighScoreStore& other) = delete;
+    HighScoreStore(HighScoreStore&& other) noexcept = delete;
+    HighScoreStore& operator=(const HighScoreStore& other) = delete;
+    HighScoreStore& operator=(HighScoreStore&& other) noexcept = delete;
+    ~HighScoreStore() override;
+    //A store of its own on the given file, the game uses GetInstance
+    explicit HighScoreStore(std::string filePath);
+
+    //Entries with the same score are kept, the older one ranks higher
+    void Submit(const std::string& name, int score);
+    [[nodiscard]] int GetHighestScore();
+    //Copy of the table, highest score first
+    [[nodiscard]] std::vector<HighScoreEntry> GetEntries();
+    //Blocks until every submitted score has been written
+    void Flush();
+
+    static constexpr size_t m_NrOfEntries{ 10 };
+private:
+    friend class GameEngine::Singleton<HighScoreStore>;
+    HighScoreStore();
+    void Load();
+    //Merges the table that is on disk into entries and writes the result, which is returned
+    [[nodiscard]] std::vector<HighScoreEntry> Write(std::vector<HighScoreEntry> entries) const;
+    void WriteTable(const std::vector<HighScoreEntry>& entries) const;
+    void ProcessWrites();
+
+    const std::string m_FilePath;
+    const uint32_t m_InstanceId;
+    uint32_t m_NrOfSubmissions{};
+    std::vector<HighScoreEntry> m_Entries;
+    //bumped on every submit, the worker writes the latest table once it catches up
+    int m_Version{};
+    int m_WrittenVersion{};
+    bool m_IsRunning{ true };
+    std::mutex m_Mutex;
+    std::condition_variable m_ConditionVariable;
+    std::condition_variable m_WrittenConditionVariable;
+    std::thread m_WorkerThread;
+};
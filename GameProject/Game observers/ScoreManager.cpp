@@ -1,44 +1,39 @@
 ﻿#include "ScoreManager.h"
 
-#include <fstream>
 #include <iostream>
-#include <sstream>
 
 #include "DataStructs.h"
+#include "HighScoreStore.h"
+#include "Initializers.h"
+#include "Snapshot.h"
 
 int ScoreManager::m_PlayerScore{};
 
-const std::unordered_map<EnemyId, int> ScoreManager::m_EnemyScores{
-    { EnemyId::bee,50 },
-    { EnemyId::beeDiving,100 },
-    { EnemyId::butterfly,80 },
-    { EnemyId::butterflyDiving,160 },
-    { EnemyId::bossGalaga,150 },
-    { EnemyId::bossGalagaDiving,400 }
-};
-
 void ScoreManager::AddScore(EnemyId enemyId)
 {
-    m_PlayerScore += m_EnemyScores.at(enemyId);
+    const EnemyPrefab& prefab = GetEnemyPrefab(enemyId);
+    const bool isDiving = enemyId == EnemyId::beeDiving || enemyId == EnemyId::butterflyDiving || enemyId == EnemyId::bossGalagaDiving;
+    m_PlayerScore += isDiving ? prefab.divingScore : prefab.score;
 #ifndef NDEBUG
     std::cout << "Player has score: " << m_PlayerScore << '\n';
 #endif
 }
 int ScoreManager::GetHighestScore()
 {
-    std::ifstream inFile("../Data/HighestScores.txt");
-
-    std::string line;
-    std::getline(inFile, line);
-    std::istringstream iss(line);
-    std::string playerName;
-    int playerScore;
-    iss >> playerName >> playerScore;
-    inFile.close();
-    return playerScore;
+    return HighScoreStore::GetInstance().GetHighestScore();
 }
 
 int ScoreManager::GetPlayerScore()
 {
     return m_PlayerScore;
 }
+
+void ScoreManager::SaveState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Write(m_PlayerScore);
+}
+
+void ScoreManager::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_PlayerScore);
+}
@@ -1,13 +1,17 @@
 ﻿#pragma once
-#include <unordered_map>
 enum class EnemyId;
+namespace GameEngine
+{
+    class Snapshot;
+}
 class ScoreManager final
 {
 public:
     static int GetPlayerScore();
     static void AddScore(EnemyId enemyId);
     static int GetHighestScore();
+    static void SaveState(GameEngine::Snapshot& snapshot);
+    static void LoadState(GameEngine::Snapshot& snapshot);
 private:
     static int m_PlayerScore;
-    const static std::unordered_map<EnemyId, int> m_EnemyScores;
 };
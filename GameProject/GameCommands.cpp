@@ -6,23 +6,17 @@
 #include "Subjects/GameObject.h"
 #include "Game components/ModeSelectionComp.h"
 #include "Game components/NameSelectionComp.h"
+#include "Game components/PlayerComponent.h"
 #include "Game observers/EnemyAIManager.h"
+#include "Trajectory Logic/StageGenerator.h"
 
 ShootBulletCommand::ShootBulletCommand(GameEngine::GameObject* actor): Command(actor) {}
 
 void ShootBulletCommand::Execute()
 {
-    m_Current = GameEngine::TimeManager::GetInstance().GetCurrent();
-    const std::chrono::duration<float> elapsed = m_Current - m_Previous;
+    if (!m_Actor->GetComponent<PlayerComponent>()->TryShoot()) return;
 
-    if (m_ShootsAvailable < m_MaxShootCount && elapsed.count() > m_ShootCooldown) m_ShootsAvailable = m_MaxShootCount;
-    if (m_ShootsAvailable <= 0) return;
-
-    --m_ShootsAvailable;
-    m_Actor->Notify(static_cast<int>(GameEvent::bulletShot),
-        static_cast<int>(ObserverIdentifier::bullet));
-
-    m_Previous = m_Current;
+    m_Actor->Emit(BulletShotEvent{});
     BulletTracker::BulletFired();
 }
 
@@ -123,3 +117,12 @@ GameEngine::Command::ExecuteOn SkipLevelCommand::ExecuteOnKeyState() const
 {
     return ExecuteOn::keyDown;
 }
+LoadStressLevelCommand::LoadStressLevelCommand(GameEngine::GameObject* actor): Command(actor) {}
+void LoadStressLevelCommand::Execute()
+{
+    Galaga::GetInstance().LoadStressLevel(StressStageSettings{});
+}
+GameEngine::Command::ExecuteOn LoadStressLevelCommand::ExecuteOnKeyState() const
+{
+    return ExecuteOn::keyDown;
+}
@@ -16,12 +16,6 @@ public:
     ~ShootBulletCommand() override = default;
     void Execute() override;
     [[nodiscard]] ExecuteOn ExecuteOnKeyState() const override;
-private:
-    const float m_ShootCooldown{ .5f };
-    std::chrono::high_resolution_clock::time_point m_Previous{ std::chrono::high_resolution_clock::now() };
-    std::chrono::high_resolution_clock::time_point m_Current{};
-    const int m_MaxShootCount{ 2 };
-    int m_ShootsAvailable{ 2 };
 };
 
 class SwitchModesCommand final : public GameEngine::Command
@@ -147,6 +141,22 @@ public:
 private:
 };
 
+//Replaces the current level with a generated stress stage
+class LoadStressLevelCommand final : public GameEngine::Command
+{
+public:
+    LoadStressLevelCommand(const LoadStressLevelCommand& other) = delete;
+    LoadStressLevelCommand(LoadStressLevelCommand&& other) noexcept = delete;
+    LoadStressLevelCommand& operator=(const LoadStressLevelCommand& other) = delete;
+    LoadStressLevelCommand& operator=(LoadStressLevelCommand&& other) noexcept = delete;
+
+    explicit LoadStressLevelCommand(GameEngine::GameObject* actor);
+    ~LoadStressLevelCommand() override = default;
+    void Execute() override;
+    [[nodiscard]] ExecuteOn ExecuteOnKeyState() const override;
+private:
+};
+
 class SkipLevelCommand final : public GameEngine::Command
 {
 public:
@@ -1,19 +1,21 @@
 ﻿#include "Initializers.h"
 #include "Game components/BulletComponent.h"
 #include "DataStructs.h"
+#include "Minigin.h"
 #include "GameCommands.h"
 #include "Game components/PlayerHealthComponent.h"
 #include "Game components/PlayerComponent.h"
 #include "Components/CollisionComponent.h"
 #include "Components/SpriteComponent.h"
 #include "Game components/CapturedFighterComponent.h"
-#include "Game components/ExplosionComponent.h"
 #include "Game components/Enemy components/BeamComponent.h"
 #include "Game components/Enemy components/BeeComponent.h"
 #include "Game components/Enemy components/BossGalagaComponent.h"
 #include "Game components/Enemy components/ButterflyComponent.h"
 #include "Game components/Enemy components/EnemyBulletComponent.h"
 #include "Managers/InputManager.h"
+#include "Managers/ParticleSystem.h"
+#include "Managers/ResourceManager.h"
 
 std::unique_ptr<GameEngine::GameObject> InitFighter()
 {
@@ -32,7 +34,7 @@ std::unique_ptr<GameEngine::GameObject> InitFighter()
     spriteComponent->UpdateSrcRect();
     spriteComponent->m_IsActive = false;
 
-    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect);
+    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect)->UseSpriteMask(spriteComponent);
     gameObject->SetPosition(PlayerComponent::m_RespawnPos);
 
     gameObject->AddComponent<PlayerComponent>(spriteComponent,0);
@@ -56,7 +58,7 @@ std::unique_ptr<GameEngine::GameObject> InitCapturedFighter(BossGalagaComponent*
     spriteComponent->UpdateSrcRect();
     spriteComponent->m_IsActive = false;
 
-    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect);
+    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect)->UseSpriteMask(spriteComponent);
     gameObject->AddComponent<CapturedFighterComponent>(parent,spriteComponent);
 
     return gameObject;
@@ -80,7 +82,7 @@ std::unique_ptr<GameEngine::GameObject> InitBullet(int playerID)
     SDL_Rect collisionRect = bulletSpriteComp->m_DestRect;
     collisionRect.w /= 3;
     collisionRect.x += collisionRect.w;
-    bullet->AddComponent<GameEngine::CollisionComponent>(collisionRect);
+    bullet->AddComponent<GameEngine::CollisionComponent>(collisionRect)->SetFastMoving(true);
     return bullet;
 }
 std::unique_ptr<GameEngine::GameObject> InitEnemyBullet(const glm::vec2& direction)
@@ -101,77 +103,117 @@ std::unique_ptr<GameEngine::GameObject> InitEnemyBullet(const glm::vec2& directi
     SDL_Rect collisionRect = bulletSpriteComp->m_DestRect;
     collisionRect.w /= 3;
     collisionRect.x += collisionRect.w;
-    bullet->AddComponent<GameEngine::CollisionComponent>(collisionRect);
+    bullet->AddComponent<GameEngine::CollisionComponent>(collisionRect)->SetFastMoving(true);
     return bullet;
 }
 
-std::unique_ptr<GameEngine::GameObject> InitBee(PlayerComponent* playerComponent)
+namespace
 {
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::enemy));
-    auto* spriteComponent = gameObject->AddComponent<GameEngine::SpriteComponent>("GalagaUpdated.png");
-    spriteComponent->m_SpriteInfo.m_Height = 16;
-    spriteComponent->m_SpriteInfo.m_Width = 16;
-    spriteComponent->m_SpriteInfo.m_Spacing = 2;
-    spriteComponent->m_SpriteInfo.m_StartPos.x = 1;
-    spriteComponent->m_SpriteInfo.m_StartPos.y = 19;
-    spriteComponent->m_SpriteInfo.m_NrOfCols = 5;
-    spriteComponent->m_SpriteInfo.m_NrOfRows = 2;
-    spriteComponent->m_SpriteInfo.m_CurrentCol = 0;
-    spriteComponent->m_SpriteInfo.m_TimeInterval = 0.8f;
-    spriteComponent->m_Scale = 2;
-    spriteComponent->UpdateSrcRect();
-    spriteComponent->m_IsActive = true;
+    EnemyPrefab CreateEnemyPrefab(int spriteStartY, int score, int divingScore)
+    {
+        EnemyPrefab prefab{};
+        prefab.texture = GameEngine::ResourceManager::GetInstance().LoadTexture("GalagaUpdated.png");
+        prefab.spriteInfo.m_Height = 16;
+        prefab.spriteInfo.m_Width = 16;
+        prefab.spriteInfo.m_Spacing = 2;
+        prefab.spriteInfo.m_StartPos.x = 1;
+        prefab.spriteInfo.m_StartPos.y = spriteStartY;
+        prefab.spriteInfo.m_NrOfCols = 5;
+        prefab.spriteInfo.m_NrOfRows = 2;
+        prefab.spriteInfo.m_CurrentCol = 0;
+        prefab.spriteInfo.m_TimeInterval = 0.8f;
+        prefab.scale = 2;
+        prefab.srcRect = prefab.spriteInfo.GetSrcRect();
+        prefab.destRect = { 0, 0, static_cast<int>(prefab.srcRect.w * prefab.scale), static_cast<int>(prefab.srcRect.h * prefab.scale) };
+        prefab.collisionRect = prefab.destRect;
+        prefab.score = score;
+        prefab.divingScore = divingScore;
+        //warm up the rotation table every enemy of this type is going to share
+        static_cast<void>(RotatingSprite::GetColFlipTable(prefab.spriteInfo.m_NrOfCols));
+        return prefab;
+    }
 
-    gameObject->AddComponent<BeeComponent>(spriteComponent, playerComponent);
-    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect);
+    template<typename T>
+    void SpawnEnemiesOfType(const EnemyPrefab& prefab, size_t count, PlayerComponent* playerComponent,
+        std::vector<std::unique_ptr<GameEngine::GameObject>>& enemies)
+    {
+        GameEngine::SpriteComponent::ReservePool(count);
+        GameEngine::CollisionComponent::ReservePool(count);
+        T::ReservePool(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::enemy));
+            gameObject->ReserveComponents(3);
+            auto* spriteComponent = gameObject->AddComponent<GameEngine::SpriteComponent>(prefab.texture);
+            spriteComponent->m_SpriteInfo = prefab.spriteInfo;
+            spriteComponent->m_Scale = prefab.scale;
+            spriteComponent->m_SrcRect = prefab.srcRect;
+            spriteComponent->m_DestRect = prefab.destRect;
+            spriteComponent->m_IsActive = true;
 
-    return gameObject;
+            gameObject->AddComponent<T>(spriteComponent, playerComponent);
+            gameObject->AddComponent<GameEngine::CollisionComponent>(prefab.collisionRect)->UseSpriteMask(spriteComponent);
+            enemies.emplace_back(std::move(gameObject));
+        }
+    }
 }
 
-std::unique_ptr<GameEngine::GameObject> InitButterfly(PlayerComponent* playerComponent)
+const EnemyPrefab& GetEnemyPrefab(EnemyId enemyId)
 {
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::enemy));
-    auto* spriteComponent = gameObject->AddComponent<GameEngine::SpriteComponent>("GalagaUpdated.png");
-    spriteComponent->m_SpriteInfo.m_Height = 16;
-    spriteComponent->m_SpriteInfo.m_Width = 16;
-    spriteComponent->m_SpriteInfo.m_Spacing = 2;
-    spriteComponent->m_SpriteInfo.m_StartPos.x = 1;
-    spriteComponent->m_SpriteInfo.m_StartPos.y = 55;
-    spriteComponent->m_SpriteInfo.m_NrOfCols = 5;
-    spriteComponent->m_SpriteInfo.m_NrOfRows = 2;
-    spriteComponent->m_SpriteInfo.m_CurrentCol = 0;
-    spriteComponent->m_SpriteInfo.m_TimeInterval = 0.8f;
-    spriteComponent->m_Scale = 2;
-    spriteComponent->UpdateSrcRect();
-    spriteComponent->m_IsActive = true;
-
-    gameObject->AddComponent<ButterflyComponent>(spriteComponent, playerComponent);
-    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect);
+    static const EnemyPrefab beePrefab{ CreateEnemyPrefab(19, 50, 100) };
+    static const EnemyPrefab butterflyPrefab{ CreateEnemyPrefab(55, 80, 160) };
+    static const EnemyPrefab bossGalagaPrefab{ CreateEnemyPrefab(91, 150, 400) };
+    switch (enemyId)
+    {
+    case EnemyId::bee:
+    case EnemyId::beeDiving:
+        return beePrefab;
+    case EnemyId::butterfly:
+    case EnemyId::butterflyDiving:
+        return butterflyPrefab;
+    case EnemyId::bossGalaga:
+    case EnemyId::bossGalagaDiving:
+    default:
+        return bossGalagaPrefab;
+    }
+}
 
-    return gameObject;
+std::vector<std::unique_ptr<GameEngine::GameObject>> SpawnEnemies(EnemyId enemyId, size_t count, PlayerComponent* playerComponent)
+{
+    std::vector<std::unique_ptr<GameEngine::GameObject>> enemies;
+    enemies.reserve(count);
+    const EnemyPrefab& prefab = GetEnemyPrefab(enemyId);
+    switch (enemyId)
+    {
+    case EnemyId::bee:
+    case EnemyId::beeDiving:
+        SpawnEnemiesOfType<BeeComponent>(prefab, count, playerComponent, enemies);
+        break;
+    case EnemyId::butterfly:
+    case EnemyId::butterflyDiving:
+        SpawnEnemiesOfType<ButterflyComponent>(prefab, count, playerComponent, enemies);
+        break;
+    case EnemyId::bossGalaga:
+    case EnemyId::bossGalagaDiving:
+        SpawnEnemiesOfType<BossGalagaComponent>(prefab, count, playerComponent, enemies);
+        break;
+    }
+    return enemies;
 }
 
-std::unique_ptr<GameEngine::GameObject> InitBossGalaga(PlayerComponent* playerComponent)
+std::unique_ptr<GameEngine::GameObject> InitBee(PlayerComponent* playerComponent)
 {
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::enemy));
-    auto* spriteComponent = gameObject->AddComponent<GameEngine::SpriteComponent>("GalagaUpdated.png");
-    spriteComponent->m_SpriteInfo.m_Height = 16;
-    spriteComponent->m_SpriteInfo.m_Width = 16;
-    spriteComponent->m_SpriteInfo.m_Spacing = 2;
-    spriteComponent->m_SpriteInfo.m_StartPos.x = 1;
-    spriteComponent->m_SpriteInfo.m_StartPos.y = 91;
-    spriteComponent->m_SpriteInfo.m_NrOfCols = 5;
-    spriteComponent->m_SpriteInfo.m_NrOfRows = 2;
-    spriteComponent->m_SpriteInfo.m_CurrentCol = 0;
-    spriteComponent->m_SpriteInfo.m_TimeInterval = 0.8f;
-    spriteComponent->m_Scale = 2;
-    spriteComponent->UpdateSrcRect();
-    spriteComponent->m_IsActive = true;
+    return std::move(SpawnEnemies(EnemyId::bee, 1, playerComponent).front());
+}
 
-    gameObject->AddComponent<BossGalagaComponent>(spriteComponent, playerComponent);
-    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect);
+std::unique_ptr<GameEngine::GameObject> InitButterfly(PlayerComponent* playerComponent)
+{
+    return std::move(SpawnEnemies(EnemyId::butterfly, 1, playerComponent).front());
+}
 
-    return gameObject;
+std::unique_ptr<GameEngine::GameObject> InitBossGalaga(PlayerComponent* playerComponent)
+{
+    return std::move(SpawnEnemies(EnemyId::bossGalaga, 1, playerComponent).front());
 }
 std::unique_ptr<GameEngine::GameObject> InitBossBeam(EnemyComponent* parentComp)
 {
@@ -188,35 +230,39 @@ std::unique_ptr<GameEngine::GameObject> InitBossBeam(EnemyComponent* parentComp)
     spriteComponent->m_Scale = 2;
     spriteComponent->UpdateSrcRect();
     spriteComponent->m_IsActive = true;
-    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect);
+    gameObject->AddComponent<GameEngine::CollisionComponent>(spriteComponent->m_DestRect)->UseSpriteMask(spriteComponent);
     gameObject->AddComponent<BeamComponent>(spriteComponent, parentComp);
     return gameObject;
 }
-std::unique_ptr<GameEngine::GameObject> InitExplosion(GameEngine::GameObject* parentObj)
+void InitStarfield(GameEngine::ParticleSystem* particleSystem)
 {
-    auto gameObject = std::make_unique<GameEngine::GameObject>(static_cast<int>(GameId::misc));
-    auto* spriteComponent = gameObject->AddComponent<GameEngine::SpriteComponent>("GalagaUpdated.png");
-    spriteComponent->m_SpriteInfo.m_Height = 32;
-    spriteComponent->m_SpriteInfo.m_Width = 32;
-    spriteComponent->m_SpriteInfo.m_Spacing = 2;
-    spriteComponent->m_SpriteInfo.m_StartPos.x = 91;
-    spriteComponent->m_SpriteInfo.m_StartPos.y = 19;
-    spriteComponent->m_SpriteInfo.m_NrOfCols = 5;
-    spriteComponent->m_SpriteInfo.m_NrOfRows = 1;
-    spriteComponent->m_SpriteInfo.m_CurrentCol = 0;
-    spriteComponent->m_SpriteInfo.m_TimeInterval = 0.05f;
-    spriteComponent->m_Scale = 2;
-    spriteComponent->UpdateSrcRect();
-    spriteComponent->m_IsActive = true;
-    gameObject->AddComponent<ExplosionComponent>(spriteComponent);
-
-    //calculate the center of the parent object
-    const auto parentRect = parentObj->GetComponent<GameEngine::SpriteComponent>()->m_DestRect;
-    const auto centerParent = glm::vec2{ parentRect.x + parentRect.w / 2, parentRect.y + parentRect.h / 2 };
-    const auto explosionPos = glm::vec2{ centerParent.x - spriteComponent->m_DestRect.w / 2,
-        centerParent.y - spriteComponent->m_DestRect.h / 2 };
-    
-    gameObject->SetPosition({explosionPos,0});
-    
-    return gameObject;
+    struct StarLayer
+    {
+        float speed;
+        float size;
+        SDL_Color color;
+        int nrOfStars;
+    };
+    //the nearer a layer, the faster and brighter it scrolls past
+    constexpr StarLayer starLayers[]{
+        { 150.f, 2.f, { 90, 110, 220, 255 }, 70 },
+        { 320.f, 2.f, { 220, 220, 255, 255 }, 45 },
+        { 650.f, 3.f, { 255, 230, 140, 255 }, 25 }
+    };
+    for (const auto& layer : starLayers)
+    {
+        GameEngine::EmitterSettings stars{};
+        stars.size = { layer.size, layer.size };
+        //the lifetime is the twinkle period of a star
+        stars.minLifeTime = 0.6f;
+        stars.maxLifeTime = 1.6f;
+        stars.minSpeed = stars.maxSpeed = layer.speed;
+        stars.minAngle = stars.maxAngle = 90.f;
+        stars.color = layer.color;
+        stars.isFadingOut = true;
+        stars.isWrapping = true;
+        stars.bounds = { 0, 0, GameEngine::g_WindowRect.w, GameEngine::g_WindowRect.h };
+        stars.layer = GameEngine::ParticleLayer::background;
+        particleSystem->Fill(particleSystem->AddEmitter(stars), layer.nrOfStars);
+    }
 }
@@ -1,10 +1,38 @@
 ﻿#pragma once
 #include <memory>
+#include <vector>
+#include <SDL_rect.h>
+
+#include "Components/SpriteComponent.h"
 #include "Subjects/GameObject.h"
 
+namespace GameEngine
+{
+    class ParticleSystem;
+}
 class PlayerComponent;
 class EnemyComponent;
 class BossGalagaComponent;
+enum class EnemyId;
+
+//Immutable data shared by every enemy of one type, built once on first use
+struct EnemyPrefab
+{
+    GameEngine::Texture2D* texture{};
+    GameEngine::SpriteInfo spriteInfo{};
+    float scale{};
+    SDL_Rect srcRect{};
+    SDL_Rect destRect{};
+    SDL_Rect collisionRect{};
+    int score{};
+    int divingScore{};
+};
+
+//Diving ids share the prefab of their enemy type
+[[nodiscard]] const EnemyPrefab& GetEnemyPrefab(EnemyId enemyId);
+
+//Spawns count enemies of one type, their components are allocated from contiguous pool blocks
+std::vector<std::unique_ptr<GameEngine::GameObject>> SpawnEnemies(EnemyId enemyId, size_t count, PlayerComponent* playerComponent);
 
 std::unique_ptr<GameEngine::GameObject> InitFighter();
 
@@ -22,4 +50,5 @@ std::unique_ptr<GameEngine::GameObject> InitBossGalaga(PlayerComponent* playerCo
 
 std::unique_ptr<GameEngine::GameObject> InitBossBeam(EnemyComponent* parentComp);
 
-std::unique_ptr<GameEngine::GameObject> InitExplosion(GameEngine::GameObject* parentObj);
+//Parallax star layers that scroll down and twinkle, drawn behind the scene's objects
+void InitStarfield(GameEngine::ParticleSystem* particleSystem);
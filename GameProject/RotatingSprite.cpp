@@ -1,43 +1,177 @@
 ﻿#include "RotatingSprite.h"
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 #include <glm/trigonometric.hpp>
 #include <glm/ext/scalar_constants.hpp>
 
+#include "Snapshot.h"
 #include "Components/SpriteComponent.h"
+#include "Trajectory Logic/Trajectory.h"
+#include "Trajectory Logic/TrajectoryBatch.h"
 
+RotatingSprite::RotationQueue RotatingSprite::m_Queue{};
 
 RotatingSprite::RotatingSprite(GameEngine::SpriteComponent* spriteComponent):
 m_SpriteComponent(spriteComponent),
 m_InitXPos{ spriteComponent->m_SpriteInfo.m_StartPos.x },
-m_NrOfRotationStages((spriteComponent->m_SpriteInfo.m_NrOfCols - 1) * 4)
+m_NrOfRotationStages((spriteComponent->m_SpriteInfo.m_NrOfCols - 1) * 4),
+m_Tables(&GetRotationTables(spriteComponent->m_SpriteInfo.m_NrOfCols))
 {
-    InitColFlipPairs(spriteComponent->m_SpriteInfo.m_NrOfCols);
     spriteComponent->m_SpriteInfo.m_NrOfCols = 1;
 }
-void RotatingSprite::RotateSpriteInDirection(const glm::vec2& direction) const
+RotatingSprite::~RotatingSprite()
 {
-    //calculate rotation angle based on the direction
-    float rotationAngle = -(glm::atan(-direction.y, direction.x) - glm::pi<float>() / 2);
-    //convert angle between 0 and 2*pi
-    if (rotationAngle < 0) rotationAngle += glm::pi<float>() * 2;
-    auto rotationStage = static_cast<int>(rotationAngle / (glm::pi<float>() * 2) * m_NrOfRotationStages);
-    UpdateSprite(rotationStage);
+    if (m_QueueIndex == -1) return;
+    //the last queued sprite takes this one's place, so a stage teardown doesn't shift the queue per sprite
+    RotatingSprite* lastSprite = m_Queue.sprites.back();
+    m_Queue.sprites[m_QueueIndex] = lastSprite;
+    m_Queue.dirX[m_QueueIndex] = m_Queue.dirX.back();
+    m_Queue.dirY[m_QueueIndex] = m_Queue.dirY.back();
+    m_Queue.lanes[m_QueueIndex] = m_Queue.lanes.back();
+    lastSprite->m_QueueIndex = m_QueueIndex;
+    m_Queue.sprites.pop_back();
+    m_Queue.dirX.pop_back();
+    m_Queue.dirY.pop_back();
+    m_Queue.lanes.pop_back();
 }
-void RotatingSprite::UpdateSprite(int rotationStage) const
+void RotatingSprite::RotateSpriteInDirection(const glm::vec2& direction)
 {
-    const auto rotationInfo = GetColFlipPair(rotationStage);
-    m_SpriteComponent->m_SpriteInfo.m_StartPos.x = rotationInfo.first * (m_SpriteComponent->m_SpriteInfo.m_Width
+    ApplyDirectionBucket(QuantiseDirection(direction.x, direction.y));
+}
+void RotatingSprite::QueueRotation(const glm::vec2& direction)
+{
+    Queue(direction, -1);
+}
+void RotatingSprite::QueueRotation(const Trajectory& trajectory)
+{
+    Queue(trajectory.GetDirection(), trajectory.GetLane());
+}
+void RotatingSprite::Queue(const glm::vec2& direction, int lane)
+{
+    if (m_QueueIndex != -1)
+    {
+        //only the latest direction of this frame matters
+        m_Queue.dirX[m_QueueIndex] = direction.x;
+        m_Queue.dirY[m_QueueIndex] = direction.y;
+        m_Queue.lanes[m_QueueIndex] = lane;
+        return;
+    }
+    m_QueueIndex = static_cast<int>(m_Queue.sprites.size());
+    m_Queue.sprites.emplace_back(this);
+    m_Queue.dirX.emplace_back(direction.x);
+    m_Queue.dirY.emplace_back(direction.y);
+    m_Queue.lanes.emplace_back(lane);
+}
+void RotatingSprite::UpdateSprite(int rotationStage)
+{
+    if (rotationStage == m_RotationStage) return;
+    m_RotationStage = rotationStage;
+    const auto& [col, flipMode] = m_Tables->colFlipPairs[rotationStage];
+    m_SpriteComponent->m_SpriteInfo.m_StartPos.x = col * (m_SpriteComponent->m_SpriteInfo.m_Width
         + m_SpriteComponent->m_SpriteInfo.m_Spacing) + m_InitXPos;
-    m_SpriteComponent->SetFlipMode(rotationInfo.second);
+    m_SpriteComponent->SetFlipMode(flipMode);
     m_SpriteComponent->UpdateSrcRect();
 }
+void RotatingSprite::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_RotationStage);
+}
+void RotatingSprite::LoadState(GameEngine::Snapshot& snapshot)
+{
+    snapshot.Read(m_RotationStage);
+}
+void RotatingSprite::ApplyDirectionBucket(int bucket)
+{
+    //a zero direction keeps the current rotation
+    if (bucket < 0) return;
+    UpdateSprite(m_Tables->stageByDirection[bucket]);
+}
+
+void RotatingSprite::ResolveQueuedRotations()
+{
+    const size_t nrOfSprites = m_Queue.sprites.size();
+    if (nrOfSprites == 0) return;
+
+    //the batch has stepped by now, so lanes hold this frame's direction
+    for (size_t i = 0; i < nrOfSprites; ++i)
+    {
+        if (m_Queue.lanes[i] == -1) continue;
+        const glm::vec2 direction = TrajectoryBatch::GetDirection(m_Queue.lanes[i]);
+        m_Queue.dirX[i] = direction.x;
+        m_Queue.dirY[i] = direction.y;
+    }
+    //quantise every direction first so the lookups below only touch the tables
+    m_Queue.buckets.resize(nrOfSprites);
+    for (size_t i = 0; i < nrOfSprites; ++i)
+        m_Queue.buckets[i] = QuantiseDirection(m_Queue.dirX[i], m_Queue.dirY[i]);
+
+    for (size_t i = 0; i < nrOfSprites; ++i)
+    {
+        m_Queue.sprites[i]->m_QueueIndex = -1;
+        m_Queue.sprites[i]->ApplyDirectionBucket(m_Queue.buckets[i]);
+    }
+    m_Queue.sprites.clear();
+    m_Queue.dirX.clear();
+    m_Queue.dirY.clear();
+    m_Queue.lanes.clear();
+}
+int RotatingSprite::QuantiseDirection(float dirX, float dirY)
+{
+    //"diamond angle": grows monotonically with the real angle, 0..4 going from +x towards +y
+    const float absSum = std::abs(dirX) + std::abs(dirY);
+    if (absSum == 0.f) return -1;
+    const float x = dirX / absSum;
+    const float y = dirY / absSum;
+    float diamondAngle;
+    if (y >= 0.f) diamondAngle = x >= 0.f ? y : 1.f - x;
+    else diamondAngle = x < 0.f ? 2.f - y : 3.f + x;
+    const int bucket = static_cast<int>(diamondAngle * (g_NrOfDirectionBuckets / 4));
+    return std::min(bucket, g_NrOfDirectionBuckets - 1);
+}
 
-void RotatingSprite::InitColFlipPairs(int nrOfCols)
+const RotatingSprite::ColFlipTable& RotatingSprite::GetColFlipTable(int nrOfCols)
+{
+    return GetRotationTables(nrOfCols).colFlipPairs;
+}
+const RotatingSprite::RotationTables& RotatingSprite::GetRotationTables(int nrOfCols)
+{
+    static std::unordered_map<int, RotationTables> rotationTables;
+    auto it = rotationTables.find(nrOfCols);
+    if (it == rotationTables.end())
+        it = rotationTables.emplace(nrOfCols,
+            RotationTables{ InitColFlipPairs(nrOfCols), InitStageByDirection((nrOfCols - 1) * 4) }).first;
+    return it->second;
+}
+std::vector<int> RotatingSprite::InitStageByDirection(int nrOfRotationStages)
+{
+    std::vector<int> stageByDirection(g_NrOfDirectionBuckets);
+    for (int bucket = 0; bucket < g_NrOfDirectionBuckets; ++bucket)
+    {
+        //direction through the middle of the bucket, inverting QuantiseDirection
+        const float diamondAngle = (static_cast<float>(bucket) + 0.5f) / (g_NrOfDirectionBuckets / 4);
+        glm::vec2 direction;
+        if (diamondAngle < 1.f) direction = { 1.f - diamondAngle, diamondAngle };
+        else if (diamondAngle < 2.f) direction = { 1.f - diamondAngle, 2.f - diamondAngle };
+        else if (diamondAngle < 3.f) direction = { diamondAngle - 3.f, 2.f - diamondAngle };
+        else direction = { diamondAngle - 3.f, diamondAngle - 4.f };
+
+        //rotation angle measured clockwise from the sprite facing up
+        float rotationAngle = -(glm::atan(-direction.y, direction.x) - glm::pi<float>() / 2);
+        if (rotationAngle < 0) rotationAngle += glm::pi<float>() * 2;
+        const auto rotationStage = static_cast<int>(rotationAngle / (glm::pi<float>() * 2) * nrOfRotationStages);
+        stageByDirection[bucket] = std::min(rotationStage, nrOfRotationStages - 1);
+    }
+    return stageByDirection;
+}
+RotatingSprite::ColFlipTable RotatingSprite::InitColFlipPairs(int nrOfCols)
 {
+    ColFlipTable colFlipPairs;
     bool isColIncreasing = true;
     int col = 0;
     SDL_RendererFlip flipMode = SDL_FLIP_NONE;
-    m_ColFlipPairs.emplace_back(col, SDL_FLIP_NONE);
+    colFlipPairs.emplace_back(col, SDL_FLIP_NONE);
 
     for (int i = 1; i < (nrOfCols - 1) * 4; ++i)
     {
@@ -53,6 +187,7 @@ void RotatingSprite::InitColFlipPairs(int nrOfCols)
             isColIncreasing = true;
             flipMode = flipMode == SDL_FLIP_HORIZONTAL ? SDL_FLIP_NONE : static_cast<SDL_RendererFlip>(SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL);
         }
-        m_ColFlipPairs.emplace_back(col, flipMode);
+        colFlipPairs.emplace_back(col, flipMode);
     }
+    return colFlipPairs;
 }
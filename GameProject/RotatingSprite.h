@@ -7,26 +7,68 @@
 namespace GameEngine
 {
     class SpriteComponent;
+    class Snapshot;
 }
+class Trajectory;
 class RotatingSprite final
 {
 public:
+    using ColFlipPair = std::pair<int, SDL_RendererFlip>;
+    using ColFlipTable = std::vector<ColFlipPair>;
+    //Resolution of the direction -> rotation stage lookup
+    static constexpr int g_NrOfDirectionBuckets{ 1024 };
+
     explicit RotatingSprite(GameEngine::SpriteComponent* spriteComponent);
 
     RotatingSprite(const RotatingSprite& other) = delete;
     RotatingSprite(RotatingSprite&& other) noexcept = delete;
     RotatingSprite& operator=(const RotatingSprite& other) = delete;
     RotatingSprite& operator=(RotatingSprite&& other) noexcept = delete;
-    ~RotatingSprite() = default;
+    ~RotatingSprite();
 
     int GetNrOfRotationStages() const { return m_NrOfRotationStages; }
-    void RotateSpriteInDirection(const glm::vec2& direction) const;
-    void UpdateSprite(int rotationStage) const;
+    void RotateSpriteInDirection(const glm::vec2& direction);
+    //The rotation is applied by the next ResolveQueuedRotations, together with the other queued sprites
+    void QueueRotation(const glm::vec2& direction);
+    //Takes the direction the trajectory's lane has after this frame's batch step
+    void QueueRotation(const Trajectory& trajectory);
+    void UpdateSprite(int rotationStage);
+    //Only the cached stage, the sprite rects themselves belong to the SpriteComponent's state
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    void LoadState(GameEngine::Snapshot& snapshot);
+
+    static void ResolveQueuedRotations();
+    //Tables only depend on the nr of columns of the sprite sheet, so they are built once and shared
+    [[nodiscard]] static const ColFlipTable& GetColFlipTable(int nrOfCols);
+    //Maps a direction to a bucket without any trig, returns -1 for the zero vector
+    [[nodiscard]] static int QuantiseDirection(float dirX, float dirY);
 private:
-    std::pair<int,SDL_RendererFlip> GetColFlipPair(int index) const { return m_ColFlipPairs[index]; }
+    struct RotationTables
+    {
+        ColFlipTable colFlipPairs;
+        std::vector<int> stageByDirection;
+    };
+    [[nodiscard]] static const RotationTables& GetRotationTables(int nrOfCols);
+    static ColFlipTable InitColFlipPairs(int nrOfCols);
+    static std::vector<int> InitStageByDirection(int nrOfRotationStages);
+    void ApplyDirectionBucket(int bucket);
+
     GameEngine::SpriteComponent* m_SpriteComponent;
     int m_InitXPos{};
     int m_NrOfRotationStages;
-    void InitColFlipPairs(int nrOfCols);
-    std::vector<std::pair<int,SDL_RendererFlip>> m_ColFlipPairs;
+    int m_RotationStage{ -1 };
+    //where the sprite is in the rotation queue, -1 while it isn't queued
+    int m_QueueIndex{ -1 };
+    const RotationTables* m_Tables;
+
+    struct RotationQueue
+    {
+        std::vector<RotatingSprite*> sprites;
+        std::vector<float> dirX, dirY;
+        //the batch lane to read the direction from, -1 to use dirX/dirY
+        std::vector<int> lanes;
+        std::vector<int> buckets;
+    };
+    void Queue(const glm::vec2& direction, int lane);
+    static RotationQueue m_Queue;
 };
@@ -0,0 +1,143 @@
+﻿#include "SceneTypes.h"
+
+#include <stdexcept>
+
+#include "DataStructs.h"
+#include "GameCommands.h"
+#include "SceneBlob.h"
+#include "Components/TextComponent.h"
+#include "Components/TextureComponent.h"
+#include "Game components/FormationComponent.h"
+#include "Game components/LevelStateComponent.h"
+#include "Game components/ModeSelectionComp.h"
+#include "Game components/NameSelectionComp.h"
+#include "Game components/ScoreComponent.h"
+#include "Game components/SoakStatsComponent.h"
+#include "Game components/SpriteRotationComponent.h"
+#include "Game observers/BulletObserver.h"
+#include "Game observers/EnemyAIManager.h"
+#include "Game observers/EnemyAttacksObserver.h"
+#include "Game observers/EnemyObserver.h"
+#include "Game observers/ExplosionObserver.h"
+#include "Game observers/FighterObserver.h"
+#include "Game observers/FormationObserver.h"
+#include "Subjects/GameObject.h"
+#include "Trajectory Logic/TrajectoryBatch.h"
+
+namespace
+{
+    GameMode ParseGameMode(std::string_view mode)
+    {
+        if (mode == "singlePlayer") return GameMode::singlePlayer;
+        if (mode == "coop") return GameMode::coop;
+        if (mode == "versus") return GameMode::versus;
+        throw std::runtime_error("Unknown game mode: " + std::string(mode));
+    }
+
+    template<GameEngine::ComponentType T>
+    void RegisterComponent(GameEngine::SceneTypeRegistry& registry, const std::string& name)
+    {
+        registry.RegisterComponent(name, [](GameEngine::GameObject& gameObject, const GameEngine::SceneArgs&) {
+            gameObject.AddComponent<T>();
+        });
+    }
+    template<typename T>
+    void RegisterCommand(GameEngine::SceneTypeRegistry& registry, const std::string& name)
+    {
+        registry.RegisterCommand(name, [](GameEngine::GameObject* target, const GameEngine::SceneArgs&) {
+            return std::make_unique<T>(target);
+        });
+    }
+    //Observers whose only constructor argument is the scene they spawn objects in
+    template<typename T>
+    void RegisterSceneObserver(GameEngine::SceneTypeRegistry& registry, const std::string& name, void (T::*observe)(GameEngine::GameObject*))
+    {
+        registry.RegisterObserver<T>(name, [](GameEngine::Scene& scene, const GameEngine::SceneArgs&) {
+            return std::make_unique<T>(&scene);
+        }, observe);
+    }
+    template<typename T>
+    void RegisterObserver(GameEngine::SceneTypeRegistry& registry, const std::string& name, void (T::*observe)(GameEngine::GameObject*))
+    {
+        registry.RegisterObserver<T>(name, [](GameEngine::Scene&, const GameEngine::SceneArgs&) {
+            return std::make_unique<T>();
+        }, observe);
+    }
+}
+
+void RegisterSceneTypes(GameEngine::SceneTypeRegistry& registry)
+{
+    registry.RegisterObjectId("enemy", static_cast<int>(GameId::enemy));
+    registry.RegisterObjectId("player", static_cast<int>(GameId::player));
+    registry.RegisterObjectId("bullet", static_cast<int>(GameId::bullet));
+    registry.RegisterObjectId("capturedFighter", static_cast<int>(GameId::capturedFighter));
+    registry.RegisterObjectId("enemyBullet", static_cast<int>(GameId::enemyBullet));
+    registry.RegisterObjectId("bossBeam", static_cast<int>(GameId::bossBeam));
+    registry.RegisterObjectId("observer", static_cast<int>(GameId::observer));
+    registry.RegisterObjectId("text", static_cast<int>(GameId::text));
+    registry.RegisterObjectId("texture", static_cast<int>(GameId::texture));
+    registry.RegisterObjectId("misc", static_cast<int>(GameId::misc));
+
+    //------ENGINE COMPONENTS------
+    //[texture]
+    registry.RegisterComponent("texture", [](GameEngine::GameObject& gameObject, const GameEngine::SceneArgs& args) {
+        if (args.GetSize() == 0) gameObject.AddComponent<GameEngine::TextureComponent>();
+        else gameObject.AddComponent<GameEngine::TextureComponent>(args.GetTexture(0));
+    });
+    //font, [text], [color]
+    registry.RegisterComponent("text", [](GameEngine::GameObject& gameObject, const GameEngine::SceneArgs& args) {
+        const std::string text{ args.GetSize() > 1 ? args.GetString(1) : std::string_view{} };
+        const SDL_Color color = args.GetSize() > 2 ? args.GetColor(2) : SDL_Color{ 255,255,255,255 };
+        gameObject.AddComponent<GameEngine::TextComponent>(args.GetFont(0), text, color);
+    });
+
+    //------GAME COMPONENTS------
+    //shows the player score in the text component of its object
+    registry.RegisterComponent("score", [](GameEngine::GameObject& gameObject, const GameEngine::SceneArgs&) {
+        gameObject.AddComponent<ScoreComponent>(gameObject.GetComponent<GameEngine::TextComponent>());
+    });
+    RegisterComponent<ModeSelectionComp>(registry, "modeSelection");
+    //selector object, game mode; adds the text of its object to the selector's options
+    registry.RegisterComponent("modeOption", [](GameEngine::GameObject& gameObject, const GameEngine::SceneArgs& args) {
+        args.GetObject(0)->GetComponent<ModeSelectionComp>()->AddTextComponent(
+            gameObject.GetComponent<GameEngine::TextComponent>(), ParseGameMode(args.GetString(1)));
+    });
+    RegisterComponent<NameSelectionComp>(registry, "nameSelection");
+    //selector object; adds the text of its object as the next letter of the name
+    registry.RegisterComponent("nameLetter", [](GameEngine::GameObject& gameObject, const GameEngine::SceneArgs& args) {
+        args.GetObject(0)->GetComponent<NameSelectionComp>()->AddTextComponent(gameObject.GetComponent<GameEngine::TextComponent>());
+    });
+    RegisterComponent<LevelStateComponent>(registry, "levelState");
+    RegisterComponent<TrajectoryBatch>(registry, "trajectoryBatch");
+    RegisterComponent<EnemyAIManager>(registry, "enemyAI");
+    RegisterComponent<FormationComponent>(registry, "formation");
+    RegisterComponent<SpriteRotationComponent>(registry, "spriteRotation");
+    RegisterComponent<SoakStatsComponent>(registry, "soakStats");
+
+    //------OBSERVERS------
+    RegisterSceneObserver<ExplosionObserver>(registry, "explosion", &ExplosionObserver::Observe);
+    RegisterSceneObserver<BulletObserver>(registry, "bullet", &BulletObserver::ObserveFighter);
+    RegisterSceneObserver<EnemyAttacksObserver>(registry, "enemyAttacks", &EnemyAttacksObserver::ObserveEnemy);
+    RegisterObserver<FighterObserver>(registry, "fighter", &FighterObserver::Observe);
+    RegisterObserver<EnemyObserver>(registry, "enemy", &EnemyObserver::Observe);
+    RegisterObserver<FormationObserver>(registry, "formation", &FormationObserver::Observe);
+
+    //------COMMANDS------
+    RegisterCommand<MuteCommand>(registry, "mute");
+    RegisterCommand<SelectModeCommand>(registry, "selectMode");
+    RegisterCommand<SelectNameCommand>(registry, "selectName");
+    RegisterCommand<LoadChooseNameCommand>(registry, "loadChooseName");
+    RegisterCommand<SkipLevelCommand>(registry, "skipLevel");
+    RegisterCommand<LoadStressLevelCommand>(registry, "loadStressLevel");
+    RegisterCommand<ShootBulletCommand>(registry, "shootBullet");
+    RegisterCommand<ShootBeamCommand>(registry, "shootBeam");
+    RegisterCommand<BombingRunCommand>(registry, "bombingRun");
+    //moving up
+    registry.RegisterCommand("switchModes", [](GameEngine::GameObject* target, const GameEngine::SceneArgs& args) {
+        return std::make_unique<SwitchModesCommand>(target, args.GetBool(0));
+    });
+    //moving up
+    registry.RegisterCommand("switchName", [](GameEngine::GameObject* target, const GameEngine::SceneArgs& args) {
+        return std::make_unique<SwitchNameCommand>(target, args.GetBool(0));
+    });
+}
@@ -0,0 +1,9 @@
+﻿#pragma once
+
+namespace GameEngine
+{
+    class SceneTypeRegistry;
+}
+
+//Registers the object ids, components, observers and commands the scene files in Data/Scenes can use
+void RegisterSceneTypes(GameEngine::SceneTypeRegistry& registry);
@@ -0,0 +1,137 @@
+﻿#include "CompiledPath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include "Snapshot.h"
+
+CompiledPath::CompiledPath(std::span<const PathData> pathData, const glm::vec2& startPos, float mirrorAxisX)
+{
+    Rebuild(pathData, startPos, mirrorAxisX);
+    BuildSegmentLookup();
+}
+
+void CompiledPath::Rebuild(std::span<const PathData> pathData, const glm::vec2& startPos, float mirrorAxisX)
+{
+    m_Segments.clear();
+    m_Segments.reserve(pathData.size());
+    m_SegmentLookup.clear();
+    m_Length = 0.f;
+    m_MirrorAxisX = mirrorAxisX;
+    m_EndsAtFormationSlot = false;
+    m_StartPosition = startPos;
+    m_EndPosition = startPos;
+    for (size_t i = 0; i < pathData.size(); ++i) AddPathData(pathData[i], i + 1 == pathData.size());
+}
+void CompiledPath::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(static_cast<uint32_t>(m_Segments.size()));
+    snapshot.WriteArray(m_Segments.data(), m_Segments.size());
+    snapshot.Write(m_Length);
+    snapshot.Write(m_MirrorAxisX);
+    snapshot.Write(m_EndsAtFormationSlot);
+    snapshot.Write(m_StartPosition);
+    snapshot.Write(m_EndPosition);
+}
+void CompiledPath::LoadState(GameEngine::Snapshot& snapshot)
+{
+    m_Segments.resize(snapshot.Read<uint32_t>());
+    snapshot.ReadArray(m_Segments.data(), m_Segments.size());
+    snapshot.Read(m_Length);
+    snapshot.Read(m_MirrorAxisX);
+    snapshot.Read(m_EndsAtFormationSlot);
+    snapshot.Read(m_StartPosition);
+    snapshot.Read(m_EndPosition);
+    m_SegmentLookup.clear();
+}
+
+int CompiledPath::GetSegmentIndex(float distance) const
+{
+    if (distance <= 0.f) return 0;
+    if (distance >= m_Length) return static_cast<int>(m_Segments.size()) - 1;
+    //rebuilt paths have no lookup, they are short enough to scan from their first segment
+    int index = m_SegmentLookup.empty() ? 0 : m_SegmentLookup[static_cast<size_t>(distance / m_LookupStep)];
+    //segments shorter than the lookup step can share a bucket
+    while (index + 1 < static_cast<int>(m_Segments.size())
+        && distance >= m_Segments[index].startDistance + m_Segments[index].length) ++index;
+    return index;
+}
+PathSegment CompiledPath::GetSegment(int index, bool isMirrored) const
+{
+    PathSegment segment = m_Segments[index];
+    if (!isMirrored) return segment;
+    segment.origin = Mirror(segment.origin, true);
+    segment.direction.x = -segment.direction.x;
+    segment.startAngle = glm::pi<float>() - segment.startAngle;
+    segment.rotationSign = -segment.rotationSign;
+    return segment;
+}
+
+void CompiledPath::AddPathData(const PathData& pathData, bool isLast)
+{
+    if (pathData.isRotating)
+    {
+        AddArc(pathData.centerOfRotation, pathData.isRotatingClockwise, pathData.totalRotationAngle);
+        return;
+    }
+    if (pathData.destination == g_FormationSlotDestination)
+    {
+        if (!isLast) throw std::runtime_error("The formation position has to be the last destination of a trajectory");
+        m_EndsAtFormationSlot = true;
+        return;
+    }
+    AddLine(pathData.destination);
+}
+void CompiledPath::AddLine(const glm::vec2& destination)
+{
+    const float length = glm::distance(m_EndPosition, destination);
+    if (length <= 0.f) return;
+    PathSegment segment{};
+    segment.origin = m_EndPosition;
+    segment.direction = (destination - m_EndPosition) / length;
+    segment.startDistance = m_Length;
+    segment.length = length;
+    m_Segments.emplace_back(segment);
+    m_Length += length;
+    m_EndPosition = destination;
+}
+void CompiledPath::AddArc(const glm::vec2& center, bool isClockwise, float totalAngle)
+{
+    const glm::vec2 offset = m_EndPosition - center;
+    const float radius = glm::length(offset);
+    if (radius <= 0.f || totalAngle <= 0.f) return;
+    PathSegment segment{};
+    segment.isArc = true;
+    segment.origin = center;
+    segment.radius = radius;
+    segment.startAngle = std::atan2(offset.y, offset.x);
+    segment.rotationSign = isClockwise ? 1.f : -1.f;
+    segment.startDistance = m_Length;
+    segment.length = radius * totalAngle;
+    const float endAngle = segment.startAngle + segment.rotationSign * totalAngle;
+    segment.direction = segment.rotationSign * glm::vec2{ -std::sin(segment.startAngle), std::cos(segment.startAngle) };
+    m_Segments.emplace_back(segment);
+    m_Length += segment.length;
+    m_EndPosition = center + radius * glm::vec2{ std::cos(endAngle), std::sin(endAngle) };
+}
+glm::vec2 CompiledPath::Mirror(const glm::vec2& pos, bool isMirrored) const
+{
+    if (!isMirrored) return pos;
+    return { m_MirrorAxisX - pos.x, pos.y };
+}
+void CompiledPath::BuildSegmentLookup()
+{
+    m_SegmentLookup.resize(static_cast<size_t>(m_Length / m_LookupStep) + 1);
+    int index = 0;
+    for (size_t bucket = 0; bucket < m_SegmentLookup.size(); ++bucket)
+    {
+        const float bucketStart = static_cast<float>(bucket) * m_LookupStep;
+        while (index + 1 < static_cast<int>(m_Segments.size())
+            && bucketStart >= m_Segments[index].startDistance + m_Segments[index].length) ++index;
+        m_SegmentLookup[bucket] = index;
+    }
+}
@@ -0,0 +1,74 @@
+﻿#pragma once
+#include <span>
+#include <vector>
+#include <glm/vec2.hpp>
+
+#include "PathDataStruct.h"
+
+namespace GameEngine
+{
+    class Snapshot;
+}
+
+//A path segment parameterised by arc length
+struct PathSegment
+{
+    bool isArc{ false };
+    //start point for lines, center of rotation for arcs
+    glm::vec2 origin{};
+    glm::vec2 direction{};
+    float radius{};
+    float startAngle{};
+    //+1 when rotating clockwise (on screen), -1 otherwise
+    float rotationSign{ 1.f };
+    float startDistance{};
+    float length{};
+};
+
+//Destination placeholder that gets replaced by each enemy's own formation position
+inline constexpr glm::vec2 g_FormationSlotDestination{ -1,-1 };
+
+//PathData compiled into arc-length parameterised segments, so a path can be evaluated
+//at any travelled distance in O(1) instead of being stepped frame by frame.
+//Compiled paths are immutable and can be shared by every enemy flying the same stage:
+//mirroring is applied when a segment is read and a final g_FormationSlotDestination
+//line is left to the reader, who knows its own formation position.
+class CompiledPath final
+{
+public:
+    CompiledPath() = default;
+    //mirrorAxisX: mirrored paths map x to mirrorAxisX - x
+    CompiledPath(std::span<const PathData> pathData, const glm::vec2& startPos, float mirrorAxisX = 0.f);
+
+    //Recompiles a path that is not shared in place. The segment storage is reused and no lookup is built,
+    //so re-targeting a path of at most as many segments does not allocate
+    void Rebuild(std::span<const PathData> pathData, const glm::vec2& startPos, float mirrorAxisX = 0.f);
+    //Paths owned by a single trajectory are stored by value, shared ones go through Snapshot::WriteShared
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    void LoadState(GameEngine::Snapshot& snapshot);
+
+    [[nodiscard]] bool IsEmpty() const { return m_Segments.empty(); }
+    [[nodiscard]] bool EndsAtFormationSlot() const { return m_EndsAtFormationSlot; }
+    [[nodiscard]] int GetNrOfSegments() const { return static_cast<int>(m_Segments.size()); }
+    [[nodiscard]] float GetLength() const { return m_Length; }
+    [[nodiscard]] glm::vec2 GetStartPosition(bool isMirrored = false) const { return Mirror(m_StartPosition, isMirrored); }
+    [[nodiscard]] glm::vec2 GetEndPosition(bool isMirrored = false) const { return Mirror(m_EndPosition, isMirrored); }
+    [[nodiscard]] int GetSegmentIndex(float distance) const;
+    [[nodiscard]] PathSegment GetSegment(int index, bool isMirrored = false) const;
+private:
+    void AddPathData(const PathData& pathData, bool isLast);
+    void AddLine(const glm::vec2& destination);
+    void AddArc(const glm::vec2& center, bool isClockwise, float totalAngle);
+    void BuildSegmentLookup();
+    [[nodiscard]] glm::vec2 Mirror(const glm::vec2& pos, bool isMirrored) const;
+
+    std::vector<PathSegment> m_Segments;
+    //first segment overlapping each m_LookupStep long stretch of the path
+    std::vector<int> m_SegmentLookup;
+    float m_Length{};
+    float m_MirrorAxisX{};
+    bool m_EndsAtFormationSlot{ false };
+    glm::vec2 m_StartPosition{};
+    glm::vec2 m_EndPosition{};
+    static constexpr float m_LookupStep{ 16.f };
+};
@@ -5,6 +5,7 @@
 
 #include "Initializers.h"
 #include "Minigin.h"
+#include "CompiledPath.h"
 #include "PathDataStruct.h"
 #include "Game components/Enemy components/EnemyComponent.h"
 #include "Game observers/FormationObserver.h"
@@ -40,96 +41,135 @@ namespace Parser
         return pathDataQueue;
     }
 
-    inline std::vector<std::vector<PathData>> ParseTrajectoryVec(const std::string& trajectoryPath, std::vector<glm::vec2>& startPositions)
+    //mirrored stages are flipped around the center of the screen, sprites are drawn from their top left corner
+    inline float GetMirrorAxisX()
     {
-        std::vector<std::vector<PathData>> pathDataQueueVec;
-        std::ifstream trajectoryFileStream(trajectoryPath);
-        nlohmann::json trajectoryJsonData;
-        trajectoryFileStream >> trajectoryJsonData;
-        
-        FormationObserver::SetNrOfStages(static_cast<int>(trajectoryJsonData.size()));
-        for (const auto& element : trajectoryJsonData)
+        constexpr int spriteOffset = 16;
+        return static_cast<float>(GameEngine::g_WindowRect.w - spriteOffset);
+    }
+
+    //Compiles one element of a trajectory file, pathDataVec is scratch space reused between stages
+    inline std::shared_ptr<const CompiledPath> ParseStagePath(const nlohmann::json& element, std::vector<PathData>& pathDataVec)
+    {
+        const glm::vec2 startPos{ element["startPos"][0].get<float>(), element["startPos"][1].get<float>() };
+        const auto& trajectory = element["trajectory"];
+        pathDataVec.clear();
+        for (const auto& path : trajectory)
         {
-            startPositions.emplace_back(element["startPos"][0].get<float>(), element["startPos"][1].get<float>());
-            const auto trajectory = element["trajectory"];
-            std::vector<PathData> pathDataQueue;
-            for (const auto& path : trajectory)
+            PathData pathData{};
+            pathData.isRotating = path["isRotating"].get<bool>();
+            if (pathData.isRotating)
+            {
+                pathData.isRotatingClockwise = path["isRotatingClockwise"].get<bool>();
+                pathData.totalRotationAngle = path["totalRotationAngle"].get<float>();
+                pathData.centerOfRotation.x = path["centerOfRotation"][0].get<float>();
+                pathData.centerOfRotation.y = path["centerOfRotation"][1].get<float>();
+            }
+            else
             {
-                PathData pathData{};
-                pathData.isRotating = path["isRotating"].get<bool>();
-                if (pathData.isRotating)
+                if (path["destination"].is_string() && path["destination"].get<std::string>() == "formationPos")
                 {
-                    pathData.isRotatingClockwise = path["isRotatingClockwise"].get<bool>();
-                    pathData.totalRotationAngle = path["totalRotationAngle"].get<float>();
-                    pathData.centerOfRotation.x = path["centerOfRotation"][0].get<float>();
-                    pathData.centerOfRotation.y = path["centerOfRotation"][1].get<float>();
+                    pathData.destination = g_FormationSlotDestination;
                 }
                 else
                 {
-                    if (path["destination"].is_string() && path["destination"].get<std::string>() == "formationPos")
-                    {
-                        pathData.destination = { -1,-1 };
-                    }
-                    else
-                    {
-                        pathData.destination.x = path["destination"][0].get<float>();
-                        pathData.destination.y = path["destination"][1].get<float>();
-                    }
+                    pathData.destination.x = path["destination"][0].get<float>();
+                    pathData.destination.y = path["destination"][1].get<float>();
                 }
-                pathDataQueue.emplace_back(pathData);
             }
-            pathDataQueueVec.emplace_back(pathDataQueue);
+            pathDataVec.emplace_back(pathData);
         }
+        return std::make_shared<const CompiledPath>(pathDataVec, startPos, GetMirrorAxisX());
+    }
+
+    inline nlohmann::json ReadJson(const std::string& filePath)
+    {
+        std::ifstream fileStream(filePath);
+        if (!fileStream) throw std::runtime_error("Couldn't open " + filePath);
+        nlohmann::json jsonData;
+        fileStream >> jsonData;
+        return jsonData;
+    }
+
+    inline std::vector<std::shared_ptr<const CompiledPath>> ParseStagePaths(const std::string& trajectoryPath)
+    {
+        const nlohmann::json trajectoryJsonData = ReadJson(trajectoryPath);
+        
+        FormationObserver::SetNrOfStages(static_cast<int>(trajectoryJsonData.size()));
+        std::vector<std::shared_ptr<const CompiledPath>> stagePaths;
+        stagePaths.reserve(trajectoryJsonData.size());
+        std::vector<PathData> pathDataVec;
+        for (const auto& element : trajectoryJsonData) stagePaths.emplace_back(ParseStagePath(element, pathDataVec));
+
+        return stagePaths;
+    }
+
+    //One enemy of an enemy info file, in the order of the file
+    struct EnemySpawn
+    {
+        EnemyId enemyId;
+        glm::ivec2 formationPosition;
+        int stage;
+        int turn;
+        bool isXReversed;
+        bool operator==(const EnemySpawn& other) const = default;
+    };
+
+    inline std::vector<EnemySpawn> ParseEnemySpawns(const std::string& enemyInfoPath)
+    {
+        std::vector<EnemySpawn> spawns;
+        for (const auto& element : ReadJson(enemyInfoPath))
+        {
+            std::string enemyType = element["enemyType"];
+            EnemyId enemyId{};
+            if (enemyType == "Bee") enemyId = EnemyId::bee;
+            else if (enemyType == "Butterfly") enemyId = EnemyId::butterfly;
+            else if (enemyType == "BossGalaga") enemyId = EnemyId::bossGalaga;
+            else throw std::runtime_error("Unknown enemy type: " + enemyType);
 
-        return pathDataQueueVec;
+            for (const auto& posElem : element["positions"])
+            {
+                EnemySpawn spawn{};
+                spawn.enemyId = enemyId;
+                spawn.formationPosition = glm::ivec2{ glm::vec2{ posElem["formationPosition"][0].get<float>(),posElem["formationPosition"][1].get<float>() } };
+                spawn.stage = posElem["formationStage"];
+                spawn.turn = posElem["turn"];
+                spawn.isXReversed = posElem.contains("isXReversed") && posElem["isXReversed"].get<bool>();
+                spawns.emplace_back(spawn);
+            }
+        }
+        return spawns;
     }
 
     inline std::vector<std::unique_ptr<GameEngine::GameObject>> ParseEnemyInfoByStage(const std::string& enemyInfoPath,
         const std::string& trajectoryPath, PlayerComponent* playerComponent)
     {
-        std::vector<std::vector<PathData>> pathDataQueueVec;
-        std::vector<glm::vec2> startPositions;
-        pathDataQueueVec = ParseTrajectoryVec(trajectoryPath, startPositions);
+        const auto stagePaths = ParseStagePaths(trajectoryPath);
+        const auto spawns = ParseEnemySpawns(enemyInfoPath);
 
         std::vector<std::unique_ptr<GameEngine::GameObject>> enemyVec;
-        std::ifstream enemyFileStream(enemyInfoPath);
-        nlohmann::json enemyJsonData;
-        enemyFileStream >> enemyJsonData;
-
-        for (const auto& element : enemyJsonData)
+        enemyVec.reserve(spawns.size());
+        //enemies of a type are spawned together, the file lists them per type
+        for (size_t first = 0; first < spawns.size();)
         {
-            std::string enemyType = element["enemyType"];
-            const auto positions = element["positions"];
-            for (auto posElem : positions)
+            size_t last = first + 1;
+            while (last < spawns.size() && spawns[last].enemyId == spawns[first].enemyId) ++last;
+            auto enemies = SpawnEnemies(spawns[first].enemyId, last - first, playerComponent);
+            for (size_t i = first; i < last; ++i)
             {
-                std::unique_ptr<GameEngine::GameObject> enemy{};
-                glm::vec2 pos = { posElem["formationPosition"][0].get<float>(),posElem["formationPosition"][1].get<float>() };
-                int formationStage = posElem["formationStage"];
-                std::queue<PathData> pathDataQueue;
-                auto pathDataVec = pathDataQueueVec[formationStage];
-                for (auto path : pathDataVec)
-                {
-                    if (path.destination.x == -1 && path.destination.y == -1) path.destination = pos;
-                    else if (posElem.contains("isXReversed") && posElem["isXReversed"].get<bool>())
-                    {
-                        constexpr int spriteOffset = 16;
-                        path.destination.x = GameEngine::g_WindowRect.w - path.destination.x - spriteOffset;
-                        path.centerOfRotation.x = GameEngine::g_WindowRect.w - path.centerOfRotation.x - spriteOffset;
-                        path.isRotatingClockwise = !path.isRotatingClockwise;
-                    }
-                    pathDataQueue.push(path);
-                }
-                if (enemyType == "Bee") enemy = InitBee(playerComponent);
-                else if (enemyType == "Butterfly") enemy = InitButterfly(playerComponent);
-                else if (enemyType == "BossGalaga") enemy = InitBossGalaga(playerComponent);
-                enemy->SetPosition({ startPositions[formationStage],0 });
-                enemy->GetComponent<EnemyComponent>()->SetFormationPosition({ pos.x,pos.y });
-                enemy->GetComponent<EnemyComponent>()->SetFormationTrajectory(pathDataQueue);
-                int turn = posElem["turn"];
-                enemy->GetComponent<EnemyComponent>()->m_SetOutTurn = turn;
-                enemy->GetComponent<EnemyComponent>()->m_Stage = formationStage;
+                const EnemySpawn& spawn = spawns[i];
+                auto& enemy = enemies[i - first];
+                const auto& stagePath = stagePaths.at(spawn.stage);
+                auto enemyComponent = enemy->GetComponent<EnemyComponent>();
+                enemy->SetPosition({ stagePath->GetStartPosition(spawn.isXReversed),0 });
+                enemyComponent->SetFormationPosition(spawn.formationPosition);
+                enemyComponent->SetFormationTrajectory(stagePath, spawn.isXReversed);
+                enemyComponent->m_SetOutTurn = spawn.turn;
+                enemyComponent->m_Stage = spawn.stage;
+                enemyComponent->m_SpawnIndex = static_cast<int>(i);
                 enemyVec.emplace_back(std::move(enemy));
             }
+            first = last;
         }
         return enemyVec;
     }
@@ -0,0 +1,102 @@
+﻿#include "StageGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <json.hpp>
+#include <glm/ext/scalar_constants.hpp>
+
+#include "Minigin.h"
+
+namespace
+{
+    constexpr float g_SpriteSize{ 16.f };
+    constexpr float g_FormationTop{ 60.f };
+    constexpr float g_FormationBottom{ 400.f };
+
+    nlohmann::json GeneratePath(std::mt19937& random, int pathComplexity)
+    {
+        const auto windowWidth = static_cast<float>(GameEngine::g_WindowRect.w);
+        const auto windowHeight = static_cast<float>(GameEngine::g_WindowRect.h);
+        std::uniform_real_distribution<float> screenX{ 60.f, windowWidth - 60.f };
+        std::uniform_real_distribution<float> screenY{ 200.f, windowHeight - 120.f };
+        std::uniform_real_distribution<float> loopRadius{ 30.f, 70.f };
+        std::uniform_real_distribution<float> loopAngle{ glm::pi<float>() / 2, glm::pi<float>() * 2 };
+        std::bernoulli_distribution coinFlip{};
+
+        nlohmann::json path;
+        //enter from the top or from the bottom corners, like the handmade stages
+        if (coinFlip(random)) path["startPos"] = { screenX(random), -30.f };
+        else path["startPos"] = { coinFlip(random) ? -30.f : windowWidth + 30.f, windowHeight + 70.f };
+
+        nlohmann::json& trajectory = path["trajectory"];
+        for (int i = 0; i < pathComplexity; ++i)
+        {
+            const float x = screenX(random);
+            const float y = screenY(random);
+            trajectory.push_back({ { "isRotating", false }, { "destination", { x, y } } });
+
+            const float radius = loopRadius(random);
+            trajectory.push_back({
+                { "isRotating", true },
+                { "isRotatingClockwise", coinFlip(random) },
+                { "totalRotationAngle", loopAngle(random) },
+                { "centerOfRotation", { x, y + (coinFlip(random) ? radius : -radius) } } });
+        }
+        trajectory.push_back({ { "isRotating", false }, { "destination", "formationPos" } });
+        return path;
+    }
+}
+
+void StageGenerator::GenerateStage(const StressStageSettings& settings, const std::string& enemyInfoPath,
+    const std::string& trajectoryPath)
+{
+    std::mt19937 random{ settings.seed };
+    const int nrOfEnemies = std::max(settings.nrOfEnemies, 1);
+    const int nrOfStages = std::clamp(settings.nrOfStages, 1, nrOfEnemies);
+
+    nlohmann::json trajectories = nlohmann::json::array();
+    for (int stage = 0; stage < nrOfStages; ++stage)
+        trajectories.push_back(GeneratePath(random, settings.pathComplexity));
+    std::ofstream(trajectoryPath) << trajectories.dump(2);
+
+    //one formation slot per enemy on a grid filling the formation area, slots overlap once there are a lot of enemies
+    const float formationWidth = static_cast<float>(GameEngine::g_WindowRect.w) - g_SpriteSize * 4;
+    const float formationHeight = g_FormationBottom - g_FormationTop;
+    const int nrOfCols = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(nrOfEnemies) * formationWidth / formationHeight))));
+    const int nrOfRows = (nrOfEnemies + nrOfCols - 1) / nrOfCols;
+    const float spacingX = formationWidth / static_cast<float>(nrOfCols);
+    const float spacingY = formationHeight / static_cast<float>(nrOfRows);
+
+    //bosses on the top rows, then butterflies, then bees, like the handmade stages (1:3:6)
+    nlohmann::json bosses{ { "enemyType", "BossGalaga" }, { "positions", nlohmann::json::array() } };
+    nlohmann::json butterflies{ { "enemyType", "Butterfly" }, { "positions", nlohmann::json::array() } };
+    nlohmann::json bees{ { "enemyType", "Bee" }, { "positions", nlohmann::json::array() } };
+
+    const int enemiesPerStage = (nrOfEnemies + nrOfStages - 1) / nrOfStages;
+    //spreads each stage's set out over about 40 turns
+    const int enemiesPerTurn = std::max(1, enemiesPerStage / 40);
+    std::vector<int> slots(nrOfEnemies);
+    for (int i = 0; i < nrOfEnemies; ++i) slots[i] = i;
+    std::ranges::shuffle(slots, random);
+    std::bernoulli_distribution coinFlip{};
+
+    for (int enemy = 0; enemy < nrOfEnemies; ++enemy)
+    {
+        const int slot = slots[enemy];
+        const int stage = enemy / enemiesPerStage;
+        nlohmann::json position{
+            { "formationPosition", { g_SpriteSize * 2 + static_cast<float>(slot % nrOfCols) * spacingX,
+                g_FormationTop + static_cast<float>(slot / nrOfCols) * spacingY } },
+            { "formationStage", stage },
+            { "turn", (enemy % enemiesPerStage) / enemiesPerTurn },
+            { "isXReversed", coinFlip(random) } };
+
+        const float slotFraction = static_cast<float>(slot) / static_cast<float>(nrOfEnemies);
+        if (slotFraction < 0.1f) bosses["positions"].push_back(std::move(position));
+        else if (slotFraction < 0.4f) butterflies["positions"].push_back(std::move(position));
+        else bees["positions"].push_back(std::move(position));
+    }
+    std::ofstream(enemyInfoPath) << nlohmann::json::array({ bees, butterflies, bosses }).dump(2);
+}
@@ -0,0 +1,21 @@
+﻿#pragma once
+#include <string>
+
+//Settings of a synthetic stage, used to see how the game scales with the amount of enemies
+struct StressStageSettings
+{
+    int nrOfEnemies{ 1000 };
+    //groups of enemies that fly in one after the other
+    int nrOfStages{ 5 };
+    //nr of line + loop pairs every entry path has before heading to the formation
+    int pathComplexity{ 2 };
+    //enemies the AI keeps out of formation at once
+    int maxConcurrentDivers{ 50 };
+    unsigned int seed{ 0 };
+};
+
+namespace StageGenerator
+{
+    //Writes a stage in the same formats as EnemyInfoN.json and FormationTrajectoriesN.json
+    void GenerateStage(const StressStageSettings& settings, const std::string& enemyInfoPath, const std::string& trajectoryPath);
+}
@@ -1,38 +1,138 @@
 ﻿#include "Trajectory.h"
+#include <glm/geometric.hpp>
 
-std::pair<glm::vec2, bool> Trajectory::Update(float speed, const glm::vec2& currentPos)
+#include "TrajectoryBatch.h"
+#include "Managers/TimeManager.h"
+#include "Snapshot.h"
+#include "Subjects/GameObject.h"
+
+Trajectory::~Trajectory()
+{
+    ReleaseLane();
+}
+
+void Trajectory::Update(float speed, GameEngine::GameObject* gameObj)
 {
-    auto stateInfo = m_State->Update(m_PathData.front(), speed, currentPos);
-    if (stateInfo.second == false)
+    if (m_IsComplete) return;
+    m_Cursor.distance += speed * GameEngine::TimeManager::GetElapsed();
+    if (m_Cursor.distance >= m_Length)
     {
-        m_PathData.pop();
-        m_HasDirectionChanged = true;
-        if (m_PathData.empty())
-        {
-            m_Direction = { 0,1 };
-            m_IsComplete = true;
-            return { stateInfo.first,m_HasDirectionChanged };
-        }
-        UpdateState(currentPos);
+        const glm::vec2 endPos = m_pPath->EndsAtFormationSlot() ? m_FormationSlot : m_pPath->GetEndPosition(m_Cursor.isMirrored);
+        gameObj->SetPosition({ endPos,0 });
+        m_Direction = { 0,1 };
+        m_IsComplete = true;
+        ReleaseLane();
+        return;
     }
-    if(m_Direction != m_State->GetDirection())
+
+    //a long frame can skip over several segments at once
+    const int segment = m_Cursor.distance >= m_pPath->GetLength() ? m_pPath->GetNrOfSegments()
+                                                                   : m_pPath->GetSegmentIndex(m_Cursor.distance);
+    const PathSegment currentSegment = GetSegment(segment);
+    if (segment != m_Cursor.segment)
     {
-        m_Direction = m_State->GetDirection();
-        m_HasDirectionChanged = true;
+        m_Cursor.segment = segment;
+        TrajectoryBatch::LoadSegment(m_Lane, currentSegment);
     }
-    return { stateInfo.first,m_HasDirectionChanged };
- 
+    TrajectoryBatch::Submit(m_Lane, gameObj, m_Cursor.distance - currentSegment.startDistance);
+}
+glm::vec2 Trajectory::GetDirection() const
+{
+    return m_Lane != -1 ? TrajectoryBatch::GetDirection(m_Lane) : m_Direction;
 }
-void Trajectory::SetPathData(const std::queue<PathData>& pathData, const glm::vec2& currentPos)
+void Trajectory::SetPathData(std::span<const PathData> pathData, const glm::vec2& currentPos)
 {
-    m_PathData = pathData;
-    UpdateState(currentPos);
+    m_OwnPath.Rebuild(pathData, currentPos);
+    m_Path.reset();
+    m_pPath = &m_OwnPath;
+    Start(false, {});
+}
+void Trajectory::SetPath(std::shared_ptr<const CompiledPath> path, bool isMirrored, const glm::vec2& formationSlot)
+{
+    m_Path = std::move(path);
+    m_pPath = m_Path.get();
+    Start(isMirrored, formationSlot);
+}
+void Trajectory::Start(bool isMirrored, const glm::vec2& formationSlot)
+{
+    m_Cursor = { -1, 0.f, isMirrored };
+    m_FormationSlot = formationSlot;
+    m_Length = m_pPath->GetLength();
+    if (m_pPath->EndsAtFormationSlot()) m_Length += glm::distance(m_pPath->GetEndPosition(isMirrored), formationSlot);
+    m_IsComplete = m_Length <= 0.f;
+    if (m_IsComplete) return;
+    if (m_Lane == -1) m_Lane = TrajectoryBatch::AcquireLane();
+    m_Direction = GetSegment(0).direction;
+    //the lane may still hold the direction of its previous owner
+    TrajectoryBatch::SetDirection(m_Lane, m_Direction);
 }
 
-void Trajectory::UpdateState(const glm::vec2& currentPos) {
-    if (m_PathData.front().isRotating) m_State = std::make_unique<CircleTrajectory>();
-    else m_State = std::make_unique<LinearTrajectory>();
-    m_State->Enter(m_PathData.front(),currentPos);
-    m_Direction = m_State->GetDirection();
-    m_HasDirectionChanged = true;
+void Trajectory::SaveState(GameEngine::Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsComplete);
+    snapshot.Write(m_Cursor);
+    snapshot.Write(m_Length);
+    snapshot.Write(m_FormationSlot);
+    snapshot.Write(m_Direction);
+    const bool isOwnPath = m_pPath == &m_OwnPath;
+    snapshot.Write(isOwnPath);
+    if (isOwnPath) m_OwnPath.SaveState(snapshot);
+    else snapshot.WriteShared(m_Path);
+    snapshot.Write(m_Lane != -1 && TrajectoryBatch::IsSubmitted(m_Lane));
+    //arcs update the lane direction on every step, the next update compares against it
+    snapshot.Write(m_Lane != -1 ? TrajectoryBatch::GetDirection(m_Lane) : m_Direction);
+}
+void Trajectory::LoadState(GameEngine::Snapshot& snapshot, GameEngine::GameObject* gameObj)
+{
+    snapshot.Read(m_IsComplete);
+    snapshot.Read(m_Cursor);
+    snapshot.Read(m_Length);
+    snapshot.Read(m_FormationSlot);
+    snapshot.Read(m_Direction);
+    if (snapshot.Read<bool>())
+    {
+        m_OwnPath.LoadState(snapshot);
+        m_Path.reset();
+        m_pPath = &m_OwnPath;
+    }
+    else
+    {
+        m_Path = snapshot.ReadShared<CompiledPath>();
+        m_pPath = m_Path.get();
+    }
+    const bool isSubmitted = snapshot.Read<bool>();
+    const auto laneDirection = snapshot.Read<glm::vec2>();
+    if (m_IsComplete || m_pPath == nullptr)
+    {
+        ReleaseLane();
+        return;
+    }
+    if (m_Lane == -1) m_Lane = TrajectoryBatch::AcquireLane();
+    TrajectoryBatch::Withdraw(m_Lane);
+    //the lane may have been used by another trajectory, it has to be given the saved direction even before the first step
+    TrajectoryBatch::SetDirection(m_Lane, laneDirection);
+    if (m_Cursor.segment == -1) return;
+    //the lane may hold another segment, or none at all if it was just acquired
+    const PathSegment currentSegment = GetSegment(m_Cursor.segment);
+    TrajectoryBatch::LoadSegment(m_Lane, currentSegment);
+    TrajectoryBatch::SetDirection(m_Lane, laneDirection);
+    if (isSubmitted) TrajectoryBatch::Submit(m_Lane, gameObj, m_Cursor.distance - currentSegment.startDistance);
+}
+
+PathSegment Trajectory::GetSegment(int index) const
+{
+    if (index < m_pPath->GetNrOfSegments()) return m_pPath->GetSegment(index, m_Cursor.isMirrored);
+    //the line from the end of the shared path to this trajectory's formation slot
+    PathSegment segment{};
+    segment.origin = m_pPath->GetEndPosition(m_Cursor.isMirrored);
+    segment.startDistance = m_pPath->GetLength();
+    segment.length = m_Length - m_pPath->GetLength();
+    segment.direction = (m_FormationSlot - segment.origin) / segment.length;
+    return segment;
+}
+void Trajectory::ReleaseLane()
+{
+    if (m_Lane == -1) return;
+    TrajectoryBatch::ReleaseLane(m_Lane);
+    m_Lane = -1;
 }
@@ -1,26 +1,67 @@
 ﻿#pragma once
 #include <memory>
-#include <queue>
+#include <span>
 #include <glm/vec2.hpp>
 
+#include "CompiledPath.h"
 #include "PathDataStruct.h"
-#include "TrajectoryStates.h"
 
+namespace GameEngine
+{
+    class GameObject;
+    class Snapshot;
+}
+
+//Per-object progress along a shared CompiledPath
+struct PathCursor
+{
+    int segment{ -1 };
+    float distance{};
+    bool isMirrored{ false };
+};
 
-class EnemyComponent;
-class Trajectory
+class Trajectory final
 {
 public:
-    std::pair<glm::vec2,bool> Update(float speed, const glm::vec2& currentPos);
-    void SetPathData(const std::queue<PathData>& pathData, const glm::vec2& currentPos);
-    ~Trajectory() = default;
-    [[nodiscard]] glm::vec2 GetDirection() const { return m_Direction; }
+    Trajectory() = default;
+
+    Trajectory(const Trajectory& other) = delete;
+    Trajectory(Trajectory&& other) noexcept = delete;
+    Trajectory& operator=(const Trajectory& other) = delete;
+    Trajectory& operator=(Trajectory&& other) noexcept = delete;
+    ~Trajectory();
+
+    //Advances speed * elapsed time along the path and queues the new position for the next
+    //TrajectoryBatch step, which moves gameObj
+    void Update(float speed, GameEngine::GameObject* gameObj);
+    //Compiles a path only this trajectory uses into the storage it kept from its previous one
+    void SetPathData(std::span<const PathData> pathData, const glm::vec2& currentPos);
+    //Follows a shared path, formationSlot replaces its formation slot destination
+    void SetPath(std::shared_ptr<const CompiledPath> path, bool isMirrored, const glm::vec2& formationSlot = {});
+    //The direction of the last batch step, or the final one once the path is complete
+    [[nodiscard]] glm::vec2 GetDirection() const;
+    //The batch lane that holds the stepped direction, -1 once the path is complete
+    [[nodiscard]] int GetLane() const { return m_Lane; }
     [[nodiscard]] bool IsComplete() const { return m_IsComplete; }
+    [[nodiscard]] bool IsMirrored() const { return m_Cursor.isMirrored; }
+
+    //Saves the cursor along the path and whether a position is waiting for the next batch step
+    void SaveState(GameEngine::Snapshot& snapshot) const;
+    //Restores the cursor and re-submits the pending position of gameObj
+    void LoadState(GameEngine::Snapshot& snapshot, GameEngine::GameObject* gameObj);
 private:
-    bool m_HasDirectionChanged = false;
     bool m_IsComplete = false;
-    void UpdateState(const glm::vec2& currentPos);
+    [[nodiscard]] PathSegment GetSegment(int index) const;
+    void Start(bool isMirrored, const glm::vec2& formationSlot);
+    void ReleaseLane();
+    int m_Lane{ -1 };
+    PathCursor m_Cursor{};
+    float m_Length{};
+    glm::vec2 m_FormationSlot{};
     glm::vec2 m_Direction{};
-    std::queue<PathData> m_PathData;
-    std::unique_ptr<TrajectoryState> m_State;
+    std::shared_ptr<const CompiledPath> m_Path;
+    //the path SetPathData compiles, re-targeted in place
+    CompiledPath m_OwnPath{};
+    //m_Path, &m_OwnPath or nullptr before the first path is set
+    const CompiledPath* m_pPath{};
 };
@@ -0,0 +1,157 @@
+﻿#include "TrajectoryBatch.h"
+
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+#include "CompiledPath.h"
+#include "SimdPack.h"
+#include "Subjects/GameObject.h"
+
+TrajectoryBatch::Lanes TrajectoryBatch::m_Lanes{};
+std::chrono::microseconds TrajectoryBatch::m_LastStepCost{};
+
+namespace
+{
+    using GameEngine::SimdPack;
+
+    //sin and cos by their Taylor series after wrapping the angle into [-pi, pi], accurate to ~1e-5
+    template<typename Pack>
+    void SinCos(typename Pack::Reg angle, typename Pack::Reg& sinOut, typename Pack::Reg& cosOut)
+    {
+        using Reg = typename Pack::Reg;
+        const Reg one = Pack::Set(1.f);
+        const Reg turns = Pack::Round(Pack::Mul(angle, Pack::Set(1.f / glm::two_pi<float>())));
+        const Reg x = Pack::Sub(angle, Pack::Mul(turns, Pack::Set(glm::two_pi<float>())));
+        const Reg xSq = Pack::Mul(x, x);
+
+        Reg sinX = one;
+        for (const float divisor : { 14.f * 15.f, 12.f * 13.f, 10.f * 11.f, 8.f * 9.f, 6.f * 7.f, 4.f * 5.f, 2.f * 3.f })
+            sinX = Pack::Sub(one, Pack::Mul(Pack::Mul(xSq, Pack::Set(1.f / divisor)), sinX));
+        sinOut = Pack::Mul(x, sinX);
+
+        Reg cosX = one;
+        for (const float divisor : { 15.f * 16.f, 13.f * 14.f, 11.f * 12.f, 9.f * 10.f, 7.f * 8.f, 5.f * 6.f, 3.f * 4.f, 1.f * 2.f })
+            cosX = Pack::Sub(one, Pack::Mul(Pack::Mul(xSq, Pack::Set(1.f / divisor)), cosX));
+        cosOut = cosX;
+    }
+
+    //Evaluates lanes [first, last) at their submitted distance. Both segment kinds are evaluated for
+    //every lane and blended by the isArc mask, inactive lanes are left untouched.
+    template<typename Pack>
+    void EvaluateLanes(size_t first, size_t last, float* posX, float* posY, float* dirX, float* dirY,
+        const float* originX, const float* originY, const float* lineDirX, const float* lineDirY,
+        const float* radius, const float* startAngle, const float* rotationSign, const float* isArc,
+        const float* distance, const float* isActive)
+    {
+        using Reg = typename Pack::Reg;
+        using Mask = typename Pack::Mask;
+        const Reg half = Pack::Set(.5f);
+
+        for (size_t i = first; i < last; i += Pack::width)
+        {
+            const Mask activeLane = Pack::Greater(Pack::Load(isActive + i), half);
+            const Mask arcLane = Pack::Greater(Pack::Load(isArc + i), half);
+            const Reg ox = Pack::Load(originX + i);
+            const Reg oy = Pack::Load(originY + i);
+            const Reg lx = Pack::Load(lineDirX + i);
+            const Reg ly = Pack::Load(lineDirY + i);
+            const Reg r = Pack::Load(radius + i);
+            const Reg sign = Pack::Load(rotationSign + i);
+            const Reg s = Pack::Load(distance + i);
+
+            //--- line ---
+            const Reg linX = Pack::Add(ox, Pack::Mul(lx, s));
+            const Reg linY = Pack::Add(oy, Pack::Mul(ly, s));
+
+            //--- arc ---
+            const Reg angle = Pack::Add(Pack::Load(startAngle + i), Pack::Div(Pack::Mul(sign, s), r));
+            Reg sinA, cosA;
+            SinCos<Pack>(angle, sinA, cosA);
+            const Reg arcX = Pack::Add(ox, Pack::Mul(r, cosA));
+            const Reg arcY = Pack::Add(oy, Pack::Mul(r, sinA));
+            const Reg arcDirX = Pack::Sub(Pack::Set(0.f), Pack::Mul(sign, sinA));
+            const Reg arcDirY = Pack::Mul(sign, cosA);
+
+            //--- blend ---
+            Pack::Store(posX + i, Pack::Select(activeLane, Pack::Select(arcLane, arcX, linX), Pack::Load(posX + i)));
+            Pack::Store(posY + i, Pack::Select(activeLane, Pack::Select(arcLane, arcY, linY), Pack::Load(posY + i)));
+            Pack::Store(dirX + i, Pack::Select(activeLane, Pack::Select(arcLane, arcDirX, lx), Pack::Load(dirX + i)));
+            Pack::Store(dirY + i, Pack::Select(activeLane, Pack::Select(arcLane, arcDirY, ly), Pack::Load(dirY + i)));
+        }
+    }
+}
+
+int TrajectoryBatch::AcquireLane()
+{
+    if (m_Lanes.freeLanes.empty())
+    {
+        const size_t nrOfLanes = m_Lanes.owners.size();
+        Resize(nrOfLanes + GameEngine::g_SimdLaneBlock);
+        for (size_t lane = nrOfLanes + GameEngine::g_SimdLaneBlock; lane > nrOfLanes; --lane)
+            m_Lanes.freeLanes.emplace_back(static_cast<int>(lane - 1));
+    }
+    const int lane = m_Lanes.freeLanes.back();
+    m_Lanes.freeLanes.pop_back();
+    return lane;
+}
+void TrajectoryBatch::ReleaseLane(int lane)
+{
+    m_Lanes.isActive[lane] = 0.f;
+    m_Lanes.owners[lane] = nullptr;
+    m_Lanes.freeLanes.emplace_back(lane);
+}
+void TrajectoryBatch::LoadSegment(int lane, const PathSegment& segment)
+{
+    m_Lanes.originX[lane] = segment.origin.x;
+    m_Lanes.originY[lane] = segment.origin.y;
+    m_Lanes.lineDirX[lane] = segment.direction.x;
+    m_Lanes.lineDirY[lane] = segment.direction.y;
+    m_Lanes.dirX[lane] = segment.direction.x;
+    m_Lanes.dirY[lane] = segment.direction.y;
+    //keeps the unused arc math of line lanes finite
+    m_Lanes.radius[lane] = segment.isArc ? segment.radius : 1.f;
+    m_Lanes.startAngle[lane] = segment.startAngle;
+    m_Lanes.rotationSign[lane] = segment.rotationSign;
+    m_Lanes.isArc[lane] = segment.isArc ? 1.f : 0.f;
+}
+void TrajectoryBatch::Submit(int lane, GameEngine::GameObject* gameObj, float segmentDistance)
+{
+    m_Lanes.distance[lane] = segmentDistance;
+    m_Lanes.isActive[lane] = 1.f;
+    m_Lanes.owners[lane] = gameObj;
+}
+
+void TrajectoryBatch::Step()
+{
+    const size_t nrOfLanes = m_Lanes.owners.size();
+    if (nrOfLanes == 0) return;
+
+    EvaluateLanes<SimdPack>(0, nrOfLanes,
+        m_Lanes.posX.data(), m_Lanes.posY.data(), m_Lanes.dirX.data(), m_Lanes.dirY.data(),
+        m_Lanes.originX.data(), m_Lanes.originY.data(), m_Lanes.lineDirX.data(), m_Lanes.lineDirY.data(),
+        m_Lanes.radius.data(), m_Lanes.startAngle.data(), m_Lanes.rotationSign.data(), m_Lanes.isArc.data(),
+        m_Lanes.distance.data(), m_Lanes.isActive.data());
+
+    for (size_t lane = 0; lane < nrOfLanes; ++lane)
+    {
+        if (m_Lanes.isActive[lane] == 0.f) continue;
+        m_Lanes.owners[lane]->SetPosition(m_Lanes.posX[lane], m_Lanes.posY[lane]);
+        m_Lanes.isActive[lane] = 0.f;
+    }
+}
+void TrajectoryBatch::LateUpdate()
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    Step();
+    m_LastStepCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+}
+
+void TrajectoryBatch::Resize(size_t nrOfLanes)
+{
+    for (auto* lanes : { &m_Lanes.posX, &m_Lanes.posY, &m_Lanes.dirX, &m_Lanes.dirY, &m_Lanes.originX, &m_Lanes.originY,
+        &m_Lanes.lineDirX, &m_Lanes.lineDirY, &m_Lanes.startAngle, &m_Lanes.isArc, &m_Lanes.distance, &m_Lanes.isActive })
+        lanes->resize(nrOfLanes, 0.f);
+    m_Lanes.radius.resize(nrOfLanes, 1.f);
+    m_Lanes.rotationSign.resize(nrOfLanes, 1.f);
+    m_Lanes.owners.resize(nrOfLanes, nullptr);
+}
@@ -0,0 +1,61 @@
+﻿#pragma once
+#include <chrono>
+#include <vector>
+#include <glm/vec2.hpp>
+
+#include "Components/Component.h"
+
+struct PathSegment;
+// Evaluates the active path segment of every trajectory in one pass.
+// Lane data is stored as SoA so line and arc segments can be evaluated
+// with SIMD kernels (AVX/SSE when available, scalar otherwise); the new
+// positions are written back to the owning game objects afterwards.
+// The step runs in LateUpdate, after every trajectory of the scene has submitted its lane.
+class TrajectoryBatch final : public GameEngine::Component
+{
+public:
+    explicit TrajectoryBatch(GameEngine::GameObject* gameObj) : Component(gameObj) { EnableLateUpdate(); }
+
+    TrajectoryBatch(const TrajectoryBatch& other) = delete;
+    TrajectoryBatch(TrajectoryBatch&& other) noexcept = delete;
+    TrajectoryBatch& operator=(const TrajectoryBatch& other) = delete;
+    TrajectoryBatch& operator=(TrajectoryBatch&& other) noexcept = delete;
+    ~TrajectoryBatch() override = default;
+
+    [[nodiscard]] static int AcquireLane();
+    static void ReleaseLane(int lane);
+    static void LoadSegment(int lane, const PathSegment& segment);
+    //Marks the lane to be evaluated at the given distance into its segment by the next batch update
+    static void Submit(int lane, GameEngine::GameObject* gameObj, float segmentDistance);
+    //Drops the lane's submission, if any, so the next step leaves its owner in place
+    static void Withdraw(int lane) { m_Lanes.isActive[lane] = 0.f; }
+    [[nodiscard]] static bool IsSubmitted(int lane) { return m_Lanes.isActive[lane] != 0.f; }
+    [[nodiscard]] static glm::vec2 GetDirection(int lane) { return { m_Lanes.dirX[lane], m_Lanes.dirY[lane] }; }
+    static void SetDirection(int lane, const glm::vec2& direction) { m_Lanes.dirX[lane] = direction.x; m_Lanes.dirY[lane] = direction.y; }
+    [[nodiscard]] static int GetNrOfLanes() { return static_cast<int>(m_Lanes.owners.size()); }
+
+    static void Step();
+    void LateUpdate() override;
+    //Profiling counter of the last step
+    [[nodiscard]] static std::chrono::microseconds GetLastStepCost() { return m_LastStepCost; }
+private:
+    struct Lanes
+    {
+        std::vector<float> posX, posY;
+        std::vector<float> dirX, dirY;
+        //start point for lines, center of rotation for arcs
+        std::vector<float> originX, originY;
+        std::vector<float> lineDirX, lineDirY;
+        std::vector<float> radius, startAngle;
+        //+1 when rotating clockwise (on screen), -1 otherwise
+        std::vector<float> rotationSign;
+        std::vector<float> isArc;
+        std::vector<float> distance;
+        std::vector<float> isActive;
+        std::vector<GameEngine::GameObject*> owners;
+        std::vector<int> freeLanes;
+    };
+    static void Resize(size_t nrOfLanes);
+    static Lanes m_Lanes;
+    static std::chrono::microseconds m_LastStepCost;
+};
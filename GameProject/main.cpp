@@ -5,14 +5,67 @@
 #endif
 #endif
 
+#include <cstring>
+#include <iostream>
+
 #include "Minigin.h"
+#include "Renderable/Renderer.h"
+#include "Managers/FramePacer.h"
+#include "Managers/Telemetry.h"
+#include "Managers/AllocationTracking.h"
 #include "Galaga.h"
+#include "SceneCompiler.h"
+#include "Network/DerivedTransports.h"
 
 void Load()
 {
+	//labels only change on score updates and menu input, in between they are drawn from one cached texture
+	GameEngine::Renderer::GetInstance().SetLayerCaching(GameEngine::RenderLayer::ui, true);
 	Galaga::GetInstance().LoadStartScene();
 }
-int main(int, char* []) {
+int main(int argc, char* argv[]) {
+	//-compile-scene <scene.json> <scene.scene> only compiles the scene file, scenes the game loads are compiled on their own when they change
+	if (argc == 4 && std::strcmp(argv[1], "-compile-scene") == 0)
+	{
+		try
+		{
+			GameEngine::SceneCompiler::Compile(argv[2], argv[3]);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << e.what() << '\n';
+			return 1;
+		}
+		return 0;
+	}
+	//-scene <scene.json> starts in the given scene instead of the start menu
+	if (argc == 3 && std::strcmp(argv[1], "-scene") == 0)
+	{
+		Galaga::GetInstance().SetStartSceneFile(argv[2]);
+	}
+	//-net <localPort> <remoteHost> <remotePort> <player 0|1> plays coop and versus against a peer
+	if (argc == 6 && std::strcmp(argv[1], "-net") == 0)
+	{
+		try
+		{
+			Galaga::GetInstance().SetNetworkPeer(std::make_unique<GameEngine::UdpTransport>(
+				static_cast<uint16_t>(std::stoi(argv[2])), argv[3], static_cast<uint16_t>(std::stoi(argv[4]))), std::stoi(argv[5]) == 0 ? 0 : 1);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Couldn't set up the network peer: " << e.what() << '\n';
+		}
+	}
+	//-stats <file> writes the session's frame time and input latency percentiles once the game is closed
+	if (argc == 3 && std::strcmp(argv[1], "-stats") == 0)
+	{
+		GameEngine::FramePacer::GetInstance().SetStatisticsFile(argv[2]);
+	}
+	//-telemetry <file> appends the engine and game metrics to a CSV file once a second
+	if (argc == 3 && std::strcmp(argv[1], "-telemetry") == 0)
+	{
+		GameEngine::Telemetry::GetInstance().StartSession(argv[2]);
+	}
 	GameEngine::Minigin engine("../Data/");
 	engine.Run(Load);
 
@@ -0,0 +1,99 @@
+#include "CollisionMask.h"
+#include <algorithm>
+
+using namespace GameEngine;
+
+namespace
+{
+	constexpr int g_BitsPerWord{ 64 };
+
+	uint64_t GetLowBits(int nrOfBits)
+	{
+		return nrOfBits >= g_BitsPerWord ? ~uint64_t{} : (uint64_t{ 1 } << nrOfBits) - 1;
+	}
+}
+
+CollisionMask::CollisionMask(int width, int height) :
+	m_Width(std::max(width, 0)),
+	m_Height(std::max(height, 0)),
+	m_WordsPerRow((m_Width + g_BitsPerWord - 1) / g_BitsPerWord),
+	m_Bits(static_cast<size_t>(m_WordsPerRow) * m_Height)
+{}
+
+void CollisionMask::SetBit(int x, int y)
+{
+	m_Bits[y * m_WordsPerRow + x / g_BitsPerWord] |= uint64_t{ 1 } << (x % g_BitsPerWord);
+}
+
+bool CollisionMask::GetBit(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= m_Width || y >= m_Height) return false;
+	return ((m_Bits[y * m_WordsPerRow + x / g_BitsPerWord] >> (x % g_BitsPerWord)) & 1) != 0;
+}
+
+uint64_t CollisionMask::GetRowBits(int row, int startCol) const
+{
+	const int word = startCol / g_BitsPerWord;
+	const int shift = startCol % g_BitsPerWord;
+	const uint64_t* rowBits = m_Bits.data() + row * m_WordsPerRow;
+
+	uint64_t bits = word < m_WordsPerRow ? rowBits[word] >> shift : 0;
+	if (shift != 0 && word + 1 < m_WordsPerRow) bits |= rowBits[word + 1] << (g_BitsPerWord - shift);
+	return bits;
+}
+
+bool CollisionMask::Overlaps(const glm::ivec2& pos, const CollisionMask& other, const glm::ivec2& otherPos) const
+{
+	const int left = std::max(pos.x, otherPos.x);
+	const int right = std::min(pos.x + m_Width, otherPos.x + other.m_Width);
+	const int top = std::max(pos.y, otherPos.y);
+	const int bottom = std::min(pos.y + m_Height, otherPos.y + other.m_Height);
+	if (left >= right || top >= bottom) return false;
+
+	for (int y = top; y < bottom; ++y)
+	{
+		for (int x = left; x < right; x += g_BitsPerWord)
+		{
+			const uint64_t bits = GetRowBits(y - pos.y, x - pos.x) & other.GetRowBits(y - otherPos.y, x - otherPos.x);
+			if ((bits & GetLowBits(right - x)) != 0) return true;
+		}
+	}
+	return false;
+}
+
+bool CollisionMask::Overlaps(const glm::ivec2& pos, const SDL_Rect& rect) const
+{
+	const int left = std::max(pos.x, rect.x);
+	const int right = std::min(pos.x + m_Width, rect.x + rect.w);
+	const int top = std::max(pos.y, rect.y);
+	const int bottom = std::min(pos.y + m_Height, rect.y + rect.h);
+	if (left >= right || top >= bottom) return false;
+
+	for (int y = top; y < bottom; ++y)
+	{
+		for (int x = left; x < right; x += g_BitsPerWord)
+		{
+			if ((GetRowBits(y - pos.y, x - pos.x) & GetLowBits(right - x)) != 0) return true;
+		}
+	}
+	return false;
+}
+
+CollisionMask CollisionMask::Extract(const SDL_Rect& srcRect, SDL_RendererFlip flipMode, const glm::ivec2& destSize) const
+{
+	CollisionMask mask{ destSize.x, destSize.y };
+	if (srcRect.w <= 0 || srcRect.h <= 0) return mask;
+
+	for (int y = 0; y < mask.m_Height; ++y)
+	{
+		int srcY = y * srcRect.h / mask.m_Height;
+		if (flipMode & SDL_FLIP_VERTICAL) srcY = srcRect.h - 1 - srcY;
+		for (int x = 0; x < mask.m_Width; ++x)
+		{
+			int srcX = x * srcRect.w / mask.m_Width;
+			if (flipMode & SDL_FLIP_HORIZONTAL) srcX = srcRect.w - 1 - srcX;
+			if (GetBit(srcRect.x + srcX, srcRect.y + srcY)) mask.SetBit(x, y);
+		}
+	}
+	return mask;
+}
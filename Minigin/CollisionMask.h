@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SDL_rect.h>
+#include <SDL_render.h>
+#include <glm/vec2.hpp>
+
+namespace GameEngine
+{
+	//1 bit per pixel, set where the sprite is opaque. Rows are packed into 64 bit words
+	//so overlap tests AND a whole word of columns at once
+	class CollisionMask final
+	{
+	public:
+		CollisionMask(int width, int height);
+
+		void SetBit(int x, int y);
+		[[nodiscard]] bool GetBit(int x, int y) const;
+		[[nodiscard]] int GetWidth() const { return m_Width; }
+		[[nodiscard]] int GetHeight() const { return m_Height; }
+
+		//Whether a set bit of this mask at pos covers a set bit of other at otherPos
+		[[nodiscard]] bool Overlaps(const glm::ivec2& pos, const CollisionMask& other, const glm::ivec2& otherPos) const;
+		//Whether a set bit of this mask at pos lies inside rect
+		[[nodiscard]] bool Overlaps(const glm::ivec2& pos, const SDL_Rect& rect) const;
+
+		//The srcRect region of this mask mirrored like the renderer would and scaled to destSize
+		[[nodiscard]] CollisionMask Extract(const SDL_Rect& srcRect, SDL_RendererFlip flipMode, const glm::ivec2& destSize) const;
+	private:
+		//64 columns of a row starting at startCol, columns past the width read as 0
+		[[nodiscard]] uint64_t GetRowBits(int row, int startCol) const;
+
+		int m_Width;
+		int m_Height;
+		int m_WordsPerRow;
+		std::vector<uint64_t> m_Bits;
+	};
+}
@@ -1,11 +1,16 @@
 ﻿#include "CollisionComponent.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "TextureComponent.h"
+#include "../CollisionMask.h"
 #include "../EventData.h"
 #include "../Managers/CollisionManager.h"
+#include "../Managers/ResourceManager.h"
 #include "../Subjects/GameObject.h"
 #include "../Subjects/Subject.h"
+#include "../Snapshot.h"
 
 using namespace GameEngine;
 CollisionComponent::CollisionComponent(GameObject* gameObj,SDL_Rect collisionRect):
@@ -20,19 +25,97 @@ const SDL_Rect& CollisionComponent::GetCollisionRect() const
 }
 bool CollisionComponent::IsColliding(CollisionComponent* other) const
 {
-    return SDL_HasIntersection(&m_CollisionRect, &other->m_CollisionRect);
+    if (m_IsFastMoving) return IsSweptColliding(other);
+    if (other->m_IsFastMoving) return other->IsSweptColliding(this);
+    return SDL_HasIntersection(&m_CollisionRect, &other->m_CollisionRect) && AreMasksOverlapping(other);
+}
+bool CollisionComponent::AreMasksOverlapping(const CollisionComponent* other) const
+{
+    //the masks are placed where the sprites are drawn, at the object's position
+    if (m_Mask != nullptr && other->m_Mask != nullptr) return m_Mask->Overlaps(m_LastPosition, *other->m_Mask, other->m_LastPosition);
+    if (m_Mask != nullptr) return m_Mask->Overlaps(m_LastPosition, other->m_CollisionRect);
+    if (other->m_Mask != nullptr) return other->m_Mask->Overlaps(other->m_LastPosition, m_CollisionRect);
+    return true;
+}
+bool CollisionComponent::IsSweptColliding(const CollisionComponent* other) const
+{
+    //overlapping now, the pixels decide. A hit earlier along the path is taken on the rects alone
+    if (SDL_HasIntersection(&m_CollisionRect, &other->m_CollisionRect)) return AreMasksOverlapping(other);
+
+    const SDL_Rect& from = m_IsSweepValid ? m_PrevCollisionRect : m_CollisionRect;
+    //slow colliders are taken where they are now, a respawn or a formation snap isn't a path
+    const SDL_Rect& otherFrom = other->m_IsFastMoving && other->m_IsSweepValid ? other->m_PrevCollisionRect : other->m_CollisionRect;
+    if (from.w <= 0 || from.h <= 0 || otherFrom.w <= 0 || otherFrom.h <= 0) return false;
+
+    //move this rect relative to the other one, which then stands still at its previous rect.
+    //Sweeping the corner of this rect through the other rect grown by this rect's size
+    //gives the part of the frame both overlap in, per axis
+    const glm::vec2 motion{ (m_CollisionRect.x - from.x) - (other->m_CollisionRect.x - otherFrom.x),
+        (m_CollisionRect.y - from.y) - (other->m_CollisionRect.y - otherFrom.y) };
+    const glm::vec2 start{ from.x, from.y };
+    const glm::vec2 minCorner{ otherFrom.x - from.w, otherFrom.y - from.h };
+    const glm::vec2 maxCorner{ otherFrom.x + otherFrom.w, otherFrom.y + otherFrom.h };
+
+    float entry{ 0.f };
+    float exit{ 1.f };
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        if (motion[axis] == 0.f)
+        {
+            if (start[axis] <= minCorner[axis] || start[axis] >= maxCorner[axis]) return false;
+            continue;
+        }
+        float enterTime = (minCorner[axis] - start[axis]) / motion[axis];
+        float exitTime = (maxCorner[axis] - start[axis]) / motion[axis];
+        if (enterTime > exitTime) std::swap(enterTime, exitTime);
+        entry = std::max(entry, enterTime);
+        exit = std::min(exit, exitTime);
+        if (entry >= exit) return false;
+    }
+    return true;
 }
 void CollisionComponent::CollidedWith(CollisionComponent* other) const
 {
-    CollisionData data;
-    data.pOtherCollider = other->GetGameObjParent();
-    if(!GetGameObjParent()->IsDestroyed()) GetGameObjParent()->NotifyAll(static_cast<int>(EngineGameEvent::collision),&data);
+    if(!GetGameObjParent()->IsDestroyed()) GetGameObjParent()->Emit(CollisionEvent{ other->GetGameObjParent() });
+}
+
+void CollisionComponent::SaveState(Snapshot& snapshot) const
+{
+    snapshot.Write(m_CollisionRect);
+    snapshot.Write(m_PrevCollisionRect);
+    snapshot.Write(m_LastPosition);
+    snapshot.Write(m_IsSweepValid);
+}
+
+void CollisionComponent::LoadState(Snapshot& snapshot)
+{
+    snapshot.Read(m_CollisionRect);
+    snapshot.Read(m_PrevCollisionRect);
+    snapshot.Read(m_LastPosition);
+    snapshot.Read(m_IsSweepValid);
 }
 
 void CollisionComponent::Update()
 {
     auto pos = GetGameObjParent()->GetIntPosition();
+    m_PrevCollisionRect = m_CollisionRect;
     m_CollisionRect.x += pos.x - m_LastPosition.x;
     m_CollisionRect.y += pos.y - m_LastPosition.y;
     m_LastPosition = {pos.x,pos.y};
+    //the first update moves the rect from where the object was created to where it was placed
+    if (!m_IsSweepValid) m_PrevCollisionRect = m_CollisionRect;
+    m_IsSweepValid = true;
+    if (m_MaskSource != nullptr) UpdateMask();
+}
+void CollisionComponent::UpdateMask()
+{
+    const SDL_Rect& srcRect = m_MaskSource->m_SrcRect;
+    const glm::ivec2 size{ m_MaskSource->m_DestRect.w, m_MaskSource->m_DestRect.h };
+    const SDL_RendererFlip flipMode = m_MaskSource->GetFlipMode();
+    if (m_Mask != nullptr && SDL_RectEquals(&srcRect, &m_MaskSrcRect) && flipMode == m_MaskFlipMode && size == m_MaskSize) return;
+
+    m_Mask = ResourceManager::GetInstance().LoadCollisionMask(m_MaskSource->GetTexture(), srcRect, flipMode, size);
+    m_MaskSrcRect = srcRect;
+    m_MaskFlipMode = flipMode;
+    m_MaskSize = size;
 }
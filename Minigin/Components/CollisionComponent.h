@@ -1,18 +1,32 @@
 ﻿#pragma once
 #include <SDL_rect.h>
+#include <SDL_render.h>
 #include <glm/vec2.hpp>
 #include "Component.h"
+#include "ComponentPool.h"
 
 namespace GameEngine
 {
-    class CollisionComponent final : public Component
+    class CollisionMask;
+    class TextureComponent;
+    class CollisionComponent final : public Component, public PooledComponent<CollisionComponent>
     {
     public:
         explicit CollisionComponent(GameObject* gameObj,SDL_Rect collisionRect);
         [[nodiscard]] const SDL_Rect& GetCollisionRect() const;
         bool IsColliding(CollisionComponent* other) const;
         void CollidedWith(CollisionComponent* other) const;
+        //Fast movers are tested along the path their rect covered since the last frame,
+        //so they can't skip past a collider when a frame takes long
+        void SetFastMoving(bool isFastMoving) { m_IsFastMoving = isFastMoving; }
+        [[nodiscard]] bool IsFastMoving() const { return m_IsFastMoving; }
+        //Call after teleporting the object so the jump isn't swept
+        void ResetSweep() { m_IsSweepValid = false; }
+        //Rect hits are confirmed against the opaque pixels of the frame the texture component shows
+        void UseSpriteMask(const TextureComponent* textureComponent) { m_MaskSource = textureComponent; }
         virtual void Update() override;
+        virtual void SaveState(Snapshot& snapshot) const override;
+        virtual void LoadState(Snapshot& snapshot) override;
     
         virtual ~CollisionComponent() override = default;
         CollisionComponent(const CollisionComponent& other) = delete;
@@ -20,8 +34,22 @@ namespace GameEngine
         CollisionComponent& operator=(const CollisionComponent& other) = delete;
         CollisionComponent& operator=(CollisionComponent&& other) = delete;
     private:
+        [[nodiscard]] bool IsSweptColliding(const CollisionComponent* other) const;
+        [[nodiscard]] bool AreMasksOverlapping(const CollisionComponent* other) const;
+        void UpdateMask();
+
         SDL_Rect m_CollisionRect{};
+        //rect before the last update, the sweep covers the movement from here to m_CollisionRect
+        SDL_Rect m_PrevCollisionRect{};
         glm::ivec2 m_LastPosition{};
+        bool m_IsFastMoving{ false };
+        bool m_IsSweepValid{ false };
+        const TextureComponent* m_MaskSource{};
+        //mask of the frame shown at the last update, looked up again when the frame changes
+        const CollisionMask* m_Mask{};
+        SDL_Rect m_MaskSrcRect{};
+        SDL_RendererFlip m_MaskFlipMode{ SDL_FLIP_NONE };
+        glm::ivec2 m_MaskSize{};
     };
 }
 
@@ -3,17 +3,25 @@
 namespace GameEngine
 {
     class GameObject;
+    class Snapshot;
     class Component
     {
     private:
         GameObject* m_pParent;
         bool m_IsDestroyed{ false };
+        bool m_HasLateUpdate{ false };
     public:
         virtual void Update() {}
+        //Runs once every object of the scene has updated, e.g. to apply what the other objects submitted this frame
+        virtual void LateUpdate() {}
         virtual void Render() {}
+        //Mutable state for scene snapshots. Components with nothing to restore keep the defaults
+        virtual void SaveState(Snapshot&) const {}
+        virtual void LoadState(Snapshot&) {}
         [[nodiscard]] GameObject* GetGameObjParent() const;
         [[nodiscard]] bool IsDestroyed() const;
         void SetDestroyedFlag();
+        [[nodiscard]] bool HasLateUpdate() const { return m_HasLateUpdate; }
 
         virtual ~Component() = default;
         Component(const Component& other) = delete;
@@ -22,6 +30,8 @@ namespace GameEngine
         Component& operator=(Component&& other) = delete;
     protected:
         explicit Component(GameObject* gameObj);
+        //Called from the constructor of components that override LateUpdate, the scene only visits those objects
+        void EnableLateUpdate() { m_HasLateUpdate = true; }
     };
 
     
@@ -0,0 +1,96 @@
+﻿#pragma once
+#include <cstddef>
+#include <new>
+
+namespace GameEngine
+{
+    //Mixin that makes AddComponent<T> allocate T from a free list of contiguous blocks
+    //instead of the global heap. Components of types derived from T fall back to the heap.
+    template<typename T>
+    class PooledComponent
+    {
+    public:
+        static void* operator new(size_t size)
+        {
+            if (size != sizeof(T)) return ::operator new(size);
+            if (m_pFreeList == nullptr) AddBlock(m_BlockSize);
+            Slot* slot = m_pFreeList;
+            m_pFreeList = slot->pNext;
+            ++m_NrOfLiveSlots;
+            return slot;
+        }
+        static void operator delete(void* ptr, size_t size)
+        {
+            if (size != sizeof(T))
+            {
+                ::operator delete(ptr);
+                return;
+            }
+            Slot* slot = static_cast<Slot*>(ptr);
+            slot->pNext = m_pFreeList;
+            m_pFreeList = slot;
+            if (--m_NrOfLiveSlots == 0 && m_IsReleasingOnEmpty) ReleaseBlocks();
+        }
+        //Makes sure the next count allocations are served without touching the heap,
+        //bulk spawns call this so their components end up next to each other
+        static void ReservePool(size_t count)
+        {
+            size_t nrOfFreeSlots{};
+            for (const Slot* slot = m_pFreeList; slot != nullptr && nrOfFreeSlots < count; slot = slot->pNext) ++nrOfFreeSlots;
+            if (nrOfFreeSlots < count) AddBlock(count - nrOfFreeSlots);
+        }
+    protected:
+        PooledComponent() = default;
+        ~PooledComponent() = default;
+    private:
+        union Slot
+        {
+            Slot* pNext;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        static void AddBlock(size_t nrOfSlots)
+        {
+            //odr-use the releaser so it gets instantiated for this T
+            static_cast<void>(&m_BlockReleaser);
+            //the first slot of every block links the blocks together
+            Slot* block = new Slot[nrOfSlots + 1];
+            block[0].pNext = m_pBlocks;
+            m_pBlocks = block;
+            //pushed back to front so allocations walk the block in address order
+            for (size_t i = nrOfSlots; i > 0; --i)
+            {
+                block[i].pNext = m_pFreeList;
+                m_pFreeList = &block[i];
+            }
+        }
+        static void ReleaseBlocks()
+        {
+            while (m_pBlocks != nullptr)
+            {
+                Slot* next = m_pBlocks[0].pNext;
+                delete[] m_pBlocks;
+                m_pBlocks = next;
+            }
+            m_pFreeList = nullptr;
+        }
+
+        //Blocks are kept for the whole run. At exit components can still be alive in scenes that are
+        //destroyed later on, the last of them to be deleted releases the blocks then
+        struct BlockReleaser
+        {
+            ~BlockReleaser()
+            {
+                if (m_NrOfLiveSlots == 0) ReleaseBlocks();
+                else m_IsReleasingOnEmpty = true;
+            }
+        };
+
+        //plain pointers and counters only, so the pool stays usable while other statics are torn down
+        static inline Slot* m_pFreeList{};
+        static inline Slot* m_pBlocks{};
+        static inline size_t m_NrOfLiveSlots{};
+        static inline bool m_IsReleasingOnEmpty{ false };
+        static inline BlockReleaser m_BlockReleaser{};
+        static constexpr size_t m_BlockSize{ 64 };
+    };
+}
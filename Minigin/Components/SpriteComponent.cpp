@@ -1,5 +1,5 @@
 ﻿#include "SpriteComponent.h"
-#include "../Managers/TimeManager.h"
+#include "../Snapshot.h"
 
 using namespace GameEngine;
 
@@ -8,6 +8,8 @@ SpriteComponent::SpriteComponent(GameObject* gameObj, const std::string& filenam
     TextureComponent(gameObj, filename) {}
 SpriteComponent::SpriteComponent(GameObject* gameObj, std::unique_ptr<Texture2D>&& texture) :
     TextureComponent(gameObj, std::move(texture)) {}
+SpriteComponent::SpriteComponent(GameObject* gameObj, Texture2D* texture) :
+    TextureComponent(gameObj, texture) {}
 
 void SpriteComponent::UpdateSrcRect()
 {
@@ -23,15 +25,18 @@ void SpriteComponent::UpdateSrcRect()
         m_DestRect.h = static_cast<int>(m_SrcRect.h * m_Scale);
     }
 }
-void SpriteComponent::Update()
+void SpriteComponent::SaveState(Snapshot& snapshot) const
 {
-    if (!m_IsActive) return;
-    m_CurrentTimeElapsed += TimeManager::GetElapsed();
-    if (m_CurrentTimeElapsed >= m_SpriteInfo.m_TimeInterval)
-    {
-        ++m_SpriteInfo.m_CurrentCol %= m_SpriteInfo.m_NrOfCols;
-        if (m_SpriteInfo.m_CurrentCol == 0) ++m_SpriteInfo.m_CurrentRow %= m_SpriteInfo.m_NrOfRows;
-        UpdateSrcRect();
-        m_CurrentTimeElapsed -= m_SpriteInfo.m_TimeInterval;
-    }
-}
\ No newline at end of file
+    TextureComponent::SaveState(snapshot);
+    snapshot.Write(m_SpriteInfo);
+    snapshot.Write(m_IsActive);
+    snapshot.Write(m_Scale);
+}
+
+void SpriteComponent::LoadState(Snapshot& snapshot)
+{
+    TextureComponent::LoadState(snapshot);
+    snapshot.Read(m_SpriteInfo);
+    snapshot.Read(m_IsActive);
+    snapshot.Read(m_Scale);
+}
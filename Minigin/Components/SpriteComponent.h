@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <glm/vec2.hpp>
+#include "ComponentPool.h"
 #include "TextureComponent.h"
 
 namespace GameEngine
@@ -27,18 +28,23 @@ namespace GameEngine
         }
     };
 
-    class SpriteComponent : public TextureComponent
+    class SpriteComponent : public TextureComponent, public PooledComponent<SpriteComponent>
     {
     public:
         explicit SpriteComponent(GameObject* gameObj);
         explicit SpriteComponent(GameObject* gameObj, const std::string& filename);
         explicit SpriteComponent(GameObject* gameObj, std::unique_ptr<Texture2D>&& texture);
+        explicit SpriteComponent(GameObject* gameObj, Texture2D* texture);
+        //Recomputes the source and destination rect, the scene's SpriteAnimator advances the frames
         void UpdateSrcRect();
-        virtual void Update() override;
+        virtual void SaveState(Snapshot& snapshot) const override;
+        virtual void LoadState(Snapshot& snapshot) override;
         SpriteInfo m_SpriteInfo{};
         bool m_IsActive{ true };
         float m_Scale{};
-    protected:
-        float m_CurrentTimeElapsed{};
+    private:
+        friend class SpriteAnimator;
+        int m_AnimationClock{ -1 };
+        size_t m_AnimationSlot{};
     };
 }
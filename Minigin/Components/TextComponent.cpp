@@ -4,9 +4,9 @@
 
 #include "TextureComponent.h"
 #include "Minigin/Renderable/Font.h"
-#include "Minigin/Renderable/Renderer.h"
 #include "Minigin/Renderable/Texture2D.h"
 #include "Minigin/Subjects/GameObject.h"
+#include "Minigin/Snapshot.h"
 
 using namespace GameEngine;
 TextComponent::TextComponent(GameObject* gameObj, std::shared_ptr<Font> font, const std::string& text, const SDL_Color& color) : Component(gameObj),
@@ -35,6 +35,16 @@ void TextComponent::SetColor(const SDL_Color& color)
     m_NeedsUpdate = true;
 }
 
+void TextComponent::SaveState(Snapshot& snapshot) const
+{
+    snapshot.WriteString(m_Text);
+}
+
+void TextComponent::LoadState(Snapshot& snapshot)
+{
+    SetText(snapshot.ReadString());
+}
+
 void TextComponent::Update()
 {
     if (m_NeedsUpdate && GetGameObjParent()->CheckIfComponentExists<TextureComponent>())
@@ -44,13 +54,7 @@ void TextComponent::Update()
         {
             throw std::runtime_error(std::string("Render  text failed: ") + SDL_GetError());
         }
-        auto texture = SDL_CreateTextureFromSurface(Renderer::GetInstance().GetSDLRenderer(), surf);
-        if (texture == nullptr)
-        {
-            throw std::runtime_error(std::string("Create text texture from surface failed: ") + SDL_GetError());
-        }
-        SDL_FreeSurface(surf);
-        GetGameObjParent()->GetComponent<TextureComponent>()->SetTexture(std::make_unique<Texture2D>(texture));
+        GetGameObjParent()->GetComponent<TextureComponent>()->SetTexture(std::make_unique<Texture2D>(surf));
         m_NeedsUpdate = false;
     }
 }
@@ -17,6 +17,8 @@ namespace GameEngine
         void SetFont(const std::shared_ptr<Font>& font);
         void SetColor(const SDL_Color& color);
         virtual void Update() override;
+        virtual void SaveState(Snapshot& snapshot) const override;
+        virtual void LoadState(Snapshot& snapshot) override;
     private:
         SDL_Color m_Color;
         std::string m_Text{};
@@ -4,6 +4,7 @@
 #include "../Renderable/Renderer.h"
 #include "Minigin/Renderable/Texture2D.h"
 #include "Minigin/Subjects/GameObject.h"
+#include "Minigin/Snapshot.h"
 
 using namespace GameEngine;
 TextureComponent::TextureComponent(GameObject* gameObj): Component(gameObj)
@@ -30,6 +31,29 @@ TextureComponent::TextureComponent(GameObject* gameObj, std::unique_ptr<Texture2
     SetTexture(std::move(texture));
 }
 
+TextureComponent::TextureComponent(GameObject* gameObj, Texture2D* texture) :
+    Component(gameObj),
+    m_Texture(texture)
+{
+    InitRects();
+}
+
+void TextureComponent::SaveState(Snapshot& snapshot) const
+{
+    snapshot.Write(m_SrcRect);
+    snapshot.Write(m_DestRect);
+    snapshot.Write(m_RotationAngle);
+    snapshot.Write(m_FlipMode);
+}
+
+void TextureComponent::LoadState(Snapshot& snapshot)
+{
+    snapshot.Read(m_SrcRect);
+    snapshot.Read(m_DestRect);
+    snapshot.Read(m_RotationAngle);
+    snapshot.Read(m_FlipMode);
+}
+
 void TextureComponent::Render()
 {
     if (m_Texture != nullptr)
@@ -14,8 +14,12 @@ namespace GameEngine
         explicit TextureComponent(GameObject* gameObj);
         explicit TextureComponent(GameObject* gameObj, const std::string& filename);
         explicit TextureComponent(GameObject* gameObj, std::unique_ptr<Texture2D>&& texture);
+        //for textures already owned by the ResourceManager, skips the lookup by file name
+        explicit TextureComponent(GameObject* gameObj, Texture2D* texture);
         //virtual void Update() override;
         virtual void Render() override;
+        virtual void SaveState(Snapshot& snapshot) const override;
+        virtual void LoadState(Snapshot& snapshot) override;
         [[nodiscard]] Texture2D* GetTexture() const;
         void SetTexture(const std::string& filename);
         void SetTexture(std::unique_ptr<Texture2D>&& texture);
@@ -24,6 +28,7 @@ namespace GameEngine
         SDL_Rect m_SrcRect{};
 
         void SetFlipMode(const SDL_RendererFlip& flipMode) { m_FlipMode = flipMode; }
+        [[nodiscard]] SDL_RendererFlip GetFlipMode() const { return m_FlipMode; }
         void SetRotationAngle(float angle) { m_RotationAngle = angle; }
         void SetRotationCenter(const SDL_Point& center) { m_RotationCenter = center; }
     protected:
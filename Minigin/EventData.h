@@ -3,8 +3,8 @@
 namespace GameEngine
 {
     class GameObject;
-    struct EventData {};
-    struct CollisionData : EventData
+    //Emitted by an object with a collision component for every collider it overlaps
+    struct CollisionEvent
     {
         GameObject* pOtherCollider;
     };
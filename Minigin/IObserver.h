@@ -1,15 +1,12 @@
 #pragma once
-#include "Subjects/Subject.h"
 
 namespace GameEngine
 {
-    class Subject;
-
+    //Base of the observers a scene owns. Observers connect their own slots to the subjects they watch,
+    //see Subject::Connect
     class IObserver
     {
     public:
-        virtual void Notify(Subject* subject, int event, EventData* eventData = nullptr) = 0;
-
         IObserver() = default;
         virtual ~IObserver() = default;
         IObserver(const IObserver& other) = delete;
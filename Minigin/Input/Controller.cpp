@@ -1,118 +1,70 @@
-#define WIN32_LEAN_AND_MEAN
-#include "windows.h"
-#include <XInput.h>
 #include "Controller.h"
+#include <array>
 #include <iostream>
-#include <unordered_map>
+#include <SDL.h>
 
-class GameEngine::Controller::XInput
-{
-    const std::unordered_map<ControllerInputKey, std::uint32_t> keyMappings = {
-        { ControllerInputKey::dpadUp, XINPUT_GAMEPAD_DPAD_UP },
-        { ControllerInputKey::dpadLeft,XINPUT_GAMEPAD_DPAD_LEFT },
-        { ControllerInputKey::dpadDown,XINPUT_GAMEPAD_DPAD_DOWN },
-        { ControllerInputKey::dpadRight,XINPUT_GAMEPAD_DPAD_RIGHT },
-        { ControllerInputKey::X,XINPUT_GAMEPAD_X },
-        { ControllerInputKey::Y,XINPUT_GAMEPAD_Y },
-        { ControllerInputKey::A,XINPUT_GAMEPAD_A },
-        { ControllerInputKey::B, XINPUT_GAMEPAD_B } };
-    
-    unsigned int m_ControllerIdx{ 0 };
-    XINPUT_STATE m_PreviousState{};
-    XINPUT_STATE m_CurrentState{};
-    unsigned int m_ButtonsPressedThisFrame{};
-    unsigned int m_ButtonsReleasedThisFrame{};
-public:
-    explicit XInput(unsigned int controllerIdx): m_ControllerIdx{ controllerIdx } {}
-    XInput(const XInput& other) = delete; 
-    XInput(XInput&& other) = delete;
-    XInput& operator=(const XInput& other) = delete;
-    XInput& operator=(XInput&& other) = delete;
-    ~XInput() = default;
+using namespace GameEngine;
 
-    void ProcessControllerInput()
-    {
-        CopyMemory(&m_PreviousState, &m_CurrentState, sizeof(XINPUT_STATE));
-        ZeroMemory(&m_CurrentState, sizeof(XINPUT_STATE));
-        if (const auto result = XInputGetState(m_ControllerIdx, &m_CurrentState); result != ERROR_SUCCESS)
-        {
-            switch (result)
-            {
-            case ERROR_DEVICE_NOT_CONNECTED:
-                std::cerr << "Controller error! Device not connected! \n";
-                break;
-            case ERROR_NOT_SUPPORTED:
-                std::cerr << "Controller error! Not supported! \n";
-                break;
-            default:
-                std::cerr << "Controller error! \n";
-                break;
-            }
-        }
+namespace
+{
+    //indexed by SDL_GameControllerButton, SDL names the face buttons by their position on an Xbox pad like XInput did
+    constexpr std::array<uint32_t, SDL_CONTROLLER_BUTTON_MAX> g_ButtonBits = [] {
+        std::array<uint32_t, SDL_CONTROLLER_BUTTON_MAX> bits{};
+        const auto bit = [](ControllerInputKey key) { return 1u << static_cast<uint32_t>(key); };
+        bits[SDL_CONTROLLER_BUTTON_DPAD_UP] = bit(ControllerInputKey::dpadUp);
+        bits[SDL_CONTROLLER_BUTTON_DPAD_LEFT] = bit(ControllerInputKey::dpadLeft);
+        bits[SDL_CONTROLLER_BUTTON_DPAD_DOWN] = bit(ControllerInputKey::dpadDown);
+        bits[SDL_CONTROLLER_BUTTON_DPAD_RIGHT] = bit(ControllerInputKey::dpadRight);
+        bits[SDL_CONTROLLER_BUTTON_X] = bit(ControllerInputKey::X);
+        bits[SDL_CONTROLLER_BUTTON_Y] = bit(ControllerInputKey::Y);
+        bits[SDL_CONTROLLER_BUTTON_A] = bit(ControllerInputKey::A);
+        bits[SDL_CONTROLLER_BUTTON_B] = bit(ControllerInputKey::B);
+        return bits;
+    }();
+}
 
-        const int buttonChanges = m_CurrentState.Gamepad.wButtons ^ m_PreviousState.Gamepad.wButtons;
-        m_ButtonsPressedThisFrame = buttonChanges & m_CurrentState.Gamepad.wButtons;
-        m_ButtonsReleasedThisFrame = buttonChanges & (~m_CurrentState.Gamepad.wButtons);
-    }
-    [[nodiscard]] bool IsKeyDown(ControllerInputKey button) const
-    {
-        try
-        {
-            return m_ButtonsPressedThisFrame & keyMappings.at(button);
-        }
-        catch (const std::out_of_range& e)
-        {
-            std::cerr <<"Out of range error: "<<e.what()<<" Controller.cpp\n";
-        }
-        return false;
-    }
-    [[nodiscard]] bool IsKeyUp(ControllerInputKey button) const
-    {
-        try
-        {
-            return m_ButtonsReleasedThisFrame & keyMappings.at(button);
-        }
-        catch (const std::out_of_range& e)
-        {
-            std::cerr <<"Out of range error: "<<e.what()<<" Controller.cpp\n";
-        }
-        return false;
-    }
-    [[nodiscard]] bool IsKeyPressed(ControllerInputKey button) const
+bool Controller::Connect(int deviceIndex)
+{
+    Disconnect();
+    m_pController = SDL_GameControllerOpen(deviceIndex);
+    if (m_pController == nullptr)
     {
-        try
-        {
-            return m_CurrentState.Gamepad.wButtons & keyMappings.at(button);
-        }
-        catch (const std::out_of_range& e)
-        {
-            std::cerr <<"Out of range error: "<<e.what()<<" Controller.cpp\n";
-        }
+        std::cerr << "Couldn't open controller " << deviceIndex << ": " << SDL_GetError() << '\n';
         return false;
     }
-};
-
-GameEngine::Controller::Controller(unsigned int controllerIdx):
-    m_pXInput{ std::make_unique<XInput>(controllerIdx) }
-{}
-
-GameEngine::Controller::~Controller() {}
-
-void GameEngine::Controller::ProcessControllerInput() const
-{
-    m_pXInput->ProcessControllerInput();
+    m_InstanceId = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(m_pController));
+    return true;
 }
 
-bool GameEngine::Controller::IsKeyDown(ControllerInputKey inputKey) const
+void Controller::Disconnect()
 {
-   return m_pXInput->IsKeyDown(inputKey);
+    if (m_pController == nullptr) return;
+    SDL_GameControllerClose(m_pController);
+    m_pController = nullptr;
+    m_InstanceId = -1;
+    m_ButtonsReleasedThisFrame |= m_Buttons;
+    m_ButtonsPressedThisFrame = 0;
+    m_Buttons = 0;
 }
-bool GameEngine::Controller::IsKeyPressed(ControllerInputKey inputKey) const
+
+void Controller::StartFrame()
 {
-    return m_pXInput->IsKeyPressed(inputKey);
+    m_ButtonsPressedThisFrame = 0;
+    m_ButtonsReleasedThisFrame = 0;
 }
 
-bool GameEngine::Controller::IsKeyUp(ControllerInputKey inputKey) const
+void Controller::HandleButtonEvent(uint8_t sdlButton, bool isDown)
 {
-    return m_pXInput->IsKeyUp(inputKey);
+    if (sdlButton >= g_ButtonBits.size()) return;
+    const uint32_t bit = g_ButtonBits[sdlButton];
+    if (isDown)
+    {
+        if (!(m_Buttons & bit)) m_ButtonsPressedThisFrame |= bit;
+        m_Buttons |= bit;
+    }
+    else
+    {
+        if (m_Buttons & bit) m_ButtonsReleasedThisFrame |= bit;
+        m_Buttons &= ~bit;
+    }
 }
@@ -1,5 +1,8 @@
 #pragma once
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+struct _SDL_GameController;
 
 namespace GameEngine {
 	constexpr size_t g_maxControllerCount{4};
@@ -15,26 +18,45 @@ namespace GameEngine {
 		B
 	};
 	
+	//One controller slot, fed by SDL's game controller events. The InputManager routes button and
+	//hot-plug events here while it pumps the event queue, so nothing is polled per frame. Headless
+	//tests can drive it with SDL's virtual joysticks or by pushing synthetic events
 	class Controller final
 	{
 	public:
-		explicit Controller(unsigned int controllerIdx);
-		~Controller();
+		Controller() = default;
+		//SDL_Quit closes the controllers that are still open
+		~Controller() = default;
 		Controller(const Controller& other) = delete;
 		Controller(Controller&& other) = delete;
 		Controller& operator=(const Controller& other) = delete;
 		Controller& operator=(Controller&& other) = delete;
 
-		void ProcessControllerInput() const;
+		//Opens the controller at the SDL device index, false if SDL can't open it
+		bool Connect(int deviceIndex);
+		//Buttons that are still held count as released this frame
+		void Disconnect();
+		[[nodiscard]] bool IsConnected() const { return m_pController != nullptr; }
+		//SDL instance id of the connected controller, -1 if none
+		[[nodiscard]] int32_t GetInstanceId() const { return m_InstanceId; }
+
+		//Forgets the presses and releases of the previous frame
+		void StartFrame();
+		//sdlButton is an SDL_GameControllerButton, buttons without a ControllerInputKey are ignored
+		void HandleButtonEvent(uint8_t sdlButton, bool isDown);
 
-		[[nodiscard]] bool IsKeyDown(ControllerInputKey inputKey) const;
-		[[nodiscard]] bool IsKeyPressed(ControllerInputKey inputKey) const;
-		[[nodiscard]] bool IsKeyUp(ControllerInputKey inputKey) const;
+		[[nodiscard]] bool IsKeyDown(ControllerInputKey inputKey) const { return m_ButtonsPressedThisFrame & GetKeyBit(inputKey); }
+		[[nodiscard]] bool IsKeyPressed(ControllerInputKey inputKey) const { return m_Buttons & GetKeyBit(inputKey); }
+		[[nodiscard]] bool IsKeyUp(ControllerInputKey inputKey) const { return m_ButtonsReleasedThisFrame & GetKeyBit(inputKey); }
 
 	private:
-		class XInput;
-		std::unique_ptr<XInput> m_pXInput;
+		[[nodiscard]] static uint32_t GetKeyBit(ControllerInputKey inputKey) { return 1u << static_cast<uint32_t>(inputKey); }
+
+		_SDL_GameController* m_pController{};
+		int32_t m_InstanceId{ -1 };
+		//one bit per ControllerInputKey
+		uint32_t m_Buttons{};
+		uint32_t m_ButtonsPressedThisFrame{};
+		uint32_t m_ButtonsReleasedThisFrame{};
 	};
 }
-
-
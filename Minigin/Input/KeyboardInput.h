@@ -18,7 +18,10 @@ namespace GameEngine
         KeyboardInput& operator=(const KeyboardInput& other) = delete;
         KeyboardInput& operator=(KeyboardInput&& other) = delete;
 
-        [[nodiscard]] bool ProcessKeyboardInput() const;
+        //Forgets the presses and releases of the previous frame
+        void StartFrame() const;
+        //scancode is the SDL_Scancode of an SDL_KEYDOWN or SDL_KEYUP event
+        void HandleKeyEvent(int scancode, bool isDown) const;
 
         [[nodiscard]] bool IsKeyDown(KeyboardInputKey inputKey) const;
         [[nodiscard]] bool IsKeyUp(KeyboardInputKey inputKey) const;
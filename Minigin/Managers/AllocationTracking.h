@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdlib>
+#include <new>
+
+#include "Telemetry.h"
+
+//Replaces the global operator new and delete so Telemetry can count heap allocations.
+//Include it in exactly one source file of the executable, replacements in a static library
+//aren't reliably picked over the ones of the runtime
+void* operator new(size_t size)
+{
+	GameEngine::Telemetry::CountAllocation();
+	if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+	throw std::bad_alloc{};
+}
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
@@ -2,8 +2,15 @@
 #include "Minigin/Components/CollisionComponent.h"
 #include "Minigin/Renderable/Renderer.h"
 #include "Minigin/Subjects/GameObject.h"
+#include "Telemetry.h"
 using namespace GameEngine;
 
+namespace
+{
+    const MetricId g_PairsMetric{ Telemetry::GetInstance().RegisterHistogram("collision pairs tested") };
+    const MetricId g_HitsMetric{ Telemetry::GetInstance().RegisterCounter("collision hits") };
+}
+
 void CollisionManager::AddCollisionComponent(GameEngine::CollisionComponent* collisionComponent)
 {
     m_CollisionComponents.emplace_back(collisionComponent);
@@ -16,6 +23,7 @@ void CollisionManager::CheckCollisions() const
 {
     if(m_CollisionComponents.empty()) return;
     const size_t size = m_CollisionComponents.size();
+    uint64_t nrOfHits{};
     for (size_t first = 0; first < size - 1; ++first)
     {
         for (size_t second = first + 1; second < size; ++second)
@@ -24,9 +32,13 @@ void CollisionManager::CheckCollisions() const
             {
                 m_CollisionComponents[first]->CollidedWith(m_CollisionComponents[second]);
                 m_CollisionComponents[second]->CollidedWith(m_CollisionComponents[first]);
+                ++nrOfHits;
             }
         }
     }
+    auto& telemetry = Telemetry::GetInstance();
+    telemetry.Record(g_PairsMetric, size * (size - 1) / 2);
+    telemetry.Add(g_HitsMetric, nrOfHits);
 }
 void CollisionManager::RenderCollisionRects() const
 {
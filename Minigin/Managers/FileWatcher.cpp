@@ -0,0 +1,156 @@
+#include "FileWatcher.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std::chrono;
+using namespace GameEngine;
+
+FileWatcher::~FileWatcher()
+{
+    m_IsRunning = false;
+    if (m_WatchThread.joinable()) m_WatchThread.join();
+#ifdef __linux__
+    if (m_Inotify != -1) close(m_Inotify);
+#endif
+}
+
+FileWatcher::WatchId FileWatcher::Watch(const std::string& path, Callback onChanged)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const std::filesystem::path absolutePath = std::filesystem::absolute(path).lexically_normal();
+    WatchedFile file{ m_NextId++, absolutePath.parent_path(), absolutePath.filename(), path, std::move(onChanged), {} };
+    std::error_code error;
+    file.lastWriteTime = std::filesystem::last_write_time(absolutePath, error);
+
+#ifdef __linux__
+    if (m_Inotify == -1) m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_Inotify != -1)
+    {
+        //adding a directory twice returns the descriptor it already has
+        const int directory = inotify_add_watch(m_Inotify, file.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (directory != -1) m_Directories[directory] = file.directory;
+        else std::cerr << "Couldn't watch " << file.directory << ", changes to " << path << " go unnoticed\n";
+    }
+#endif
+
+    const WatchId id = file.id;
+    m_Files.emplace_back(std::move(file));
+    if (!m_WatchThread.joinable())
+    {
+        m_IsRunning = true;
+        m_WatchThread = std::thread(&FileWatcher::RunWatchThread, this);
+    }
+    return id;
+}
+
+void FileWatcher::Unwatch(WatchId id)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const auto it = std::ranges::find(m_Files, id, &WatchedFile::id);
+    if (it == m_Files.end()) return;
+    const std::filesystem::path directory = it->directory;
+    m_Files.erase(it);
+
+#ifdef __linux__
+    if (std::ranges::any_of(m_Files, [&](const WatchedFile& file) { return file.directory == directory; })) return;
+    const auto directoryIt = std::ranges::find_if(m_Directories, [&](const auto& pair) { return pair.second == directory; });
+    if (directoryIt == m_Directories.end()) return;
+    inotify_rm_watch(m_Inotify, directoryIt->first);
+    m_Directories.erase(directoryIt);
+#endif
+}
+
+void FileWatcher::RunWatchThread()
+{
+    std::vector<WatchId> pending{};
+    steady_clock::time_point changeTime{};
+    while (m_IsRunning)
+    {
+        const bool wasPending = !pending.empty();
+        if (CollectChanges(pending, wasPending ? m_SettleTime : m_PollInterval))
+        {
+            if (!wasPending) changeTime = steady_clock::now();
+            continue;
+        }
+        if (!wasPending) continue;
+        Dispatch(pending, changeTime);
+        pending.clear();
+    }
+}
+
+#ifdef __linux__
+bool FileWatcher::CollectChanges(std::vector<WatchId>& pending, milliseconds timeout)
+{
+    pollfd descriptor{ m_Inotify, POLLIN, 0 };
+    if (poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0) return false;
+
+    //events are aligned to their watch descriptor and never split over reads
+    alignas(inotify_event) char buffer[4096];
+    bool hasChanged = false;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ssize_t size;
+    while ((size = read(m_Inotify, buffer, sizeof(buffer))) > 0)
+    {
+        for (ssize_t offset = 0; offset < size;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            const auto directoryIt = m_Directories.find(event->wd);
+            if (event->len == 0 || directoryIt == m_Directories.end()) continue;
+
+            const std::filesystem::path fileName{ event->name };
+            for (const WatchedFile& file : m_Files)
+            {
+                if (file.fileName != fileName || file.directory != directoryIt->second) continue;
+                if (std::ranges::find(pending, file.id) == pending.end()) pending.emplace_back(file.id);
+                hasChanged = true;
+            }
+        }
+    }
+    return hasChanged;
+}
+#else
+bool FileWatcher::CollectChanges(std::vector<WatchId>& pending, milliseconds timeout)
+{
+    std::this_thread::sleep_for(timeout);
+
+    bool hasChanged = false;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (WatchedFile& file : m_Files)
+    {
+        std::error_code error;
+        const auto writeTime = std::filesystem::last_write_time(file.directory / file.fileName, error);
+        //a file that is being replaced can briefly be missing
+        if (error || writeTime == file.lastWriteTime) continue;
+        file.lastWriteTime = writeTime;
+        if (std::ranges::find(pending, file.id) == pending.end()) pending.emplace_back(file.id);
+        hasChanged = true;
+    }
+    return hasChanged;
+}
+#endif
+
+void FileWatcher::Dispatch(const std::vector<WatchId>& pending, steady_clock::time_point changeTime)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const WatchId id : pending)
+    {
+        //unwatched while the change was settling
+        const auto it = std::ranges::find(m_Files, id, &WatchedFile::id);
+        if (it == m_Files.end()) continue;
+        try
+        {
+            it->onChanged(it->path, changeTime);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Reloading " << it->path << " failed: " << e.what() << '\n';
+        }
+    }
+}
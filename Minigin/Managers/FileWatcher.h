@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Singleton.h"
+
+namespace GameEngine
+{
+	//Calls back when watched files change, e.g. to reload data files while the game runs. Linux is told
+	//about changes by inotify, other platforms compare write times every poll interval. Changes are
+	//reported once the file has been quiet for a moment, so an editor saving in several steps causes
+	//one callback. Callbacks run on the watcher thread, one at a time: slow work like parsing belongs
+	//there, but the results have to be handed to the game thread. They may not call Watch or Unwatch
+	class FileWatcher final : public Singleton<FileWatcher>
+	{
+	public:
+		using WatchId = uint32_t;
+		//changeTime is when the change was first noticed, for measuring the reload latency
+		using Callback = std::function<void(const std::string& path, std::chrono::steady_clock::time_point changeTime)>;
+
+		//The file doesn't have to exist yet, creating it counts as a change
+		WatchId Watch(const std::string& path, Callback onChanged);
+		//Waits for a running callback of the watch, it is never called again afterwards
+		void Unwatch(WatchId id);
+
+		~FileWatcher() override;
+	private:
+		friend class Singleton<FileWatcher>;
+		FileWatcher() = default;
+
+		struct WatchedFile
+		{
+			WatchId id;
+			std::filesystem::path directory;
+			std::filesystem::path fileName;
+			std::string path;
+			Callback onChanged;
+			//only used when polling
+			std::filesystem::file_time_type lastWriteTime;
+		};
+
+		void RunWatchThread();
+		//Adds the files that changed within the timeout to the pending ones, returns whether any did
+		bool CollectChanges(std::vector<WatchId>& pending, std::chrono::milliseconds timeout);
+		void Dispatch(const std::vector<WatchId>& pending, std::chrono::steady_clock::time_point changeTime);
+
+		//how long a file has to be left alone before its change is reported
+		static constexpr std::chrono::milliseconds m_SettleTime{ 50 };
+		//also bounds how long stopping the thread takes
+		static constexpr std::chrono::milliseconds m_PollInterval{ 100 };
+
+		//held while callbacks run, which is what makes Unwatch wait for them
+		std::mutex m_Mutex{};
+		std::vector<WatchedFile> m_Files{};
+		WatchId m_NextId{};
+		std::thread m_WatchThread{};
+		std::atomic<bool> m_IsRunning{};
+#ifdef __linux__
+		int m_Inotify{ -1 };
+		//inotify watches the directories, editors often save by replacing the file
+		std::unordered_map<int, std::filesystem::path> m_Directories{};
+#endif
+	};
+}
@@ -0,0 +1,187 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+using namespace std::chrono;
+using namespace GameEngine;
+
+LatencyHistogram::LatencyHistogram() :
+    m_Buckets(m_NrOfBuckets)
+{}
+
+void LatencyHistogram::Add(float milliseconds)
+{
+    const auto bucket = static_cast<size_t>(std::max(milliseconds, 0.f) / m_BucketSize);
+    ++m_Buckets[std::min(bucket, m_NrOfBuckets - 1)];
+    ++m_NrOfSamples;
+    m_Total += milliseconds;
+    m_Max = std::max(m_Max, milliseconds);
+}
+
+void LatencyHistogram::Clear()
+{
+    std::ranges::fill(m_Buckets, 0u);
+    m_NrOfSamples = 0;
+    m_Total = 0;
+    m_Max = 0;
+}
+
+float LatencyHistogram::GetPercentile(float percentile) const
+{
+    if (m_NrOfSamples == 0) return 0.f;
+    //the smallest bucket that has at least the requested share of the samples at or below it
+    const auto rank = static_cast<uint32_t>(std::ceil(percentile / 100.f * static_cast<float>(m_NrOfSamples)));
+    uint32_t count{};
+    for (size_t i = 0; i < m_NrOfBuckets; ++i)
+    {
+        count += m_Buckets[i];
+        if (count >= std::max(rank, 1u)) return std::min(static_cast<float>(i + 1) * m_BucketSize, m_Max);
+    }
+    return m_Max;
+}
+
+LatencySummary LatencyHistogram::GetSummary() const
+{
+    return LatencySummary{ m_NrOfSamples, m_NrOfSamples == 0 ? 0.f : static_cast<float>(m_Total / m_NrOfSamples),
+        GetPercentile(50.f), GetPercentile(95.f), GetPercentile(99.f), m_Max };
+}
+
+void LatencyHistogram::WriteBuckets(std::ostream& stream) const
+{
+    for (size_t i = 0; i < m_NrOfBuckets; ++i)
+    {
+        if (m_Buckets[i] != 0) stream << static_cast<float>(i) * m_BucketSize << ',' << m_Buckets[i] << '\n';
+    }
+}
+
+FramePacer::FramePacer()
+{
+    SetTargetFrameRate(m_TargetFrameRate);
+#ifdef _WIN32
+    //needs Windows 10 1803, older versions fall back to sleep_for
+    m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+    if (m_Timer != nullptr) CloseHandle(m_Timer);
+#endif
+}
+
+void FramePacer::SetTargetFrameRate(float framesPerSecond)
+{
+    m_TargetFrameRate = framesPerSecond;
+    m_FrameDuration = framesPerSecond > 0.f ?
+        duration_cast<Clock::duration>(duration<double>(1.0 / framesPerSecond)) : Clock::duration::zero();
+}
+
+void FramePacer::StartSession()
+{
+    m_FrameTimes.Clear();
+    {
+        std::lock_guard<std::mutex> lock(m_InputLatencyMutex);
+        m_InputLatencies.Clear();
+    }
+    m_FrameStart = Clock::now();
+    m_Deadline = m_FrameStart;
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if (m_FrameDuration > Clock::duration::zero())
+    {
+        //deadlines are a fixed period apart so waits don't accumulate drift
+        m_Deadline += m_FrameDuration;
+        const auto now = Clock::now();
+        //a frame that ran over by more than a whole frame starts a new schedule instead of rushing to catch up
+        if (now > m_Deadline + m_FrameDuration) m_Deadline = now;
+        else
+        {
+            SleepUntil(m_Deadline - m_SpinTime);
+            while (Clock::now() < m_Deadline) std::this_thread::yield();
+        }
+    }
+    const auto now = Clock::now();
+    m_FrameTimes.Add(duration<float, std::milli>(now - m_FrameStart).count());
+    Telemetry::GetInstance().Record(m_FrameTimeMetric, static_cast<uint64_t>(duration_cast<microseconds>(now - m_FrameStart).count()));
+    m_FrameStart = now;
+}
+
+void FramePacer::SleepUntil(Clock::time_point time) const
+{
+    const auto remaining = time - Clock::now();
+    if (remaining <= Clock::duration::zero()) return;
+#ifdef _WIN32
+    if (m_Timer != nullptr)
+    {
+        //negative due times are relative, in 100 ns units
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>(duration_cast<nanoseconds>(remaining).count() / 100);
+        if (SetWaitableTimerEx(m_Timer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+        {
+            WaitForSingleObject(m_Timer, INFINITE);
+            return;
+        }
+    }
+#endif
+    std::this_thread::sleep_for(remaining);
+}
+
+void FramePacer::RecordPresent(Clock::time_point inputTime)
+{
+    const float latency = duration<float, std::milli>(Clock::now() - inputTime).count();
+    std::lock_guard<std::mutex> lock(m_InputLatencyMutex);
+    m_InputLatencies.Add(latency);
+}
+
+void FramePacer::EndSession()
+{
+    if (!m_StatisticsFile.empty()) ExportStatistics(m_StatisticsFile);
+}
+
+LatencySummary FramePacer::GetFrameTimes() const
+{
+    return m_FrameTimes.GetSummary();
+}
+
+LatencySummary FramePacer::GetInputLatencies() const
+{
+    std::lock_guard<std::mutex> lock(m_InputLatencyMutex);
+    return m_InputLatencies.GetSummary();
+}
+
+void FramePacer::ExportStatistics(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "Couldn't write the frame statistics to " << path << '\n';
+        return;
+    }
+    const auto writeSummary = [&file](const char* name, const LatencySummary& summary) {
+        file << name << ',' << summary.nrOfSamples << ',' << summary.mean << ',' << summary.p50 << ','
+            << summary.p95 << ',' << summary.p99 << ',' << summary.max << '\n';
+    };
+    file << "metric,samples,mean ms,p50 ms,p95 ms,p99 ms,max ms\n";
+    writeSummary("frame time", GetFrameTimes());
+    writeSummary("input to present", GetInputLatencies());
+
+    file << "\nframe time ms,count\n";
+    m_FrameTimes.WriteBuckets(file);
+    file << "\ninput to present ms,count\n";
+    std::lock_guard<std::mutex> lock(m_InputLatencyMutex);
+    m_InputLatencies.WriteBuckets(file);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Singleton.h"
+#include "Telemetry.h"
+
+namespace GameEngine
+{
+	struct LatencySummary
+	{
+		uint32_t nrOfSamples;
+		float mean;
+		float p50;
+		float p95;
+		float p99;
+		float max;
+	};
+
+	//Millisecond samples counted in fixed 10 µs buckets, anything past the last bucket is clamped into it
+	class LatencyHistogram final
+	{
+	public:
+		LatencyHistogram();
+		void Add(float milliseconds);
+		void Clear();
+		[[nodiscard]] float GetPercentile(float percentile) const;
+		[[nodiscard]] LatencySummary GetSummary() const;
+		//One "bucket start,count" line per non empty bucket
+		void WriteBuckets(std::ostream& stream) const;
+	private:
+		static constexpr float m_BucketSize{ 0.01f };
+		static constexpr size_t m_NrOfBuckets{ 10000 };
+		std::vector<uint32_t> m_Buckets{};
+		uint32_t m_NrOfSamples{};
+		double m_Total{};
+		float m_Max{};
+	};
+
+	//Ends each frame on a fixed deadline. It sleeps on a high resolution timer until shortly before
+	//the deadline and spins the rest, since sleeps overshoot by up to the OS timer resolution.
+	//Frame times and the time from sampling input to presenting the frame are kept per session
+	class FramePacer final : public GameEngine::Singleton<FramePacer>
+	{
+	public:
+		using Clock = std::chrono::high_resolution_clock;
+
+		//0 runs uncapped
+		void SetTargetFrameRate(float framesPerSecond);
+		[[nodiscard]] float GetTargetFrameRate() const { return m_TargetFrameRate; }
+		//How long before the deadline the pacer stops sleeping and starts spinning
+		void SetSpinTime(std::chrono::microseconds spinTime) { m_SpinTime = spinTime; }
+		//Written when the session ends, leave empty to not export anything
+		void SetStatisticsFile(const std::string& path) { m_StatisticsFile = path; }
+
+		void StartSession();
+		//Waits for the current frame's deadline and records its frame time
+		void WaitForNextFrame();
+		//Called by the render thread once the frame whose input was sampled at inputTime is presented
+		void RecordPresent(Clock::time_point inputTime);
+		void EndSession();
+
+		[[nodiscard]] LatencySummary GetFrameTimes() const;
+		[[nodiscard]] LatencySummary GetInputLatencies() const;
+		void ExportStatistics(const std::string& path) const;
+
+		~FramePacer() override;
+	private:
+		friend class GameEngine::Singleton<FramePacer>;
+		FramePacer();
+
+		void SleepUntil(Clock::time_point time) const;
+
+		float m_TargetFrameRate{ 160.f };
+		Clock::duration m_FrameDuration{};
+		std::chrono::microseconds m_SpinTime{ 1000 };
+		Clock::time_point m_Deadline{};
+		Clock::time_point m_FrameStart{};
+		std::string m_StatisticsFile{};
+
+		LatencyHistogram m_FrameTimes{};
+		MetricId m_FrameTimeMetric{ Telemetry::GetInstance().RegisterHistogram("frame time us") };
+		//written by the render thread
+		LatencyHistogram m_InputLatencies{};
+		mutable std::mutex m_InputLatencyMutex{};
+
+		//high resolution waitable timer on Windows, null elsewhere or if it isn't available
+		void* m_Timer{};
+	};
+}
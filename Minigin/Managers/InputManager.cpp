@@ -2,6 +2,9 @@
 
 #include <algorithm>
 #include <ranges>
+#include <SDL.h>
+
+#include "Minigin/Renderable/Renderer.h"
 
 void GameEngine::InputManager::UnbindRemovedCommands()
 {
@@ -17,8 +20,17 @@ void GameEngine::InputManager::UnbindRemovedCommands()
 }
 bool GameEngine::InputManager::ProcessInput()
 {
-    if (!ProcessKeyboardInput()) return false;
-    ProcessControllerInput();
+    m_pKeyboard->StartFrame();
+    for (auto& controller : m_Controllers) controller.StartFrame();
+
+    SDL_Event e;
+    while (SDL_PollEvent(&e))
+    {
+        if (e.type == SDL_QUIT) return false;
+        HandleEvent(e);
+    }
+    ExecuteKeyboardCommands();
+    ExecuteControllerCommands();
     if (m_AreElemsToUnbind)
     {
         m_AreElemsToUnbind = false;
@@ -27,15 +39,53 @@ bool GameEngine::InputManager::ProcessInput()
     return true;
 }
 
+void GameEngine::InputManager::HandleEvent(const SDL_Event& e)
+{
+    switch (e.type)
+    {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        m_pKeyboard->HandleKeyEvent(static_cast<int>(e.key.keysym.scancode), e.type == SDL_KEYDOWN);
+        break;
+    case SDL_CONTROLLERDEVICEADDED:
+        ConnectController(e.cdevice.which);
+        break;
+    case SDL_CONTROLLERDEVICEREMOVED:
+        if (Controller* pController = FindController(e.cdevice.which)) pController->Disconnect();
+        break;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        if (Controller* pController = FindController(e.cbutton.which))
+            pController->HandleButtonEvent(e.cbutton.button, e.type == SDL_CONTROLLERBUTTONDOWN);
+        break;
+    default: ;
+    }
+    Renderer::GetInstance().QueueUIEvent(e);
+}
+
+void GameEngine::InputManager::ConnectController(int deviceIndex)
+{
+    //SDL also reports the controllers that were plugged in before it started
+    if (FindController(SDL_JoystickGetDeviceInstanceID(deviceIndex)) != nullptr) return;
+    const auto it = std::ranges::find_if(m_Controllers, [](const Controller& controller) { return !controller.IsConnected(); });
+    if (it == m_Controllers.end()) return;
+    it->Connect(deviceIndex);
+}
 
-void GameEngine::InputManager::ProcessControllerInput()
+GameEngine::Controller* GameEngine::InputManager::FindController(int32_t instanceId)
+{
+    if (instanceId < 0) return nullptr;
+    const auto it = std::ranges::find_if(m_Controllers, [instanceId](const Controller& controller) {
+        return controller.GetInstanceId() == instanceId;
+    });
+    return it != m_Controllers.end() ? &*it : nullptr;
+}
+
+void GameEngine::InputManager::ExecuteControllerCommands()
 {
     for (size_t i = 0; i < g_maxControllerCount; i++)
     {
-        if (m_pControllers[i] == nullptr) continue;
-        m_pControllers[i]->ProcessControllerInput();
-
-        //TODO: perhaps create an event queue with the inputs received
+        const Controller& controller = m_Controllers[i];
         for (const auto& [inputKey, command] : m_pControllerCommands[i])
         {
             if (command == nullptr) continue;
@@ -43,23 +93,20 @@ void GameEngine::InputManager::ProcessControllerInput()
             switch (command->ExecuteOnKeyState())
             {
             case Command::ExecuteOn::keyPressed:
-                if (m_pControllers[i]->IsKeyPressed(inputKey))
-                    command->Execute();
+                if (controller.IsKeyPressed(inputKey)) command->Execute();
                 break;
             case Command::ExecuteOn::keyUp:
-                if (m_pControllers[i]->IsKeyUp(inputKey)) command->Execute();
+                if (controller.IsKeyUp(inputKey)) command->Execute();
                 break;
             case Command::ExecuteOn::keyDown:
-                if (m_pControllers[i]->IsKeyDown(inputKey)) command->Execute();
+                if (controller.IsKeyDown(inputKey)) command->Execute();
                 break;
             }
         }
     }
 }
-bool GameEngine::InputManager::ProcessKeyboardInput()
+void GameEngine::InputManager::ExecuteKeyboardCommands()
 {
-    if (!m_pKeyboard->ProcessKeyboardInput()) return false;
-    //TODO: perhaps create an event queue with the inputs received
     for (const auto& [inputKey, command] : m_pKeyboardCommands)
     {
         if (command == nullptr) continue;
@@ -83,7 +130,6 @@ bool GameEngine::InputManager::ProcessKeyboardInput()
         break;
         }
     }
-    return true;
 }
 
 void GameEngine::InputManager::BindCommand(KeyboardInputKey inputKey, std::unique_ptr<Command>&& command)
@@ -92,9 +138,6 @@ void GameEngine::InputManager::BindCommand(KeyboardInputKey inputKey, std::uniqu
 }
 void GameEngine::InputManager::BindCommand(ControllerInputKey inputKey, std::unique_ptr<Command>&& command, int controllerIdx)
 {
-    if (m_pControllers[controllerIdx] == nullptr)
-        m_pControllers[controllerIdx] = std::make_unique<Controller>(controllerIdx);
-
     m_pControllerCommands[controllerIdx][inputKey] = std::move(command);
 }
 
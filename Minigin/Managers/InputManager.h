@@ -6,9 +6,10 @@
 #include <array>
 #include <unordered_map>
 
+union SDL_Event;
+
 namespace GameEngine
 {
-    class KeyboardInput;
     class InputManager final : public Singleton<InputManager>
     {
     public:
@@ -20,15 +21,21 @@ namespace GameEngine
         ~InputManager() override = default;
 
         void UnbindRemovedCommands();
+        //Pumps the SDL event queue and executes the commands, false once the window is closed
         bool ProcessInput();
-        void ProcessControllerInput();
-        bool ProcessKeyboardInput();
+        //Keyboard, controller and hot-plug events all come through here, synthetic events can be fed in directly
+        void HandleEvent(const SDL_Event& e);
 
         void BindCommand(KeyboardInputKey inputKey, std::unique_ptr<Command>&& command);
         void BindCommand(ControllerInputKey inputKey, std::unique_ptr<Command>&& command, int controllerIdx);
         void UnbindCommand(KeyboardInputKey inputKey);
         void UnbindCommand(ControllerInputKey inputKey, int controllerIdx);
     private:
+        void ExecuteControllerCommands();
+        void ExecuteKeyboardCommands();
+        void ConnectController(int deviceIndex);
+        [[nodiscard]] Controller* FindController(int32_t instanceId);
+
         bool m_AreElemsToUnbind{false};
         //Commands
         typedef std::unique_ptr<Command> CommandUnique;
@@ -37,7 +44,8 @@ namespace GameEngine
         KeyboardCommandMap m_pKeyboardCommands;
         std::array<ControllerCommandMap, g_maxControllerCount> m_pControllerCommands;
 
-        std::array<std::unique_ptr<Controller>, g_maxControllerCount> m_pControllers;
+        //a controller takes the first free slot when it's plugged in and keeps it until it's unplugged
+        std::array<Controller, g_maxControllerCount> m_Controllers;
         std::unique_ptr<KeyboardInput> m_pKeyboard{std::make_unique<KeyboardInput>()};
 
     };
@@ -0,0 +1,251 @@
+﻿#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <glm/trigonometric.hpp>
+#include "TimeManager.h"
+#include "Minigin/SimdPack.h"
+#include "Minigin/Snapshot.h"
+#include "Minigin/Renderable/Renderer.h"
+#include "Minigin/Renderable/Texture2D.h"
+using namespace GameEngine;
+
+namespace
+{
+    //lanes stepped by one task when an emitter is split across the cores
+    constexpr size_t g_ChunkSize{ 4096 };
+
+    size_t RoundUpToBlock(size_t nrOfLanes)
+    {
+        return (nrOfLanes + g_SimdLaneBlock - 1) / g_SimdLaneBlock * g_SimdLaneBlock;
+    }
+
+    //Integrates lanes [first, last). Wrapping lanes are moved back inside the bounds and restart
+    //their lifetime, the others are left to be removed once their age passes their lifetime
+    template<typename Pack, bool isWrapping>
+    void StepLanes(size_t first, size_t last, float elapsed, const glm::vec2& acceleration, const SDL_Rect& bounds,
+        float* posX, float* posY, float* velX, float* velY, float* age, const float* lifeTime)
+    {
+        using Reg = typename Pack::Reg;
+        const Reg dt = Pack::Set(elapsed);
+        const Reg accX = Pack::Set(acceleration.x * elapsed);
+        const Reg accY = Pack::Set(acceleration.y * elapsed);
+        const Reg left = Pack::Set(static_cast<float>(bounds.x));
+        const Reg top = Pack::Set(static_cast<float>(bounds.y));
+        const Reg right = Pack::Set(static_cast<float>(bounds.x + bounds.w));
+        const Reg bottom = Pack::Set(static_cast<float>(bounds.y + bounds.h));
+        const Reg width = Pack::Set(static_cast<float>(bounds.w));
+        const Reg height = Pack::Set(static_cast<float>(bounds.h));
+
+        for (size_t i = first; i < last; i += Pack::width)
+        {
+            const Reg vx = Pack::Add(Pack::Load(velX + i), accX);
+            const Reg vy = Pack::Add(Pack::Load(velY + i), accY);
+            Reg x = Pack::Add(Pack::Load(posX + i), Pack::Mul(vx, dt));
+            Reg y = Pack::Add(Pack::Load(posY + i), Pack::Mul(vy, dt));
+            Reg a = Pack::Add(Pack::Load(age + i), dt);
+            if constexpr (isWrapping)
+            {
+                x = Pack::Select(Pack::Greater(x, right), Pack::Sub(x, width), x);
+                x = Pack::Select(Pack::Greater(left, x), Pack::Add(x, width), x);
+                y = Pack::Select(Pack::Greater(y, bottom), Pack::Sub(y, height), y);
+                y = Pack::Select(Pack::Greater(top, y), Pack::Add(y, height), y);
+                const Reg life = Pack::Load(lifeTime + i);
+                a = Pack::Select(Pack::Greater(a, life), Pack::Sub(a, life), a);
+            }
+            Pack::Store(velX + i, vx);
+            Pack::Store(velY + i, vy);
+            Pack::Store(posX + i, x);
+            Pack::Store(posY + i, y);
+            Pack::Store(age + i, a);
+        }
+    }
+}
+
+ParticleSystem::ParticleSystem() :
+    m_Random(std::random_device{}())
+{}
+
+int ParticleSystem::AddEmitter(const EmitterSettings& settings)
+{
+    m_Emitters.emplace_back(Emitter{ settings, {}, 0 });
+    return static_cast<int>(m_Emitters.size() - 1);
+}
+void ParticleSystem::Burst(int emitter, const glm::vec2& pos, int nrOfParticles)
+{
+    Emitter& target = m_Emitters[emitter];
+    for (int i{}; i < nrOfParticles; ++i)
+    {
+        const size_t lane = Spawn(target);
+        target.particles.posX[lane] = pos.x;
+        target.particles.posY[lane] = pos.y;
+    }
+}
+void ParticleSystem::Fill(int emitter, int nrOfParticles)
+{
+    Emitter& target = m_Emitters[emitter];
+    const SDL_Rect& bounds = target.settings.bounds;
+    std::uniform_real_distribution<float> xDistr{ static_cast<float>(bounds.x), static_cast<float>(bounds.x + bounds.w) };
+    std::uniform_real_distribution<float> yDistr{ static_cast<float>(bounds.y), static_cast<float>(bounds.y + bounds.h) };
+    for (int i{}; i < nrOfParticles; ++i)
+    {
+        const size_t lane = Spawn(target);
+        target.particles.posX[lane] = xDistr(m_Random);
+        target.particles.posY[lane] = yDistr(m_Random);
+        target.particles.age[lane] = std::uniform_real_distribution<float>{ 0.f, target.particles.lifeTime[lane] }(m_Random);
+    }
+}
+size_t ParticleSystem::Spawn(Emitter& emitter)
+{
+    const EmitterSettings& settings = emitter.settings;
+    Particles& particles = emitter.particles;
+    const size_t lane = emitter.nrOfParticles++;
+    if (lane >= particles.age.size()) Resize(particles, RoundUpToBlock(std::max(lane + 1, particles.age.size() * 2)));
+
+    const float angle = glm::radians(std::uniform_real_distribution<float>{ settings.minAngle, settings.maxAngle }(m_Random));
+    const float speed = std::uniform_real_distribution<float>{ settings.minSpeed, settings.maxSpeed }(m_Random);
+    particles.velX[lane] = std::cos(angle) * speed;
+    particles.velY[lane] = std::sin(angle) * speed;
+    particles.age[lane] = 0.f;
+    particles.lifeTime[lane] = std::uniform_real_distribution<float>{ settings.minLifeTime, settings.maxLifeTime }(m_Random);
+    return lane;
+}
+
+void ParticleSystem::Update()
+{
+    const float elapsed = TimeManager::GetElapsed();
+    for (auto& emitter : m_Emitters)
+    {
+        if (emitter.nrOfParticles == 0) continue;
+        Step(emitter, elapsed);
+        if (emitter.settings.isWrapping) continue;
+
+        //swap the dead particles with the last ones, the order of an emitter's particles doesn't matter
+        Particles& particles = emitter.particles;
+        for (size_t lane{}; lane < emitter.nrOfParticles;)
+        {
+            if (particles.age[lane] < particles.lifeTime[lane]) ++lane;
+            else MoveLane(particles, --emitter.nrOfParticles, lane);
+        }
+    }
+}
+void ParticleSystem::Step(Emitter& emitter, float elapsed)
+{
+    const EmitterSettings& settings = emitter.settings;
+    Particles& particles = emitter.particles;
+    //the lanes are allocated in whole blocks, so stepping the padding keeps the kernel free of a tail loop
+    const size_t nrOfLanes = RoundUpToBlock(emitter.nrOfParticles);
+    const auto kernel = settings.isWrapping ? &StepLanes<SimdPack, true> : &StepLanes<SimdPack, false>;
+    const auto stepLanes = [&](size_t first, size_t last)
+    {
+        kernel(first, last, elapsed, settings.acceleration, settings.bounds,
+            particles.posX.data(), particles.posY.data(), particles.velX.data(), particles.velY.data(),
+            particles.age.data(), particles.lifeTime.data());
+    };
+
+    if (emitter.nrOfParticles < m_ParallelThreshold)
+    {
+        stepLanes(0, nrOfLanes);
+        return;
+    }
+    m_ChunkStarts.clear();
+    for (size_t first{}; first < nrOfLanes; first += g_ChunkSize) m_ChunkStarts.emplace_back(first);
+    std::for_each(std::execution::par, m_ChunkStarts.begin(), m_ChunkStarts.end(),
+        [&](size_t first) { stepLanes(first, std::min(first + g_ChunkSize, nrOfLanes)); });
+}
+
+void ParticleSystem::Render(ParticleLayer layer) const
+{
+    for (const auto& emitter : m_Emitters)
+    {
+        const EmitterSettings& settings = emitter.settings;
+        if (settings.layer != layer || emitter.nrOfParticles == 0) continue;
+
+        const Particles& particles = emitter.particles;
+        const glm::vec2 halfSize = settings.size * .5f;
+        const glm::vec2 textureSize = settings.texture != nullptr ? glm::vec2(settings.texture->GetSize()) : glm::vec2{ 1.f, 1.f };
+        const float frameWidth = static_cast<float>(settings.srcRect.w + settings.frameSpacing) / textureSize.x;
+        const float u = static_cast<float>(settings.srcRect.x) / textureSize.x;
+        const float v = static_cast<float>(settings.srcRect.y) / textureSize.y;
+        const float uvWidth = static_cast<float>(settings.srcRect.w) / textureSize.x;
+        const float uvHeight = static_cast<float>(settings.srcRect.h) / textureSize.y;
+
+        m_Vertices.resize(emitter.nrOfParticles * 4);
+        for (size_t lane{}; lane < emitter.nrOfParticles; ++lane)
+        {
+            const float lifeRatio = std::clamp(particles.age[lane] / particles.lifeTime[lane], 0.f, 1.f);
+            const int frame = std::min(static_cast<int>(lifeRatio * settings.nrOfFrames), settings.nrOfFrames - 1);
+            const float frameU = u + frameWidth * static_cast<float>(frame);
+            SDL_Color color = settings.color;
+            if (settings.isFadingOut) color.a = static_cast<Uint8>(color.a * (1.f - lifeRatio));
+
+            const float left = particles.posX[lane] - halfSize.x;
+            const float top = particles.posY[lane] - halfSize.y;
+            SDL_Vertex* quad = &m_Vertices[lane * 4];
+            quad[0] = { { left, top }, color, { frameU, v } };
+            quad[1] = { { left + settings.size.x, top }, color, { frameU + uvWidth, v } };
+            quad[2] = { { left + settings.size.x, top + settings.size.y }, color, { frameU + uvWidth, v + uvHeight } };
+            quad[3] = { { left, top + settings.size.y }, color, { frameU, v + uvHeight } };
+        }
+
+        //the index pattern is the same for every emitter, it only grows
+        for (size_t quad = m_Indices.size() / 6; quad < emitter.nrOfParticles; ++quad)
+        {
+            const int first = static_cast<int>(quad * 4);
+            m_Indices.insert(m_Indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+        }
+        Renderer::GetInstance().RenderGeometry(settings.texture, m_Vertices.data(), static_cast<int>(m_Vertices.size()),
+            m_Indices.data(), static_cast<int>(emitter.nrOfParticles * 6));
+    }
+}
+
+size_t ParticleSystem::GetNrOfParticles() const
+{
+    size_t nrOfParticles{};
+    for (const auto& emitter : m_Emitters) nrOfParticles += emitter.nrOfParticles;
+    return nrOfParticles;
+}
+void ParticleSystem::Resize(Particles& particles, size_t nrOfLanes)
+{
+    for (auto* lanes : { &particles.posX, &particles.posY, &particles.velX, &particles.velY, &particles.age })
+        lanes->resize(nrOfLanes, 0.f);
+    //keeps the lifetime of padding lanes non zero
+    particles.lifeTime.resize(nrOfLanes, 1.f);
+}
+void ParticleSystem::MoveLane(Particles& particles, size_t from, size_t to)
+{
+    particles.posX[to] = particles.posX[from];
+    particles.posY[to] = particles.posY[from];
+    particles.velX[to] = particles.velX[from];
+    particles.velY[to] = particles.velY[from];
+    particles.age[to] = particles.age[from];
+    particles.lifeTime[to] = particles.lifeTime[from];
+}
+
+void ParticleSystem::SaveState(Snapshot& snapshot) const
+{
+    snapshot.Write(m_Random);
+    snapshot.Write(static_cast<uint32_t>(m_Emitters.size()));
+    for (const auto& emitter : m_Emitters)
+    {
+        const Particles& particles = emitter.particles;
+        snapshot.Write(static_cast<uint32_t>(emitter.nrOfParticles));
+        for (const auto* lanes : { &particles.posX, &particles.posY, &particles.velX, &particles.velY, &particles.age, &particles.lifeTime })
+            snapshot.WriteArray(lanes->data(), emitter.nrOfParticles);
+    }
+}
+void ParticleSystem::LoadState(Snapshot& snapshot)
+{
+    snapshot.Read(m_Random);
+    //emitters are only added while the scene is built, so the saved ones are the first ones
+    const auto nrOfEmitters = snapshot.Read<uint32_t>();
+    for (uint32_t i{}; i < nrOfEmitters; ++i)
+    {
+        Emitter& emitter = m_Emitters[i];
+        Particles& particles = emitter.particles;
+        emitter.nrOfParticles = snapshot.Read<uint32_t>();
+        if (emitter.nrOfParticles > particles.age.size()) Resize(particles, RoundUpToBlock(emitter.nrOfParticles));
+        for (auto* lanes : { &particles.posX, &particles.posY, &particles.velX, &particles.velY, &particles.age, &particles.lifeTime })
+            snapshot.ReadArray(lanes->data(), emitter.nrOfParticles);
+    }
+}
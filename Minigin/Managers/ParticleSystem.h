@@ -0,0 +1,97 @@
+﻿#pragma once
+#include <random>
+#include <vector>
+#include <SDL_rect.h>
+#include <SDL_pixels.h>
+#include <SDL_render.h>
+#include <glm/vec2.hpp>
+
+namespace GameEngine
+{
+    class Texture2D;
+    class Snapshot;
+    //background particles are drawn before the scene's objects, foreground ones after them
+    enum class ParticleLayer
+    {
+        background,
+        foreground
+    };
+    struct EmitterSettings
+    {
+        //nullptr draws plain colored quads
+        Texture2D* texture{};
+        //first animation frame, the others follow to its right. The frames are spread over the lifetime
+        SDL_Rect srcRect{};
+        int nrOfFrames{ 1 };
+        int frameSpacing{};
+        glm::vec2 size{ 1.f, 1.f };
+        float minLifeTime{ 1.f };
+        float maxLifeTime{ 1.f };
+        float minSpeed{};
+        float maxSpeed{};
+        //in degrees, 0 points right and 90 down
+        float minAngle{};
+        float maxAngle{ 360.f };
+        glm::vec2 acceleration{};
+        SDL_Color color{ 255, 255, 255, 255 };
+        bool isFadingOut{};
+        //wrapping particles never die, they wrap around the bounds and restart their lifetime
+        bool isWrapping{};
+        SDL_Rect bounds{};
+        ParticleLayer layer{ ParticleLayer::foreground };
+    };
+
+    //Owns the particles of a scene. They are kept as SoA lanes per emitter, stepped by a SIMD
+    //kernel and drawn with one geometry call per emitter, no game object is created for them
+    class ParticleSystem final
+    {
+    public:
+        ParticleSystem();
+        ParticleSystem(const ParticleSystem& other) = delete;
+        ParticleSystem(ParticleSystem&& other) noexcept = delete;
+        ParticleSystem& operator=(const ParticleSystem& other) = delete;
+        ParticleSystem& operator=(ParticleSystem&& other) noexcept = delete;
+
+        //Emitters live as long as the scene, add them while building it
+        [[nodiscard]] int AddEmitter(const EmitterSettings& settings);
+        //Spawns the particles at pos, which is the center of their quads
+        void Burst(int emitter, const glm::vec2& pos, int nrOfParticles);
+        //Spawns the particles spread over the emitter bounds, with their lifetime already under way
+        void Fill(int emitter, int nrOfParticles);
+        void Update();
+        void Render(ParticleLayer layer) const;
+        void SaveState(Snapshot& snapshot) const;
+        void LoadState(Snapshot& snapshot);
+
+        [[nodiscard]] size_t GetNrOfParticles() const;
+        [[nodiscard]] size_t GetNrOfParticles(int emitter) const { return m_Emitters[emitter].nrOfParticles; }
+        //Emitters with at least this many particles are stepped in chunks across the cores
+        void SetParallelThreshold(size_t nrOfParticles) { m_ParallelThreshold = nrOfParticles; }
+
+        ~ParticleSystem() = default;
+    private:
+        struct Particles
+        {
+            std::vector<float> posX, posY;
+            std::vector<float> velX, velY;
+            std::vector<float> age, lifeTime;
+        };
+        struct Emitter
+        {
+            EmitterSettings settings;
+            Particles particles;
+            size_t nrOfParticles;
+        };
+        size_t Spawn(Emitter& emitter);
+        void Step(Emitter& emitter, float elapsed);
+        static void Resize(Particles& particles, size_t nrOfLanes);
+        static void MoveLane(Particles& particles, size_t from, size_t to);
+
+        std::vector<Emitter> m_Emitters{};
+        std::minstd_rand m_Random;
+        size_t m_ParallelThreshold{ 16384 };
+        std::vector<size_t> m_ChunkStarts{};
+        mutable std::vector<SDL_Vertex> m_Vertices{};
+        mutable std::vector<int> m_Indices{};
+    };
+}
@@ -2,8 +2,13 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include "ResourceManager.h"
-#include "Minigin/Renderable/Renderer.h"
 #include "Minigin/Renderable/Font.h"
+#include "Telemetry.h"
+
+namespace
+{
+	const GameEngine::MetricId g_AssetLoadMetric{ GameEngine::Telemetry::GetInstance().RegisterHistogram("asset load us") };
+}
 
 void GameEngine::ResourceManager::Init(const std::string& dataPath)
 {
@@ -20,12 +25,15 @@ GameEngine::Texture2D* GameEngine::ResourceManager::LoadTexture(const std::strin
 	const auto fullPath = m_dataPath + file;
 	if(m_TextureMap.contains(fullPath)) return m_TextureMap.at(fullPath).get();
 	
-	auto texture = IMG_LoadTexture(Renderer::GetInstance().GetSDLRenderer(), fullPath.c_str());
-	if (texture == nullptr)
+	ScopedTimer timer{ g_AssetLoadMetric };
+	//the render thread uploads the surface, it owns the renderer
+	auto surface = IMG_Load(fullPath.c_str());
+	if (surface == nullptr)
 	{
 		throw std::runtime_error(std::string("Failed to load texture: ") + SDL_GetError());
 	}
-	m_TextureMap[fullPath] = std::make_unique<Texture2D>(texture);
+	m_TextureMap[fullPath] = std::make_unique<Texture2D>(surface);
+	m_TexturePaths[m_TextureMap.at(fullPath).get()] = fullPath;
 	
 	return m_TextureMap.at(fullPath).get();
 }
@@ -37,5 +45,69 @@ GameEngine::Texture2D* GameEngine::ResourceManager::LoadTexture(std::unique_ptr<
 
 std::shared_ptr<GameEngine::Font> GameEngine::ResourceManager::LoadFont(const std::string& file, unsigned int size) const
 {
+	ScopedTimer timer{ g_AssetLoadMetric };
 	return std::make_shared<Font>(m_dataPath + file, size);
 }
+
+const GameEngine::CollisionMask* GameEngine::ResourceManager::LoadCollisionMask(const Texture2D* texture, const SDL_Rect& srcRect,
+	SDL_RendererFlip flipMode, const glm::ivec2& destSize)
+{
+	const auto pathIt = m_TexturePaths.find(texture);
+	if (pathIt == m_TexturePaths.end()) return nullptr;
+
+	auto& masks = m_CollisionMasks[texture];
+	if (masks.alphaMask == nullptr) masks.alphaMask = CreateAlphaMask(pathIt->second);
+
+	const MaskKey key{ srcRect, flipMode, destSize };
+	auto& region = masks.regions[key];
+	if (region == nullptr) region = std::make_unique<CollisionMask>(masks.alphaMask->Extract(srcRect, flipMode, destSize));
+	return region.get();
+}
+
+std::unique_ptr<GameEngine::CollisionMask> GameEngine::ResourceManager::CreateAlphaMask(const std::string& fullPath) const
+{
+	//the texture itself lives on the gpu, the pixels are read once more from the file
+	SDL_Surface* loaded = IMG_Load(fullPath.c_str());
+	if (loaded == nullptr)
+	{
+		throw std::runtime_error(std::string("Failed to load collision mask: ") + SDL_GetError());
+	}
+	SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(loaded);
+	if (surface == nullptr)
+	{
+		throw std::runtime_error(std::string("Failed to convert collision mask: ") + SDL_GetError());
+	}
+
+	constexpr Uint8 alphaThreshold{ 128 };
+	auto mask = std::make_unique<CollisionMask>(surface->w, surface->h);
+	SDL_LockSurface(surface);
+	for (int y = 0; y < surface->h; ++y)
+	{
+		const auto* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+		for (int x = 0; x < surface->w; ++x)
+		{
+			//RGBA32 is byte ordered, alpha is the 4th byte on every platform
+			if (row[x * 4 + 3] >= alphaThreshold) mask->SetBit(x, y);
+		}
+	}
+	SDL_UnlockSurface(surface);
+	SDL_FreeSurface(surface);
+	return mask;
+}
+
+bool GameEngine::ResourceManager::MaskKey::operator==(const MaskKey& other) const
+{
+	return srcRect.x == other.srcRect.x && srcRect.y == other.srcRect.y && srcRect.w == other.srcRect.w &&
+		srcRect.h == other.srcRect.h && flipMode == other.flipMode && destSize == other.destSize;
+}
+
+size_t GameEngine::ResourceManager::MaskKeyHash::operator()(const MaskKey& key) const
+{
+	size_t hash{ 17 };
+	for (const int value : { key.srcRect.x, key.srcRect.y, key.srcRect.w, key.srcRect.h, static_cast<int>(key.flipMode), key.destSize.x, key.destSize.y })
+	{
+		hash = hash * 31 + std::hash<int>{}(value);
+	}
+	return hash;
+}
@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "Singleton.h"
+#include "../CollisionMask.h"
 #include "../Renderable/Texture2D.h"
 
 namespace GameEngine
@@ -16,13 +17,38 @@ namespace GameEngine
 		[[nodiscard]] Texture2D* LoadTexture(const std::string& file);
 		[[nodiscard]] Texture2D* LoadTexture(std::unique_ptr<Texture2D>&& texture);
 		[[nodiscard]] std::shared_ptr<Font> LoadFont(const std::string& file, unsigned int size) const;
+		//Alpha mask of a region of a texture loaded from file, built once per region, flip and size.
+		//Returns nullptr for textures that weren't loaded from a file
+		[[nodiscard]] const CollisionMask* LoadCollisionMask(const Texture2D* texture, const SDL_Rect& srcRect,
+			SDL_RendererFlip flipMode, const glm::ivec2& destSize);
 	private:
 		friend class Singleton<ResourceManager>;
 		ResourceManager() = default;
 
+		struct MaskKey
+		{
+			SDL_Rect srcRect;
+			SDL_RendererFlip flipMode;
+			glm::ivec2 destSize;
+			bool operator==(const MaskKey& other) const;
+		};
+		struct MaskKeyHash
+		{
+			size_t operator()(const MaskKey& key) const;
+		};
+		struct TextureMasks
+		{
+			//1 bit per texel of the whole texture, the regions are cut from it
+			std::unique_ptr<CollisionMask> alphaMask;
+			std::unordered_map<MaskKey, std::unique_ptr<CollisionMask>, MaskKeyHash> regions;
+		};
+		[[nodiscard]] std::unique_ptr<CollisionMask> CreateAlphaMask(const std::string& fullPath) const;
+
 		std::unordered_map<std::string,std::unique_ptr<Texture2D>> m_TextureMap;
 		//for the textures that are init with a texture2d obj (for eg text textures)
 		std::vector<std::unique_ptr<Texture2D>> m_TextureVec;
+		std::unordered_map<const Texture2D*, std::string> m_TexturePaths;
+		std::unordered_map<const Texture2D*, TextureMasks> m_CollisionMasks;
 		std::string m_dataPath;
 	};
 }
@@ -1,14 +1,128 @@
 #include "SceneManager.h"
+#include "FileWatcher.h"
+#include "InputManager.h"
+#include "ResourceManager.h"
+#include "Telemetry.h"
 #include "Minigin/Subjects/GameObject.h"
 
+namespace
+{
+    const GameEngine::MetricId g_SceneInstantiationMetric{ GameEngine::Telemetry::GetInstance().RegisterHistogram("scene instantiation us") };
+}
+
+GameEngine::SceneManager::SceneManager()
+{
+    //the scenes' components unwatch their files when they are destroyed. Statics are destroyed in the reverse
+    //order they were created in, so creating the watcher first makes it outlive the scenes whoever asks first
+    FileWatcher::GetInstance();
+}
 void GameEngine::SceneManager::SetCurrentScene(int sceneId)
 {
     m_CurrentSceneId = sceneId;
 }
 void GameEngine::SceneManager::AddScene(int sceneId, std::unique_ptr<Scene>&& scene)
 {
+    //a session of the scene that is replaced can't step the new one
+    m_RollbackSessions.erase(sceneId);
     m_Scenes[sceneId] = std::move(scene);
 }
+void GameEngine::SceneManager::SetRollbackSession(int sceneId, std::unique_ptr<RollbackSession>&& session)
+{
+    m_RollbackSessions[sceneId] = std::move(session);
+}
+GameEngine::Scene* GameEngine::SceneManager::GetCurrentScene() const
+{
+    const auto it = m_Scenes.find(m_CurrentSceneId);
+    return it == m_Scenes.end() ? nullptr : it->second.get();
+}
+GameEngine::InstantiatedScene GameEngine::SceneManager::InstantiateScene(const SceneBlob& blob, const SceneTypeRegistry& registry) const
+{
+    ScopedTimer timer{ g_SceneInstantiationMetric };
+
+    //every type is looked up by name once, the records only carry indices
+    const auto resolve = [&blob](const std::vector<SceneStringRef>& names, const auto& lookup) {
+        std::vector<std::decay_t<decltype(lookup(std::string{}))>> resolved;
+        resolved.reserve(names.size());
+        for (const SceneStringRef& name : names) resolved.emplace_back(lookup(std::string(blob.GetString(name))));
+        return resolved;
+    };
+    const auto objectIds = resolve(blob.objectIds, [&](const std::string& name) { return registry.GetObjectId(name); });
+    const auto componentTypes = resolve(blob.componentTypes, [&](const std::string& name) { return &registry.GetComponent(name); });
+    const auto observerTypes = resolve(blob.observerTypes, [&](const std::string& name) { return &registry.GetObserver(name); });
+    const auto commandTypes = resolve(blob.commandTypes, [&](const std::string& name) { return &registry.GetCommand(name); });
+
+    SceneInstanceData data{};
+    auto& resourceManager = ResourceManager::GetInstance();
+    data.fonts.resize(blob.resources.size());
+    data.textures.resize(blob.resources.size());
+    for (size_t i = 0; i < blob.resources.size(); ++i)
+    {
+        const std::string file{ blob.GetString(blob.resources[i].file) };
+        if (blob.resources[i].size != 0) data.fonts[i] = resourceManager.LoadFont(file, blob.resources[i].size);
+        else data.textures[i] = resourceManager.LoadTexture(file);
+    }
+
+    InstantiatedScene instance{};
+    instance.scene = std::make_unique<Scene>();
+    instance.scene->ReserveObjects(blob.objects.size());
+    instance.scene->ReserveObservers(blob.observers.size());
+
+    //all objects exist before the first component is made, so components can refer to any of them
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.reserve(blob.objects.size());
+    data.objects.reserve(blob.objects.size());
+    for (const SceneObjectRecord& record : blob.objects)
+    {
+        auto& object = objects.emplace_back(std::make_unique<GameObject>(objectIds.at(record.id)));
+        object->SetRenderLayer(static_cast<RenderLayer>(record.renderLayer));
+        object->ReserveComponents(record.nrOfComponents);
+        object->SetPosition(record.x, record.y);
+        if (record.parent >= 0) object->SetParent(data.objects.at(record.parent), false);
+        data.objects.emplace_back(object.get());
+    }
+    for (size_t i = 0; i < blob.objects.size(); ++i)
+    {
+        const SceneObjectRecord& record = blob.objects[i];
+        for (uint32_t componentIdx = record.firstComponent; componentIdx < record.firstComponent + record.nrOfComponents; ++componentIdx)
+        {
+            const SceneComponentRecord& component = blob.components.at(componentIdx);
+            (*componentTypes.at(component.type))(*objects[i], SceneArgs{ blob, data, component.firstArg, component.nrOfArgs });
+        }
+    }
+    //the scene registers the colliders and sprites when the object is added, so it has to be complete by then
+    for (auto& object : objects) instance.scene->AddObject(std::move(object));
+
+    instance.observers.reserve(blob.observers.size());
+    for (const SceneObserverRecord& record : blob.observers)
+    {
+        const auto& type = *observerTypes.at(record.type);
+        IObserver* observer = instance.scene->AddObserver(type.create(*instance.scene, SceneArgs{ blob, data, record.firstArg, record.nrOfArgs }));
+        for (uint32_t i = record.firstObserved; i < record.firstObserved + record.nrOfObserved; ++i)
+            type.observe(*observer, *data.objects.at(blob.observedObjects.at(i)));
+        instance.observers.emplace_back(observer);
+    }
+
+    auto& input = InputManager::GetInstance();
+    for (const SceneBindingRecord& record : blob.bindings)
+    {
+        auto command = (*commandTypes.at(record.type))(data.objects.at(record.target), SceneArgs{ blob, data, record.firstArg, record.nrOfArgs });
+        if (record.controllerIdx < 0)
+        {
+            const auto key = static_cast<KeyboardInputKey>(record.key);
+            input.BindCommand(key, std::move(command));
+            instance.keyboardKeys.emplace_back(key);
+        }
+        else
+        {
+            const auto key = static_cast<ControllerInputKey>(record.key);
+            input.BindCommand(key, std::move(command), record.controllerIdx);
+            instance.controllerKeys.emplace_back(key, record.controllerIdx);
+        }
+    }
+
+    instance.objects = std::move(data.objects);
+    return instance;
+}
 void GameEngine::SceneManager::RemoveScene(int sceneId)
 {
     m_AreScenesToBeRemoved = true;
@@ -16,14 +130,21 @@ void GameEngine::SceneManager::RemoveScene(int sceneId)
 }
 void GameEngine::SceneManager::Update()
 {
-    if(m_CurrentSceneId != -1) m_Scenes[m_CurrentSceneId]->Update();
+    if(m_CurrentSceneId != -1)
+    {
+        if (const auto it = m_RollbackSessions.find(m_CurrentSceneId); it != m_RollbackSessions.end()) it->second->Update();
+        else m_Scenes[m_CurrentSceneId]->Update();
+    }
     if(m_AreScenesToBeRemoved)
     {
         m_AreScenesToBeRemoved = false;
         for(auto& sceneId : m_SceneIdsToBeRemoved)
         {
+            m_RollbackSessions.erase(sceneId);
             m_Scenes.erase(sceneId);
         }
+        //a scene loaded again later under the same id would otherwise be removed with them
+        m_SceneIdsToBeRemoved.clear();
     }
 }
 
@@ -3,6 +3,8 @@
 #include <memory>
 #include "Singleton.h"
 #include "../Scene.h"
+#include "../SceneBlob.h"
+#include "../Network/RollbackSession.h"
 
 namespace GameEngine
 {
@@ -13,13 +15,20 @@ namespace GameEngine
 		void SetCurrentScene(int sceneId);
 		void AddScene(int sceneId, std::unique_ptr<Scene>&& scene);
 		void RemoveScene(int sceneId);
+		//The session steps the scene from then on, it is removed together with the scene
+		void SetRollbackSession(int sceneId, std::unique_ptr<RollbackSession>&& session);
+		[[nodiscard]] Scene* GetCurrentScene() const;
+		//Creates the blob's objects, components, observers and input bindings in one go. The scene
+		//still has to be added, the bindings are live as soon as this returns
+		[[nodiscard]] InstantiatedScene InstantiateScene(const SceneBlob& blob, const SceneTypeRegistry& registry) const;
 
 		void Update();
 		void Render();
 	private:
 		friend class Singleton<SceneManager>;
-		SceneManager() = default;
+		SceneManager();
 		std::map<int, std::unique_ptr<Scene>> m_Scenes;
+		std::map<int, std::unique_ptr<RollbackSession>> m_RollbackSessions;
 		bool m_AreScenesToBeRemoved = false;
 		std::vector<int> m_SceneIdsToBeRemoved;
 		int m_CurrentSceneId = -1;
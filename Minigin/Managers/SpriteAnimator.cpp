@@ -0,0 +1,132 @@
+﻿#include "SpriteAnimator.h"
+#include <algorithm>
+#include "TimeManager.h"
+#include "Minigin/Snapshot.h"
+#include "Minigin/Components/SpriteComponent.h"
+using namespace GameEngine;
+
+void SpriteAnimator::AddSprite(SpriteComponent* sprite)
+{
+    if (sprite->m_AnimationClock != -1) return;
+    AddToClock(sprite, GetClock(GetLayout(sprite)));
+}
+void SpriteAnimator::RemoveSprite(SpriteComponent* sprite)
+{
+    if (sprite->m_AnimationClock == -1) return;
+    RemoveFromClock(sprite);
+    std::erase(m_SpritesToRegroup, sprite);
+}
+void SpriteAnimator::Update()
+{
+    const float elapsed = TimeManager::GetElapsed();
+    for (auto& clock : m_Clocks)
+    {
+        if (clock.sprites.empty()) continue;
+        //like the sprites used to, a clock ticks at most once a frame and keeps the rest of the time
+        clock.accumTime += elapsed;
+        if (clock.accumTime < clock.layout.timeInterval) continue;
+        clock.accumTime -= clock.layout.timeInterval;
+        if (clock.cells.empty()) continue;
+
+        for (auto sprite : clock.sprites)
+        {
+            if (!sprite->m_IsActive) continue;
+            if (GetLayout(sprite) != clock.layout)
+            {
+                m_SpritesToRegroup.emplace_back(sprite);
+                continue;
+            }
+            Advance(sprite, clock.cells);
+        }
+    }
+    if (m_SpritesToRegroup.empty()) return;
+
+    //the game changed these layouts mid animation, they tick once with their new one
+    for (auto sprite : m_SpritesToRegroup)
+    {
+        RemoveFromClock(sprite);
+        const int clockIdx = GetClock(GetLayout(sprite));
+        AddToClock(sprite, clockIdx);
+        if (m_Clocks[clockIdx].cells.empty()) continue;
+        Advance(sprite, m_Clocks[clockIdx].cells);
+        sprite->UpdateSrcRect();
+    }
+    m_SpritesToRegroup.clear();
+}
+void SpriteAnimator::Advance(SpriteComponent* sprite, const std::vector<Cell>& cells)
+{
+    auto& info = sprite->m_SpriteInfo;
+    auto cellIdx = static_cast<size_t>(info.m_CurrentRow * info.m_NrOfCols + info.m_CurrentCol);
+    //cells set out of range by hand restart the animation
+    if (cellIdx >= cells.size()) cellIdx = cells.size() - 1;
+
+    const Cell& cell = cells[cellIdx];
+    info.m_CurrentCol = cell.nextCol;
+    info.m_CurrentRow = cell.nextRow;
+    sprite->m_SrcRect.x = info.m_StartPos.x + cell.nextOffset.x;
+    sprite->m_SrcRect.y = info.m_StartPos.y + cell.nextOffset.y;
+}
+SpriteAnimator::Layout SpriteAnimator::GetLayout(const SpriteComponent* sprite)
+{
+    const auto& info = sprite->m_SpriteInfo;
+    return { info.m_Width, info.m_Height, info.m_Spacing, info.m_NrOfCols, info.m_NrOfRows, info.m_TimeInterval };
+}
+int SpriteAnimator::GetClock(const Layout& layout)
+{
+    const auto it = std::ranges::find(m_Clocks, layout, &Clock::layout);
+    if (it != m_Clocks.end()) return static_cast<int>(it - m_Clocks.begin());
+
+    Clock& clock = m_Clocks.emplace_back(Clock{ layout, 0.f, {}, {} });
+    if (layout.nrOfCols <= 0 || layout.nrOfRows <= 0) return static_cast<int>(m_Clocks.size() - 1);
+
+    //the cells run through the columns of a row before moving on to the next row
+    clock.cells.resize(static_cast<size_t>(layout.nrOfCols) * layout.nrOfRows);
+    for (int row = 0; row < layout.nrOfRows; ++row)
+    {
+        for (int col = 0; col < layout.nrOfCols; ++col)
+        {
+            Cell& cell = clock.cells[row * layout.nrOfCols + col];
+            cell.nextCol = (col + 1) % layout.nrOfCols;
+            cell.nextRow = cell.nextCol == 0 ? (row + 1) % layout.nrOfRows : row;
+            cell.nextOffset = { (layout.width + layout.spacing) * cell.nextCol, (layout.height + layout.spacing) * cell.nextRow };
+        }
+    }
+    return static_cast<int>(m_Clocks.size() - 1);
+}
+void SpriteAnimator::AddToClock(SpriteComponent* sprite, int clockIdx)
+{
+    auto& sprites = m_Clocks[clockIdx].sprites;
+    sprite->m_AnimationClock = clockIdx;
+    sprite->m_AnimationSlot = sprites.size();
+    sprites.emplace_back(sprite);
+}
+void SpriteAnimator::RemoveFromClock(SpriteComponent* sprite)
+{
+    //swap with the last sprite of the clock, the order within a clock doesn't matter
+    auto& sprites = m_Clocks[sprite->m_AnimationClock].sprites;
+    SpriteComponent* last = sprites.back();
+    sprites[sprite->m_AnimationSlot] = last;
+    last->m_AnimationSlot = sprite->m_AnimationSlot;
+    sprites.pop_back();
+    sprite->m_AnimationClock = -1;
+}
+
+void SpriteAnimator::SaveState(Snapshot& snapshot) const
+{
+    snapshot.Write(static_cast<uint32_t>(m_Clocks.size()));
+    for (const auto& clock : m_Clocks)
+    {
+        snapshot.Write(clock.layout);
+        snapshot.Write(clock.accumTime);
+    }
+}
+void SpriteAnimator::LoadState(Snapshot& snapshot)
+{
+    for (auto& clock : m_Clocks) clock.accumTime = 0.f;
+    const auto nrOfClocks = snapshot.Read<uint32_t>();
+    for (uint32_t i{}; i < nrOfClocks; ++i)
+    {
+        const auto layout = snapshot.Read<Layout>();
+        m_Clocks[GetClock(layout)].accumTime = snapshot.Read<float>();
+    }
+}
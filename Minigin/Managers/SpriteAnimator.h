@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace GameEngine
+{
+    class SpriteComponent;
+    class Snapshot;
+    //Advances the animated sprites of a scene. Sprites with the same layout and interval share
+    //one clock, so a frame in which a clock doesn't tick costs nothing per sprite, and a tick
+    //only looks up the next cell of the sprite in the table of its layout
+    class SpriteAnimator final
+    {
+    public:
+        SpriteAnimator() = default;
+        SpriteAnimator(const SpriteAnimator& other) = delete;
+        SpriteAnimator(SpriteAnimator&& other) noexcept = delete;
+        SpriteAnimator& operator=(const SpriteAnimator& other) = delete;
+        SpriteAnimator& operator=(SpriteAnimator&& other) noexcept = delete;
+
+        void AddSprite(SpriteComponent* sprite);
+        void RemoveSprite(SpriteComponent* sprite);
+        void Update();
+        void SaveState(Snapshot& snapshot) const;
+        void LoadState(Snapshot& snapshot);
+
+        ~SpriteAnimator() = default;
+    private:
+        struct Layout
+        {
+            int width;
+            int height;
+            int spacing;
+            int nrOfCols;
+            int nrOfRows;
+            float timeInterval;
+            bool operator==(const Layout& other) const = default;
+        };
+        struct Cell
+        {
+            int nextCol;
+            int nextRow;
+            //offset of the next cell's source rect from the sprite's start position
+            glm::ivec2 nextOffset;
+        };
+        struct Clock
+        {
+            Layout layout;
+            float accumTime;
+            std::vector<Cell> cells;
+            std::vector<SpriteComponent*> sprites;
+        };
+        [[nodiscard]] static Layout GetLayout(const SpriteComponent* sprite);
+        [[nodiscard]] int GetClock(const Layout& layout);
+        void AddToClock(SpriteComponent* sprite, int clockIdx);
+        void RemoveFromClock(SpriteComponent* sprite);
+        static void Advance(SpriteComponent* sprite, const std::vector<Cell>& cells);
+
+        std::vector<Clock> m_Clocks{};
+        //sprites whose layout was changed since they were added, moved once the clocks are done
+        std::vector<SpriteComponent*> m_SpritesToRegroup{};
+    };
+}
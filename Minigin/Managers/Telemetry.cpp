@@ -0,0 +1,208 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std::chrono;
+using namespace GameEngine;
+
+Telemetry::Telemetry()
+{
+    //the flush thread reads the names while they are registered, they may never reallocate
+    m_Counters.names.reserve(m_MaxCounters);
+    m_Gauges.names.reserve(m_MaxGauges);
+    m_Histograms.names.reserve(m_MaxHistograms);
+    m_AllocationCounter = RegisterCounter("allocations");
+}
+
+Telemetry::~Telemetry()
+{
+    EndSession();
+}
+
+MetricId Telemetry::Register(MetricNames& metrics, size_t maxCount, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const size_t count = metrics.count.load(std::memory_order_relaxed);
+    const auto it = std::find(metrics.names.begin(), metrics.names.begin() + count, name);
+    if (it != metrics.names.begin() + count) return static_cast<MetricId>(it - metrics.names.begin());
+    if (count == maxCount) throw std::runtime_error("Too many telemetry metrics of one kind, can't add " + name);
+
+    metrics.names.emplace_back(name);
+    metrics.count.store(count + 1, std::memory_order_release);
+    return static_cast<MetricId>(count);
+}
+
+MetricId Telemetry::RegisterCounter(const std::string& name)
+{
+    return Register(m_Counters, m_MaxCounters, name);
+}
+
+MetricId Telemetry::RegisterGauge(const std::string& name)
+{
+    return Register(m_Gauges, m_MaxGauges, name);
+}
+
+MetricId Telemetry::RegisterHistogram(const std::string& name)
+{
+    return Register(m_Histograms, m_MaxHistograms, name);
+}
+
+Telemetry::Shard& Telemetry::GetShard()
+{
+    if (m_ThreadShard == nullptr)
+    {
+        //shards outlive their thread so its last samples still get flushed
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Shards.emplace_back(std::make_unique<Shard>());
+        m_ThreadShard = m_Shards.back().get();
+    }
+    return *m_ThreadShard;
+}
+
+void Telemetry::Add(MetricId counter, uint64_t amount)
+{
+    GetShard().counters[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Telemetry::Set(MetricId gauge, int64_t value)
+{
+    m_GaugeValues[gauge].store(value, std::memory_order_relaxed);
+}
+
+void Telemetry::Record(MetricId histogram, uint64_t value)
+{
+    Shard& shard = GetShard();
+    shard.buckets[histogram][GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sums[histogram].fetch_add(value, std::memory_order_relaxed);
+}
+
+size_t Telemetry::GetBucket(uint64_t value)
+{
+    if (value < m_NrOfExactBuckets) return static_cast<size_t>(value);
+    const int magnitude = static_cast<int>(std::bit_width(value)) - 1;
+    if (magnitude > m_MaxMagnitude) return m_NrOfBuckets - 1;
+    //the 4 bits below the leading one pick the bucket within the power of two
+    const auto subBucket = static_cast<size_t>(value >> (magnitude - 4)) & (m_BucketsPerMagnitude - 1);
+    return m_NrOfExactBuckets + static_cast<size_t>(magnitude - 5) * m_BucketsPerMagnitude + subBucket;
+}
+
+uint64_t Telemetry::GetBucketStart(size_t bucket)
+{
+    if (bucket < m_NrOfExactBuckets) return bucket;
+    const int magnitude = static_cast<int>((bucket - m_NrOfExactBuckets) / m_BucketsPerMagnitude) + 5;
+    const uint64_t subBucket = (bucket - m_NrOfExactBuckets) % m_BucketsPerMagnitude;
+    return (m_BucketsPerMagnitude + subBucket) << (magnitude - 4);
+}
+
+void Telemetry::StartSession(const std::string& path, milliseconds flushInterval)
+{
+    EndSession();
+    m_File.open(path, std::ios::trunc);
+    if (!m_File)
+    {
+        std::cerr << "Couldn't open the telemetry file " << path << '\n';
+        return;
+    }
+    m_File << "time s,metric,value,samples,p50,p95,p99,max\n";
+    m_SessionStart = high_resolution_clock::now();
+    m_LastNrOfAllocations = GetNrOfAllocations();
+    m_IsRunning = true;
+    m_FlushThread = std::thread(&Telemetry::RunFlushThread, this, flushInterval);
+}
+
+void Telemetry::EndSession()
+{
+    if (!m_FlushThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsRunning = false;
+    }
+    m_ConditionVariable.notify_all();
+    m_FlushThread.join();
+    //whatever was recorded since the last flush
+    Flush();
+    m_File.close();
+}
+
+void Telemetry::RunFlushThread(milliseconds flushInterval)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (m_ConditionVariable.wait_for(lock, flushInterval, [this] { return !m_IsRunning; })) break;
+        }
+        Flush();
+    }
+}
+
+void Telemetry::Flush()
+{
+    const float time = duration<float>(high_resolution_clock::now() - m_SessionStart).count();
+    const uint64_t nrOfAllocations = GetNrOfAllocations();
+    GetShard().counters[m_AllocationCounter].fetch_add(nrOfAllocations - m_LastNrOfAllocations, std::memory_order_relaxed);
+    m_LastNrOfAllocations = nrOfAllocations;
+
+    //samples recorded while the shards are summed land in this interval or the next one, none are lost
+    std::vector<Shard*> shards;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        shards.reserve(m_Shards.size());
+        for (const auto& shard : m_Shards) shards.emplace_back(shard.get());
+    }
+
+    for (size_t i = 0; i < m_Counters.count.load(std::memory_order_acquire); ++i)
+    {
+        uint64_t total{};
+        for (Shard* shard : shards) total += shard->counters[i].exchange(0, std::memory_order_relaxed);
+        m_File << time << ',' << m_Counters.names[i] << ',' << total << ",,,,,\n";
+    }
+    for (size_t i = 0; i < m_Gauges.count.load(std::memory_order_acquire); ++i)
+    {
+        m_File << time << ',' << m_Gauges.names[i] << ',' << m_GaugeValues[i].load(std::memory_order_relaxed) << ",,,,,\n";
+    }
+
+    std::array<uint64_t, m_NrOfBuckets> buckets{};
+    for (size_t i = 0; i < m_Histograms.count.load(std::memory_order_acquire); ++i)
+    {
+        buckets.fill(0);
+        uint64_t sum{};
+        uint64_t nrOfSamples{};
+        for (Shard* shard : shards)
+        {
+            for (size_t bucket = 0; bucket < m_NrOfBuckets; ++bucket)
+            {
+                const uint32_t count = shard->buckets[i][bucket].exchange(0, std::memory_order_relaxed);
+                buckets[bucket] += count;
+                nrOfSamples += count;
+            }
+            sum += shard->sums[i].exchange(0, std::memory_order_relaxed);
+        }
+        if (nrOfSamples == 0) continue;
+
+        //percentiles are reported as the middle of their bucket
+        const auto getPercentile = [&buckets, nrOfSamples](double percentile) {
+            const auto rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(nrOfSamples))), 1);
+            uint64_t count{};
+            for (size_t bucket = 0; bucket < m_NrOfBuckets; ++bucket)
+            {
+                count += buckets[bucket];
+                if (count >= rank) return (GetBucketStart(bucket) + GetBucketStart(bucket + 1) - 1) / 2;
+            }
+            return GetBucketStart(m_NrOfBuckets - 1);
+        };
+        m_File << time << ',' << m_Histograms.names[i] << ',' << static_cast<double>(sum) / static_cast<double>(nrOfSamples)
+            << ',' << nrOfSamples << ',' << getPercentile(0.5) << ',' << getPercentile(0.95) << ','
+            << getPercentile(0.99) << ',' << getPercentile(1.0) << '\n';
+    }
+    m_File.flush();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    const auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - m_Start);
+    Telemetry::GetInstance().Record(m_Histogram, static_cast<uint64_t>(elapsed.count()));
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Singleton.h"
+
+namespace GameEngine
+{
+	//Index of a metric among the ones of its kind
+	using MetricId = uint16_t;
+
+	//Counters, gauges and histograms that can be recorded from any thread without locking. Every thread
+	//writes to its own shard, a background thread sums the shards once per flush interval and appends
+	//a CSV row per metric to the session file. Histograms use HDR style log-linear buckets: exact below
+	//32, 16 buckets per power of two above that, so percentiles are within ~3% of the recorded values
+	class Telemetry final : public GameEngine::Singleton<Telemetry>
+	{
+	public:
+		//Registering a name twice returns the id it already has
+		MetricId RegisterCounter(const std::string& name);
+		MetricId RegisterGauge(const std::string& name);
+		MetricId RegisterHistogram(const std::string& name);
+
+		void Add(MetricId counter, uint64_t amount = 1);
+		void Set(MetricId gauge, int64_t value);
+		void Record(MetricId histogram, uint64_t value);
+
+		//Metrics are recorded either way, a session only adds the file they are flushed to
+		void StartSession(const std::string& path, std::chrono::milliseconds flushInterval = std::chrono::milliseconds{ 1000 });
+		void EndSession();
+
+		//Called by the replaced operator new, see AllocationTracking.h
+		static void CountAllocation() { m_NrOfAllocations.fetch_add(1, std::memory_order_relaxed); }
+		[[nodiscard]] static uint64_t GetNrOfAllocations() { return m_NrOfAllocations.load(std::memory_order_relaxed); }
+
+		~Telemetry() override;
+	private:
+		friend class GameEngine::Singleton<Telemetry>;
+		Telemetry();
+
+		static constexpr size_t m_MaxCounters{ 32 };
+		static constexpr size_t m_MaxGauges{ 32 };
+		static constexpr size_t m_MaxHistograms{ 32 };
+		static constexpr size_t m_NrOfExactBuckets{ 32 };
+		static constexpr size_t m_BucketsPerMagnitude{ 16 };
+		//values from 2^40 on are clamped into the last bucket
+		static constexpr int m_MaxMagnitude{ 39 };
+		static constexpr size_t m_NrOfBuckets{ m_NrOfExactBuckets + (m_MaxMagnitude - 4) * m_BucketsPerMagnitude };
+
+		struct Shard
+		{
+			std::array<std::atomic<uint64_t>, m_MaxCounters> counters{};
+			std::array<std::array<std::atomic<uint32_t>, m_NrOfBuckets>, m_MaxHistograms> buckets{};
+			std::array<std::atomic<uint64_t>, m_MaxHistograms> sums{};
+		};
+		struct MetricNames
+		{
+			std::vector<std::string> names{};
+			//read without the lock by the flush thread, names are added before the count is raised
+			std::atomic<size_t> count{};
+		};
+
+		[[nodiscard]] static size_t GetBucket(uint64_t value);
+		[[nodiscard]] static uint64_t GetBucketStart(size_t bucket);
+		MetricId Register(MetricNames& metrics, size_t maxCount, const std::string& name);
+		Shard& GetShard();
+		void RunFlushThread(std::chrono::milliseconds flushInterval);
+		void Flush();
+
+		inline static std::atomic<uint64_t> m_NrOfAllocations{};
+		uint64_t m_LastNrOfAllocations{};
+
+		MetricNames m_Counters{};
+		MetricNames m_Gauges{};
+		MetricNames m_Histograms{};
+		std::array<std::atomic<int64_t>, m_MaxGauges> m_GaugeValues{};
+		MetricId m_AllocationCounter{};
+
+		inline static thread_local Shard* m_ThreadShard{};
+		std::vector<std::unique_ptr<Shard>> m_Shards{};
+		std::mutex m_Mutex{};
+
+		std::ofstream m_File{};
+		std::chrono::high_resolution_clock::time_point m_SessionStart{};
+		std::thread m_FlushThread{};
+		std::condition_variable m_ConditionVariable{};
+		bool m_IsRunning{};
+	};
+
+	//Records the microseconds between its construction and destruction into a histogram
+	class ScopedTimer final
+	{
+	public:
+		explicit ScopedTimer(MetricId histogram) : m_Histogram(histogram), m_Start(std::chrono::high_resolution_clock::now()) {}
+		~ScopedTimer();
+		ScopedTimer(const ScopedTimer& other) = delete;
+		ScopedTimer(ScopedTimer&& other) = delete;
+		ScopedTimer& operator=(const ScopedTimer& other) = delete;
+		ScopedTimer& operator=(ScopedTimer&& other) = delete;
+	private:
+		MetricId m_Histogram;
+		std::chrono::high_resolution_clock::time_point m_Start;
+	};
+}
@@ -9,6 +9,8 @@ namespace GameEngine
 	{
 	public:
 		static float GetElapsed();
+		//Fixed step simulations (e.g. a RollbackSession) override the frame time while they step
+		static void SetElapsed(float elapsed) { m_ElapsedTime = elapsed; }
 		[[nodiscard]] std::chrono::high_resolution_clock::time_point GetCurrent() const;
 		void Update();
 	private:
@@ -1,7 +1,6 @@
 //#include <steam_api.h>
+#include <chrono>
 #include <stdexcept>
-#define WIN32_LEAN_AND_MEAN 
-#include <windows.h>
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -13,9 +12,15 @@
 #include "Managers/ResourceManager.h"
 #include "Sound/DerivedSoundSystems.h"
 #include "Managers/TimeManager.h"
+#include "Managers/FramePacer.h"
+#include "Managers/Telemetry.h"
 
 SDL_Window* g_window{};
-constexpr float g_TargetFPS{1/160.f};
+
+namespace
+{
+    const GameEngine::MetricId g_UpdateMetric{ GameEngine::Telemetry::GetInstance().RegisterHistogram("update us") };
+}
 
 void PrintSDLVersion()
 {
@@ -45,10 +50,16 @@ void PrintSDLVersion()
         version.major, version.minor, version.patch);
 }
 
-GameEngine::Minigin::Minigin(const std::string& dataPath)
+GameEngine::Minigin::Minigin(const std::string& dataPath, bool isHeadless)
 {
     PrintSDLVersion();
-    if (SDL_Init(SDL_INIT_VIDEO) != 0)
+    if (isHeadless)
+    {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER) != 0)
     {
         throw std::runtime_error(std::string("SDL_Init Error: ") + SDL_GetError());
     }
@@ -59,7 +70,7 @@ GameEngine::Minigin::Minigin(const std::string& dataPath)
         g_WindowRect.y,
         g_WindowRect.w,
         g_WindowRect.h,
-        SDL_WINDOW_OPENGL
+        isHeadless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_OPENGL
     );
     if (g_window == nullptr)
     {
@@ -74,6 +85,7 @@ GameEngine::Minigin::Minigin(const std::string& dataPath)
 GameEngine::Minigin::~Minigin()
 {
     Renderer::GetInstance().Destroy();
+    Telemetry::GetInstance().EndSession();
     SDL_DestroyWindow(g_window);
     g_window = nullptr;
     SDL_Quit();
@@ -85,28 +97,27 @@ void GameEngine::Minigin::Run(const std::function<void()>& load)
 
     load();
 
-    auto& renderer = Renderer::GetInstance();
-    auto& sceneManager = SceneManager::GetInstance();
-    auto& input = InputManager::GetInstance();
-    auto& time = TimeManager::GetInstance();
-
-    bool doContinue = true;
-    while (doContinue)
+    auto& pacer = FramePacer::GetInstance();
+    pacer.StartSession();
+    while (StepFrame())
     {
-        float frameStartTime = SDL_GetTicks() / 1000.0f; // Get the current time in seconds
-        
-        time.Update();
-        doContinue = input.ProcessInput();
-
-        sceneManager.Update();
-        renderer.Render();
-
-        float frameEndTime = SDL_GetTicks() / 1000.0f; // Get the current time in seconds
-        float frameTime = frameEndTime - frameStartTime; // Calculate the elapsed time 
-
-        if (frameTime < g_TargetFPS)
-        {
-            SDL_Delay(static_cast<Uint32>((g_TargetFPS - frameTime) * 1000)); // Delay for the remaining time
-        }
+        pacer.WaitForNextFrame();
     }
+    pacer.EndSession();
+}
+
+bool GameEngine::Minigin::StepFrame(float fixedElapsed)
+{
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+
+    TimeManager::GetInstance().Update();
+    if (fixedElapsed > 0.f) TimeManager::SetElapsed(fixedElapsed);
+    const bool doContinue = InputManager::GetInstance().ProcessInput();
+
+    SceneManager::GetInstance().Update();
+    const auto updateTime = std::chrono::high_resolution_clock::now() - updateStart;
+    Telemetry::GetInstance().Record(g_UpdateMetric, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(updateTime).count()));
+    //the render thread draws this frame while the next one is simulated
+    Renderer::GetInstance().SubmitFrame(std::chrono::duration<float, std::milli>(updateTime).count(), updateStart);
+    return doContinue;
 }
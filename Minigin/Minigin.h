@@ -10,9 +10,14 @@ namespace GameEngine
 	class Minigin final
 	{
 	public:
-		explicit Minigin(const std::string& dataPath);
+		//Headless engines use SDL's dummy video and audio drivers and draw into a hidden window
+		//with the software renderer, for benchmarks and machines without a display
+		explicit Minigin(const std::string& dataPath, bool isHeadless = false);
 		~Minigin();
 		void Run(const std::function<void()>& load);
+		//Updates and submits one frame without pacing it. A fixedElapsed above 0 replaces the measured
+		//frame time, so the same frames are simulated on every run. Returns false once the window is closed
+		bool StepFrame(float fixedElapsed = 0.f);
 
 		Minigin(const Minigin& other) = delete;
 		Minigin(Minigin&& other) = delete;
@@ -0,0 +1,188 @@
+﻿#include "DerivedTransports.h"
+
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace GameEngine;
+
+#pragma region UdpTransport
+
+namespace
+{
+#ifdef _WIN32
+    using SocketHandle = SOCKET;
+    using BufferSize = int;
+    using AddressSize = int;
+    constexpr SocketHandle g_InvalidSocket{ INVALID_SOCKET };
+
+    //Winsock is started for every socket, it counts the starts and only stops after the last cleanup
+    bool StartSockets()
+    {
+        WSADATA wsaData{};
+        return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+    }
+    void StopSockets() { WSACleanup(); }
+    void CloseSocket(SocketHandle socketHandle) { closesocket(socketHandle); }
+    bool SetNonBlocking(SocketHandle socketHandle)
+    {
+        u_long isNonBlocking = 1;
+        return ioctlsocket(socketHandle, FIONBIO, &isNonBlocking) != SOCKET_ERROR;
+    }
+    //an earlier send hit a closed port, the peer might just not be up yet
+    bool IsIgnorableReceiveError() { return WSAGetLastError() == WSAECONNRESET; }
+#else
+    using SocketHandle = int;
+    using BufferSize = size_t;
+    using AddressSize = socklen_t;
+    constexpr SocketHandle g_InvalidSocket{ -1 };
+
+    bool StartSockets() { return true; }
+    void StopSockets() {}
+    void CloseSocket(SocketHandle socketHandle) { close(socketHandle); }
+    bool SetNonBlocking(SocketHandle socketHandle)
+    {
+        const int flags = fcntl(socketHandle, F_GETFL, 0);
+        return flags != -1 && fcntl(socketHandle, F_SETFL, flags | O_NONBLOCK) != -1;
+    }
+    //an earlier send hit a closed port, or a signal came in before anything was read
+    bool IsIgnorableReceiveError() { return errno == ECONNREFUSED || errno == EINTR; }
+#endif
+}
+
+class UdpTransport::SocketImpl final
+{
+public:
+    SocketImpl(uint16_t localPort, const std::string& remoteHost, uint16_t remotePort)
+    {
+        if (!StartSockets()) throw std::runtime_error("WSAStartup failed");
+        m_Socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (m_Socket == g_InvalidSocket)
+        {
+            StopSockets();
+            throw std::runtime_error("Could not create the UDP socket");
+        }
+        sockaddr_in localAddress{};
+        localAddress.sin_family = AF_INET;
+        localAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+        localAddress.sin_port = htons(localPort);
+        if (bind(m_Socket, reinterpret_cast<const sockaddr*>(&localAddress), sizeof(localAddress)) != 0 ||
+            !SetNonBlocking(m_Socket) ||
+            inet_pton(AF_INET, remoteHost.c_str(), &m_RemoteAddress.sin_addr) != 1)
+        {
+            CloseSocket(m_Socket);
+            StopSockets();
+            throw std::runtime_error("Could not set up the UDP socket for " + remoteHost);
+        }
+        m_RemoteAddress.sin_family = AF_INET;
+        m_RemoteAddress.sin_port = htons(remotePort);
+    }
+    SocketImpl(const SocketImpl& other) = delete;
+    SocketImpl(SocketImpl&& other) noexcept = delete;
+    SocketImpl& operator=(const SocketImpl& other) = delete;
+    SocketImpl& operator=(SocketImpl&& other) noexcept = delete;
+    ~SocketImpl()
+    {
+        CloseSocket(m_Socket);
+        StopSockets();
+    }
+
+    void Send(std::span<const std::byte> packet) const
+    {
+        //a full send buffer is a dropped packet, the protocol resends anyway
+        sendto(m_Socket, reinterpret_cast<const char*>(packet.data()), static_cast<BufferSize>(packet.size()), 0,
+            reinterpret_cast<const sockaddr*>(&m_RemoteAddress), sizeof(m_RemoteAddress));
+    }
+    bool Receive(std::vector<std::byte>& packet) const
+    {
+        packet.resize(m_MaxPacketSize);
+        while (true)
+        {
+            sockaddr_in sender{};
+            AddressSize senderSize = sizeof(sender);
+            const auto size = recvfrom(m_Socket, reinterpret_cast<char*>(packet.data()), static_cast<BufferSize>(packet.size()), 0,
+                reinterpret_cast<sockaddr*>(&sender), &senderSize);
+            if (size < 0)
+            {
+                if (IsIgnorableReceiveError()) continue;
+                packet.clear();
+                return false;
+            }
+            if (sender.sin_addr.s_addr != m_RemoteAddress.sin_addr.s_addr || sender.sin_port != m_RemoteAddress.sin_port) continue;
+            packet.resize(static_cast<size_t>(size));
+            return true;
+        }
+    }
+private:
+    static constexpr size_t m_MaxPacketSize{ 1472 };
+    SocketHandle m_Socket{ g_InvalidSocket };
+    sockaddr_in m_RemoteAddress{};
+};
+
+UdpTransport::UdpTransport(uint16_t localPort, const std::string& remoteHost, uint16_t remotePort) :
+    m_pImpl(std::make_unique<SocketImpl>(localPort, remoteHost, remotePort))
+{}
+
+UdpTransport::~UdpTransport() = default;
+
+void UdpTransport::Send(std::span<const std::byte> packet)
+{
+    m_pImpl->Send(packet);
+}
+
+bool UdpTransport::Receive(std::vector<std::byte>& packet)
+{
+    return m_pImpl->Receive(packet);
+}
+
+#pragma endregion
+
+#pragma region LoopbackTransport
+
+std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> LoopbackTransport::CreatePair(int latencyInPolls)
+{
+    auto first = std::make_shared<Channel>();
+    auto second = std::make_shared<Channel>();
+    return { std::unique_ptr<LoopbackTransport>(new LoopbackTransport(first, second, latencyInPolls)),
+        std::unique_ptr<LoopbackTransport>(new LoopbackTransport(second, first, latencyInPolls)) };
+}
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<Channel> inbox, std::shared_ptr<Channel> outbox, int latencyInPolls) :
+    m_Inbox(std::move(inbox)),
+    m_Outbox(std::move(outbox)),
+    m_LatencyInPolls(latencyInPolls)
+{}
+
+void LoopbackTransport::Send(std::span<const std::byte> packet)
+{
+    ++m_NrOfPacketsSent;
+    if (m_DropInterval > 0 && m_NrOfPacketsSent % m_DropInterval == 0) return;
+    std::lock_guard lock(m_Outbox->mutex);
+    m_Outbox->packets.push_back({ { packet.begin(), packet.end() }, m_Outbox->nrOfPolls + m_LatencyInPolls });
+}
+
+bool LoopbackTransport::Receive(std::vector<std::byte>& packet)
+{
+    std::lock_guard lock(m_Inbox->mutex);
+    if (!m_Inbox->packets.empty() && m_Inbox->packets.front().deliverAt <= m_Inbox->nrOfPolls)
+    {
+        packet = std::move(m_Inbox->packets.front().data);
+        m_Inbox->packets.pop_front();
+        return true;
+    }
+    //a receiver drains its inbox once per frame, so every empty poll is a frame of latency
+    ++m_Inbox->nrOfPolls;
+    return false;
+}
+
+#pragma endregion
@@ -0,0 +1,68 @@
+﻿#pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "ITransport.h"
+
+namespace GameEngine
+{
+    class UdpTransport final : public ITransport
+    {
+    public:
+        //Binds localPort and sends to remoteHost:remotePort, throws if the socket can't be set up
+        UdpTransport(uint16_t localPort, const std::string& remoteHost, uint16_t remotePort);
+        UdpTransport(const UdpTransport& other) = delete;
+        UdpTransport(UdpTransport&& other) noexcept = delete;
+        UdpTransport& operator=(const UdpTransport& other) = delete;
+        UdpTransport& operator=(UdpTransport&& other) noexcept = delete;
+        virtual ~UdpTransport() override;
+
+        virtual void Send(std::span<const std::byte> packet) override;
+        virtual bool Receive(std::vector<std::byte>& packet) override;
+    private:
+        class SocketImpl;
+        std::unique_ptr<SocketImpl> m_pImpl;
+    };
+
+    //In-process stand-in for UdpTransport. Both ends of a pair share one set of queues,
+    //packets can be held back for a number of empty Receive polls to imitate latency
+    class LoopbackTransport final : public ITransport
+    {
+    public:
+        [[nodiscard]] static std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>>
+            CreatePair(int latencyInPolls = 0);
+        LoopbackTransport(const LoopbackTransport& other) = delete;
+        LoopbackTransport(LoopbackTransport&& other) noexcept = delete;
+        LoopbackTransport& operator=(const LoopbackTransport& other) = delete;
+        LoopbackTransport& operator=(LoopbackTransport&& other) noexcept = delete;
+        virtual ~LoopbackTransport() override = default;
+
+        virtual void Send(std::span<const std::byte> packet) override;
+        virtual bool Receive(std::vector<std::byte>& packet) override;
+        //Every nth packet sent from this end is dropped, 0 drops nothing
+        void SetDropInterval(int interval) { m_DropInterval = interval; }
+    private:
+        struct Channel
+        {
+            struct Packet
+            {
+                std::vector<std::byte> data;
+                int deliverAt;
+            };
+            std::mutex mutex;
+            std::deque<Packet> packets;
+            //nr of times the receiving end found nothing to deliver
+            int nrOfPolls{};
+        };
+        LoopbackTransport(std::shared_ptr<Channel> inbox, std::shared_ptr<Channel> outbox, int latencyInPolls);
+        std::shared_ptr<Channel> m_Inbox;
+        std::shared_ptr<Channel> m_Outbox;
+        int m_LatencyInPolls;
+        int m_DropInterval{};
+        int m_NrOfPacketsSent{};
+    };
+}
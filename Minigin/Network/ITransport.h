@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace GameEngine
+{
+    //Unreliable, unordered datagrams between two peers. Packets may be dropped or arrive twice
+    class ITransport
+    {
+    public:
+        ITransport() = default;
+        ITransport(const ITransport& other) = delete;
+        ITransport(ITransport&& other) noexcept = delete;
+        ITransport& operator=(const ITransport& other) = delete;
+        ITransport& operator=(ITransport&& other) noexcept = delete;
+        virtual ~ITransport() = default;
+
+        virtual void Send(std::span<const std::byte> packet) = 0;
+        //Non-blocking, returns false when no packet is waiting
+        virtual bool Receive(std::vector<std::byte>& packet) = 0;
+    };
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+
+namespace GameEngine
+{
+    //Inputs of one player indexed by simulation frame. Frames are confirmed in order,
+    //the ones that are not confirmed yet are predicted to repeat the last confirmed input
+    class InputBuffer final
+    {
+    public:
+        using InputWord = uint16_t;
+        //covers the rollback window, the input delay and a peer running ahead
+        static constexpr int g_Capacity{ 64 };
+
+        //Returns false if frame is not the next one to confirm
+        bool Confirm(int frame, InputWord input)
+        {
+            if (frame != m_LastConfirmedFrame + 1) return false;
+            m_Inputs[frame % g_Capacity] = input;
+            m_LastConfirmedFrame = frame;
+            return true;
+        }
+        [[nodiscard]] InputWord Get(int frame) const
+        {
+            if (frame < 0 || m_LastConfirmedFrame < 0) return 0;
+            if (frame > m_LastConfirmedFrame) return m_Inputs[m_LastConfirmedFrame % g_Capacity];
+            return m_Inputs[frame % g_Capacity];
+        }
+        [[nodiscard]] bool IsConfirmed(int frame) const { return frame <= m_LastConfirmedFrame; }
+        [[nodiscard]] int GetLastConfirmedFrame() const { return m_LastConfirmedFrame; }
+    private:
+        std::array<InputWord, g_Capacity> m_Inputs{};
+        int m_LastConfirmedFrame{ -1 };
+    };
+}
@@ -0,0 +1,191 @@
+﻿#include "RollbackSession.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "ITransport.h"
+#include "../Scene.h"
+#include "../Managers/SceneManager.h"
+#include "../Managers/TimeManager.h"
+#include "../Sound/ServiceLocator.h"
+
+using namespace GameEngine;
+
+RollbackSession::RollbackSession(Scene* scene, ITransport* transport, int localPlayer, uint16_t sessionId) :
+    m_Scene(scene),
+    m_Transport(transport),
+    m_LocalPlayer(localPlayer),
+    m_SessionId(sessionId)
+{
+    //objects destroyed inside the window have to come back when it is rolled back
+    m_Scene->SetDestroyedObjectRetention(g_MaxRollbackFrames + 1);
+}
+
+void RollbackSession::BindAction(int player, InputWord input, std::unique_ptr<Command>&& command)
+{
+    m_Actions[player].emplace_back(input, std::move(command));
+}
+
+void RollbackSession::Update()
+{
+    m_LastStats = {};
+    const float frameTime = TimeManager::GetElapsed();
+    ReceiveInputs();
+    if (!m_IsConnected)
+    {
+        SendInputs();
+        return;
+    }
+    if (m_RollbackFrame != -1) Rollback();
+
+    //a stalled session doesn't build up frames to catch up on
+    m_AccumulatedTime = std::min(m_AccumulatedTime + frameTime, m_TimeStep * g_MaxRollbackFrames);
+    const Scene* currentScene = SceneManager::GetInstance().GetCurrentScene();
+    bool isLocalInputConfirmed = false;
+    while (m_AccumulatedTime >= m_TimeStep && currentScene == m_Scene)
+    {
+        //too far ahead of the remote peer to roll back to its next input
+        if (m_CurrentFrame - m_Inputs[GetRemotePlayer()].GetLastConfirmedFrame() > g_MaxRollbackFrames) break;
+        //the first frames of the session have no local input to delay
+        while (m_Inputs[m_LocalPlayer].GetLastConfirmedFrame() < m_CurrentFrame + m_InputDelay - 1)
+            m_Inputs[m_LocalPlayer].Confirm(m_Inputs[m_LocalPlayer].GetLastConfirmedFrame() + 1, 0);
+        m_Inputs[m_LocalPlayer].Confirm(m_CurrentFrame + m_InputDelay, m_LocalInput);
+        isLocalInputConfirmed = true;
+        SimulateFrame();
+        m_AccumulatedTime -= m_TimeStep;
+        currentScene = SceneManager::GetInstance().GetCurrentScene();
+    }
+    SendInputs();
+    //render frames that don't step the simulation, e.g. above its rate, keep their input for the next step,
+    //so a press that only lasts one render frame still reaches a simulated frame
+    if (isLocalInputConfirmed) m_LocalInput = 0;
+    TimeManager::SetElapsed(frameTime);
+
+    m_TotalStats.nrOfRollbacks += m_LastStats.nrOfRollbacks;
+    m_TotalStats.nrOfResimulatedFrames += m_LastStats.nrOfResimulatedFrames;
+    m_TotalStats.rollbackCost += m_LastStats.rollbackCost;
+}
+
+void RollbackSession::SimulateFrame()
+{
+    Snapshot& snapshot = m_Snapshots[m_CurrentFrame % m_Snapshots.size()];
+    snapshot.Clear();
+    m_Scene->SaveState(snapshot);
+    TimeManager::SetElapsed(m_TimeStep);
+    ApplyInputs(m_CurrentFrame);
+    m_Scene->Update();
+    ++m_CurrentFrame;
+}
+
+void RollbackSession::ApplyInputs(int frame)
+{
+    for (int player{}; player < g_NrOfPlayers; ++player)
+    {
+        const InputWord input = m_Inputs[player].Get(frame);
+        const InputWord previousInput = m_Inputs[player].Get(frame - 1);
+        m_UsedInputs[player][frame % InputBuffer::g_Capacity] = input;
+        for (const auto& [bit, command] : m_Actions[player])
+        {
+            const bool isHeld = (input & bit) != 0;
+            const bool wasHeld = (previousInput & bit) != 0;
+            switch (command->ExecuteOnKeyState())
+            {
+            case Command::ExecuteOn::keyPressed:
+                if (isHeld) command->Execute();
+                break;
+            case Command::ExecuteOn::keyDown:
+                if (isHeld && !wasHeld) command->Execute();
+                break;
+            case Command::ExecuteOn::keyUp:
+                if (!isHeld && wasHeld) command->Execute();
+                break;
+            }
+        }
+    }
+}
+
+void RollbackSession::Rollback()
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    const int rollbackFrame = m_RollbackFrame;
+    m_RollbackFrame = -1;
+    if (rollbackFrame < m_CurrentFrame - g_MaxRollbackFrames)
+    {
+        std::cerr << "Rollback to frame " << rollbackFrame << " is outside of the rollback window\n";
+        return;
+    }
+    if (!m_Scene->LoadState(m_Snapshots[rollbackFrame % m_Snapshots.size()]))
+        std::cerr << "Rollback to frame " << rollbackFrame << " could not restore every object\n";
+
+    const int endFrame = m_CurrentFrame;
+    m_CurrentFrame = rollbackFrame;
+    //the frames are replayed, not heard again
+    ServiceLocator::SetMuted(true);
+    while (m_CurrentFrame < endFrame) SimulateFrame();
+    ServiceLocator::SetMuted(false);
+
+    ++m_LastStats.nrOfRollbacks;
+    m_LastStats.nrOfResimulatedFrames += endFrame - rollbackFrame;
+    m_LastStats.rollbackCost += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+}
+
+#pragma region Packets
+
+void RollbackSession::ReceiveInputs()
+{
+    const int remotePlayer = GetRemotePlayer();
+    InputBuffer& remoteInputs = m_Inputs[remotePlayer];
+    while (m_Transport->Receive(m_Packet))
+    {
+        PacketHeader header{};
+        if (m_Packet.size() < sizeof(header)) continue;
+        std::memcpy(&header, m_Packet.data(), sizeof(header));
+        if (header.sessionId != m_SessionId || header.player != remotePlayer ||
+            m_Packet.size() < sizeof(header) + header.nrOfInputs * sizeof(InputWord)) continue;
+        m_IsConnected = true;
+        m_RemoteAck = std::max(m_RemoteAck, static_cast<int>(header.ackFrame));
+
+        for (int i{}; i < header.nrOfInputs; ++i)
+        {
+            const int frame = header.firstFrame + i;
+            if (remoteInputs.IsConfirmed(frame)) continue;
+            //frames past the window would overwrite inputs that are still needed, they get resent
+            if (frame - m_CurrentFrame >= InputBuffer::g_Capacity - g_MaxRollbackFrames - 2) break;
+            InputWord input{};
+            std::memcpy(&input, m_Packet.data() + sizeof(header) + i * sizeof(InputWord), sizeof(InputWord));
+            if (!remoteInputs.Confirm(frame, input)) break;
+            const bool wasMispredicted = frame < m_CurrentFrame &&
+                m_UsedInputs[remotePlayer][frame % InputBuffer::g_Capacity] != input;
+            if (wasMispredicted && (m_RollbackFrame == -1 || frame < m_RollbackFrame)) m_RollbackFrame = frame;
+        }
+    }
+}
+
+void RollbackSession::SendInputs()
+{
+    const InputBuffer& localInputs = m_Inputs[m_LocalPlayer];
+    const int lastFrame = localInputs.GetLastConfirmedFrame();
+    //everything the remote has not acknowledged yet, so a lost packet costs nothing
+    const int firstFrame = std::max(m_RemoteAck + 1, lastFrame - InputBuffer::g_Capacity / 2 + 1);
+    const int nrOfInputs = std::max(lastFrame - firstFrame + 1, 0);
+
+    PacketHeader header{};
+    header.sessionId = m_SessionId;
+    header.player = static_cast<uint8_t>(m_LocalPlayer);
+    header.nrOfInputs = static_cast<uint8_t>(nrOfInputs);
+    header.firstFrame = firstFrame;
+    header.ackFrame = m_Inputs[GetRemotePlayer()].GetLastConfirmedFrame();
+
+    m_Packet.resize(sizeof(header) + nrOfInputs * sizeof(InputWord));
+    std::memcpy(m_Packet.data(), &header, sizeof(header));
+    for (int i{}; i < nrOfInputs; ++i)
+    {
+        const InputWord input = localInputs.Get(firstFrame + i);
+        std::memcpy(m_Packet.data() + sizeof(header) + i * sizeof(InputWord), &input, sizeof(InputWord));
+    }
+    m_Transport->Send(m_Packet);
+}
+
+#pragma endregion
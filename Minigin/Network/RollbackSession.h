@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "InputBuffer.h"
+#include "../Snapshot.h"
+#include "../Input/Command.h"
+
+namespace GameEngine
+{
+    class ITransport;
+    class Scene;
+
+    //Runs a scene in fixed steps for two peers. Inputs are exchanged per frame, the remote input
+    //of frames that did not arrive yet is predicted. When a prediction turns out wrong the scene
+    //is restored to the snapshot of that frame and the frames since are simulated again.
+    //Inputs only reach the simulation through the actions bound to their bits, so both peers
+    //run the same commands on the same frames.
+    class RollbackSession final
+    {
+    public:
+        using InputWord = InputBuffer::InputWord;
+        static constexpr int g_NrOfPlayers{ 2 };
+        static constexpr int g_MaxRollbackFrames{ 8 };
+
+        struct Stats
+        {
+            int nrOfRollbacks{};
+            int nrOfResimulatedFrames{};
+            std::chrono::microseconds rollbackCost{};
+        };
+
+        //sessionId tells packets of consecutive sessions over the same transport apart
+        RollbackSession(Scene* scene, ITransport* transport, int localPlayer, uint16_t sessionId);
+        RollbackSession(const RollbackSession& other) = delete;
+        RollbackSession(RollbackSession&& other) noexcept = delete;
+        RollbackSession& operator=(const RollbackSession& other) = delete;
+        RollbackSession& operator=(RollbackSession&& other) noexcept = delete;
+        ~RollbackSession() = default;
+
+        //command runs on the frames the input bit of the player is held, pressed or released,
+        //depending on its ExecuteOnKeyState
+        void BindAction(int player, InputWord input, std::unique_ptr<Command>&& command);
+        //Bits held by the local player, gathered until a simulated frame takes them
+        void RecordLocalInput(InputWord input) { m_LocalInput |= input; }
+        void SetInputDelay(int nrOfFrames) { m_InputDelay = nrOfFrames; }
+        void SetTimeStep(float seconds) { m_TimeStep = seconds; }
+
+        //Replaces Scene::Update for the scene of the session
+        void Update();
+
+        [[nodiscard]] bool IsConnected() const { return m_IsConnected; }
+        [[nodiscard]] int GetCurrentFrame() const { return m_CurrentFrame; }
+        //Counters of the last update and of the whole session
+        [[nodiscard]] const Stats& GetLastStats() const { return m_LastStats; }
+        [[nodiscard]] const Stats& GetTotalStats() const { return m_TotalStats; }
+    private:
+        struct PacketHeader
+        {
+            uint16_t sessionId;
+            uint8_t player;
+            uint8_t nrOfInputs;
+            int32_t firstFrame;
+            //last frame of the receiver the sender has confirmed
+            int32_t ackFrame;
+        };
+        void ReceiveInputs();
+        void SendInputs();
+        void Rollback();
+        void SimulateFrame();
+        void ApplyInputs(int frame);
+        [[nodiscard]] int GetRemotePlayer() const { return 1 - m_LocalPlayer; }
+
+        Scene* m_Scene;
+        ITransport* m_Transport;
+        int m_LocalPlayer;
+        uint16_t m_SessionId;
+        int m_InputDelay{ 2 };
+        float m_TimeStep{ 1.f / 60.f };
+        float m_AccumulatedTime{};
+        bool m_IsConnected{ false };
+
+        InputWord m_LocalInput{};
+        int m_CurrentFrame{};
+        //earliest frame that was simulated with a wrong prediction, -1 if none
+        int m_RollbackFrame{ -1 };
+        int m_RemoteAck{ -1 };
+        std::array<InputBuffer, g_NrOfPlayers> m_Inputs{};
+        //the inputs each frame was simulated with, compared against the confirmed ones
+        std::array<std::array<InputWord, InputBuffer::g_Capacity>, g_NrOfPlayers> m_UsedInputs{};
+        std::array<std::vector<std::pair<InputWord, std::unique_ptr<Command>>>, g_NrOfPlayers> m_Actions;
+        //state at the start of each frame in the rollback window
+        std::array<Snapshot, g_MaxRollbackFrames + 1> m_Snapshots;
+        std::vector<std::byte> m_Packet;
+
+        Stats m_LastStats{};
+        Stats m_TotalStats{};
+    };
+
+    //Records an input bit of the local player instead of acting on it directly
+    class RecordInputCommand final : public Command
+    {
+    public:
+        RecordInputCommand(RollbackSession* session, RollbackSession::InputWord input) :
+            Command(nullptr), m_Session(session), m_Input(input) {}
+        void Execute() override { m_Session->RecordLocalInput(m_Input); }
+        [[nodiscard]] ExecuteOn ExecuteOnKeyState() const override { return ExecuteOn::keyPressed; }
+    private:
+        RollbackSession* m_Session;
+        RollbackSession::InputWord m_Input;
+    };
+}
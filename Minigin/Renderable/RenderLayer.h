@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace GameEngine
+{
+    //Draw order of the recorded commands, a layer is drawn over the ones before it
+    enum class RenderLayer : uint8_t
+    {
+        background,
+        objects,
+        foreground,
+        ui,
+        debug
+    };
+    constexpr int g_NrOfRenderLayers{ static_cast<int>(RenderLayer::debug) + 1 };
+}
@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <stdexcept>
 #include "Renderer.h"
 #include "Minigin/Managers/SceneManager.h"
+#include "Minigin/Managers/FramePacer.h"
 #include "Texture2D.h"
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui.h>
@@ -23,75 +27,461 @@ int GetOpenGLDriverIndex()
     return openglIndex;
 }
 
+namespace
+{
+    bool IsSameRect(const SDL_Rect& a, const SDL_Rect& b)
+    {
+        return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+    }
+
+    //ARGB8888, rounded to the nearest color
+    uint32_t Unpremultiply(uint32_t pixel)
+    {
+        const uint32_t alpha = pixel >> 24;
+        if (alpha == 0) return 0;
+        const auto unpremultiply = [alpha](uint32_t channel) {
+            return std::min<uint32_t>((channel * 255 + alpha / 2) / alpha, 255);
+        };
+        return (alpha << 24) | (unpremultiply((pixel >> 16) & 0xFF) << 16) | (unpremultiply((pixel >> 8) & 0xFF) << 8)
+            | unpremultiply(pixel & 0xFF);
+    }
+}
+
+//Only the fields a cacheable command uses are compared, new or changed text is a new texture
+bool GameEngine::Renderer::RenderCommand::IsSameAs(const RenderCommand& other) const
+{
+    return type == other.type && flipMode == other.flipMode && texture == other.texture &&
+        IsSameRect(srcRect, other.srcRect) && IsSameRect(destRect, other.destRect) &&
+        color.r == other.color.r && color.g == other.color.g && color.b == other.color.b && color.a == other.color.a;
+}
+
+void GameEngine::Renderer::RenderList::Clear()
+{
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+    uiEvents.clear();
+    isCaptured = false;
+}
+
 void GameEngine::Renderer::Init(SDL_Window* window)
 {
     m_window = window;
-    m_renderer = SDL_CreateRenderer(window, GetOpenGLDriverIndex(), SDL_RENDERER_ACCELERATED);
+    //the GL context is current on the thread that creates the renderer, so the render thread creates it.
+    //It counts as busy until it is done
+    m_IsRunning = true;
+    m_IsFrameSubmitted = true;
+    m_RenderThread = std::thread(&Renderer::RunRenderThread, this);
+    WaitForRenderThread();
+    if (m_InitException != nullptr)
+    {
+        m_RenderThread.join();
+        std::rethrow_exception(m_InitException);
+    }
+}
+
+void GameEngine::Renderer::InitRenderThread()
+{
+    //SDL_RENDER_DRIVER=software picks SDL's software renderer, handy to measure the cost of a frame's draw calls
+    const bool isDriverForced = SDL_GetHint(SDL_HINT_RENDER_DRIVER) != nullptr;
+    m_renderer = SDL_CreateRenderer(m_window, isDriverForced ? -1 : GetOpenGLDriverIndex(),
+        isDriverForced ? 0 : SDL_RENDERER_ACCELERATED);
     if (m_renderer == nullptr)
     {
         throw std::runtime_error(std::string("SDL_CreateRenderer Error: ") + SDL_GetError());
     }
+
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(m_renderer, &info);
+    //layer textures hold premultiplied colors, drawn with the blend mode below they match drawing the commands directly.
+    //Renderers that can't compose it (e.g. the software renderer) get a straight alpha copy of the layer instead,
+    //regular blending would darken the translucent pixels of the premultiplied one
+    m_CacheBlendMode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+        SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    m_IsLayerCachingSupported = (info.flags & SDL_RENDERER_TARGETTEXTURE) != 0;
+    if (m_IsLayerCachingSupported)
+    {
+        SDL_Texture* probe = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, 1, 1);
+        m_IsCachePremultiplied = probe != nullptr && SDL_SetTextureBlendMode(probe, m_CacheBlendMode) == 0;
+        if (probe != nullptr) SDL_DestroyTexture(probe);
+    }
+
+    //the ImGui backend draws with OpenGL, it is left out on the other renderers
+    m_IsUsingImGui = !strcmp(info.name, "opengl");
+    if (!m_IsUsingImGui) return;
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
-    ImGui_ImplSDL2_InitForOpenGL(window, SDL_GL_GetCurrentContext());
+    ImGui_ImplSDL2_InitForOpenGL(m_window, SDL_GL_GetCurrentContext());
     ImGui_ImplOpenGL3_Init();
 }
 
-void GameEngine::Renderer::Render() const
+void GameEngine::Renderer::RunRenderThread()
 {
-    const auto& color = GetBackgroundColor();
+    try
+    {
+        InitRenderThread();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_InitException = std::current_exception();
+        m_IsRunning = false;
+        m_IsFrameSubmitted = false;
+        m_ConditionVariable.notify_all();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsFrameSubmitted = false;
+    }
+    m_ConditionVariable.notify_all();
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_ConditionVariable.wait(lock, [this] { return m_IsFrameSubmitted || !m_IsRunning; });
+        if (!m_IsRunning) break;
+        //the simulation only writes to the other list until this one is handed back
+        RenderList& list = m_RenderLists[1 - m_WriteList];
+        lock.unlock();
+
+        DrawList(list);
+
+        lock.lock();
+        m_IsFrameSubmitted = false;
+        lock.unlock();
+        m_ConditionVariable.notify_all();
+    }
+
+    ReleaseLayerCaches();
+    if (m_IsUsingImGui)
+    {
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplSDL2_Shutdown();
+        ImGui::DestroyContext();
+    }
+    if (m_renderer != nullptr)
+    {
+        SDL_DestroyRenderer(m_renderer);
+        m_renderer = nullptr;
+    }
+}
+
+void GameEngine::Renderer::WaitForRenderThread()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_ConditionVariable.wait(lock, [this] { return !m_IsFrameSubmitted; });
+}
+
+void GameEngine::Renderer::SubmitFrame(float updateTime, std::chrono::high_resolution_clock::time_point inputTime)
+{
+    RenderList& list = m_RenderLists[m_WriteList];
+    list.clearColor = m_clearColor;
+    list.updateTime = updateTime;
+    list.inputTime = inputTime;
+    list.cachedLayers = m_CachedLayers;
+    SceneManager::GetInstance().Render();
+    m_CurrentLayer = RenderLayer::objects;
+
+    WaitForRenderThread();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_WriteList = 1 - m_WriteList;
+        m_IsFrameSubmitted = true;
+    }
+    m_ConditionVariable.notify_all();
+    //the render thread is done with this one, it was drawn last frame
+    m_RenderLists[m_WriteList].Clear();
+}
+
+GameEngine::Renderer::CapturedFrame GameEngine::Renderer::CaptureFrame()
+{
+    m_RenderLists[m_WriteList].isCaptured = true;
+    SubmitFrame(0.f, std::chrono::high_resolution_clock::now());
+    WaitForRenderThread();
+    //the drawn list is left alone until the next frame is submitted
+    return std::move(m_RenderLists[1 - m_WriteList].capture);
+}
+
+void GameEngine::Renderer::DrawList(RenderList& list)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    m_NrOfDrawCalls = 0;
+    for (const auto& event : list.uiEvents)
+    {
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+        {
+            for (auto& cache : m_LayerCaches) cache.commands.clear();
+        }
+    }
+
+    const auto& color = list.clearColor;
     SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
     SDL_RenderClear(m_renderer);
 
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplSDL2_NewFrame();
-    ImGui::NewFrame();
+    std::ranges::stable_sort(list.commands, {}, &RenderCommand::layer);
+    for (auto first = list.commands.begin(); first != list.commands.end();)
+    {
+        const RenderLayer layer = first->layer;
+        const auto last = std::find_if(first, list.commands.end(),
+            [layer](const RenderCommand& command) { return command.layer != layer; });
+        const std::span<const RenderCommand> commands{ first, last };
+        const auto layerIndex = static_cast<int>(layer);
+        const bool isCached = (list.cachedLayers & (1u << layerIndex)) != 0;
+        if (!isCached || !DrawCachedLayer(m_LayerCaches[layerIndex], commands, list))
+            DrawCommands(commands, list, SDL_Point{});
+        first = last;
+    }
 
-    SceneManager::GetInstance().Render();
+    if (list.isCaptured)
+    {
+        auto& capture = list.capture;
+        capture.nrOfDrawCalls = m_NrOfDrawCalls;
+        SDL_GetRendererOutputSize(m_renderer, &capture.width, &capture.height);
+        capture.pixels.resize(static_cast<size_t>(capture.width) * capture.height);
+        if (SDL_RenderReadPixels(m_renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, capture.pixels.data(),
+            capture.width * static_cast<int>(sizeof(uint32_t))) != 0)
+        {
+            capture = CapturedFrame{};
+        }
+    }
 
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (m_IsUsingImGui)
+    {
+        for (auto& event : list.uiEvents) ImGui_ImplSDL2_ProcessEvent(&event);
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplSDL2_NewFrame();
+        ImGui::NewFrame();
+        #ifndef NDEBUG
+        DrawProfiler(list.updateTime, m_LastRenderTime);
+        #endif
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
 
     SDL_RenderPresent(m_renderer);
+    FramePacer::GetInstance().RecordPresent(list.inputTime);
+    const auto renderTime = std::chrono::high_resolution_clock::now() - start;
+    m_LastRenderTime = std::chrono::duration<float, std::milli>(renderTime).count();
+    auto& telemetry = Telemetry::GetInstance();
+    telemetry.Record(m_RenderTimeMetric, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(renderTime).count()));
+    telemetry.Record(m_DrawCallMetric, static_cast<uint64_t>(m_NrOfDrawCalls));
+}
+
+void GameEngine::Renderer::DrawCommands(std::span<const RenderCommand> commands, const RenderList& list,
+    SDL_Point offset)
+{
+    for (const auto& command : commands)
+    {
+        SDL_Rect destRect{ command.destRect.x + offset.x, command.destRect.y + offset.y,
+            command.destRect.w, command.destRect.h };
+        switch (command.type)
+        {
+        case RenderCommand::Type::texture:
+            if (command.angle == 0.f && command.flipMode == SDL_FLIP_NONE)
+                SDL_RenderCopy(m_renderer, command.texture->GetSDLTexture(), &command.srcRect, &destRect);
+            else
+                SDL_RenderCopyEx(m_renderer, command.texture->GetSDLTexture(), &command.srcRect, &destRect,
+                    command.angle, &command.center, command.flipMode);
+            break;
+        case RenderCommand::Type::rect:
+            SDL_SetRenderDrawColor(m_renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+            SDL_RenderDrawRect(m_renderer, &destRect);
+            break;
+        case RenderCommand::Type::geometry:
+            SDL_RenderGeometry(m_renderer, command.texture != nullptr ? command.texture->GetSDLTexture() : nullptr,
+                list.vertices.data() + command.firstVertex, static_cast<int>(command.nrOfVertices),
+                list.indices.data() + command.firstIndex, static_cast<int>(command.nrOfIndices));
+            break;
+        }
+    }
+    m_NrOfDrawCalls += static_cast<int>(commands.size());
+}
+
+bool GameEngine::Renderer::DrawCachedLayer(LayerCache& cache, std::span<const RenderCommand> commands,
+    const RenderList& list)
+{
+    if (!m_IsLayerCachingSupported) return false;
+    const bool isCacheable = std::ranges::none_of(commands, [](const RenderCommand& command) {
+        return command.type == RenderCommand::Type::geometry || command.angle != 0.f;
+    });
+    if (!isCacheable) return false;
+
+    if (!std::ranges::equal(commands, cache.commands,
+        [](const RenderCommand& a, const RenderCommand& b) { return a.IsSameAs(b); }))
+    {
+        if (!CompositeLayer(cache, commands, list))
+        {
+            cache.commands.clear();
+            return false;
+        }
+    }
+    if (cache.bounds.w <= 0 || cache.bounds.h <= 0) return true;
+
+    const SDL_Rect srcRect{ 0, 0, cache.bounds.w, cache.bounds.h };
+    SDL_RenderCopy(m_renderer, m_IsCachePremultiplied ? cache.target : cache.straightTexture, &srcRect, &cache.bounds);
+    ++m_NrOfDrawCalls;
+    return true;
+}
+
+bool GameEngine::Renderer::CompositeLayer(LayerCache& cache, std::span<const RenderCommand> commands,
+    const RenderList& list)
+{
+    cache.bounds = commands.front().destRect;
+    for (const auto& command : commands.subspan(1))
+    {
+        SDL_UnionRect(&cache.bounds, &command.destRect, &cache.bounds);
+    }
+    cache.commands.assign(commands.begin(), commands.end());
+    if (cache.bounds.w <= 0 || cache.bounds.h <= 0) return true;
+
+    //the target only grows, so a label changing length doesn't reallocate it every time
+    if (cache.target == nullptr || cache.targetSize.x < cache.bounds.w || cache.targetSize.y < cache.bounds.h)
+    {
+        if (cache.target != nullptr) SDL_DestroyTexture(cache.target);
+        if (cache.straightTexture != nullptr) SDL_DestroyTexture(cache.straightTexture);
+        cache.straightTexture = nullptr;
+        cache.targetSize = SDL_Point{ std::max(cache.targetSize.x, cache.bounds.w), std::max(cache.targetSize.y, cache.bounds.h) };
+        cache.target = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+            cache.targetSize.x, cache.targetSize.y);
+        if (!m_IsCachePremultiplied && cache.target != nullptr)
+        {
+            cache.straightTexture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                cache.targetSize.x, cache.targetSize.y);
+            if (cache.straightTexture == nullptr)
+            {
+                SDL_DestroyTexture(cache.target);
+                cache.target = nullptr;
+            }
+        }
+        if (cache.target == nullptr)
+        {
+            cache.targetSize = SDL_Point{};
+            return false;
+        }
+        if (m_IsCachePremultiplied) SDL_SetTextureBlendMode(cache.target, m_CacheBlendMode);
+        else SDL_SetTextureBlendMode(cache.straightTexture, SDL_BLENDMODE_BLEND);
+    }
+
+    if (SDL_SetRenderTarget(m_renderer, cache.target) != 0) return false;
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(m_renderer);
+    DrawCommands(commands, list, SDL_Point{ -cache.bounds.x, -cache.bounds.y });
+    const bool isConverted = m_IsCachePremultiplied || ConvertToStraightAlpha(cache);
+    SDL_SetRenderTarget(m_renderer, nullptr);
+    return isConverted;
+}
+
+//Runs while the layer's target is the render target, only when the layer changed
+bool GameEngine::Renderer::ConvertToStraightAlpha(LayerCache& cache)
+{
+    const SDL_Rect rect{ 0, 0, cache.bounds.w, cache.bounds.h };
+    const int pitch = rect.w * static_cast<int>(sizeof(uint32_t));
+    cache.pixels.resize(static_cast<size_t>(rect.w) * rect.h);
+    if (SDL_RenderReadPixels(m_renderer, &rect, SDL_PIXELFORMAT_ARGB8888, cache.pixels.data(), pitch) != 0) return false;
+    std::ranges::transform(cache.pixels, cache.pixels.begin(), Unpremultiply);
+    return SDL_UpdateTexture(cache.straightTexture, &rect, cache.pixels.data(), pitch) == 0;
+}
+
+void GameEngine::Renderer::ReleaseLayerCaches()
+{
+    for (auto& cache : m_LayerCaches)
+    {
+        if (cache.target != nullptr) SDL_DestroyTexture(cache.target);
+        if (cache.straightTexture != nullptr) SDL_DestroyTexture(cache.straightTexture);
+        cache = LayerCache{};
+    }
+}
+
+void GameEngine::Renderer::DrawProfiler(float updateTime, float renderTime)
+{
+    m_UpdateTimes[m_ProfilerSample] = updateTime;
+    m_RenderTimes[m_ProfilerSample] = renderTime;
+    m_ProfilerSample = (m_ProfilerSample + 1) % nrOfProfilerSamples;
+
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Profiler");
+    ImGui::Text("update %.2f ms, render %.2f ms", updateTime, renderTime);
+    ImGui::Text("draw calls %d", m_NrOfDrawCalls);
+    ImGui::PlotLines("update", m_UpdateTimes.data(), nrOfProfilerSamples, m_ProfilerSample, nullptr, 0.f, 10.f, ImVec2{ 0, 40 });
+    ImGui::PlotLines("render", m_RenderTimes.data(), nrOfProfilerSamples, m_ProfilerSample, nullptr, 0.f, 10.f, ImVec2{ 0, 40 });
+    ImGui::End();
 }
 
 void GameEngine::Renderer::Destroy()
 {
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplSDL2_Shutdown();
-    ImGui::DestroyContext();
-    if (m_renderer != nullptr)
+    if (!m_RenderThread.joinable()) return;
+    WaitForRenderThread();
     {
-        SDL_DestroyRenderer(m_renderer);
-        m_renderer = nullptr;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsRunning = false;
     }
+    m_ConditionVariable.notify_all();
+    m_RenderThread.join();
 }
 
-void GameEngine::Renderer::RenderTexture(const Texture2D& texture, const float x, const float y) const
+void GameEngine::Renderer::RenderTexture(const Texture2D& texture, const float x, const float y)
 {
-    SDL_Rect dst{};
-    dst.x = static_cast<int>(x);
-    dst.y = static_cast<int>(y);
-    SDL_QueryTexture(texture.GetSDLTexture(), nullptr, nullptr, &dst.w, &dst.h);
-    SDL_RenderCopy(GetSDLRenderer(), texture.GetSDLTexture(), nullptr, &dst);
+    const auto size = texture.GetSize();
+    RenderTexture(texture, SDL_Rect{ 0, 0, size.x, size.y }, SDL_Rect{ static_cast<int>(x), static_cast<int>(y), size.x, size.y });
 }
 
 void GameEngine::Renderer::RenderTexture(const Texture2D& texture, const SDL_Rect& srcRect,
-    const SDL_Rect& destRect) const
+    const SDL_Rect& destRect)
+{
+    RenderTexture(texture, srcRect, destRect, 0.f, SDL_Point{}, SDL_FLIP_NONE);
+}
+void GameEngine::Renderer::RenderRect(const SDL_Rect& rect, const SDL_Color& color)
 {
-    SDL_RenderCopy(GetSDLRenderer(), texture.GetSDLTexture(), &srcRect, &destRect);
+    RenderCommand command{};
+    command.type = RenderCommand::Type::rect;
+    command.layer = m_CurrentLayer;
+    command.destRect = rect;
+    command.color = color;
+    m_RenderLists[m_WriteList].commands.emplace_back(command);
 }
-void GameEngine::Renderer::RenderRect(const SDL_Rect& rect, const SDL_Color& color) const
+void GameEngine::Renderer::RenderGeometry(const Texture2D* texture, const SDL_Vertex* vertices, int nrOfVertices,
+    const int* indices, int nrOfIndices)
 {
-    SDL_SetRenderDrawColor(GetSDLRenderer(), color.r, color.g, color.b, color.a); // Set the color to red
-    SDL_RenderDrawRect(GetSDLRenderer(), &rect); // Draw the rectangle
+    RenderList& list = m_RenderLists[m_WriteList];
+    RenderCommand command{};
+    command.type = RenderCommand::Type::geometry;
+    command.layer = m_CurrentLayer;
+    command.texture = texture;
+    command.firstVertex = static_cast<uint32_t>(list.vertices.size());
+    command.firstIndex = static_cast<uint32_t>(list.indices.size());
+    command.nrOfVertices = static_cast<uint32_t>(nrOfVertices);
+    command.nrOfIndices = static_cast<uint32_t>(nrOfIndices);
+    list.vertices.insert(list.vertices.end(), vertices, vertices + nrOfVertices);
+    list.indices.insert(list.indices.end(), indices, indices + nrOfIndices);
+    list.commands.emplace_back(command);
 }
 
 void GameEngine::Renderer::RenderTexture(const Texture2D& texture, const SDL_Rect& srcRect,
-    const SDL_Rect& destRect, float angle, SDL_Point center, const SDL_RendererFlip& flipMode = SDL_FLIP_NONE) const
+    const SDL_Rect& destRect, float angle, SDL_Point center, const SDL_RendererFlip& flipMode = SDL_FLIP_NONE)
+{
+    RenderCommand command{};
+    command.type = RenderCommand::Type::texture;
+    command.flipMode = flipMode;
+    command.layer = m_CurrentLayer;
+    command.texture = &texture;
+    command.srcRect = srcRect;
+    command.destRect = destRect;
+    command.angle = angle;
+    command.center = center;
+    m_RenderLists[m_WriteList].commands.emplace_back(command);
+}
+
+void GameEngine::Renderer::SetLayerCaching(RenderLayer layer, bool isCached)
+{
+    const uint32_t layerBit = 1u << static_cast<int>(layer);
+    if (isCached) m_CachedLayers |= layerBit;
+    else m_CachedLayers &= ~layerBit;
+}
+
+void GameEngine::Renderer::QueueUIEvent(const SDL_Event& event)
 {
-    SDL_RenderCopyEx(GetSDLRenderer(), texture.GetSDLTexture(), &srcRect, &destRect,
-        angle, &center, flipMode);
+    m_RenderLists[m_WriteList].uiEvents.emplace_back(event);
 }
 
 SDL_Renderer* GameEngine::Renderer::GetSDLRenderer() const { return m_renderer; }
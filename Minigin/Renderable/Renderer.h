@@ -1,30 +1,162 @@
 #pragma once
 #include <SDL.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
 #include "../Managers/Singleton.h"
+#include "RenderLayer.h"
+#include "../Managers/Telemetry.h"
 
 namespace GameEngine
 {
     class Texture2D;
     /**
-     * Simple RAII wrapper for the SDL renderer
+     * Records the draw calls of a frame and replays them on its own render thread, which owns
+     * the SDL renderer. The simulation records the next frame while the previous one is drawn.
+     * Layers marked as cached are composited into an offscreen texture and redrawn from it with a
+     * single copy for as long as their recorded commands stay the same
      */
     class Renderer final : public Singleton<Renderer>
     {
+    public:
+        //A drawn frame read back from the renderer
+        struct CapturedFrame
+        {
+            int width;
+            int height;
+            //ARGB8888, row by row
+            std::vector<uint32_t> pixels;
+            //including the ones that composited cached layers
+            int nrOfDrawCalls;
+            [[nodiscard]] uint32_t GetPixel(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+        };
+    private:
+        struct RenderCommand
+        {
+            enum class Type : uint8_t { texture, rect, geometry };
+            Type type;
+            SDL_RendererFlip flipMode;
+            RenderLayer layer;
+            const Texture2D* texture;
+            SDL_Rect srcRect;
+            SDL_Rect destRect;
+            float angle;
+            SDL_Point center;
+            SDL_Color color;
+            //ranges of the frame's vertex and index buffers used by geometry commands
+            uint32_t firstVertex;
+            uint32_t firstIndex;
+            uint32_t nrOfVertices;
+            uint32_t nrOfIndices;
+            [[nodiscard]] bool IsSameAs(const RenderCommand& other) const;
+        };
+        struct RenderList
+        {
+            std::vector<RenderCommand> commands;
+            std::vector<SDL_Vertex> vertices;
+            std::vector<int> indices;
+            //handed to ImGui on the render thread, it isn't thread safe
+            std::vector<SDL_Event> uiEvents;
+            SDL_Color clearColor;
+            float updateTime;
+            //when the input of this frame was sampled
+            std::chrono::high_resolution_clock::time_point inputTime;
+            uint32_t cachedLayers;
+            bool isCaptured;
+            CapturedFrame capture;
+            void Clear();
+        };
+
         SDL_Renderer* m_renderer{};
         SDL_Window* m_window{};
         SDL_Color m_clearColor{};
+
+        struct LayerCache
+        {
+            SDL_Texture* target;
+            //the target's pixels converted to straight alpha, for renderers without premultiplied blending
+            SDL_Texture* straightTexture;
+            std::vector<uint32_t> pixels;
+            SDL_Point targetSize;
+            //screen area covered by the layer, drawn from the top left of the target
+            SDL_Rect bounds;
+            std::vector<RenderCommand> commands;
+        };
+
+        std::array<RenderList, 2> m_RenderLists{};
+        int m_WriteList{};
+        RenderLayer m_CurrentLayer{ RenderLayer::objects };
+        uint32_t m_CachedLayers{};
+        std::thread m_RenderThread;
+        std::mutex m_Mutex;
+        std::condition_variable m_ConditionVariable;
+        bool m_IsFrameSubmitted{};
+        bool m_IsRunning{};
+        std::exception_ptr m_InitException{};
+
+        static constexpr int nrOfProfilerSamples = 120;
+        std::array<float, nrOfProfilerSamples> m_UpdateTimes{};
+        std::array<float, nrOfProfilerSamples> m_RenderTimes{};
+        int m_ProfilerSample{};
+        float m_LastRenderTime{};
+        int m_NrOfDrawCalls{};
+        MetricId m_RenderTimeMetric{ Telemetry::GetInstance().RegisterHistogram("render us") };
+        MetricId m_DrawCallMetric{ Telemetry::GetInstance().RegisterHistogram("draw calls") };
+
+        //render thread only
+        std::array<LayerCache, g_NrOfRenderLayers> m_LayerCaches{};
+        SDL_BlendMode m_CacheBlendMode{ SDL_BLENDMODE_BLEND };
+        //set by the render thread before Init returns
+        bool m_IsLayerCachingSupported{};
+        bool m_IsCachePremultiplied{};
+        bool m_IsUsingImGui{};
+
+        void RunRenderThread();
+        void InitRenderThread();
+        void DrawList(RenderList& list);
+        void DrawCommands(std::span<const RenderCommand> commands, const RenderList& list, SDL_Point offset);
+        //Returns false if the commands can't be cached and have to be drawn directly
+        bool DrawCachedLayer(LayerCache& cache, std::span<const RenderCommand> commands, const RenderList& list);
+        bool CompositeLayer(LayerCache& cache, std::span<const RenderCommand> commands, const RenderList& list);
+        bool ConvertToStraightAlpha(LayerCache& cache);
+        void ReleaseLayerCaches();
+        void DrawProfiler(float updateTime, float renderTime);
+        void WaitForRenderThread();
     public:
         void Init(SDL_Window* window);
-        void Render() const;
+        //Records the current scene and hands it to the render thread once it is done with the previous frame
+        void SubmitFrame(float updateTime, std::chrono::high_resolution_clock::time_point inputTime);
+        //Submits the current scene, waits until it is drawn and reads it back without the ImGui overlay.
+        //Meant for checks and screenshots, the simulation stalls until the frame is drawn
+        [[nodiscard]] CapturedFrame CaptureFrame();
         void Destroy();
 
-        void RenderTexture(const Texture2D& texture, float x, float y) const;
-        void RenderTexture(const Texture2D& texture, const SDL_Rect& srcRect, const SDL_Rect& destRect) const;
-        void RenderRect(const SDL_Rect& rect, const SDL_Color& color) const;
+        void RenderTexture(const Texture2D& texture, float x, float y);
+        void RenderTexture(const Texture2D& texture, const SDL_Rect& srcRect, const SDL_Rect& destRect);
+        void RenderRect(const SDL_Rect& rect, const SDL_Color& color);
+        //Draws a batch of triangles in one call, a null texture draws them with their vertex colors only
+        void RenderGeometry(const Texture2D* texture, const SDL_Vertex* vertices, int nrOfVertices,
+            const int* indices, int nrOfIndices);
 
         void RenderTexture(const Texture2D& texture, const SDL_Rect& srcRect, const SDL_Rect& destRect,
-            float angle, SDL_Point center, const SDL_RendererFlip& flipMode) const;
+            float angle, SDL_Point center, const SDL_RendererFlip& flipMode);
+
+        //Commands of a higher layer are drawn over the ones of lower layers, within a layer they keep their order
+        void SetLayer(RenderLayer layer) { m_CurrentLayer = layer; }
+        //Meant for layers that rarely change, a layer holding rotated sprites or geometry is drawn directly
+        void SetLayerCaching(RenderLayer layer, bool isCached);
+        [[nodiscard]] bool IsLayerCached(RenderLayer layer) const { return (m_CachedLayers & (1u << static_cast<int>(layer))) != 0; }
+        //False if the renderer can't draw into textures, cached layers are then drawn directly
+        [[nodiscard]] bool IsLayerCachingSupported() const { return m_IsLayerCachingSupported; }
+        void QueueUIEvent(const SDL_Event& event);
 
+        //Only valid on the render thread
         [[nodiscard]] SDL_Renderer* GetSDLRenderer() const;
 
         [[nodiscard]] const SDL_Color& GetBackgroundColor() const { return m_clearColor; }
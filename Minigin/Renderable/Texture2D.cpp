@@ -1,24 +1,30 @@
 #include <SDL.h>
 #include "Texture2D.h"
+#include "Renderer.h"
 
 GameEngine::Texture2D::~Texture2D()
 {
 	SDL_DestroyTexture(m_Texture);
+	SDL_FreeSurface(m_Surface);
 }
 
 glm::ivec2 GameEngine::Texture2D::GetSize() const
 {
-	SDL_Rect dst;
-	SDL_QueryTexture(GetSDLTexture(), nullptr, nullptr, &dst.w, &dst.h);
-	return { dst.w,dst.h };
+	return m_Size;
 }
 
 SDL_Texture* GameEngine::Texture2D::GetSDLTexture() const
 {
+	if (m_Texture == nullptr && m_Surface != nullptr)
+	{
+		m_Texture = SDL_CreateTextureFromSurface(Renderer::GetInstance().GetSDLRenderer(), m_Surface);
+		SDL_FreeSurface(m_Surface);
+		m_Surface = nullptr;
+	}
 	return m_Texture;
 }
 
-GameEngine::Texture2D::Texture2D(SDL_Texture* texture)
-{
-	m_Texture = texture;
-}
+GameEngine::Texture2D::Texture2D(SDL_Surface* surface) :
+	m_Surface(surface),
+	m_Size(surface->w, surface->h)
+{}
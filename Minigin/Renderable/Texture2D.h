@@ -2,16 +2,20 @@
 #include <glm/vec2.hpp>
 
 struct SDL_Texture;
+struct SDL_Surface;
 namespace GameEngine
 {
 	/**
-	 * Simple RAII wrapper for an SDL_Texture
+	 * Simple RAII wrapper for an SDL_Texture. It is created from a surface and uploaded
+	 * by the render thread the first time it is drawn
 	 */
 	class Texture2D final
 	{
 	public:
+		//Only valid on the render thread
 		[[nodiscard]] SDL_Texture* GetSDLTexture() const;
-		explicit Texture2D(SDL_Texture* texture);
+		//Takes ownership of the surface
+		explicit Texture2D(SDL_Surface* surface);
 		~Texture2D();
 
 		[[nodiscard]] glm::ivec2 GetSize() const;
@@ -22,6 +26,8 @@ namespace GameEngine
 		Texture2D & operator= (const Texture2D &&) = delete;
 
 	private:
-		SDL_Texture* m_Texture;
+		mutable SDL_Texture* m_Texture{};
+		mutable SDL_Surface* m_Surface;
+		glm::ivec2 m_Size;
 	};
 }
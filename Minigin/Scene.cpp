@@ -4,15 +4,39 @@
 #include <algorithm>
 #include "Managers/CollisionManager.h"
 #include "Components/CollisionComponent.h"
+#include "Components/SpriteComponent.h"
 #include "Managers/TimeManager.h"
+#include "Renderable/Renderer.h"
+#include "Snapshot.h"
 
 using namespace GameEngine;
 
 //#define CHECK_COLLISION_RECTS
 
-Scene::Scene() : m_CollisionManager(std::make_unique<CollisionManager>())
+Scene::Scene() :
+    m_CollisionManager(std::make_unique<CollisionManager>()),
+    m_SpriteAnimator(std::make_unique<SpriteAnimator>()),
+    m_ParticleSystem(std::make_unique<ParticleSystem>())
 {}
 
+void Scene::RegisterComponents(GameObject* object)
+{
+    if (object->CheckIfComponentExists<CollisionComponent>())
+        m_CollisionManager->AddCollisionComponent(object->GetComponent<CollisionComponent>());
+    if (object->CheckIfComponentExists<SpriteComponent>())
+        m_SpriteAnimator->AddSprite(object->GetComponent<SpriteComponent>());
+    if (object->HasLateUpdate()) m_LateUpdateObjects.emplace_back(object);
+}
+
+void Scene::UnregisterComponents(GameObject* object)
+{
+    if (object->CheckIfComponentExists<CollisionComponent>())
+        m_CollisionManager->RemoveCollisionComponent(object->GetComponent<CollisionComponent>());
+    if (object->CheckIfComponentExists<SpriteComponent>())
+        m_SpriteAnimator->RemoveSprite(object->GetComponent<SpriteComponent>());
+    if (object->HasLateUpdate()) std::erase(m_LateUpdateObjects, object);
+}
+
 Scene::~Scene() = default;
 
 void Scene::AddGameObjectsToBeAdded()
@@ -24,39 +48,40 @@ void Scene::AddGameObjectsToBeAdded()
 
 GameObject* Scene::AddObject(std::unique_ptr<GameObject>&& object)
 {
-    if (object->CheckIfComponentExists<CollisionComponent>())
-    {
-        m_CollisionManager->AddCollisionComponent(object->GetComponent<CollisionComponent>());
-    }
+    RegisterComponents(object.get());
     m_GameObjectsToBeAdded.emplace_back(std::move(object));
     m_AreElemsToBeAdded = true;
     return m_GameObjectsToBeAdded.back().get();
 }
 
-IObserver* GameEngine::Scene::AddObserver(int message, std::unique_ptr<IObserver>&& observer, GameObject* gameObj)
+void Scene::ReserveObjects(size_t nrOfObjects)
 {
-    if (gameObj != nullptr)
-        gameObj->AddObserver(message, m_Observers.emplace_back(std::move(observer)).get());
-    else m_Observers.emplace_back(std::move(observer));
-    return m_Observers.back().get();
+    m_GameObjects.reserve(m_GameObjects.size() + nrOfObjects);
+    m_GameObjectsToBeAdded.reserve(m_GameObjectsToBeAdded.size() + nrOfObjects);
 }
 
 void Scene::Remove(const std::unique_ptr<GameObject>& object)
 {
-    if (object->CheckIfComponentExists<CollisionComponent>())
-    {
-        m_CollisionManager->RemoveCollisionComponent(object->GetComponent<CollisionComponent>());
-    }
+    UnregisterComponents(object.get());
     std::erase(m_GameObjects, object);
 }
 
 void Scene::RemoveAll()
 {
     m_GameObjects.clear();
+    m_DestroyedObjects.clear();
+    m_LateUpdateObjects.clear();
 }
 
 void Scene::Update()
 {
+    ++m_FrameNr;
+    if (!m_DestroyedObjects.empty())
+    {
+        std::erase_if(m_DestroyedObjects, [&](const DestroyedObject& destroyed) {
+            return m_FrameNr - destroyed.frameDestroyed > static_cast<uint64_t>(m_DestroyedObjectRetention);
+        });
+    }
     if (m_AreElemsToBeAdded) AddGameObjectsToBeAdded();
     bool areElemsToErase = false;
     for (const auto& object : m_GameObjects)
@@ -65,25 +90,120 @@ void Scene::Update()
         else areElemsToErase = true;
     }
     if (areElemsToErase) RemoveDestroyedObjects();
+    //after every object, so what they submitted this frame is applied before sprites and collisions are checked
+    for (GameObject* object : m_LateUpdateObjects)
+    {
+        if (!object->IsDestroyed()) object->LateUpdate();
+    }
+    m_SpriteAnimator->Update();
+    m_ParticleSystem->Update();
     m_CollisionManager->CheckCollisions();
 }
 
 void Scene::Render() const
 {
+    auto& renderer = Renderer::GetInstance();
+    renderer.SetLayer(RenderLayer::background);
+    m_ParticleSystem->Render(ParticleLayer::background);
+    //objects set their own layer
     for (const auto& object : m_GameObjects)
     {
         object->Render();
     }
+    renderer.SetLayer(RenderLayer::foreground);
+    m_ParticleSystem->Render(ParticleLayer::foreground);
     #ifdef CHECK_COLLISION_RECTS
+    renderer.SetLayer(RenderLayer::debug);
     m_CollisionManager->RenderCollisionRects();
     #endif
 }
 
 void Scene::RemoveDestroyedObjects()
 {
-    std::erase_if(m_GameObjects, [&](const auto& obj) {
-        if (obj->IsDestroyed() && obj->template CheckIfComponentExists<CollisionComponent>())
-            m_CollisionManager->RemoveCollisionComponent(obj->template GetComponent<CollisionComponent>());
-        return obj->IsDestroyed();
-    });
+    if (m_DestroyedObjectRetention <= 0)
+    {
+        std::erase_if(m_GameObjects, [&](const auto& obj) {
+            if (obj->IsDestroyed()) UnregisterComponents(obj.get());
+            return obj->IsDestroyed();
+        });
+        return;
+    }
+    const auto firstDestroyed = std::stable_partition(m_GameObjects.begin(), m_GameObjects.end(),
+        [](const auto& obj) { return !obj->IsDestroyed(); });
+    for (auto it = firstDestroyed; it != m_GameObjects.end(); ++it)
+    {
+        UnregisterComponents(it->get());
+        m_DestroyedObjects.push_back({ std::move(*it), m_FrameNr });
+    }
+    m_GameObjects.erase(firstDestroyed, m_GameObjects.end());
+}
+
+#pragma region Snapshot
+
+void Scene::SaveState(Snapshot& snapshot) const
+{
+    snapshot.Write(static_cast<uint32_t>(m_GameObjects.size() + m_GameObjectsToBeAdded.size()));
+    const auto saveObject = [&snapshot](const std::unique_ptr<GameObject>& object) {
+        snapshot.Write(object->GetSerialId());
+        const size_t block = snapshot.BeginBlock();
+        object->SaveState(snapshot);
+        snapshot.EndBlock(block);
+    };
+    std::ranges::for_each(m_GameObjects, saveObject);
+    std::ranges::for_each(m_GameObjectsToBeAdded, saveObject);
+    m_SpriteAnimator->SaveState(snapshot);
+    m_ParticleSystem->SaveState(snapshot);
+}
+
+bool Scene::LoadState(Snapshot& snapshot)
+{
+    m_SnapshotLookup.clear();
+    m_SnapshotLookup.reserve(m_GameObjects.size() + m_GameObjectsToBeAdded.size() + m_DestroyedObjects.size());
+    //everything alive gets flagged, restored objects overwrite the flag with their saved one
+    for (const auto& object : m_GameObjects)
+    {
+        m_SnapshotLookup.emplace(object->GetSerialId(), object.get());
+        object->SetDestroyedFlag();
+    }
+    for (const auto& object : m_GameObjectsToBeAdded)
+    {
+        m_SnapshotLookup.emplace(object->GetSerialId(), object.get());
+        object->SetDestroyedFlag();
+    }
+    for (const auto& destroyed : m_DestroyedObjects)
+        m_SnapshotLookup.emplace(destroyed.object->GetSerialId(), destroyed.object.get());
+    snapshot.Rewind();
+    snapshot.SetObjectLookup(&m_SnapshotLookup);
+
+    bool isComplete = true;
+    const auto nrOfObjects = snapshot.Read<uint32_t>();
+    for (uint32_t i{}; i < nrOfObjects; ++i)
+    {
+        const auto serialId = snapshot.Read<uint64_t>();
+        const size_t blockSize = snapshot.ReadBlockSize();
+        const size_t blockEnd = snapshot.GetReadPosition() + blockSize;
+        const auto it = m_SnapshotLookup.find(serialId);
+        if (it == m_SnapshotLookup.end() || !it->second->LoadState(snapshot))
+        {
+            isComplete = false;
+            snapshot.SkipBytes(blockEnd - snapshot.GetReadPosition());
+        }
+    }
+    snapshot.SetObjectLookup(nullptr);
+    m_SpriteAnimator->LoadState(snapshot);
+    m_ParticleSystem->LoadState(snapshot);
+
+    //objects that were restored from the retained ones go back into the scene
+    const auto firstRestored = std::stable_partition(m_DestroyedObjects.begin(), m_DestroyedObjects.end(),
+        [](const DestroyedObject& destroyed) { return destroyed.object->IsDestroyed(); });
+    for (auto it = firstRestored; it != m_DestroyedObjects.end(); ++it)
+    {
+        RegisterComponents(it->object.get());
+        m_GameObjectsToBeAdded.emplace_back(std::move(it->object));
+        m_AreElemsToBeAdded = true;
+    }
+    m_DestroyedObjects.erase(firstRestored, m_DestroyedObjects.end());
+    return isComplete;
 }
+
+#pragma endregion
@@ -2,19 +2,34 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
+#include <unordered_map>
 
 #include "Managers/CollisionManager.h"
+#include "Managers/SpriteAnimator.h"
+#include "Managers/ParticleSystem.h"
+#include "IObserver.h"
 
 namespace GameEngine
 {
 	class CollisionManager;
-	class IObserver;
 	class GameObject;
+	class Snapshot;
 	class Scene final
 	{
 	public:
 		GameObject* AddObject(std::unique_ptr<GameObject>&& object);
-		IObserver* AddObserver(int message,std::unique_ptr<IObserver>&& observer,GameObject* gameObj);
+		//The scene owns its observers, they connect to the objects they watch themselves
+		template<typename T>
+		T* AddObserver(std::unique_ptr<T>&& observer)
+		{
+			T* pObserver = observer.get();
+			m_Observers.emplace_back(std::move(observer));
+			return pObserver;
+		}
+		//Sizes the containers for scenes whose object and observer count is known up front
+		void ReserveObjects(size_t nrOfObjects);
+		void ReserveObservers(size_t nrOfObservers) { m_Observers.reserve(nrOfObservers); }
 		void Remove(const std::unique_ptr<GameObject>& object);
 		void RemoveAll();
 
@@ -23,6 +38,15 @@ namespace GameEngine
 		void Render() const;
 		void RemoveDestroyedObjects();
 
+		//Writes every object of the scene, including the ones added this frame
+		void SaveState(Snapshot& snapshot) const;
+		//Restores the saved objects in place. Objects created after the snapshot get destroyed.
+		//Returns false if some saved objects no longer exist and could not be restored
+		bool LoadState(Snapshot& snapshot);
+		//Keeps destroyed objects alive for the given amount of frames so a restore can bring them back
+		void SetDestroyedObjectRetention(int nrOfFrames) { m_DestroyedObjectRetention = nrOfFrames; }
+		[[nodiscard]] ParticleSystem* GetParticleSystem() const { return m_ParticleSystem.get(); }
+
 		explicit Scene();
 		~Scene();
 		Scene(const Scene& other) = delete;
@@ -33,10 +57,26 @@ namespace GameEngine
 	private:
 		void AddGameObjectsToBeAdded();
 		bool m_AreElemsToBeAdded = false;
+		void RegisterComponents(GameObject* object);
+		void UnregisterComponents(GameObject* object);
 		std::unique_ptr<CollisionManager> m_CollisionManager;
+		std::unique_ptr<SpriteAnimator> m_SpriteAnimator;
+		std::unique_ptr<ParticleSystem> m_ParticleSystem;
 		std::vector<std::unique_ptr<IObserver>> m_Observers;
 		std::vector<std::unique_ptr<GameObject>> m_GameObjects;
 		std::vector<std::unique_ptr<GameObject>> m_GameObjectsToBeAdded;
+		//late updated in the order they were added
+		std::vector<GameObject*> m_LateUpdateObjects;
+
+		struct DestroyedObject
+		{
+			std::unique_ptr<GameObject> object;
+			uint64_t frameDestroyed;
+		};
+		std::vector<DestroyedObject> m_DestroyedObjects;
+		std::unordered_map<uint64_t, GameObject*> m_SnapshotLookup;
+		int m_DestroyedObjectRetention{};
+		uint64_t m_FrameNr{};
 
 	};
 
@@ -0,0 +1,177 @@
+#include "SceneBlob.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace GameEngine;
+
+namespace
+{
+	constexpr std::array<char, 4> g_Magic{ 'S', 'C', 'N', 'B' };
+	//bump whenever a record changes, old blobs then have to be compiled again
+	constexpr uint32_t g_Version{ 1 };
+
+	struct BlobHeader
+	{
+		std::array<char, 4> magic;
+		uint32_t version;
+		//element count of every array, in the order they are stored in
+		std::array<uint32_t, 12> counts;
+	};
+
+	template<typename T>
+	void WriteArray(std::ofstream& file, const std::vector<T>& values)
+	{
+		file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+	}
+	template<typename T>
+	void ReadArray(std::ifstream& file, std::vector<T>& values, uint32_t count)
+	{
+		values.resize(count);
+		file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+	}
+
+	//saving and loading go through the arrays in the same order
+	template<typename Blob, typename Function>
+	void ForEachArray(Blob& blob, Function function)
+	{
+		function(blob.objectIds);
+		function(blob.componentTypes);
+		function(blob.observerTypes);
+		function(blob.commandTypes);
+		function(blob.resources);
+		function(blob.objects);
+		function(blob.components);
+		function(blob.observers);
+		function(blob.observedObjects);
+		function(blob.bindings);
+		function(blob.args);
+		function(blob.strings);
+	}
+}
+
+void SceneBlob::SaveToFile(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) throw std::runtime_error("Couldn't write the scene blob " + path);
+
+	BlobHeader header{ g_Magic, g_Version, {} };
+	size_t arrayIdx{};
+	ForEachArray(*this, [&](const auto& values) { header.counts[arrayIdx++] = static_cast<uint32_t>(values.size()); });
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ForEachArray(*this, [&](const auto& values) { WriteArray(file, values); });
+}
+
+void SceneBlob::LoadFromFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) throw std::runtime_error("Couldn't open the scene blob " + path);
+
+	BlobHeader header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || header.magic != g_Magic) throw std::runtime_error(path + " is not a scene blob");
+	if (header.version != g_Version) throw std::runtime_error(path + " was compiled by another version of the scene compiler");
+
+	size_t arrayIdx{};
+	ForEachArray(*this, [&](auto& values) { ReadArray(file, values, header.counts[arrayIdx++]); });
+	if (!file) throw std::runtime_error(path + " is truncated");
+}
+
+std::string_view SceneBlob::GetString(const SceneStringRef& string) const
+{
+	if (static_cast<size_t>(string.offset) + string.size > strings.size()) throw std::out_of_range("Scene string outside of the string pool");
+	return { strings.data() + string.offset, string.size };
+}
+
+size_t SceneBlob::GetObjectIndex(std::string_view name) const
+{
+	const auto it = std::ranges::find_if(objects, [&](const SceneObjectRecord& object) { return GetString(object.name) == name; });
+	if (it == objects.end()) throw std::runtime_error("The scene has no object named " + std::string(name));
+	return static_cast<size_t>(it - objects.begin());
+}
+
+SceneArgs::SceneArgs(const SceneBlob& blob, const SceneInstanceData& instance, uint32_t firstArg, uint16_t nrOfArgs) :
+	m_Blob(blob),
+	m_Instance(instance),
+	m_FirstArg(firstArg),
+	m_NrOfArgs(nrOfArgs)
+{
+	if (static_cast<size_t>(firstArg) + nrOfArgs > blob.args.size()) throw std::out_of_range("Scene arguments outside of the argument pool");
+}
+
+const SceneArg& SceneArgs::GetArg(size_t index, SceneArgType type) const
+{
+	if (index >= m_NrOfArgs) throw std::out_of_range("Missing scene argument " + std::to_string(index));
+	const SceneArg& arg = m_Blob.args[m_FirstArg + index];
+	if (arg.type != type) throw std::runtime_error("Scene argument " + std::to_string(index) + " has the wrong type");
+	return arg;
+}
+
+int SceneArgs::GetInt(size_t index) const
+{
+	return std::bit_cast<int32_t>(GetArg(index, SceneArgType::integer).value);
+}
+
+float SceneArgs::GetFloat(size_t index) const
+{
+	if (index < m_NrOfArgs && m_Blob.args[m_FirstArg + index].type == SceneArgType::integer) return static_cast<float>(GetInt(index));
+	return std::bit_cast<float>(GetArg(index, SceneArgType::number).value);
+}
+
+std::string_view SceneArgs::GetString(size_t index) const
+{
+	const SceneArg& arg = GetArg(index, SceneArgType::string);
+	return m_Blob.GetString({ arg.value, arg.size });
+}
+
+std::shared_ptr<Font> SceneArgs::GetFont(size_t index) const
+{
+	return m_Instance.fonts.at(GetArg(index, SceneArgType::font).value);
+}
+
+Texture2D* SceneArgs::GetTexture(size_t index) const
+{
+	return m_Instance.textures.at(GetArg(index, SceneArgType::texture).value);
+}
+
+GameObject* SceneArgs::GetObject(size_t index) const
+{
+	return m_Instance.objects.at(GetArg(index, SceneArgType::object).value);
+}
+
+SDL_Color SceneArgs::GetColor(size_t index) const
+{
+	const uint32_t rgba = GetArg(index, SceneArgType::color).value;
+	return { static_cast<Uint8>(rgba >> 24), static_cast<Uint8>(rgba >> 16), static_cast<Uint8>(rgba >> 8), static_cast<Uint8>(rgba) };
+}
+
+int SceneTypeRegistry::GetObjectId(const std::string& name) const
+{
+	const auto it = m_ObjectIds.find(name);
+	if (it == m_ObjectIds.end()) throw std::runtime_error("Unknown scene object id: " + name);
+	return it->second;
+}
+
+const SceneTypeRegistry::ComponentFactory& SceneTypeRegistry::GetComponent(const std::string& name) const
+{
+	const auto it = m_Components.find(name);
+	if (it == m_Components.end()) throw std::runtime_error("Unknown scene component type: " + name);
+	return it->second;
+}
+
+const SceneTypeRegistry::ObserverType& SceneTypeRegistry::GetObserver(const std::string& name) const
+{
+	const auto it = m_Observers.find(name);
+	if (it == m_Observers.end()) throw std::runtime_error("Unknown scene observer type: " + name);
+	return it->second;
+}
+
+const SceneTypeRegistry::CommandFactory& SceneTypeRegistry::GetCommand(const std::string& name) const
+{
+	const auto it = m_Commands.find(name);
+	if (it == m_Commands.end()) throw std::runtime_error("Unknown scene command type: " + name);
+	return it->second;
+}
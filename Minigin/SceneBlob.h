@@ -0,0 +1,218 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL_pixels.h>
+
+#include "IObserver.h"
+
+namespace GameEngine
+{
+	class Command;
+	class Font;
+	class GameObject;
+	class Scene;
+	class Texture2D;
+	enum class ControllerInputKey;
+	enum class KeyboardInputKey;
+
+	enum class SceneArgType : uint8_t
+	{
+		integer,
+		number,
+		string,
+		font,
+		texture,
+		object,
+		color
+	};
+	//Strings are an offset and size into the string pool, fonts and textures an index into the
+	//resources, objects an index into the objects. Numbers and colors are stored as their bits
+	struct SceneArg
+	{
+		SceneArgType type;
+		uint32_t value;
+		uint32_t size;
+	};
+	struct SceneStringRef
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+	struct SceneResourceRecord
+	{
+		SceneStringRef file;
+		//font size, 0 for textures
+		uint32_t size;
+	};
+	struct SceneObjectRecord
+	{
+		//index into the object ids
+		uint16_t id;
+		uint8_t renderLayer;
+		uint16_t nrOfComponents;
+		uint32_t firstComponent;
+		//-1 for top level objects, parents come before their children
+		int32_t parent;
+		float x;
+		float y;
+		//empty for objects nothing refers to
+		SceneStringRef name;
+	};
+	//Components, observers and bindings all refer to their type by index into their type names and
+	//to their arguments by a range of the argument pool
+	struct SceneComponentRecord
+	{
+		uint16_t type;
+		uint16_t nrOfArgs;
+		uint32_t firstArg;
+	};
+	struct SceneObserverRecord
+	{
+		uint16_t type;
+		uint16_t nrOfArgs;
+		uint32_t firstArg;
+		//range of the observed object indices
+		uint32_t firstObserved;
+		uint32_t nrOfObserved;
+	};
+	struct SceneBindingRecord
+	{
+		uint16_t type;
+		uint16_t nrOfArgs;
+		uint32_t firstArg;
+		//the object the command acts on
+		uint32_t target;
+		uint16_t key;
+		//-1 for keyboard keys
+		int16_t controllerIdx;
+	};
+
+	//A scene as a handful of flat arrays, see SceneCompiler for the text format it is compiled from.
+	//Everything a scene needs is counted up front and type names are stored once per type, so
+	//instantiating it resolves each type once and never looks up names per object
+	class SceneBlob final
+	{
+	public:
+		void LoadFromFile(const std::string& path);
+		void SaveToFile(const std::string& path) const;
+
+		[[nodiscard]] std::string_view GetString(const SceneStringRef& string) const;
+		//Index of the named object in the instantiated objects, throws if there is no such object
+		[[nodiscard]] size_t GetObjectIndex(std::string_view name) const;
+
+		std::vector<SceneStringRef> objectIds{};
+		std::vector<SceneStringRef> componentTypes{};
+		std::vector<SceneStringRef> observerTypes{};
+		std::vector<SceneStringRef> commandTypes{};
+		std::vector<SceneResourceRecord> resources{};
+		std::vector<SceneObjectRecord> objects{};
+		std::vector<SceneComponentRecord> components{};
+		std::vector<SceneObserverRecord> observers{};
+		std::vector<uint32_t> observedObjects{};
+		std::vector<SceneBindingRecord> bindings{};
+		std::vector<SceneArg> args{};
+		std::vector<char> strings{};
+	};
+
+	//The loaded resources and created objects an instantiation resolves its arguments against
+	struct SceneInstanceData
+	{
+		std::vector<std::shared_ptr<Font>> fonts{};
+		std::vector<Texture2D*> textures{};
+		std::vector<GameObject*> objects{};
+	};
+
+	//Typed view of the arguments of one component, observer or binding. Asking for the wrong type throws
+	class SceneArgs final
+	{
+	public:
+		SceneArgs(const SceneBlob& blob, const SceneInstanceData& instance, uint32_t firstArg, uint16_t nrOfArgs);
+
+		[[nodiscard]] size_t GetSize() const { return m_NrOfArgs; }
+		[[nodiscard]] int GetInt(size_t index) const;
+		//Integers are accepted too
+		[[nodiscard]] float GetFloat(size_t index) const;
+		[[nodiscard]] bool GetBool(size_t index) const { return GetInt(index) != 0; }
+		//Points into the blob, copy it if it has to outlive the instantiation
+		[[nodiscard]] std::string_view GetString(size_t index) const;
+		[[nodiscard]] std::shared_ptr<Font> GetFont(size_t index) const;
+		[[nodiscard]] Texture2D* GetTexture(size_t index) const;
+		[[nodiscard]] GameObject* GetObject(size_t index) const;
+		[[nodiscard]] SDL_Color GetColor(size_t index) const;
+	private:
+		[[nodiscard]] const SceneArg& GetArg(size_t index, SceneArgType type) const;
+
+		const SceneBlob& m_Blob;
+		const SceneInstanceData& m_Instance;
+		uint32_t m_FirstArg;
+		uint16_t m_NrOfArgs;
+	};
+
+	//Maps the type names scene files use to the game's components, observers and commands
+	class SceneTypeRegistry final
+	{
+	public:
+		using ComponentFactory = std::function<void(GameObject& gameObject, const SceneArgs& args)>;
+		using ObserverFactory = std::function<std::unique_ptr<IObserver>(Scene& scene, const SceneArgs& args)>;
+		using ObserveFunction = std::function<void(IObserver& observer, GameObject& gameObject)>;
+		using CommandFactory = std::function<std::unique_ptr<Command>(GameObject* target, const SceneArgs& args)>;
+		struct ObserverType
+		{
+			ObserverFactory create;
+			ObserveFunction observe;
+		};
+
+		void RegisterObjectId(const std::string& name, int id) { m_ObjectIds[name] = id; }
+		void RegisterComponent(const std::string& name, ComponentFactory factory) { m_Components[name] = std::move(factory); }
+		//Observe is the member function that connects the observer to an object, e.g. &ExplosionObserver::Observe
+		template<typename T>
+		void RegisterObserver(const std::string& name, std::function<std::unique_ptr<T>(Scene& scene, const SceneArgs& args)> create,
+			void (T::*observe)(GameObject*))
+		{
+			m_Observers[name] = ObserverType{
+				[create = std::move(create)](Scene& scene, const SceneArgs& args) -> std::unique_ptr<IObserver> { return create(scene, args); },
+				[observe](IObserver& observer, GameObject& gameObject) { (static_cast<T&>(observer).*observe)(&gameObject); } };
+		}
+		void RegisterCommand(const std::string& name, CommandFactory factory) { m_Commands[name] = std::move(factory); }
+
+		//Throw for names that were never registered
+		[[nodiscard]] int GetObjectId(const std::string& name) const;
+		[[nodiscard]] const ComponentFactory& GetComponent(const std::string& name) const;
+		[[nodiscard]] const ObserverType& GetObserver(const std::string& name) const;
+		[[nodiscard]] const CommandFactory& GetCommand(const std::string& name) const;
+	private:
+		std::unordered_map<std::string, int> m_ObjectIds{};
+		std::unordered_map<std::string, ComponentFactory> m_Components{};
+		std::unordered_map<std::string, ObserverType> m_Observers{};
+		std::unordered_map<std::string, CommandFactory> m_Commands{};
+	};
+
+	struct InstantiatedScene
+	{
+		std::unique_ptr<Scene> scene{};
+		//In the order of the blob, see SceneBlob::GetObjectIndex
+		std::vector<GameObject*> objects{};
+		std::vector<IObserver*> observers{};
+		//The keys the blob bound, so the caller can unbind them with the scene
+		std::vector<KeyboardInputKey> keyboardKeys{};
+		std::vector<std::pair<ControllerInputKey, int>> controllerKeys{};
+
+		//The first observer of the type
+		template<typename T>
+		[[nodiscard]] T* GetObserver() const
+		{
+			for (IObserver* observer : observers)
+			{
+				if (auto ptr = dynamic_cast<T*>(observer)) return ptr;
+			}
+			return nullptr;
+		}
+	};
+}
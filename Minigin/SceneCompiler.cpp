@@ -0,0 +1,250 @@
+#include "SceneCompiler.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <json.hpp>
+
+#include "Input/Controller.h"
+#include "Input/KeyboardInput.h"
+#include "Renderable/RenderLayer.h"
+
+using namespace GameEngine;
+
+namespace
+{
+	//in the order of the enums
+	constexpr std::array<std::string_view, 50> g_KeyboardKeyNames{
+		"A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M", "N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z",
+		"SPACE", "UP", "DOWN", "LEFT", "RIGHT", "F1", "F2", "F3", "F4", "F5", "F6", "F7", "F8", "F9", "F10", "F11", "F12",
+		"ESCAPE", "ENTER", "RETURN", "SHIFT", "CTRL", "ALT", "TAB" };
+	constexpr std::array<std::string_view, 8> g_ControllerKeyNames{ "dpadUp", "dpadLeft", "dpadDown", "dpadRight", "X", "Y", "A", "B" };
+	constexpr std::array<std::string_view, g_NrOfRenderLayers> g_RenderLayerNames{ "background", "objects", "foreground", "ui", "debug" };
+
+	template<size_t Size>
+	size_t FindName(const std::array<std::string_view, Size>& names, const std::string& name, const char* kind)
+	{
+		const auto it = std::ranges::find(names, name);
+		if (it == names.end()) throw std::runtime_error("unknown " + std::string(kind) + " " + name);
+		return static_cast<size_t>(it - names.begin());
+	}
+
+	class BlobBuilder final
+	{
+	public:
+		[[nodiscard]] SceneBlob Build(const nlohmann::json& scene)
+		{
+			const auto& objects = GetArray(scene, "objects");
+			const auto& observers = GetArray(scene, "observers");
+			const auto& bindings = GetArray(scene, "bindings");
+
+			//names first, so arguments can refer to objects further down the file
+			for (size_t i = 0; i < objects.size(); ++i)
+			{
+				if (!objects[i].contains("name")) continue;
+				const auto name = objects[i]["name"].get<std::string>();
+				if (!m_ObjectIndices.emplace(name, static_cast<uint32_t>(i)).second) throw std::runtime_error("two objects are named " + name);
+			}
+			m_Blob.objects.reserve(objects.size());
+			for (const auto& object : objects) AddObject(object);
+			m_Blob.observers.reserve(observers.size());
+			for (const auto& observer : observers) AddObserver(observer);
+			m_Blob.bindings.reserve(bindings.size());
+			for (const auto& binding : bindings) AddBinding(binding);
+			return std::move(m_Blob);
+		}
+	private:
+		[[nodiscard]] static const nlohmann::json& GetArray(const nlohmann::json& scene, const char* key)
+		{
+			static const nlohmann::json empty = nlohmann::json::array();
+			if (!scene.contains(key)) return empty;
+			if (!scene[key].is_array()) throw std::runtime_error(std::string(key) + " has to be an array");
+			return scene[key];
+		}
+
+		SceneStringRef AddString(const std::string& text)
+		{
+			if (text.empty()) return {};
+			//type names, fonts and labels repeat a lot, every distinct string is stored once
+			const auto it = m_Strings.find(text);
+			if (it != m_Strings.end()) return it->second;
+			const SceneStringRef ref{ static_cast<uint32_t>(m_Blob.strings.size()), static_cast<uint32_t>(text.size()) };
+			m_Blob.strings.insert(m_Blob.strings.end(), text.begin(), text.end());
+			m_Strings.emplace(text, ref);
+			return ref;
+		}
+		uint16_t AddType(std::vector<SceneStringRef>& types, const std::string& name)
+		{
+			const SceneStringRef ref = AddString(name);
+			const auto it = std::ranges::find_if(types, [&](const SceneStringRef& type) { return type.offset == ref.offset; });
+			if (it != types.end()) return static_cast<uint16_t>(it - types.begin());
+			types.push_back(ref);
+			return static_cast<uint16_t>(types.size() - 1);
+		}
+		uint32_t AddResource(const std::string& file, uint32_t size)
+		{
+			const SceneStringRef ref = AddString(file);
+			const auto it = std::ranges::find_if(m_Blob.resources, [&](const SceneResourceRecord& resource) {
+				return resource.file.offset == ref.offset && resource.size == size;
+			});
+			if (it != m_Blob.resources.end()) return static_cast<uint32_t>(it - m_Blob.resources.begin());
+			m_Blob.resources.push_back({ ref, size });
+			return static_cast<uint32_t>(m_Blob.resources.size() - 1);
+		}
+		[[nodiscard]] uint32_t GetObjectIndex(const std::string& name) const
+		{
+			const auto it = m_ObjectIndices.find(name);
+			if (it == m_ObjectIndices.end()) throw std::runtime_error("no object is named " + name);
+			return it->second;
+		}
+
+		SceneArg ToArg(const nlohmann::json& value)
+		{
+			if (value.is_boolean()) return { SceneArgType::integer, value.get<bool>() ? 1u : 0u, 0 };
+			if (value.is_number_integer())
+			{
+				const auto number = value.get<int64_t>();
+				if (number < std::numeric_limits<int32_t>::min() || number > std::numeric_limits<int32_t>::max())
+					throw std::runtime_error("the argument " + value.dump() + " doesn't fit in an int");
+				return { SceneArgType::integer, std::bit_cast<uint32_t>(static_cast<int32_t>(number)), 0 };
+			}
+			if (value.is_number()) return { SceneArgType::number, std::bit_cast<uint32_t>(value.get<float>()), 0 };
+			if (value.is_string())
+			{
+				const SceneStringRef ref = AddString(value.get<std::string>());
+				return { SceneArgType::string, ref.offset, ref.size };
+			}
+			if (value.contains("font"))
+				return { SceneArgType::font, AddResource(value["font"].get<std::string>(), value.at("size").get<uint32_t>()), 0 };
+			if (value.contains("texture")) return { SceneArgType::texture, AddResource(value["texture"].get<std::string>(), 0), 0 };
+			if (value.contains("object")) return { SceneArgType::object, GetObjectIndex(value["object"].get<std::string>()), 0 };
+			if (value.contains("color"))
+			{
+				const auto& color = value["color"];
+				if (color.size() < 3 || color.size() > 4) throw std::runtime_error("colors are [r, g, b] or [r, g, b, a]");
+				uint32_t rgba{};
+				for (size_t i = 0; i < 4; ++i) rgba = rgba << 8 | (i < color.size() ? color[i].get<uint32_t>() & 0xFF : 0xFF);
+				return { SceneArgType::color, rgba, 0 };
+			}
+			throw std::runtime_error("unsupported argument " + value.dump());
+		}
+		//returns the index of the first argument
+		uint32_t AddArgs(const nlohmann::json& entry, uint16_t& nrOfArgs)
+		{
+			const auto firstArg = static_cast<uint32_t>(m_Blob.args.size());
+			nrOfArgs = 0;
+			if (!entry.contains("args")) return firstArg;
+			for (const auto& value : entry["args"]) m_Blob.args.push_back(ToArg(value));
+			nrOfArgs = static_cast<uint16_t>(m_Blob.args.size() - firstArg);
+			return firstArg;
+		}
+
+		void AddObject(const nlohmann::json& object)
+		{
+			SceneObjectRecord record{};
+			record.id = AddType(m_Blob.objectIds, object.at("id").get<std::string>());
+			record.renderLayer = static_cast<uint8_t>(RenderLayer::objects);
+			if (object.contains("layer"))
+				record.renderLayer = static_cast<uint8_t>(FindName(g_RenderLayerNames, object["layer"].get<std::string>(), "render layer"));
+			record.parent = -1;
+			if (object.contains("parent"))
+			{
+				const uint32_t parent = GetObjectIndex(object["parent"].get<std::string>());
+				if (parent >= m_Blob.objects.size()) throw std::runtime_error("parents have to come before their children");
+				record.parent = static_cast<int32_t>(parent);
+			}
+			if (object.contains("position"))
+			{
+				record.x = object["position"].at(0).get<float>();
+				record.y = object["position"].at(1).get<float>();
+			}
+			if (object.contains("name")) record.name = AddString(object["name"].get<std::string>());
+
+			record.firstComponent = static_cast<uint32_t>(m_Blob.components.size());
+			if (object.contains("components"))
+			{
+				for (const auto& component : object["components"])
+				{
+					SceneComponentRecord componentRecord{};
+					componentRecord.type = AddType(m_Blob.componentTypes, component.at("type").get<std::string>());
+					componentRecord.firstArg = AddArgs(component, componentRecord.nrOfArgs);
+					m_Blob.components.push_back(componentRecord);
+				}
+			}
+			record.nrOfComponents = static_cast<uint16_t>(m_Blob.components.size() - record.firstComponent);
+			m_Blob.objects.push_back(record);
+		}
+
+		void AddObserver(const nlohmann::json& observer)
+		{
+			SceneObserverRecord record{};
+			record.type = AddType(m_Blob.observerTypes, observer.at("type").get<std::string>());
+			record.firstArg = AddArgs(observer, record.nrOfArgs);
+			record.firstObserved = static_cast<uint32_t>(m_Blob.observedObjects.size());
+			if (observer.contains("observe"))
+			{
+				for (const auto& name : observer["observe"]) m_Blob.observedObjects.push_back(GetObjectIndex(name.get<std::string>()));
+			}
+			record.nrOfObserved = static_cast<uint32_t>(m_Blob.observedObjects.size() - record.firstObserved);
+			m_Blob.observers.push_back(record);
+		}
+
+		void AddBinding(const nlohmann::json& binding)
+		{
+			SceneBindingRecord record{};
+			record.type = AddType(m_Blob.commandTypes, binding.at("command").get<std::string>());
+			record.firstArg = AddArgs(binding, record.nrOfArgs);
+			record.target = GetObjectIndex(binding.at("target").get<std::string>());
+			if (binding.contains("key"))
+			{
+				record.key = static_cast<uint16_t>(FindName(g_KeyboardKeyNames, binding["key"].get<std::string>(), "key"));
+				record.controllerIdx = -1;
+			}
+			else
+			{
+				record.key = static_cast<uint16_t>(FindName(g_ControllerKeyNames, binding.at("button").get<std::string>(), "button"));
+				record.controllerIdx = static_cast<int16_t>(binding.value("controller", 0));
+				if (record.controllerIdx < 0 || record.controllerIdx >= static_cast<int16_t>(g_maxControllerCount))
+					throw std::runtime_error("controller index out of range");
+			}
+			m_Blob.bindings.push_back(record);
+		}
+
+		SceneBlob m_Blob{};
+		std::unordered_map<std::string, SceneStringRef> m_Strings{};
+		std::unordered_map<std::string, uint32_t> m_ObjectIndices{};
+	};
+}
+
+SceneBlob SceneCompiler::Compile(const std::string& scenePath)
+{
+	std::ifstream file(scenePath);
+	if (!file) throw std::runtime_error("Couldn't open the scene " + scenePath);
+	try
+	{
+		nlohmann::json scene;
+		file >> scene;
+		return BlobBuilder{}.Build(scene);
+	}
+	catch (const std::exception& e)
+	{
+		throw std::runtime_error(scenePath + ": " + e.what());
+	}
+}
+
+void SceneCompiler::Compile(const std::string& scenePath, const std::string& blobPath)
+{
+	Compile(scenePath).SaveToFile(blobPath);
+}
+
+bool SceneCompiler::IsOutOfDate(const std::string& scenePath, const std::string& blobPath)
+{
+	std::error_code error;
+	const auto blobTime = std::filesystem::last_write_time(blobPath, error);
+	if (error) return true;
+	return std::filesystem::last_write_time(scenePath, error) > blobTime;
+}
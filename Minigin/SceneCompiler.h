@@ -0,0 +1,22 @@
+#pragma once
+#include <string>
+
+#include "SceneBlob.h"
+
+namespace GameEngine
+{
+	//Compiles JSON scene descriptions into scene blobs. A scene file is an object with up to three arrays:
+	//  "objects":   { "name", "id", "position": [x, y], "layer", "parent", "components": [{ "type", "args" }] }
+	//  "observers": { "type", "args", "observe": [object names] }
+	//  "bindings":  { "key" or "button" (+ "controller"), "command", "target": object name, "args" }
+	//Only "id", "type" and "command" are required, children are positioned relative to their parent.
+	//Arguments are numbers, booleans, strings or { "font": file, "size": n }, { "texture": file }, { "object": name }, { "color": [r, g, b, a] }
+	namespace SceneCompiler
+	{
+		//Throws a runtime_error naming the scene file and the offending entry
+		[[nodiscard]] SceneBlob Compile(const std::string& scenePath);
+		void Compile(const std::string& scenePath, const std::string& blobPath);
+		//True if the blob is missing or older than its scene file
+		[[nodiscard]] bool IsOutOfDate(const std::string& scenePath, const std::string& blobPath);
+	}
+}
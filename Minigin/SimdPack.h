@@ -0,0 +1,73 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GAMEENGINE_SIMD_SSE
+#endif
+
+namespace GameEngine
+{
+	//Float lanes for the batched SoA kernels. Kernels are written once against a pack and
+	//instantiated with SimdPack (AVX/SSE when available, scalar otherwise)
+	struct ScalarPack
+	{
+		using Reg = float;
+		using Mask = bool;
+		static constexpr size_t width{ 1 };
+		static Reg Load(const float* src) { return *src; }
+		static void Store(float* dst, Reg value) { *dst = value; }
+		static Reg Set(float value) { return value; }
+		static Reg Add(Reg a, Reg b) { return a + b; }
+		static Reg Sub(Reg a, Reg b) { return a - b; }
+		static Reg Mul(Reg a, Reg b) { return a * b; }
+		static Reg Div(Reg a, Reg b) { return a / b; }
+		static Reg Round(Reg value) { return std::nearbyint(value); }
+		static Mask Greater(Reg a, Reg b) { return a > b; }
+		static Reg Select(Mask mask, Reg a, Reg b) { return mask ? a : b; }
+	};
+
+#if defined(__AVX__)
+	struct SimdPack
+	{
+		using Reg = __m256;
+		using Mask = __m256;
+		static constexpr size_t width{ 8 };
+		static Reg Load(const float* src) { return _mm256_loadu_ps(src); }
+		static void Store(float* dst, Reg value) { _mm256_storeu_ps(dst, value); }
+		static Reg Set(float value) { return _mm256_set1_ps(value); }
+		static Reg Add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+		static Reg Sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+		static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+		static Reg Div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+		static Reg Round(Reg value) { return _mm256_round_ps(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static Mask Greater(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		static Reg Select(Mask mask, Reg a, Reg b) { return _mm256_blendv_ps(b, a, mask); }
+	};
+#elif defined(GAMEENGINE_SIMD_SSE)
+	struct SimdPack
+	{
+		using Reg = __m128;
+		using Mask = __m128;
+		static constexpr size_t width{ 4 };
+		static Reg Load(const float* src) { return _mm_loadu_ps(src); }
+		static void Store(float* dst, Reg value) { _mm_storeu_ps(dst, value); }
+		static Reg Set(float value) { return _mm_set1_ps(value); }
+		static Reg Add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+		static Reg Sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+		static Reg Mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+		static Reg Div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+		static Reg Round(Reg value) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(value)); }
+		static Mask Greater(Reg a, Reg b) { return _mm_cmpgt_ps(a, b); }
+		static Reg Select(Mask mask, Reg a, Reg b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	};
+#else
+	using SimdPack = ScalarPack;
+#endif
+
+	//Lanes are allocated in blocks of this size so the widest pack never needs a tail loop
+	constexpr size_t g_SimdLaneBlock{ 8 };
+}
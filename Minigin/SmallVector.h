@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace GameEngine
+{
+	//Contiguous storage that keeps its first N elements inline and only moves to the heap past that.
+	//Meant for the short lists most objects own (connections, handles), so trivially copyable elements only
+	template<typename T, size_t N>
+	class SmallVector final
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "SmallVector copies its elements with plain assignments");
+	public:
+		void push_back(const T& value)
+		{
+			if (m_Size < N && m_Heap.empty()) m_Inline[m_Size] = value;
+			else
+			{
+				if (m_Heap.empty()) m_Heap.assign(m_Inline.begin(), m_Inline.begin() + m_Size);
+				m_Heap.push_back(value);
+			}
+			++m_Size;
+		}
+		template<typename Predicate>
+		size_t erase_if(Predicate predicate)
+		{
+			const auto last = std::remove_if(begin(), end(), predicate);
+			const auto nrOfErased = static_cast<size_t>(end() - last);
+			m_Size -= nrOfErased;
+			if (!m_Heap.empty()) m_Heap.resize(m_Size);
+			return nrOfErased;
+		}
+		void clear()
+		{
+			m_Heap.clear();
+			m_Size = 0;
+		}
+
+		[[nodiscard]] T* data() { return m_Heap.empty() ? m_Inline.data() : m_Heap.data(); }
+		[[nodiscard]] const T* data() const { return m_Heap.empty() ? m_Inline.data() : m_Heap.data(); }
+		[[nodiscard]] size_t size() const { return m_Size; }
+		[[nodiscard]] bool empty() const { return m_Size == 0; }
+		T& operator[](size_t index) { return data()[index]; }
+		const T& operator[](size_t index) const { return data()[index]; }
+		T* begin() { return data(); }
+		T* end() { return data() + m_Size; }
+		const T* begin() const { return data(); }
+		const T* end() const { return data() + m_Size; }
+	private:
+		std::array<T, N> m_Inline{};
+		std::vector<T> m_Heap{};
+		size_t m_Size{};
+	};
+}
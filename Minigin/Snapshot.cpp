@@ -0,0 +1,91 @@
+#include "Snapshot.h"
+#include <algorithm>
+#include "Subjects/GameObject.h"
+
+using namespace GameEngine;
+
+void Snapshot::WriteString(const std::string& text)
+{
+	Write(static_cast<uint32_t>(text.size()));
+	const size_t offset = m_Data.size();
+	m_Data.resize(offset + text.size());
+	std::memcpy(m_Data.data() + offset, text.data(), text.size());
+}
+
+std::string Snapshot::ReadString()
+{
+	const auto size = Read<uint32_t>();
+	if (m_ReadPos + size > m_Data.size()) throw std::out_of_range("Reading past the end of the snapshot");
+	std::string text(reinterpret_cast<const char*>(m_Data.data() + m_ReadPos), size);
+	m_ReadPos += size;
+	return text;
+}
+
+void Snapshot::WriteShared(const std::shared_ptr<const void>& resource)
+{
+	if (resource == nullptr)
+	{
+		Write(int32_t{ -1 });
+		return;
+	}
+	//a handful of distinct resources per snapshot, a linear search beats hashing here
+	const auto it = std::ranges::find(m_Resources, resource);
+	Write(static_cast<int32_t>(it - m_Resources.begin()));
+	if (it == m_Resources.end()) m_Resources.push_back(resource);
+}
+
+std::shared_ptr<const void> Snapshot::ReadSharedImpl()
+{
+	const auto index = Read<int32_t>();
+	if (index < 0) return nullptr;
+	return m_Resources.at(index);
+}
+
+void Snapshot::WriteObject(const GameObject* gameObj)
+{
+	Write(gameObj == nullptr ? uint64_t{} : gameObj->GetSerialId());
+}
+
+GameObject* Snapshot::ReadObject()
+{
+	const auto serialId = Read<uint64_t>();
+	if (serialId == 0 || m_ObjectLookup == nullptr) return nullptr;
+	const auto it = m_ObjectLookup->find(serialId);
+	return it == m_ObjectLookup->end() ? nullptr : it->second;
+}
+
+size_t Snapshot::BeginBlock()
+{
+	const size_t blockStart = m_Data.size();
+	Write(uint32_t{});
+	return blockStart;
+}
+
+void Snapshot::EndBlock(size_t blockStart)
+{
+	const auto blockSize = static_cast<uint32_t>(m_Data.size() - blockStart - sizeof(uint32_t));
+	std::memcpy(m_Data.data() + blockStart, &blockSize, sizeof(uint32_t));
+}
+
+size_t Snapshot::ReadBlockSize()
+{
+	return Read<uint32_t>();
+}
+
+void Snapshot::SkipBytes(size_t nrOfBytes)
+{
+	if (m_ReadPos + nrOfBytes > m_Data.size()) throw std::out_of_range("Skipping past the end of the snapshot");
+	m_ReadPos += nrOfBytes;
+}
+
+void Snapshot::Clear()
+{
+	m_Data.clear();
+	m_Resources.clear();
+	m_ReadPos = 0;
+}
+
+void Snapshot::Rewind()
+{
+	m_ReadPos = 0;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace GameEngine
+{
+	class GameObject;
+
+	template<typename T>
+	concept SnapshotValue = std::is_trivially_copyable_v<T>;
+
+	//Flat byte buffer the scene and its components write their mutable state into.
+	//Reading walks the same buffer in the same order it was written in.
+	class Snapshot final
+	{
+	public:
+		template<SnapshotValue T>
+		void Write(const T& value)
+		{
+			const size_t offset = m_Data.size();
+			m_Data.resize(offset + sizeof(T));
+			std::memcpy(m_Data.data() + offset, &value, sizeof(T));
+		}
+		template<SnapshotValue T>
+		void Read(T& value)
+		{
+			if (m_ReadPos + sizeof(T) > m_Data.size()) throw std::out_of_range("Reading past the end of the snapshot");
+			std::memcpy(&value, m_Data.data() + m_ReadPos, sizeof(T));
+			m_ReadPos += sizeof(T);
+		}
+		template<SnapshotValue T>
+		[[nodiscard]] T Read()
+		{
+			T value;
+			Read(value);
+			return value;
+		}
+		template<SnapshotValue T>
+		void WriteArray(const T* values, size_t count)
+		{
+			const size_t offset = m_Data.size();
+			m_Data.resize(offset + sizeof(T) * count);
+			if (count != 0) std::memcpy(m_Data.data() + offset, values, sizeof(T) * count);
+		}
+		template<SnapshotValue T>
+		void ReadArray(T* values, size_t count)
+		{
+			if (m_ReadPos + sizeof(T) * count > m_Data.size()) throw std::out_of_range("Reading past the end of the snapshot");
+			if (count != 0) std::memcpy(values, m_Data.data() + m_ReadPos, sizeof(T) * count);
+			m_ReadPos += sizeof(T) * count;
+		}
+		void WriteString(const std::string& text);
+		[[nodiscard]] std::string ReadString();
+
+		//Immutable shared data (compiled paths, fonts...) is kept alive by the snapshot and stored as an index
+		void WriteShared(const std::shared_ptr<const void>& resource);
+		template<typename T>
+		[[nodiscard]] std::shared_ptr<const T> ReadShared()
+		{
+			return std::static_pointer_cast<const T>(ReadSharedImpl());
+		}
+
+		//Objects are stored by their serial id and resolved against the scene being restored
+		void WriteObject(const GameObject* gameObj);
+		[[nodiscard]] GameObject* ReadObject();
+
+		//Blocks are size prefixed so a reader can skip the ones it has no target for
+		[[nodiscard]] size_t BeginBlock();
+		void EndBlock(size_t blockStart);
+		[[nodiscard]] size_t ReadBlockSize();
+		void SkipBytes(size_t nrOfBytes);
+
+		void Clear();
+		void Rewind();
+		[[nodiscard]] size_t GetSize() const { return m_Data.size(); }
+		//The written bytes, two saves of the same state are equal byte for byte
+		[[nodiscard]] std::span<const std::byte> GetData() const { return m_Data; }
+		[[nodiscard]] size_t GetReadPosition() const { return m_ReadPos; }
+		[[nodiscard]] bool IsEmpty() const { return m_Data.empty(); }
+
+		void SetObjectLookup(const std::unordered_map<uint64_t, GameObject*>* lookup) { m_ObjectLookup = lookup; }
+	private:
+		[[nodiscard]] std::shared_ptr<const void> ReadSharedImpl();
+
+		std::vector<std::byte> m_Data{};
+		std::vector<std::shared_ptr<const void>> m_Resources{};
+		size_t m_ReadPos{};
+		const std::unordered_map<uint64_t, GameObject*>* m_ObjectLookup{};
+	};
+}
@@ -4,9 +4,16 @@
 
 #include "SDL_mixer.h"
 #include <iostream>
+#include "Minigin/Managers/Telemetry.h"
 
 using namespace GameEngine;
 
+namespace
+{
+    const MetricId g_AssetLoadMetric{ Telemetry::GetInstance().RegisterHistogram("asset load us") };
+    const MetricId g_QueueDepthMetric{ Telemetry::GetInstance().RegisterHistogram("audio queue depth") };
+}
+
 class SdlSoundSystem::SDLAudioClip final
 {
 public:
@@ -25,6 +32,7 @@ public:
     }
     void Load()
     {
+        ScopedTimer timer{ g_AssetLoadMetric };
         m_pSound = Mix_LoadWAV(m_FilePath.c_str());
         if (m_pSound == nullptr)
         {
@@ -120,6 +128,7 @@ void SdlSoundSystem::PlaySound(const SoundId id, const int volume)
     std::lock_guard<std::mutex> lock(m_Mutex);
     m_PendingSounds[m_QueueTail] = { id,volume };
     m_QueueTail = (m_QueueTail + 1) % maxPending;
+    Telemetry::GetInstance().Record(g_QueueDepthMetric, static_cast<uint64_t>((m_QueueTail - m_QueueHead + maxPending) % maxPending));
     m_ConditionVariable.notify_one();
 }
 int SdlSoundSystem::GetPending() const
@@ -3,3 +3,5 @@
 
 using namespace GameEngine;
 std::unique_ptr<ISoundSystem> ServiceLocator::m_SsInstance{ std::make_unique<NullSoundSystem>() };
+NullSoundSystem ServiceLocator::m_MutedSs{};
+bool ServiceLocator::m_IsMuted{ false };
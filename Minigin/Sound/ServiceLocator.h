@@ -8,8 +8,12 @@ namespace GameEngine
     class ServiceLocator final
     {
         static std::unique_ptr<ISoundSystem> m_SsInstance;
+        static NullSoundSystem m_MutedSs;
+        static bool m_IsMuted;
     public:
-        static ISoundSystem& GetSoundSystem() { return *m_SsInstance; }
+        static ISoundSystem& GetSoundSystem() { return m_IsMuted ? m_MutedSs : *m_SsInstance; }
+        //Silences every sound until unmuted, without replacing the registered sound system
+        static void SetMuted(bool isMuted) { m_IsMuted = isMuted; }
         static void RegisterSoundSystem(std::unique_ptr<ISoundSystem>&& ss)
         {
             m_SsInstance = ss == nullptr ? std::make_unique<NullSoundSystem>() : std::move(ss);
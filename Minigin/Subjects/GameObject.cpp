@@ -1,12 +1,43 @@
 #include "GameObject.h"
 #include <iostream>
+#include "../Snapshot.h"
+#include "../Renderable/Renderer.h"
 
 using namespace GameEngine;
 
+namespace
+{
+    uint64_t g_NextSerialId{ 1 };
+}
+
 GameObject::GameObject(int id) :
-    m_ID{ id }
+    m_ID{ id },
+    m_SerialId{ g_NextSerialId++ }
 {}
 
+#pragma region Snapshot
+
+void GameObject::SaveState(Snapshot& snapshot) const
+{
+    snapshot.Write(m_IsDestroyed);
+    snapshot.Write(m_LocalTransform);
+    snapshot.Write(static_cast<uint32_t>(m_Components.size()));
+    for (const auto& component : m_Components) component->SaveState(snapshot);
+}
+
+bool GameObject::LoadState(Snapshot& snapshot)
+{
+    snapshot.Read(m_IsDestroyed);
+    snapshot.Read(m_LocalTransform);
+    SetPositionIsDirty();
+    //the object keeps its restored transform even if its components can't be matched anymore
+    if (snapshot.Read<uint32_t>() != m_Components.size()) return false;
+    for (const auto& component : m_Components) component->LoadState(snapshot);
+    return true;
+}
+
+#pragma endregion
+
 #pragma region Update stuff
 
 void GameObject::Update()
@@ -24,6 +55,14 @@ void GameObject::Update()
     if (areElemsToErase) RemoveDestroyedObjects();
 }
 
+void GameObject::LateUpdate()
+{
+    for (const auto& component : m_Components)
+    {
+        if (component->HasLateUpdate() && !component->IsDestroyed()) component->LateUpdate();
+    }
+}
+
 void GameObject::RemoveDestroyedObjects()
 {
     const auto range = std::ranges::remove_if(m_Components,
@@ -37,6 +76,7 @@ void GameObject::RemoveDestroyedObjects()
 
 void GameEngine::GameObject::Render() const
 {
+    Renderer::GetInstance().SetLayer(m_RenderLayer);
     for (const auto& component : m_Components)
     {
         component->Render();
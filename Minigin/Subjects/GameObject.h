@@ -3,19 +3,26 @@
 #include "../Transform.h"
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include "../Components/Component.h"
+#include "../Renderable/RenderLayer.h"
 #include "Subject.h"
 
 namespace GameEngine
 {
+    class Snapshot;
     template<typename T>
     concept ComponentType = std::is_base_of_v<Component, T>;
-    class GameObject final: public Subject
+    class GameObject final: public Subject<GameObject>
     {
     private:
         std::vector<std::unique_ptr<Component>> m_Components{};
         int m_ID{};
+        //unique for the lifetime of the program, used to match objects to their snapshot entries
+        uint64_t m_SerialId{};
         bool m_IsDestroyed{ false };
+        bool m_HasLateUpdate{ false };
+        RenderLayer m_RenderLayer{ RenderLayer::objects };
 
         GameObject* m_pParent{};
         std::vector<GameObject*> m_pChildren{};
@@ -31,12 +38,25 @@ namespace GameEngine
         bool m_IsPositionDirty{ true };
     public:
         void Update();
+        void LateUpdate();
         void Render() const;
         [[nodiscard]] int GetID() const;
+        [[nodiscard]] uint64_t GetSerialId() const { return m_SerialId; }
+
+        //Objects on a cached layer (labels, static backgrounds) are drawn from the renderer's layer texture
+        void SetRenderLayer(RenderLayer layer) { m_RenderLayer = layer; }
+        [[nodiscard]] RenderLayer GetRenderLayer() const { return m_RenderLayer; }
 
         [[nodiscard]] bool IsDestroyed() const;
         void SetDestroyedFlag();
         void RemoveDestroyedObjects();
+        //Whether one of the components overrides LateUpdate
+        [[nodiscard]] bool HasLateUpdate() const { return m_HasLateUpdate; }
+
+        //Writes the local transform, the destroyed flag and the state of every component
+        void SaveState(Snapshot& snapshot) const;
+        //Returns false if the components no longer match the ones the state was saved from
+        bool LoadState(Snapshot& snapshot);
 
         //Scene graph functions
         [[nodiscard]] GameObject* GetParent() const;
@@ -66,16 +86,20 @@ namespace GameEngine
 
 #pragma region Component Handling
 
+        void ReserveComponents(size_t nrOfComponents) { m_Components.reserve(nrOfComponents); }
+
         template<ComponentType T, typename... Args>
         T* AddComponent(Args&&... args)
         {
             m_Components.push_back(std::make_unique<T>(this, std::forward<Args>(args)...));
+            m_HasLateUpdate |= m_Components.back()->HasLateUpdate();
             return dynamic_cast<T*>(m_Components.back().get());
         }
         template<ComponentType T>
         T* AddComponent()
         {
             m_Components.push_back(std::make_unique<T>(this));
+            m_HasLateUpdate |= m_Components.back()->HasLateUpdate();
             return dynamic_cast<T*>(m_Components.back().get());
         }
 
@@ -1,27 +1,71 @@
 #pragma once
-#include <forward_list>
-#include <map>
+#include <concepts>
+#include <type_traits>
+#include "../SmallVector.h"
 
 namespace GameEngine
 {
-    struct EventData;
-    enum class EngineGameEvent
+    //Events are plain structs whose members are their payload, the type itself identifies the event
+    template<typename Event>
+    concept EventType = std::is_class_v<Event>;
+
+    namespace Detail
     {
-        collision
-    };
-    class IObserver;
+        //one address per event type, compared instead of an int id. Not const, /OPT:ICF may fold identical
+        //read-only constants into one address but leaves writable data alone
+        template<EventType Event>
+        inline char g_EventTypeId{};
+    }
+
+    //Receivers connect one member function per event type they handle. The connections live in a flat
+    //small vector and emitting an event calls the matching ones directly, passing the sender as its
+    //own type and the event as its own struct, so receivers never cast
+    template<typename Sender>
     class Subject
     {
-    private:
-        typedef std::forward_list<IObserver*> ObserverList;
-        typedef std::map<int, ObserverList> ObserversMap;
-
-        ObserversMap m_Observers;
     public:
-        void AddObserver(int message, IObserver* observer);
-        void RemoveObserver(int message, IObserver* observer);
-        void NotifyAll(int event, EventData* eventData = nullptr);
-        void Notify(int event, int message, EventData* eventData = nullptr);
+        //Slot is a member function of Receiver taking (Sender&, const Event&)
+        template<EventType Event, auto Slot, typename Receiver>
+            requires std::invocable<decltype(Slot), Receiver*, Sender&, const Event&>
+        void Connect(Receiver* receiver)
+        {
+            m_Connections.push_back(Connection{ &Detail::g_EventTypeId<Event>, receiver, &Invoke<Event, Slot, Receiver> });
+        }
+        //Removes every connection of the receiver. While emitting, the connections are only cleared so the loop
+        //doesn't skip the one after them, they get removed once the outermost Emit returns
+        void Disconnect(const void* receiver)
+        {
+            if (m_EmitDepth == 0)
+            {
+                m_Connections.erase_if([receiver](const Connection& connection) { return connection.receiver == receiver; });
+                return;
+            }
+            for (size_t i = 0; i < m_Connections.size(); ++i)
+            {
+                if (m_Connections[i].receiver == receiver) m_Connections[i].receiver = nullptr;
+            }
+            m_HasClearedConnections = true;
+        }
+
+        template<EventType Event>
+        void Emit(const Event& event = {})
+        {
+            const void* eventId = &Detail::g_EventTypeId<Event>;
+            //slots may connect receivers to this subject, those only get the next event
+            const size_t nrOfConnections = m_Connections.size();
+            ++m_EmitDepth;
+            for (size_t i = 0; i < nrOfConnections; ++i)
+            {
+                const Connection connection = m_Connections[i];
+                if (connection.eventId == eventId && connection.receiver != nullptr)
+                    connection.invoke(connection.receiver, static_cast<Sender&>(*this), &event);
+            }
+            if (--m_EmitDepth == 0 && m_HasClearedConnections)
+            {
+                m_Connections.erase_if([](const Connection& connection) { return connection.receiver == nullptr; });
+                m_HasClearedConnections = false;
+            }
+        }
 
         Subject() = default;
         virtual ~Subject() = default;
@@ -29,5 +73,24 @@ namespace GameEngine
         Subject(Subject&& other) = delete;
         Subject& operator=(const Subject& other) = delete;
         Subject& operator=(Subject&& other) = delete;
+    private:
+        struct Connection
+        {
+            const void* eventId;
+            void* receiver;
+            void (*invoke)(void* receiver, Sender& sender, const void* event);
+        };
+
+        template<EventType Event, auto Slot, typename Receiver>
+        static void Invoke(void* receiver, Sender& sender, const void* event)
+        {
+            (static_cast<Receiver*>(receiver)->*Slot)(sender, *static_cast<const Event*>(event));
+        }
+
+        //most objects are watched by a handful of observers
+        SmallVector<Connection, 6> m_Connections{};
+        //Emit calls nested in a slot count too, connections are only removed when the outermost one returns
+        int m_EmitDepth{};
+        bool m_HasClearedConnections{ false };
     };
 }
@@ -0,0 +1,253 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <json.hpp>
+
+using namespace Bench;
+
+namespace
+{
+    [[nodiscard]] double GetMean(const std::vector<double>& values)
+    {
+        if (values.empty()) return 0.0;
+        return std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+    }
+    [[nodiscard]] double GetStandardDeviation(const std::vector<double>& values)
+    {
+        if (values.size() < 2) return 0.0;
+        const double mean = GetMean(values);
+        double sum{};
+        for (const double value : values) sum += (value - mean) * (value - mean);
+        return std::sqrt(sum / static_cast<double>(values.size() - 1));
+    }
+}
+
+double Bench::GetPercentile(std::vector<double> values, double percentile)
+{
+    if (values.empty()) return 0.0;
+    std::ranges::sort(values);
+    const auto index = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(values.size()))) - 1;
+    return values[std::min(index, values.size() - 1)];
+}
+
+void Bench::Check(bool condition, const std::string& expectation, const std::source_location& location)
+{
+    if (condition) return;
+    throw CheckFailure(std::string{ location.file_name() } + '(' + std::to_string(location.line()) + "): expected " + expectation);
+}
+
+State::State(int64_t argument, uint64_t nrOfIterations, bool isTimingEachIteration) :
+    m_Argument(argument),
+    m_NrOfIterations(nrOfIterations),
+    m_IsTimingEachIteration(isTimingEachIteration)
+{
+    if (m_IsTimingEachIteration) m_IterationTimes.reserve(nrOfIterations);
+}
+
+bool State::KeepRunning()
+{
+    if (!m_IsStarted)
+    {
+        m_IsStarted = true;
+        m_Start = Clock::now();
+        return m_NrOfIterations > 0;
+    }
+    //a micro benchmark loop only counts, the clock is read before and after the whole loop
+    if (!m_IsTimingEachIteration)
+    {
+        if (++m_Iteration < m_NrOfIterations && m_StopReason.empty()) return true;
+        if (!m_IsPaused) m_Elapsed += Clock::now() - m_Start;
+        return false;
+    }
+
+    if (!m_IsPaused) m_IterationElapsed += Clock::now() - m_Start;
+    m_IsPaused = false;
+    m_Elapsed += m_IterationElapsed;
+    m_IterationTimes.push_back(static_cast<double>(m_IterationElapsed.count()));
+    m_IterationElapsed = {};
+    if (++m_Iteration >= m_NrOfIterations || !m_StopReason.empty()) return false;
+    m_Start = Clock::now();
+    return true;
+}
+void State::PauseTiming()
+{
+    if (m_IsPaused) return;
+    const auto segment = Clock::now() - m_Start;
+    if (m_IsTimingEachIteration) m_IterationElapsed += segment;
+    else m_Elapsed += segment;
+    m_IsPaused = true;
+}
+void State::ResumeTiming()
+{
+    if (!m_IsPaused) return;
+    m_IsPaused = false;
+    m_Start = Clock::now();
+}
+void State::Stop(const std::string& reason)
+{
+    m_StopReason = reason;
+}
+
+Benchmark& Runner::Add(std::string name, std::function<void(State&)> function)
+{
+    Benchmark benchmark{};
+    benchmark.name = std::move(name);
+    benchmark.function = std::move(function);
+    return m_Benchmarks.emplace_back(std::move(benchmark));
+}
+
+void Runner::AddCheck(std::string name, std::function<void()> function)
+{
+    m_Checks.emplace_back(std::move(name), std::move(function));
+}
+
+void Runner::Run(const std::string& filter, int nrOfRepetitions)
+{
+    m_NrOfRepetitions = std::max(nrOfRepetitions, 1);
+    for (const Benchmark& benchmark : m_Benchmarks)
+    {
+        if (benchmark.arguments.empty())
+        {
+            if (benchmark.name.find(filter) != std::string::npos) RunBenchmark(benchmark, benchmark.name, 0, m_NrOfRepetitions);
+            continue;
+        }
+        for (const int64_t argument : benchmark.arguments)
+        {
+            const std::string name = benchmark.name + "/" + std::to_string(argument);
+            if (name.find(filter) != std::string::npos) RunBenchmark(benchmark, name, argument, m_NrOfRepetitions);
+        }
+    }
+}
+
+int Runner::RunChecks(const std::string& filter) const
+{
+    int nrOfFailures{};
+    for (const NamedCheck& check : m_Checks)
+    {
+        if (check.name.find(filter) == std::string::npos) continue;
+        try
+        {
+            check.function();
+            std::cout << "PASS " << check.name << '\n';
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "FAIL " << check.name << ": " << e.what() << '\n';
+            ++nrOfFailures;
+        }
+    }
+    return nrOfFailures;
+}
+
+void Runner::RunBenchmark(const Benchmark& benchmark, const std::string& name, int64_t argument, int nrOfRepetitions)
+{
+    Result result{ name, benchmark.nrOfIterations, {}, {}, {} };
+    if (benchmark.isRepeatable)
+    {
+        //fills the caches and the component pools, so the first repetition isn't the odd one out
+        State warmUp{ argument, benchmark.nrOfIterations / 10 + 1, false };
+        benchmark.function(warmUp);
+    }
+    else nrOfRepetitions = 1;
+
+    for (int repetition = 0; repetition < nrOfRepetitions; ++repetition)
+    {
+        State state{ argument, benchmark.nrOfIterations, benchmark.isTimingEachIteration };
+        benchmark.function(state);
+        const uint64_t nrOfIterationsDone = std::max<uint64_t>(state.GetNrOfIterationsDone(), 1);
+        result.repetitionTimes.push_back(static_cast<double>(state.GetElapsed().count()) / static_cast<double>(nrOfIterationsDone));
+        result.nrOfIterations = state.GetNrOfIterationsDone();
+        result.iterationTimes = state.GetIterationTimes();
+        result.stopReason = state.GetStopReason();
+    }
+    PrintResult(result);
+    m_Results.emplace_back(std::move(result));
+}
+
+void Runner::PrintResult(const Result& result)
+{
+    std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(1)
+        << std::setw(14) << GetPercentile(result.repetitionTimes, 50.0) << " ns"
+        << std::setw(12) << result.nrOfIterations << " iterations";
+    if (!result.iterationTimes.empty())
+    {
+        std::cout << "  p50 " << GetPercentile(result.iterationTimes, 50.0) / 1000.0
+            << " us  p95 " << GetPercentile(result.iterationTimes, 95.0) / 1000.0
+            << " us  p99 " << GetPercentile(result.iterationTimes, 99.0) / 1000.0 << " us";
+    }
+    if (!result.stopReason.empty()) std::cout << "  (stopped: " << result.stopReason << ')';
+    std::cout << '\n';
+}
+
+void Runner::WriteJson(const std::string& path, const std::string& label) const
+{
+    nlohmann::ordered_json json;
+    json["context"]["label"] = label;
+#ifdef NDEBUG
+    json["context"]["build"] = "release";
+#else
+    json["context"]["build"] = "debug";
+#endif
+    json["context"]["repetitions"] = m_NrOfRepetitions;
+
+    json["benchmarks"] = nlohmann::ordered_json::array();
+    for (const Result& result : m_Results)
+    {
+        nlohmann::ordered_json entry;
+        entry["name"] = result.name;
+        entry["iterations"] = result.nrOfIterations;
+        entry["time_unit"] = "ns";
+        entry["median"] = GetPercentile(result.repetitionTimes, 50.0);
+        entry["mean"] = GetMean(result.repetitionTimes);
+        entry["stddev"] = GetStandardDeviation(result.repetitionTimes);
+        entry["min"] = std::ranges::min(result.repetitionTimes);
+        entry["max"] = std::ranges::max(result.repetitionTimes);
+        entry["repetition_times"] = result.repetitionTimes;
+        if (!result.iterationTimes.empty())
+        {
+            entry["p50"] = GetPercentile(result.iterationTimes, 50.0);
+            entry["p95"] = GetPercentile(result.iterationTimes, 95.0);
+            entry["p99"] = GetPercentile(result.iterationTimes, 99.0);
+        }
+        if (!result.stopReason.empty()) entry["stopped"] = result.stopReason;
+        json["benchmarks"].push_back(std::move(entry));
+    }
+
+    std::ofstream file(path);
+    if (!file) throw std::runtime_error("Couldn't write the results to " + path);
+    file << json.dump(2) << '\n';
+}
+
+void Runner::Compare(const std::string& basePath, const std::string& newPath)
+{
+    const auto read = [](const std::string& path) {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("Couldn't open " + path);
+        nlohmann::json json;
+        file >> json;
+        return json;
+    };
+    const nlohmann::json base = read(basePath);
+    const nlohmann::json current = read(newPath);
+
+    std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "base ns" << std::setw(14) << "new ns"
+        << std::setw(10) << "change\n";
+    for (const auto& entry : current.at("benchmarks"))
+    {
+        const auto& name = entry.at("name");
+        const auto baseIt = std::ranges::find_if(base.at("benchmarks"), [&](const nlohmann::json& baseEntry) { return baseEntry.at("name") == name; });
+        if (baseIt == base.at("benchmarks").end()) continue;
+
+        const double baseTime = baseIt->at("median").get<double>();
+        const double newTime = entry.at("median").get<double>();
+        const double change = baseTime > 0.0 ? (newTime - baseTime) / baseTime * 100.0 : 0.0;
+        std::cout << std::left << std::setw(48) << name.get<std::string>() << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << baseTime << std::setw(14) << newTime << std::setw(9) << std::showpos << change << std::noshowpos << "%\n";
+    }
+}
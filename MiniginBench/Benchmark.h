@@ -0,0 +1,148 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace GameEngine
+{
+    class Minigin;
+}
+
+namespace Bench
+{
+    namespace Detail
+    {
+        inline const void* volatile g_pSink{};
+    }
+    //Keeps the compiler from optimising away a value the benchmark computes but never uses
+    template<typename T>
+    void DoNotOptimize(const T& value)
+    {
+        Detail::g_pSink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    //Thrown by Check, fails the check that is running
+    class CheckFailure final : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+    //Nearest rank percentile, 100 gives the maximum
+    [[nodiscard]] double GetPercentile(std::vector<double> values, double percentile);
+
+    //Fails the running check with what was expected and where when the condition doesn't hold
+    void Check(bool condition, const std::string& expectation, const std::source_location& location = std::source_location::current());
+
+    //Handed to a benchmark, which runs its setup and then loops while KeepRunning returns true.
+    //Only the loop is timed
+    class State final
+    {
+    public:
+        State(int64_t argument, uint64_t nrOfIterations, bool isTimingEachIteration);
+
+        [[nodiscard]] bool KeepRunning();
+        //Per iteration setup that shouldn't count, e.g. dirtying what the timed code cleans up
+        void PauseTiming();
+        void ResumeTiming();
+        //Ends the run before all iterations are done, the iterations so far are kept
+        void Stop(const std::string& reason);
+
+        [[nodiscard]] int64_t GetArgument() const { return m_Argument; }
+        [[nodiscard]] uint64_t GetNrOfIterations() const { return m_NrOfIterations; }
+        [[nodiscard]] uint64_t GetNrOfIterationsDone() const { return m_Iteration; }
+        [[nodiscard]] std::chrono::nanoseconds GetElapsed() const { return m_Elapsed; }
+        [[nodiscard]] const std::vector<double>& GetIterationTimes() const { return m_IterationTimes; }
+        [[nodiscard]] const std::string& GetStopReason() const { return m_StopReason; }
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        int64_t m_Argument;
+        uint64_t m_NrOfIterations;
+        uint64_t m_Iteration{};
+        bool m_IsStarted{ false };
+        bool m_IsPaused{ false };
+        bool m_IsTimingEachIteration;
+        Clock::time_point m_Start{};
+        std::chrono::nanoseconds m_Elapsed{};
+        std::chrono::nanoseconds m_IterationElapsed{};
+        //ns, only filled when every iteration is timed
+        std::vector<double> m_IterationTimes{};
+        std::string m_StopReason{};
+    };
+
+    struct Benchmark
+    {
+        std::string name;
+        std::function<void(State&)> function;
+        //every argument is run as its own benchmark, named name/argument
+        std::vector<int64_t> arguments{};
+        uint64_t nrOfIterations{ 100'000 };
+        //Frames and other long iterations are timed one by one, so their percentiles can be reported
+        bool isTimingEachIteration{ false };
+        //Macro benchmarks move a game along and can only be run once per process
+        bool isRepeatable{ true };
+
+        Benchmark& Args(std::vector<int64_t> args) { arguments = std::move(args); return *this; }
+        Benchmark& Iterations(uint64_t iterations) { nrOfIterations = iterations; return *this; }
+        Benchmark& TimeEachIteration() { isTimingEachIteration = true; return *this; }
+        Benchmark& RunOnce() { isRepeatable = false; return *this; }
+    };
+
+    //Runs a fixed number of iterations per benchmark instead of running for a fixed time, so every run does
+    //the same work. Each benchmark gets a warm up run that is thrown away and is then repeated, the median of
+    //the repetitions is what runs are compared on
+    class Runner final
+    {
+    public:
+        Benchmark& Add(std::string name, std::function<void(State&)> function);
+        //Checks verify what a benchmark can't, e.g. that an optimisation still gives the same results
+        void AddCheck(std::string name, std::function<void()> function);
+        //Only the benchmarks whose name contains filter are run
+        void Run(const std::string& filter, int nrOfRepetitions);
+        //Runs the checks whose name contains filter, returns the nr of failed checks
+        [[nodiscard]] int RunChecks(const std::string& filter) const;
+        //label names the run in the file, e.g. the commit it was built from
+        void WriteJson(const std::string& path, const std::string& label) const;
+
+        //Prints the change of the median of every benchmark found in both files
+        static void Compare(const std::string& basePath, const std::string& newPath);
+    private:
+        struct Result
+        {
+            std::string name;
+            uint64_t nrOfIterations;
+            //ns per iteration of every repetition
+            std::vector<double> repetitionTimes;
+            //ns, of every iteration of the last repetition when they were timed one by one
+            std::vector<double> iterationTimes;
+            std::string stopReason;
+        };
+        void RunBenchmark(const Benchmark& benchmark, const std::string& name, int64_t argument, int nrOfRepetitions);
+        static void PrintResult(const Result& result);
+
+        struct NamedCheck
+        {
+            std::string name;
+            std::function<void()> function;
+        };
+        std::vector<Benchmark> m_Benchmarks{};
+        std::vector<NamedCheck> m_Checks{};
+        std::vector<Result> m_Results{};
+        int m_NrOfRepetitions{};
+    };
+
+    void RegisterMicroBenchmarks(Runner& runner);
+    //Checks that need the engine get it from the caller, like the scene benchmarks
+    void RegisterChecks(Runner& runner, GameEngine::Minigin& engine);
+    //Frames of every Galaga scene, stepped with a fixed frame time on the headless engine
+    void RegisterSceneBenchmarks(Runner& runner, GameEngine::Minigin& engine);
+    //Plays the stress level for the given wall clock time, reloading it whenever the game moves on, and prints
+    //the frame time percentiles and the allocations of every minute and of the whole run
+    void RunSoak(GameEngine::Minigin& engine, std::chrono::minutes duration);
+}
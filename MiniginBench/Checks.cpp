@@ -0,0 +1,1479 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+#include <SDL.h>
+
+#include "CollisionMask.h"
+#include "DataStructs.h"
+#include "Galaga.h"
+#include "Initializers.h"
+#include "Minigin.h"
+#include "RollbackPeers.h"
+#include "RotatingSprite.h"
+#include "Scene.h"
+#include "SceneBlob.h"
+#include "SceneCompiler.h"
+#include "Snapshot.h"
+#include "Components/CollisionComponent.h"
+#include "Components/SpriteComponent.h"
+#include "Components/TextureComponent.h"
+#include "Game components/Enemy components/BossGalagaComponent.h"
+#include "Game components/FormationComponent.h"
+#include "Game components/PlayerComponent.h"
+#include "Game observers/EnemyAIManager.h"
+#include "Game observers/EnemyRegistry.h"
+#include "Game observers/HighScoreStore.h"
+#include "Managers/FileWatcher.h"
+#include "Managers/FramePacer.h"
+#include "Managers/InputManager.h"
+#include "Managers/ParticleSystem.h"
+#include "Managers/SceneManager.h"
+#include "Managers/SpriteAnimator.h"
+#include "Managers/Telemetry.h"
+#include "Managers/TimeManager.h"
+#include "Renderable/Renderer.h"
+#include "Renderable/Texture2D.h"
+#include "Subjects/GameObject.h"
+#include "Trajectory Logic/CompiledPath.h"
+#include "Trajectory Logic/Trajectory.h"
+#include "Trajectory Logic/TrajectoryBatch.h"
+
+namespace
+{
+    constexpr float g_FrameTime{ 1.f / 160.f };
+
+    //Moves its object along a path, the way the enemy states do
+    class PathFollowerComponent final : public GameEngine::Component
+    {
+    public:
+        PathFollowerComponent(GameEngine::GameObject* gameObj, std::shared_ptr<const CompiledPath> path, float speed) :
+            Component(gameObj),
+            m_Speed(speed)
+        {
+            m_Trajectory.SetPath(std::move(path), false);
+        }
+        void Update() override { m_Trajectory.Update(m_Speed, GetGameObjParent()); }
+        [[nodiscard]] const Trajectory& GetTrajectory() const { return m_Trajectory; }
+    private:
+        Trajectory m_Trajectory{};
+        float m_Speed;
+    };
+
+    //A half circle of radius 100 around (100, 100), starting at (200, 100)
+    [[nodiscard]] std::shared_ptr<const CompiledPath> MakeArcPath()
+    {
+        const std::vector<PathData> pathData{ { true, true, glm::pi<float>(), { 100.f, 100.f }, {} } };
+        return std::make_shared<const CompiledPath>(pathData, glm::vec2{ 200.f, 100.f });
+    }
+
+    //The batch is added before the follower, like in the level scene, and still has to apply the position
+    //the follower submits in the same frame
+    void CheckTrajectoryStepsInSameFrame()
+    {
+        constexpr float speed{ 200.f };
+        GameEngine::Scene scene{};
+        auto gameObject = std::make_unique<GameEngine::GameObject>(0);
+        gameObject->AddComponent<TrajectoryBatch>();
+        scene.AddObject(std::move(gameObject));
+        gameObject = std::make_unique<GameEngine::GameObject>(0);
+        const auto follower = gameObject->AddComponent<PathFollowerComponent>(MakeArcPath(), speed);
+        GameEngine::GameObject* mover = scene.AddObject(std::move(gameObject));
+
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        scene.Update();
+        const float angle = speed * g_FrameTime / 100.f;
+        const glm::vec2 expectedPos{ 100.f + 100.f * std::cos(angle), 100.f + 100.f * std::sin(angle) };
+        const glm::vec2 expectedDirection{ -std::sin(angle), std::cos(angle) };
+        Bench::Check(glm::distance(glm::vec2{ mover->GetPosition() }, expectedPos) < 1e-3f, "the position submitted this frame to be applied");
+        Bench::Check(glm::distance(follower->GetTrajectory().GetDirection(), expectedDirection) < 1e-3f, "the direction of this frame's step");
+    }
+
+    //Where a line, a three quarter circle and a line end up after flying for duration at the given frame rate
+    [[nodiscard]] glm::vec2 FlyPath(int frameRate, float duration)
+    {
+        const std::vector<PathData> pathData{
+            { false, true, 0.f, {}, { 300.f, 100.f } },
+            { true, false, 1.5f * glm::pi<float>(), { 300.f, 200.f }, {} },
+            { false, true, 0.f, {}, { 100.f, 400.f } } };
+        GameEngine::GameObject gameObject{ 0 };
+        Trajectory trajectory{};
+        trajectory.SetPath(std::make_shared<const CompiledPath>(pathData, glm::vec2{ 100.f, 100.f }), false);
+
+        GameEngine::TimeManager::SetElapsed(1.f / static_cast<float>(frameRate));
+        const int nrOfFrames = static_cast<int>(std::lround(duration * static_cast<float>(frameRate)));
+        for (int frame = 0; frame < nrOfFrames; ++frame)
+        {
+            trajectory.Update(200.f, &gameObject);
+            TrajectoryBatch::Step();
+        }
+        return gameObject.GetPosition();
+    }
+
+    //Arc length parameterised paths put an enemy at the same spot whatever the frame rate, only float
+    //rounding of the accumulated distance differs
+    void CheckTrajectoryFrameRateIndependence()
+    {
+        //200 px/s, so two seconds end on the arc and four and a half on the last line
+        for (const float duration : { 2.f, 4.5f })
+        {
+            const glm::vec2 at160Hz = FlyPath(160, duration);
+            for (const int frameRate : { 30, 60 })
+            {
+                Bench::Check(glm::distance(FlyPath(frameRate, duration), at160Hz) < 1e-2f,
+                    "the position at " + std::to_string(frameRate) + " Hz to match 160 Hz after " + std::to_string(duration) + " s");
+            }
+        }
+    }
+
+    //Flies a bullet up at 2000 px/s past a 6 px tall target at the given frame rate. Returns the frame the
+    //first hit was seen in and the frame the bullet's top first passed the target's bottom edge, -1 if never
+    [[nodiscard]] std::pair<int, int> FlyBulletPastTarget(int frameRate, bool isFastMoving)
+    {
+        constexpr float speed{ 2000.f };
+        constexpr SDL_Rect targetRect{ 100, 150, 16, 6 };
+        GameEngine::GameObject target{ 0 };
+        target.SetPosition(static_cast<float>(targetRect.x), static_cast<float>(targetRect.y));
+        const auto targetCollider = target.AddComponent<GameEngine::CollisionComponent>(targetRect);
+        GameEngine::GameObject bullet{ 0 };
+        bullet.SetPosition(104.f, 400.f);
+        const auto bulletCollider = bullet.AddComponent<GameEngine::CollisionComponent>(SDL_Rect{ 104, 400, 3, 8 });
+        bulletCollider->SetFastMoving(isFastMoving);
+
+        const float frameTime = 1.f / static_cast<float>(frameRate);
+        int hitFrame{ -1 };
+        int crossingFrame{ -1 };
+        for (int frame = 0; bullet.GetPosition().y > 0.f; ++frame)
+        {
+            bullet.SetPosition(104.f, bullet.GetPosition().y - speed * frameTime);
+            bulletCollider->Update();
+            targetCollider->Update();
+            if (crossingFrame == -1 && bulletCollider->GetCollisionRect().y < targetRect.y + targetRect.h) crossingFrame = frame;
+            if (hitFrame == -1 && bulletCollider->IsColliding(targetCollider)) hitFrame = frame;
+        }
+        return { hitFrame, crossingFrame };
+    }
+
+    //A swept bullet has to hit in the frame it crosses the target whatever the tick rate, down to the 0.05 s
+    //clamp. Without the sweep it skips past the target at the low rates
+    void CheckSweptCollisionAtAnyTickRate()
+    {
+        for (const int frameRate : { 160, 60, 30, 20 })
+        {
+            const auto [hitFrame, crossingFrame] = FlyBulletPastTarget(frameRate, true);
+            Bench::Check(hitFrame != -1 && hitFrame == crossingFrame,
+                "the swept bullet to hit in the frame it crosses the target at " + std::to_string(frameRate) + " Hz");
+        }
+        Bench::Check(FlyBulletPastTarget(20, false).first == -1, "the discrete test to miss the target at 20 Hz");
+    }
+
+    //Teleporting right across a collider after ResetSweep isn't a path the object flew
+    void CheckResetSweepSkipsTeleport()
+    {
+        GameEngine::GameObject target{ 0 };
+        target.SetPosition(100.f, 150.f);
+        const auto targetCollider = target.AddComponent<GameEngine::CollisionComponent>(SDL_Rect{ 100, 150, 16, 6 });
+        GameEngine::GameObject bullet{ 0 };
+        bullet.SetPosition(104.f, 400.f);
+        const auto bulletCollider = bullet.AddComponent<GameEngine::CollisionComponent>(SDL_Rect{ 104, 400, 3, 8 });
+        bulletCollider->SetFastMoving(true);
+        bulletCollider->Update();
+        targetCollider->Update();
+
+        bullet.SetPosition(104.f, 0.f);
+        bulletCollider->ResetSweep();
+        bulletCollider->Update();
+        Bench::Check(!bulletCollider->IsColliding(targetCollider), "a teleport after ResetSweep not to be swept");
+
+        bullet.SetPosition(104.f, 400.f);
+        bulletCollider->Update();
+        Bench::Check(bulletCollider->IsColliding(targetCollider), "the move after it to be swept again");
+    }
+
+    //Sets about one in density bits of a width by height mask
+    [[nodiscard]] GameEngine::CollisionMask MakeRandomMask(std::mt19937& random, int width, int height, int density)
+    {
+        GameEngine::CollisionMask mask{ width, height };
+        std::uniform_int_distribution<int> bit{ 0, density - 1 };
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                if (bit(random) == 0) mask.SetBit(x, y);
+            }
+        }
+        return mask;
+    }
+
+    //The word wise overlap tests have to agree with testing every pixel, for masks narrower and wider than a
+    //word at any alignment, and Extract has to mirror and scale like picking the source pixel by hand
+    void CheckCollisionMaskMatchesBruteForce()
+    {
+        std::mt19937 random{ 39 };
+        std::uniform_int_distribution<int> size{ 1, 160 };
+        std::uniform_int_distribution<int> offset{ -60, 60 };
+        std::uniform_int_distribution<int> density{ 2, 200 };
+        int nrOfMismatches{};
+        int nrOfOverlaps{};
+        for (int test = 0; test < 2'000; ++test)
+        {
+            const GameEngine::CollisionMask mask = MakeRandomMask(random, size(random), size(random), density(random));
+            const GameEngine::CollisionMask other = MakeRandomMask(random, size(random), size(random), density(random));
+            const glm::ivec2 otherPos{ offset(random), offset(random) };
+            const SDL_Rect rect{ offset(random), offset(random), size(random), size(random) };
+
+            bool isMaskOverlapping{};
+            bool isRectOverlapping{};
+            for (int y = 0; y < mask.GetHeight(); ++y)
+            {
+                for (int x = 0; x < mask.GetWidth(); ++x)
+                {
+                    if (!mask.GetBit(x, y)) continue;
+                    isMaskOverlapping |= other.GetBit(x - otherPos.x, y - otherPos.y);
+                    isRectOverlapping |= x >= rect.x && x < rect.x + rect.w && y >= rect.y && y < rect.y + rect.h;
+                }
+            }
+            if (isMaskOverlapping) ++nrOfOverlaps;
+            if (mask.Overlaps({}, other, otherPos) != isMaskOverlapping || mask.Overlaps({}, rect) != isRectOverlapping) ++nrOfMismatches;
+        }
+        Bench::Check(nrOfMismatches == 0, "the mask tests to match brute force, " + std::to_string(nrOfMismatches) + " of 2000 didn't");
+        Bench::Check(nrOfOverlaps > 200 && nrOfOverlaps < 1'800, "the random cases to both hit and miss, " + std::to_string(nrOfOverlaps) + " hit");
+
+        const GameEngine::CollisionMask atlas = MakeRandomMask(random, 100, 70, 3);
+        const SDL_Rect srcRect{ 13, 7, 30, 20 };
+        for (const auto flipMode : { SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL })
+        {
+            const GameEngine::CollisionMask frame = atlas.Extract(srcRect, flipMode, { 45, 40 });
+            bool isMatching = frame.GetWidth() == 45 && frame.GetHeight() == 40;
+            for (int y = 0; y < 40; ++y)
+            {
+                for (int x = 0; x < 45; ++x)
+                {
+                    const int srcX = flipMode == SDL_FLIP_HORIZONTAL ? srcRect.w - 1 - x * srcRect.w / 45 : x * srcRect.w / 45;
+                    const int srcY = flipMode == SDL_FLIP_VERTICAL ? srcRect.h - 1 - y * srcRect.h / 40 : y * srcRect.h / 40;
+                    isMatching &= frame.GetBit(x, y) == atlas.GetBit(srcRect.x + srcX, srcRect.y + srcY);
+                }
+            }
+            Bench::Check(isMatching, "the extracted frame to match the source pixels with flip mode " + std::to_string(static_cast<int>(flipMode)));
+        }
+    }
+
+    //Layouts with one and several rows, and an interval as long as the frame
+    [[nodiscard]] GameEngine::SpriteInfo MakeAnimatedSprite(int index)
+    {
+        const GameEngine::SpriteInfo layouts[]{
+            { {}, 16, 16, 2, 1, 0, 0, 1, 0.25f },
+            { {}, 16, 16, 4, 2, 0, 0, 1, 0.1f },
+            { {}, 32, 32, 3, 3, 0, 0, 0, 0.05f },
+            { {}, 8, 8, 6, 1, 0, 0, 2, 1.f / 60.f } };
+        GameEngine::SpriteInfo info = layouts[index % 4];
+        info.m_StartPos = { index % 7 * 50, index % 5 * 40 };
+        info.m_CurrentCol = index % info.m_NrOfCols;
+        info.m_CurrentRow = index % info.m_NrOfRows;
+        return info;
+    }
+
+    //The batched pass has to end on the same frames as every sprite stepping its own timer did before it,
+    //for sprites that start on different cells of the same layout
+    void CheckSpriteAnimatorMatchesPerSpriteUpdate()
+    {
+        constexpr int nrOfSprites{ 200 };
+        constexpr float frameTime{ 1.f / 60.f };
+        struct ReferenceSprite
+        {
+            GameEngine::SpriteInfo info;
+            float timeElapsed;
+        };
+        GameEngine::SpriteAnimator animator{};
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<GameEngine::SpriteComponent*> sprites{};
+        std::vector<ReferenceSprite> references{};
+        for (int i = 0; i < nrOfSprites; ++i)
+        {
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            auto sprite = sprites.emplace_back(gameObject->AddComponent<GameEngine::SpriteComponent>());
+            sprite->m_SpriteInfo = MakeAnimatedSprite(i);
+            sprite->UpdateSrcRect();
+            animator.AddSprite(sprite);
+            references.emplace_back(ReferenceSprite{ sprite->m_SpriteInfo, 0.f });
+        }
+
+        GameEngine::TimeManager::SetElapsed(frameTime);
+        int nrOfMismatches{};
+        for (int frame = 0; frame < 600; ++frame)
+        {
+            animator.Update();
+            for (int i = 0; i < nrOfSprites; ++i)
+            {
+                //what SpriteComponent::Update did
+                auto& [info, timeElapsed] = references[i];
+                timeElapsed += frameTime;
+                if (timeElapsed >= info.m_TimeInterval)
+                {
+                    ++info.m_CurrentCol %= info.m_NrOfCols;
+                    if (info.m_CurrentCol == 0) ++info.m_CurrentRow %= info.m_NrOfRows;
+                    timeElapsed -= info.m_TimeInterval;
+                }
+                const SDL_Rect expected = info.GetSrcRect();
+                const SDL_Rect& actual = sprites[i]->m_SrcRect;
+                if (sprites[i]->m_SpriteInfo.m_CurrentCol != info.m_CurrentCol || sprites[i]->m_SpriteInfo.m_CurrentRow != info.m_CurrentRow ||
+                    actual.x != expected.x || actual.y != expected.y || actual.w != expected.w || actual.h != expected.h)
+                    ++nrOfMismatches;
+            }
+        }
+        Bench::Check(nrOfMismatches == 0, "the sprites to show the frames of the per sprite update, " + std::to_string(nrOfMismatches) + " sprite frames didn't");
+    }
+
+    //The rows of the metric in a telemetry session file, split at the commas
+    [[nodiscard]] std::vector<std::vector<std::string>> ReadTelemetryRows(const std::filesystem::path& path, const std::string& metric)
+    {
+        std::vector<std::vector<std::string>> rows{};
+        std::ifstream file{ path };
+        for (std::string line; std::getline(file, line);)
+        {
+            std::vector<std::string> fields{};
+            std::stringstream stream{ line };
+            for (std::string field; std::getline(stream, field, ',');) fields.emplace_back(field);
+            if (fields.size() > 1 && fields[1] == metric) rows.emplace_back(std::move(fields));
+        }
+        return rows;
+    }
+
+    //Counters added from several threads while the flush thread sums and resets their shards lose nothing, and
+    //histograms are exact below 32 and within their ~3% bucket precision above it
+    void CheckTelemetryAcrossThreads()
+    {
+        using namespace std::chrono;
+        constexpr int nrOfThreads{ 3 };
+        constexpr uint64_t nrOfValues{ 100'000 };
+        auto& telemetry = GameEngine::Telemetry::GetInstance();
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "MiniginBenchTelemetry.csv";
+        const GameEngine::MetricId counter = telemetry.RegisterCounter("check counter");
+        const GameEngine::MetricId gauge = telemetry.RegisterGauge("check gauge");
+        const GameEngine::MetricId smallValues = telemetry.RegisterHistogram("check small values");
+        const GameEngine::MetricId largeValues = telemetry.RegisterHistogram("check large values");
+
+        //the threads add for a while rather than a number of times, so the flush thread runs in between on any machine
+        telemetry.StartSession(path.string(), milliseconds{ 10 });
+        std::atomic<uint64_t> nrOfAdds{};
+        std::vector<std::thread> threads{};
+        for (int thread = 0; thread < nrOfThreads; ++thread)
+        {
+            threads.emplace_back([&telemetry, &nrOfAdds, counter]() {
+                const auto end = steady_clock::now() + milliseconds{ 200 };
+                uint64_t nrOfThreadAdds{};
+                for (; steady_clock::now() < end; ++nrOfThreadAdds) telemetry.Add(counter);
+                nrOfAdds += nrOfThreadAdds;
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        telemetry.EndSession();
+        const auto counterRows = ReadTelemetryRows(path, "check counter");
+        uint64_t total{};
+        for (const auto& row : counterRows) total += std::stoull(row[2]);
+        Bench::Check(counterRows.size() > 1, "the counter to be flushed more than once while it was added to");
+        Bench::Check(total == nrOfAdds, "the flushed counts to add up to the " + std::to_string(nrOfAdds) + " Adds, got " + std::to_string(total));
+
+        //flushed only when the session ends, so all samples land in one row
+        telemetry.StartSession(path.string(), hours{ 1 });
+        threads.clear();
+        for (int thread = 0; thread < nrOfThreads; ++thread)
+        {
+            threads.emplace_back([&telemetry, smallValues, largeValues]() {
+                for (uint64_t value = 0; value < 32; ++value) telemetry.Record(smallValues, value);
+                for (uint64_t value = 0; value < nrOfValues; ++value) telemetry.Record(largeValues, value);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        telemetry.Set(gauge, -42);
+        telemetry.EndSession();
+
+        const auto smallRows = ReadTelemetryRows(path, "check small values");
+        Bench::Check(smallRows.size() == 1 && smallRows[0][3] == "96" && std::stod(smallRows[0][2]) == 15.5, "96 small samples with a mean of 15.5");
+        Bench::Check(smallRows[0][4] == "15" && smallRows[0][6] == "31" && smallRows[0][7] == "31", "the small percentiles to be exact");
+
+        const auto largeRows = ReadTelemetryRows(path, "check large values");
+        Bench::Check(largeRows.size() == 1 && std::stoull(largeRows[0][3]) == nrOfThreads * nrOfValues, "a sample per Record");
+        Bench::Check(std::stod(largeRows[0][2]) == 49'999.5, "the mean to be exact, got " + largeRows[0][2]);
+        const std::pair<size_t, double> expectedPercentiles[]{ { 4, 50'000. }, { 5, 95'000. }, { 6, 99'000. }, { 7, 99'999. } };
+        for (const auto& [column, expected] : expectedPercentiles)
+        {
+            const double percentile = std::stod(largeRows[0][column]);
+            Bench::Check(std::abs(percentile - expected) <= expected * 0.03, "column " + std::to_string(column) + " to be within 3% of " +
+                std::to_string(expected) + ", got " + largeRows[0][column]);
+        }
+
+        const auto gaugeRows = ReadTelemetryRows(path, "check gauge");
+        Bench::Check(gaugeRows.size() == 1 && gaugeRows[0][2] == "-42", "the gauge to hold the value it was set to");
+        std::filesystem::remove(path);
+    }
+
+    //Whether the two vectors hold the same records, padding included
+    template<typename T>
+    [[nodiscard]] bool AreSameBytes(const std::vector<T>& expected, const std::vector<T>& actual)
+    {
+        return std::ranges::equal(std::as_bytes(std::span{ expected }), std::as_bytes(std::span{ actual }));
+    }
+
+    //Throws if the scene compiles, otherwise returns the message it failed with
+    [[nodiscard]] std::string GetCompileError(const std::filesystem::path& scenePath)
+    {
+        try
+        {
+            static_cast<void>(GameEngine::SceneCompiler::Compile(scenePath.string()));
+        }
+        catch (const std::runtime_error& e)
+        {
+            return e.what();
+        }
+        throw std::runtime_error(scenePath.string() + " compiled");
+    }
+
+    //Every scene file of the game compiles to a blob that loads back into the same arrays, a cut off blob is
+    //refused, and compile errors name the scene file they are in
+    void CheckSceneBlobRoundTrip()
+    {
+        const std::filesystem::path blobPath = std::filesystem::temp_directory_path() / "MiniginBenchScene.scene";
+        int nrOfScenes{};
+        for (const auto& entry : std::filesystem::directory_iterator{ "../Data/Scenes" })
+        {
+            if (entry.path().extension() != ".json") continue;
+            ++nrOfScenes;
+            const std::string scene = entry.path().filename().string();
+            const GameEngine::SceneBlob compiled = GameEngine::SceneCompiler::Compile(entry.path().string());
+            Bench::Check(!compiled.objects.empty() && !compiled.strings.empty(), scene + " to have objects and strings");
+            compiled.SaveToFile(blobPath.string());
+            GameEngine::SceneBlob loaded{};
+            loaded.LoadFromFile(blobPath.string());
+            const bool isSame = AreSameBytes(compiled.objectIds, loaded.objectIds) && AreSameBytes(compiled.componentTypes, loaded.componentTypes) &&
+                AreSameBytes(compiled.observerTypes, loaded.observerTypes) && AreSameBytes(compiled.commandTypes, loaded.commandTypes) &&
+                AreSameBytes(compiled.resources, loaded.resources) && AreSameBytes(compiled.objects, loaded.objects) &&
+                AreSameBytes(compiled.components, loaded.components) && AreSameBytes(compiled.observers, loaded.observers) &&
+                AreSameBytes(compiled.observedObjects, loaded.observedObjects) && AreSameBytes(compiled.bindings, loaded.bindings) &&
+                AreSameBytes(compiled.args, loaded.args) && AreSameBytes(compiled.strings, loaded.strings);
+            Bench::Check(isSame, scene + " to load back into the arrays it was saved from");
+        }
+        Bench::Check(nrOfScenes == 4, "the four scene files of the game, found " + std::to_string(nrOfScenes));
+
+        std::filesystem::resize_file(blobPath, std::filesystem::file_size(blobPath) / 2);
+        bool isRefused{};
+        try
+        {
+            GameEngine::SceneBlob truncated{};
+            truncated.LoadFromFile(blobPath.string());
+        }
+        catch (const std::runtime_error&)
+        {
+            isRefused = true;
+        }
+        Bench::Check(isRefused, "a blob cut in half to be refused");
+        std::filesystem::remove(blobPath);
+
+        const std::filesystem::path scenePath = std::filesystem::temp_directory_path() / "MiniginBenchBadScene.json";
+        std::ofstream{ scenePath } << R"({ "objects": [ { "name": "label", "id": "text",
+            "components": [ { "type": "TextComponent", "args": [ { "object": "missing" } ] } ] } ] })";
+        const std::string error = GetCompileError(scenePath);
+        Bench::Check(error.find(scenePath.string()) != std::string::npos && error.find("missing") != std::string::npos,
+            "the error of a bad object reference to name the scene and the object, got: " + error);
+        std::filesystem::remove(scenePath);
+    }
+
+    //Samples in the middle of their 10 µs bucket, so every percentile is the top of a known bucket
+    void CheckLatencyHistogramSummary()
+    {
+        GameEngine::LatencyHistogram histogram{};
+        //0.105 ms up to 10.005 ms, added out of order
+        for (int i = 100; i > 0; --i) histogram.Add(static_cast<float>(i) * 0.1f + 0.005f);
+        const GameEngine::LatencySummary summary = histogram.GetSummary();
+        Bench::Check(summary.nrOfSamples == 100, "100 samples");
+        Bench::Check(std::abs(summary.mean - 5.055f) < 1e-3f, "the mean to be 5.055 ms");
+        Bench::Check(std::abs(summary.p50 - 5.01f) < 1e-3f, "the p50 to be the top of the 50th sample's bucket");
+        Bench::Check(std::abs(summary.p95 - 9.51f) < 1e-3f, "the p95 to be the top of the 95th sample's bucket");
+        Bench::Check(std::abs(summary.p99 - 9.91f) < 1e-3f, "the p99 to be the top of the 99th sample's bucket");
+        Bench::Check(summary.max == 10.005f, "the max to be the largest sample itself");
+
+        //past the last bucket a sample is clamped into it for the percentiles but kept for the max
+        histogram.Add(500.f);
+        Bench::Check(std::abs(histogram.GetPercentile(100.f) - 100.f) < 1e-3f, "a 500 ms sample to count as the last bucket");
+        Bench::Check(histogram.GetSummary().max == 500.f, "the max to keep the clamped sample");
+
+        histogram.Clear();
+        const GameEngine::LatencySummary cleared = histogram.GetSummary();
+        Bench::Check(cleared.nrOfSamples == 0 && cleared.mean == 0.f && cleared.p99 == 0.f && cleared.max == 0.f, "Clear to drop every sample");
+    }
+
+    //Busy waits, a sleep would hand the core to the pacer's spin on single core machines
+    void SimulateWork(std::chrono::microseconds duration)
+    {
+        const auto end = GameEngine::FramePacer::Clock::now() + duration;
+        while (GameEngine::FramePacer::Clock::now() < end) {}
+    }
+
+    struct PacedRun
+    {
+        GameEngine::LatencySummary frameTimes;
+        float totalTime;
+    };
+
+    //Paces frames at 160 fps with a random 0-4 ms load in every frame
+    [[nodiscard]] PacedRun PaceFramesUnderLoad(int nrOfFrames, unsigned int seed)
+    {
+        using namespace std::chrono;
+        auto& pacer = GameEngine::FramePacer::GetInstance();
+        pacer.SetTargetFrameRate(160.f);
+        std::mt19937 random{ seed };
+        std::uniform_int_distribution<int> load{ 0, 4000 };
+
+        pacer.StartSession();
+        const auto start = GameEngine::FramePacer::Clock::now();
+        for (int frame = 0; frame < nrOfFrames; ++frame)
+        {
+            SimulateWork(microseconds{ load(random) });
+            pacer.WaitForNextFrame();
+        }
+        const float totalTime = duration<float, std::milli>(GameEngine::FramePacer::Clock::now() - start).count();
+        pacer.EndSession();
+        return { pacer.GetFrameTimes(), totalTime };
+    }
+
+    //Every frame has to end on its deadline: the p50 frame time sits in the 6.25 ms bucket, sleeps that
+    //overshoot by less than the 1 ms spin time keep the p95 within it, and the frames add up to the schedule
+    //without drifting. A preempted run can miss a deadline by more than a frame, so the best of three is kept
+    void CheckFramePacerJitter()
+    {
+        constexpr int nrOfFrames{ 320 };
+        constexpr float frameTime{ 6.25f };
+        std::string failure{};
+        for (unsigned int attempt = 0; attempt < 3; ++attempt)
+        {
+            const auto [frameTimes, totalTime] = PaceFramesUnderLoad(nrOfFrames, 44 + attempt);
+            Bench::Check(frameTimes.nrOfSamples == nrOfFrames, "a frame time per frame");
+            if (std::abs(frameTimes.p50 - frameTime) > 0.05f) failure = "the p50 frame time to be 6.25 ms, got " + std::to_string(frameTimes.p50);
+            else if (frameTimes.p95 > frameTime + 1.f) failure = "the p95 frame time to stay within the spin time of 6.25 ms, got " + std::to_string(frameTimes.p95);
+            else if (std::abs(totalTime - nrOfFrames * frameTime) > frameTime) failure = "the frames to end within a frame of the schedule, took " + std::to_string(totalTime) + " ms";
+            else return;
+        }
+        Bench::Check(false, failure);
+    }
+
+    //A frame that overruns by more than a whole frame starts a new schedule, the frames after it get their
+    //full time instead of being rushed to catch up
+    void CheckFramePacerRestartsAfterOverrun()
+    {
+        using namespace std::chrono;
+        auto& pacer = GameEngine::FramePacer::GetInstance();
+        pacer.SetTargetFrameRate(160.f);
+        pacer.StartSession();
+        pacer.WaitForNextFrame();
+        SimulateWork(milliseconds{ 20 });
+        pacer.WaitForNextFrame();
+        const auto start = GameEngine::FramePacer::Clock::now();
+        pacer.WaitForNextFrame();
+        const float frameTime = duration<float, std::milli>(GameEngine::FramePacer::Clock::now() - start).count();
+        pacer.EndSession();
+        Bench::Check(frameTime >= 6.f, "the frame after an overrun to take a whole frame, took " + std::to_string(frameTime) + " ms");
+    }
+
+    struct LargeEmitters
+    {
+        int debris;
+        int stars;
+    };
+
+    //Adds a dying debris emitter and a wrapping star emitter, both past the parallel threshold
+    [[nodiscard]] LargeEmitters AddLargeEmitters(GameEngine::ParticleSystem& particleSystem)
+    {
+        GameEngine::EmitterSettings debris{};
+        debris.minLifeTime = 0.2f;
+        debris.maxLifeTime = 1.f;
+        debris.minSpeed = 50.f;
+        debris.maxSpeed = 400.f;
+        debris.acceleration = { 0.f, 300.f };
+        GameEngine::EmitterSettings stars{};
+        stars.minLifeTime = 0.6f;
+        stars.maxLifeTime = 1.6f;
+        stars.minSpeed = stars.maxSpeed = 650.f;
+        stars.minAngle = stars.maxAngle = 90.f;
+        stars.isWrapping = true;
+        stars.bounds = { 0, 0, 672, 768 };
+        return LargeEmitters{ particleSystem.AddEmitter(debris), particleSystem.AddEmitter(stars) };
+    }
+
+    //Stepping an emitter in chunks across the cores has to give the same lanes, bit for bit, as stepping
+    //it in one go, including which particles die and get swapped away
+    void CheckParallelParticlesMatchSerial()
+    {
+        GameEngine::ParticleSystem parallel{};
+        const LargeEmitters emitters = AddLargeEmitters(parallel);
+        Bench::Check(emitters.debris != emitters.stars, "every emitter to get an id of its own");
+        parallel.Burst(emitters.debris, { 336.f, 384.f }, 60'000);
+        parallel.Fill(emitters.stars, 40'000);
+        GameEngine::Snapshot start{};
+        parallel.SaveState(start);
+
+        GameEngine::ParticleSystem serial{};
+        const LargeEmitters serialEmitters = AddLargeEmitters(serial);
+        Bench::Check(serialEmitters.debris == emitters.debris && serialEmitters.stars == emitters.stars,
+            "the emitters to get the same ids in both systems");
+        serial.SetParallelThreshold(SIZE_MAX);
+        serial.LoadState(start);
+
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        //half a second, long enough for part of the debris to die
+        for (int frame = 0; frame < 80; ++frame)
+        {
+            parallel.Update();
+            serial.Update();
+        }
+        GameEngine::Snapshot parallelState{};
+        parallel.SaveState(parallelState);
+        GameEngine::Snapshot serialState{};
+        serial.SaveState(serialState);
+        Bench::Check(parallel.GetNrOfParticles(emitters.stars) == 40'000, "the wrapping stars to never die");
+        Bench::Check(parallel.GetNrOfParticles(emitters.debris) > 0 && parallel.GetNrOfParticles(emitters.debris) < 60'000,
+            "part of the debris to have died");
+        Bench::Check(std::ranges::equal(parallelState.GetData(), serialState.GetData()), "the parallel lanes to match the serial ones byte for byte");
+    }
+
+    //Two events with the same layout, their ids must still differ
+    struct FirstEvent {};
+    struct SecondEvent {};
+
+    //Counts its events, and disconnects the receivers it is given once it gets one
+    struct CountingReceiver
+    {
+        void OnFirst(GameEngine::GameObject& sender, const FirstEvent&)
+        {
+            ++nrOfFirstEvents;
+            if (isEmittingSecond) sender.Emit(SecondEvent{});
+            for (const CountingReceiver* receiver : receiversToDisconnect) sender.Disconnect(receiver);
+            receiversToDisconnect.clear();
+        }
+        void OnSecond(GameEngine::GameObject& sender, const SecondEvent&)
+        {
+            ++nrOfSecondEvents;
+            for (const CountingReceiver* receiver : receiversToDisconnect) sender.Disconnect(receiver);
+            receiversToDisconnect.clear();
+        }
+        int nrOfFirstEvents{};
+        int nrOfSecondEvents{};
+        bool isEmittingSecond{};
+        std::vector<const CountingReceiver*> receiversToDisconnect{};
+    };
+
+    //A square of one color, the resource manager owns it once a texture component takes it
+    [[nodiscard]] std::unique_ptr<GameEngine::Texture2D> MakeSquareTexture(const SDL_Color& color, int size)
+    {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+        Bench::Check(surface != nullptr, "SDL to create a surface");
+        SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, color.r, color.g, color.b, color.a));
+        return std::make_unique<GameEngine::Texture2D>(surface);
+    }
+
+    //Whether a pixel read back from the renderer shows the color, give or take the rounding of blending
+    [[nodiscard]] bool IsColor(uint32_t pixel, const SDL_Color& color, int tolerance = 0)
+    {
+        const auto isClose = [tolerance](uint32_t channel, uint8_t expected) {
+            return std::abs(static_cast<int>(channel & 0xFF) - expected) <= tolerance;
+        };
+        return isClose(pixel >> 16, color.r) && isClose(pixel >> 8, color.g) && isClose(pixel, color.b);
+    }
+
+    [[nodiscard]] SDL_Color ToColor(uint32_t pixel)
+    {
+        return SDL_Color{ static_cast<uint8_t>(pixel >> 16), static_cast<uint8_t>(pixel >> 8), static_cast<uint8_t>(pixel), 255 };
+    }
+
+    //A scene of its own that is current for as long as it lives, its frames are drawn by the render thread
+    //and read back
+    class CapturedScene final
+    {
+    public:
+        CapturedScene()
+        {
+            auto scene = std::make_unique<GameEngine::Scene>();
+            m_pScene = scene.get();
+            auto& sceneManager = GameEngine::SceneManager::GetInstance();
+            sceneManager.AddScene(g_SceneId, std::move(scene));
+            sceneManager.SetCurrentScene(g_SceneId);
+        }
+        CapturedScene(const CapturedScene& other) = delete;
+        CapturedScene(CapturedScene&& other) noexcept = delete;
+        CapturedScene& operator=(const CapturedScene& other) = delete;
+        CapturedScene& operator=(CapturedScene&& other) noexcept = delete;
+        ~CapturedScene()
+        {
+            auto& sceneManager = GameEngine::SceneManager::GetInstance();
+            sceneManager.RemoveScene(g_SceneId);
+            sceneManager.SetCurrentScene(static_cast<int>(Galaga::GetInstance().GetCurrentScene()));
+        }
+
+        GameEngine::TextureComponent* AddSquare(const SDL_Color& color, const glm::vec2& position, GameEngine::RenderLayer layer,
+            int size = 32)
+        {
+            auto object = std::make_unique<GameEngine::GameObject>(0);
+            object->SetPosition(position.x, position.y);
+            object->SetRenderLayer(layer);
+            auto* pTexture = object->AddComponent<GameEngine::TextureComponent>(MakeSquareTexture(color, size));
+            m_pScene->AddObject(std::move(object));
+            return pTexture;
+        }
+        //Adds the objects added since the last frame and draws the scene
+        [[nodiscard]] GameEngine::Renderer::CapturedFrame Capture() const
+        {
+            m_pScene->Update();
+            auto frame = GameEngine::Renderer::GetInstance().CaptureFrame();
+            Bench::Check(!frame.pixels.empty(), "the renderer to read the frame back");
+            return frame;
+        }
+    private:
+        //an id the game doesn't use
+        static constexpr int g_SceneId{ 2000 };
+        GameEngine::Scene* m_pScene;
+    };
+
+    //The render thread sorts a frame's commands by layer and keeps the order they were recorded in within a layer.
+    //The squares of each pair overlap, so the color that shows is the one drawn last
+    void CheckRendererDrawsLayersInOrder()
+    {
+        constexpr SDL_Color red{ 255, 0, 0, 255 };
+        constexpr SDL_Color blue{ 0, 0, 255, 255 };
+        constexpr SDL_Color green{ 0, 255, 0, 255 };
+        constexpr SDL_Color yellow{ 255, 255, 0, 255 };
+        CapturedScene scene{};
+        //recorded before the background square it covers
+        scene.AddSquare(red, { 10.f, 10.f }, GameEngine::RenderLayer::foreground);
+        scene.AddSquare(blue, { 10.f, 10.f }, GameEngine::RenderLayer::background);
+        scene.AddSquare(green, { 60.f, 10.f }, GameEngine::RenderLayer::objects);
+        GameEngine::TextureComponent* pLast = scene.AddSquare(yellow, { 60.f, 10.f }, GameEngine::RenderLayer::objects);
+        const auto frame = scene.Capture();
+        Bench::Check(IsColor(frame.GetPixel(20, 20), red), "the foreground square over the background one");
+        Bench::Check(IsColor(frame.GetPixel(70, 20), yellow), "the square recorded last within its layer on top");
+        Bench::Check(IsColor(frame.GetPixel(200, 200), GameEngine::Renderer::GetInstance().GetBackgroundColor()),
+            "the clear color where nothing is drawn");
+
+        //the next frame is recorded into the other list while this one is drawn, it has to start out empty
+        pLast->GetGameObjParent()->SetPosition(110.f, 10.f);
+        const auto nextFrame = scene.Capture();
+        Bench::Check(IsColor(nextFrame.GetPixel(70, 20), green) && IsColor(nextFrame.GetPixel(120, 20), yellow),
+            "the next frame to show the square where it moved to");
+    }
+
+    //A cached layer is composited into a texture with premultiplied colors and drawn from it with a single copy,
+    //straight from it or from a straight alpha copy on renderers without premultiplied blending.
+    //Translucent squares over each other, over the layer below and over the clear color have to look the same as
+    //when they are drawn directly, and the layer is only composited again when one of its squares changes
+    void CheckCachedLayerMatchesDirectDraw()
+    {
+        using Frame = GameEngine::Renderer::CapturedFrame;
+        constexpr int nrOfUiSquares{ 3 };
+        auto& renderer = GameEngine::Renderer::GetInstance();
+        const bool wasCached = renderer.IsLayerCached(GameEngine::RenderLayer::ui);
+        Frame direct{}, composited{}, cached{}, changedDirect{}, changed{}, changedCached{};
+        {
+            CapturedScene scene{};
+            scene.AddSquare({ 0, 0, 255, 255 }, { 0.f, 0.f }, GameEngine::RenderLayer::objects, 64);
+            GameEngine::TextureComponent* pLabel = scene.AddSquare({ 255, 0, 0, 128 }, { 16.f, 16.f }, GameEngine::RenderLayer::ui);
+            scene.AddSquare({ 0, 255, 0, 64 }, { 32.f, 32.f }, GameEngine::RenderLayer::ui);
+            scene.AddSquare({ 255, 255, 255, 192 }, { 100.f, 16.f }, GameEngine::RenderLayer::ui);
+            renderer.SetLayerCaching(GameEngine::RenderLayer::ui, false);
+            direct = scene.Capture();
+            renderer.SetLayerCaching(GameEngine::RenderLayer::ui, true);
+            composited = scene.Capture();
+            cached = scene.Capture();
+
+            //a label that changes gets a new texture
+            pLabel->SetTexture(MakeSquareTexture({ 255, 255, 0, 160 }, 32));
+            changed = scene.Capture();
+            changedCached = scene.Capture();
+            renderer.SetLayerCaching(GameEngine::RenderLayer::ui, false);
+            changedDirect = scene.Capture();
+            renderer.SetLayerCaching(GameEngine::RenderLayer::ui, wasCached);
+        }
+
+        //premultiplying rounds the colors one more time
+        const auto isSameFrame = [](const Frame& frame, const Frame& expected) {
+            return std::ranges::equal(frame.pixels, expected.pixels, [](uint32_t pixel, uint32_t expectedPixel) {
+                return IsColor(pixel, ToColor(expectedPixel), 3);
+            });
+        };
+        Bench::Check(isSameFrame(composited, direct) && isSameFrame(cached, direct), "the cached layer to look like the direct one");
+        Bench::Check(!IsColor(changedDirect.GetPixel(20, 20), ToColor(direct.GetPixel(20, 20)), 3), "the changed square to show");
+        Bench::Check(isSameFrame(changed, changedDirect) && isSameFrame(changedCached, changedDirect),
+            "the cached layer to look like the direct one once a square changed");
+
+        //headless, MiniginBench draws with SDL's software renderer. It can't blend premultiplied colors, but it can
+        //draw into textures, so it has to cache the layer too
+        const char* pRenderDriver = SDL_GetHint(SDL_HINT_RENDER_DRIVER);
+        const bool isSoftwareRenderer = pRenderDriver != nullptr && std::string{ pRenderDriver } == "software";
+        Bench::Check(!isSoftwareRenderer || renderer.IsLayerCachingSupported(), "layer caching to stay on with the software renderer");
+        if (!renderer.IsLayerCachingSupported())
+        {
+            Bench::Check(cached.nrOfDrawCalls == direct.nrOfDrawCalls, "a renderer without layer caching to draw the layer directly");
+            return;
+        }
+        //compositing draws the squares into the texture and copies it to the screen
+        Bench::Check(composited.nrOfDrawCalls == direct.nrOfDrawCalls + 1 && changed.nrOfDrawCalls == direct.nrOfDrawCalls + 1,
+            "the layer to be composited on the first frame and after a change");
+        Bench::Check(cached.nrOfDrawCalls == direct.nrOfDrawCalls - nrOfUiSquares + 1 && changedCached.nrOfDrawCalls == cached.nrOfDrawCalls,
+            "the unchanged layer to be drawn with a single copy, got " + std::to_string(cached.nrOfDrawCalls) + " draw calls where drawing it directly takes " +
+            std::to_string(direct.nrOfDrawCalls));
+    }
+
+    //A slot that disconnects itself or another receiver mid Emit can't make the loop skip a receiver that is
+    //still connected, and the disconnected ones don't get the event, also from an Emit nested in a slot
+    void CheckDisconnectDuringEmit()
+    {
+        Bench::Check(&GameEngine::Detail::g_EventTypeId<FirstEvent> != &GameEngine::Detail::g_EventTypeId<SecondEvent>,
+            "events with the same layout to have their own id");
+
+        GameEngine::GameObject gameObject{ 0 };
+        //past the 6 inline connections, so the heap storage is covered too
+        std::vector<CountingReceiver> receivers(8);
+        for (auto& receiver : receivers) gameObject.Connect<FirstEvent, &CountingReceiver::OnFirst>(&receiver);
+        gameObject.Connect<SecondEvent, &CountingReceiver::OnSecond>(&receivers[7]);
+        receivers[1].receiversToDisconnect = { &receivers[1], &receivers[3] };
+
+        gameObject.Emit(FirstEvent{});
+        const std::vector<int> afterFirstEmit{ 1, 1, 1, 0, 1, 1, 1, 1 };
+        for (size_t i = 0; i < receivers.size(); ++i)
+        {
+            Bench::Check(receivers[i].nrOfFirstEvents == afterFirstEmit[i], "receiver " + std::to_string(i) + " to get " +
+                std::to_string(afterFirstEmit[i]) + " events on the first emit, got " + std::to_string(receivers[i].nrOfFirstEvents));
+        }
+        Bench::Check(receivers[7].nrOfSecondEvents == 0, "a second event not to reach the receivers of the first");
+
+        //receiver 2 emits the other event, whose receiver disconnects 5 from inside the nested Emit
+        receivers[2].isEmittingSecond = true;
+        receivers[7].receiversToDisconnect = { &receivers[5] };
+        gameObject.Emit(FirstEvent{});
+        gameObject.Emit(FirstEvent{});
+        const std::vector<int> afterThirdEmit{ 3, 1, 3, 0, 3, 1, 3, 3 };
+        for (size_t i = 0; i < receivers.size(); ++i)
+        {
+            Bench::Check(receivers[i].nrOfFirstEvents == afterThirdEmit[i], "receiver " + std::to_string(i) + " to get " +
+                std::to_string(afterThirdEmit[i]) + " events after the nested disconnect, got " + std::to_string(receivers[i].nrOfFirstEvents));
+        }
+        Bench::Check(receivers[7].nrOfSecondEvents == 2, "the nested emit to reach its receiver once per outer emit");
+    }
+
+    //Waits until count differs from previous or a second went by, then as long again as a change takes to settle
+    //and be reported, so a second callback for the same change would have come in too
+    [[nodiscard]] int WaitForCallbacks(const std::atomic<int>& count, int previous)
+    {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{ 1 };
+        while (count == previous && std::chrono::steady_clock::now() < timeout) std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 300 });
+        return count;
+    }
+
+    //An editor that saves in several writes or by replacing the file causes one callback per save, and none
+    //once the file is unwatched
+    void CheckFileWatcherReportsEachSaveOnce()
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "MiniginBenchWatched.json";
+        const std::filesystem::path replacement = std::filesystem::temp_directory_path() / "MiniginBenchWatched.json.tmp";
+        std::ofstream{ path } << "{}";
+        auto& fileWatcher = GameEngine::FileWatcher::GetInstance();
+        std::atomic<int> nrOfCallbacks{};
+        const auto id = fileWatcher.Watch(path.string(), [&nrOfCallbacks](const std::string&, std::chrono::steady_clock::time_point) { ++nrOfCallbacks; });
+        //the watch has to be up before the writes, a write while it is being set up counts as one more change
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 200 });
+
+        for (int write = 0; write < 3; ++write)
+        {
+            std::ofstream{ path, std::ios::trunc } << "{ \"write\": " << write << " }";
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+        }
+        Bench::Check(WaitForCallbacks(nrOfCallbacks, 0) == 1, "a burst of three writes to cause one callback, got " + std::to_string(nrOfCallbacks));
+
+        std::ofstream{ replacement } << "{ \"replaced\": true }";
+        std::filesystem::rename(replacement, path);
+        Bench::Check(WaitForCallbacks(nrOfCallbacks, 1) == 2, "replacing the file to cause one callback, got " + std::to_string(nrOfCallbacks - 1));
+
+        fileWatcher.Unwatch(id);
+        std::ofstream{ path, std::ios::trunc } << "{}";
+        Bench::Check(WaitForCallbacks(nrOfCallbacks, 2) == 2, "no callback once the file is unwatched");
+        std::filesystem::remove(path);
+    }
+
+    class CountCommand final : public GameEngine::Command
+    {
+    public:
+        explicit CountCommand(int* pCount, ExecuteOn executeOn = ExecuteOn::keyDown) :
+            Command(nullptr),
+            m_pCount(pCount),
+            m_ExecuteOn(executeOn)
+        {}
+        [[nodiscard]] ExecuteOn ExecuteOnKeyState() const override { return m_ExecuteOn; }
+        void Execute() override { ++*m_pCount; }
+    private:
+        int* m_pCount;
+        ExecuteOn m_ExecuteOn;
+    };
+
+    //Counts the A presses and B releases of every controller slot while it lives, the game binds neither button
+    struct ControllerButtonCounts final
+    {
+        ControllerButtonCounts()
+        {
+            auto& input = GameEngine::InputManager::GetInstance();
+            for (int slot = 0; slot < static_cast<int>(GameEngine::g_maxControllerCount); ++slot)
+            {
+                input.BindCommand(GameEngine::ControllerInputKey::A, std::make_unique<CountCommand>(&nrOfPresses[slot]), slot);
+                input.BindCommand(GameEngine::ControllerInputKey::B,
+                    std::make_unique<CountCommand>(&nrOfReleases[slot], GameEngine::Command::ExecuteOn::keyUp), slot);
+            }
+        }
+        ControllerButtonCounts(const ControllerButtonCounts& other) = delete;
+        ControllerButtonCounts(ControllerButtonCounts&& other) noexcept = delete;
+        ControllerButtonCounts& operator=(const ControllerButtonCounts& other) = delete;
+        ControllerButtonCounts& operator=(ControllerButtonCounts&& other) noexcept = delete;
+        ~ControllerButtonCounts()
+        {
+            auto& input = GameEngine::InputManager::GetInstance();
+            for (int slot = 0; slot < static_cast<int>(GameEngine::g_maxControllerCount); ++slot)
+            {
+                input.UnbindCommand(GameEngine::ControllerInputKey::A, slot);
+                input.UnbindCommand(GameEngine::ControllerInputKey::B, slot);
+            }
+            //handles the events still queued and drops the unbound commands
+            input.ProcessInput();
+        }
+
+        [[nodiscard]] int GetSlotPressed(int nrOfTimes) const
+        {
+            return static_cast<int>(std::ranges::find(nrOfPresses, nrOfTimes) - nrOfPresses.begin());
+        }
+        [[nodiscard]] int GetTotalPresses() const { return std::accumulate(nrOfPresses.begin(), nrOfPresses.end(), 0); }
+        [[nodiscard]] int GetTotalReleases() const { return std::accumulate(nrOfReleases.begin(), nrOfReleases.end(), 0); }
+
+        std::array<int, GameEngine::g_maxControllerCount> nrOfPresses{};
+        std::array<int, GameEngine::g_maxControllerCount> nrOfReleases{};
+    };
+
+    //A virtual SDL controller whose hot-plug and button events are pushed on the queue the input manager pumps.
+    //SDL reports plugging it in itself as well, the input manager has to ignore the repeat
+    class VirtualController final
+    {
+    public:
+        VirtualController()
+        {
+            const int deviceIndex = SDL_JoystickAttachVirtual(SDL_JOYSTICK_TYPE_GAMECONTROLLER, SDL_CONTROLLER_AXIS_MAX, SDL_CONTROLLER_BUTTON_MAX, 0);
+            Bench::Check(deviceIndex >= 0, "SDL to attach a virtual controller");
+            m_InstanceId = SDL_JoystickGetDeviceInstanceID(deviceIndex);
+            SDL_Event e{};
+            e.type = SDL_CONTROLLERDEVICEADDED;
+            e.cdevice.which = deviceIndex;
+            SDL_PushEvent(&e);
+        }
+        VirtualController(const VirtualController& other) = delete;
+        VirtualController(VirtualController&& other) noexcept = delete;
+        VirtualController& operator=(const VirtualController& other) = delete;
+        VirtualController& operator=(VirtualController&& other) noexcept = delete;
+        ~VirtualController() { Unplug(); }
+
+        void Unplug()
+        {
+            if (!m_IsPluggedIn) return;
+            m_IsPluggedIn = false;
+            //device indices shift when a controller before this one is unplugged
+            for (int deviceIndex = 0; SDL_JoystickGetDeviceInstanceID(deviceIndex) >= 0; ++deviceIndex)
+            {
+                if (SDL_JoystickGetDeviceInstanceID(deviceIndex) != m_InstanceId) continue;
+                SDL_JoystickDetachVirtual(deviceIndex);
+                break;
+            }
+            SDL_Event e{};
+            e.type = SDL_CONTROLLERDEVICEREMOVED;
+            e.cdevice.which = m_InstanceId;
+            SDL_PushEvent(&e);
+        }
+        //Still sends events once unplugged, like a late event of a controller that is gone
+        void PushButton(SDL_GameControllerButton button, bool isDown) const
+        {
+            SDL_Event e{};
+            e.type = isDown ? SDL_CONTROLLERBUTTONDOWN : SDL_CONTROLLERBUTTONUP;
+            e.cbutton.which = m_InstanceId;
+            e.cbutton.button = static_cast<Uint8>(button);
+            e.cbutton.state = isDown ? SDL_PRESSED : SDL_RELEASED;
+            SDL_PushEvent(&e);
+        }
+    private:
+        SDL_JoystickID m_InstanceId{ -1 };
+        bool m_IsPluggedIn{ true };
+    };
+
+    //Every controller keeps the slot it got when it was plugged in, an unplugged one gives back its slot and
+    //the buttons it held, and events are handled in the order they happened even within one frame
+    void CheckControllerHotPlug()
+    {
+        auto& input = GameEngine::InputManager::GetInstance();
+        const ControllerButtonCounts counts{};
+        VirtualController first{};
+        first.PushButton(SDL_CONTROLLER_BUTTON_A, true);
+        first.PushButton(SDL_CONTROLLER_BUTTON_B, true);
+        input.ProcessInput();
+        const int firstSlot = counts.GetSlotPressed(1);
+        Bench::Check(counts.GetTotalPresses() == 1 && firstSlot < static_cast<int>(GameEngine::g_maxControllerCount),
+            "the first controller to press A once");
+
+        VirtualController second{};
+        second.PushButton(SDL_CONTROLLER_BUTTON_A, true);
+        input.ProcessInput();
+        Bench::Check(counts.GetTotalPresses() == 2 && counts.nrOfPresses[firstSlot] == 1, "the second controller to get a slot of its own");
+
+        first.Unplug();
+        input.ProcessInput();
+        Bench::Check(counts.GetTotalReleases() == 1 && counts.nrOfReleases[firstSlot] == 1,
+            "unplugging the first controller to release the B it held");
+        first.PushButton(SDL_CONTROLLER_BUTTON_B, false);
+        input.ProcessInput();
+        Bench::Check(counts.GetTotalReleases() == 1, "the events of an unplugged controller to be ignored");
+
+        const VirtualController third{};
+        third.PushButton(SDL_CONTROLLER_BUTTON_A, true);
+        input.ProcessInput();
+        Bench::Check(counts.GetTotalPresses() == 3 && counts.nrOfPresses[firstSlot] == 2,
+            "the third controller to take the slot the first one gave back");
+        third.PushButton(SDL_CONTROLLER_BUTTON_B, true);
+        third.PushButton(SDL_CONTROLLER_BUTTON_B, false);
+        input.ProcessInput();
+        Bench::Check(counts.GetTotalReleases() == 2 && counts.nrOfReleases[firstSlot] == 2,
+            "a press and release within one frame to count as a release");
+    }
+
+    //Removing swaps the last enemy into the gap, so after removals in any order every enemy that is left
+    //has to be found exactly once in the flat list and once in the bucket of its type
+    void CheckEnemyRegistryRemoval()
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<EnemyComponent*> enemies{};
+        for (const EnemyId enemyId : { EnemyId::bee, EnemyId::butterfly, EnemyId::bossGalaga })
+        {
+            for (auto& gameObject : SpawnEnemies(enemyId, 20, playerComponent))
+            {
+                enemies.emplace_back(gameObject->GetComponent<EnemyComponent>());
+                gameObjects.emplace_back(std::move(gameObject));
+            }
+        }
+        //spawned enemies register themselves with the AI manager
+        for (EnemyComponent* enemy : enemies) EnemyAIManager::RemoveEnemy(enemy);
+        EnemyRegistry registry{};
+        for (EnemyComponent* enemy : enemies) registry.Add(enemy);
+        //every third enemy, starting in the middle, so both the last entry and others get removed
+        std::vector<EnemyComponent*> remaining{};
+        for (size_t i = 0; i < enemies.size(); ++i)
+        {
+            if ((i + enemies.size() / 2) % 3 == 0) registry.Remove(enemies[i]);
+            else remaining.emplace_back(enemies[i]);
+        }
+
+        Bench::Check(registry.GetNrOfEnemies() == remaining.size(), "one entry per enemy that is left");
+        for (EnemyComponent* enemy : remaining)
+        {
+            size_t nrInList{};
+            for (size_t i = 0; i < registry.GetNrOfEnemies(); ++i) nrInList += registry.GetEnemy(i) == enemy;
+            const auto& bucket = registry.GetEnemies(enemy->GetEnemyType(), enemy->IsIdle());
+            Bench::Check(nrInList == 1 && std::ranges::count(bucket, enemy) == 1, "every enemy that is left once in the list and its bucket");
+        }
+        for (EnemyComponent* enemy : remaining) registry.Remove(enemy);
+        Bench::Check(registry.GetNrOfEnemies() == 0, "an empty registry once every enemy is removed");
+    }
+
+    //An order whose only candidate is on cooldown has to wait for it instead of being dropped
+    void CheckAttackOrderWaitsForCooldown()
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        auto spawned = SpawnEnemies(EnemyId::bee, 1, playerComponent);
+        EnemyComponent* bee = spawned.front()->GetComponent<EnemyComponent>();
+        bee->SetFormationPosition({ 100, 100 });
+        spawned.front()->SetPosition(100.f + FormationComponent::GetOffset(), 100.f);
+
+        GameEngine::GameObject aiObject{ 0 };
+        const auto aiManager = aiObject.AddComponent<EnemyAIManager>();
+        //the manager's orders are static, they are put back once the check is done
+        GameEngine::Snapshot aiState{};
+        aiManager->SaveState(aiState);
+        aiManager->Observe(spawned.front().get());
+        EnemyAIManager::SetMaxConcurrentDivers(1);
+        EnemyAIManager::SetFrameBudget(std::chrono::hours{ 1 });
+        bee->GetInIdleState();
+        bee->m_LastAttackTime = 0.001f;
+
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        aiManager->Update();
+        const size_t nrOfOrders = EnemyAIManager::GetNrOfPendingOrders();
+        Bench::Check(nrOfOrders > 0 && bee->IsIdle(), "the planned orders to wait while the bee is on cooldown");
+        for (int frame = 0; frame < 10; ++frame) aiManager->Update();
+        Bench::Check(EnemyAIManager::GetNrOfPendingOrders() == nrOfOrders, "no orders lost over the frames on cooldown");
+
+        bee->m_LastAttackTime = 0.f;
+        aiManager->Update();
+        Bench::Check(!bee->IsIdle(), "the bee to attack once it is off cooldown");
+        Bench::Check(EnemyAIManager::GetNrOfPendingOrders() == nrOfOrders - 1, "only the order the bee carried out to be removed");
+
+        aiState.Rewind();
+        aiManager->LoadState(aiState);
+    }
+
+    //Every update that plans or carries out orders records its cost in the telemetry session next to the other
+    //per system costs, the flushed mean is exact so it has to match the costs the manager reported
+    void CheckEnemyAICostIsRecorded()
+    {
+        constexpr int nrOfFrames{ 20 };
+        const auto fighter = InitFighter();
+        auto spawned = SpawnEnemies(EnemyId::bee, 1, fighter->GetComponent<PlayerComponent>());
+        spawned.front()->GetComponent<EnemyComponent>()->SetFormationPosition({ 100, 100 });
+        spawned.front()->SetPosition(100.f + FormationComponent::GetOffset(), 100.f);
+
+        GameEngine::GameObject aiObject{ 0 };
+        const auto aiManager = aiObject.AddComponent<EnemyAIManager>();
+        //the manager's orders are static, they are put back once the check is done
+        GameEngine::Snapshot aiState{};
+        aiManager->SaveState(aiState);
+        aiManager->Observe(spawned.front().get());
+        spawned.front()->GetComponent<EnemyComponent>()->GetInIdleState();
+
+        auto& telemetry = GameEngine::Telemetry::GetInstance();
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "MiniginBenchEnemyAI.csv";
+        //samples of earlier updates are held until a session flushes them, this one only takes the ones below.
+        //Flushed only when the session ends, so all samples land in one row
+        telemetry.StartSession(path.string());
+        telemetry.EndSession();
+        telemetry.StartSession(path.string(), std::chrono::hours{ 1 });
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        std::chrono::microseconds totalCost{};
+        for (int frame = 0; frame < nrOfFrames; ++frame)
+        {
+            aiManager->Update();
+            totalCost += EnemyAIManager::GetLastUpdateCost();
+        }
+        telemetry.EndSession();
+        aiState.Rewind();
+        aiManager->LoadState(aiState);
+
+        const auto rows = ReadTelemetryRows(path, "enemy ai us");
+        Bench::Check(rows.size() == 1 && rows[0][3] == std::to_string(nrOfFrames), "a sample per update in the enemy ai us histogram");
+        const double expectedMean = static_cast<double>(totalCost.count()) / nrOfFrames;
+        Bench::Check(std::abs(std::stod(rows[0][2]) - expectedMean) <= 0.01, "the mean cost to be " + std::to_string(expectedMean) + " us, got " + rows[0][2]);
+        std::filesystem::remove(path);
+    }
+
+    //Every state change of a bee, a butterfly and a boss, from formation to each attack and back
+    void RunEnemyStateTransitions(const std::vector<EnemyComponent*>& enemies, BossGalagaComponent* boss)
+    {
+        for (EnemyComponent* enemy : enemies)
+        {
+            enemy->GetInAttackState();
+            enemy->Update();
+            enemy->GetInIdleState();
+            enemy->Update();
+        }
+        boss->GetInBeamAttackState();
+        boss->Update();
+        boss->GetInIdleState();
+        TrajectoryBatch::Step();
+        RotatingSprite::ResolveQueuedRotations();
+    }
+
+    //The states re-target the path their enemy keeps, so once it has grown to the longest path nothing allocates
+    void CheckEnemyStateTransitionsDoNotAllocate()
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<EnemyComponent*> enemies{};
+        for (const EnemyId enemyId : { EnemyId::bee, EnemyId::butterfly, EnemyId::bossGalaga })
+        {
+            auto spawned = SpawnEnemies(enemyId, 1, playerComponent);
+            enemies.emplace_back(spawned.front()->GetComponent<EnemyComponent>());
+            enemies.back()->SetFormationPosition({ 100, 100 });
+            gameObjects.emplace_back(std::move(spawned.front()));
+        }
+        const auto boss = dynamic_cast<BossGalagaComponent*>(enemies.back());
+
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        RunEnemyStateTransitions(enemies, boss);
+        const uint64_t nrOfAllocationsBefore = GameEngine::Telemetry::GetNrOfAllocations();
+        for (int round = 0; round < 10; ++round) RunEnemyStateTransitions(enemies, boss);
+        //read before Check builds its message, which allocates
+        const uint64_t nrOfAllocations = GameEngine::Telemetry::GetNrOfAllocations() - nrOfAllocationsBefore;
+        Bench::Check(nrOfAllocations == 0, "no allocations once the paths are warmed up, got " + std::to_string(nrOfAllocations));
+    }
+
+    //A sprite on a 7 column sheet, so it has 24 rotation stages
+    [[nodiscard]] std::unique_ptr<RotatingSprite> MakeRotatingSprite(GameEngine::GameObject& gameObject)
+    {
+        auto spriteComponent = gameObject.AddComponent<GameEngine::SpriteComponent>();
+        spriteComponent->m_SpriteInfo.m_Width = 16;
+        spriteComponent->m_SpriteInfo.m_Height = 16;
+        spriteComponent->m_SpriteInfo.m_Spacing = 2;
+        spriteComponent->m_SpriteInfo.m_NrOfCols = 7;
+        spriteComponent->m_SpriteInfo.m_NrOfRows = 1;
+        return std::make_unique<RotatingSprite>(spriteComponent);
+    }
+
+    [[nodiscard]] int GetRotationStage(const RotatingSprite& sprite)
+    {
+        GameEngine::Snapshot snapshot{};
+        sprite.SaveState(snapshot);
+        snapshot.Rewind();
+        int rotationStage{};
+        snapshot.Read(rotationStage);
+        return rotationStage;
+    }
+
+    //Sprites destroyed while queued hand their place to the last queued sprite. Whichever sprite is destroyed,
+    //the ones that are left have to get the direction they queued last, also when they queue again after moving
+    void CheckRotationQueueSurvivesDestroyedSprites()
+    {
+        constexpr int nrOfSprites{ 8 };
+        const auto getDirection = [](int sprite, int turn) {
+            const float angle = glm::two_pi<float>() * static_cast<float>(sprite * 3 + turn) / (nrOfSprites * 3);
+            return glm::vec2{ std::cos(angle), std::sin(angle) };
+        };
+        GameEngine::GameObject referenceObject{ 0 };
+        const auto reference = MakeRotatingSprite(referenceObject);
+        const auto getExpectedStage = [&reference](const glm::vec2& direction) {
+            reference->RotateSpriteInDirection(direction);
+            return GetRotationStage(*reference);
+        };
+
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<std::unique_ptr<RotatingSprite>> sprites{};
+        for (int i = 0; i < nrOfSprites; ++i)
+        {
+            sprites.emplace_back(MakeRotatingSprite(*gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0))));
+            sprites.back()->QueueRotation(getDirection(i, 0));
+        }
+        //the first, a middle one and the last one of the queue
+        for (const int destroyed : { 0, 4, nrOfSprites - 1 }) sprites[destroyed].reset();
+        //the sprites that took the destroyed ones' places queue again, the others keep their first direction
+        std::vector<int> turns(nrOfSprites, 0);
+        for (const int requeued : { 6, 5, 1 })
+        {
+            turns[requeued] = 1;
+            sprites[requeued]->QueueRotation(getDirection(requeued, 1));
+        }
+        RotatingSprite::ResolveQueuedRotations();
+
+        for (int i = 0; i < nrOfSprites; ++i)
+        {
+            if (!sprites[i]) continue;
+            const int expectedStage = getExpectedStage(getDirection(i, turns[i]));
+            Bench::Check(GetRotationStage(*sprites[i]) == expectedStage, "sprite " + std::to_string(i) + " to turn to stage " +
+                std::to_string(expectedStage) + ", got " + std::to_string(GetRotationStage(*sprites[i])));
+        }
+        //the queue is empty, destroying the sprites that are left touches nothing
+        sprites.clear();
+        RotatingSprite::ResolveQueuedRotations();
+    }
+
+    //Two stores on one file stand in for two game instances. Each submits half a table from its own thread and
+    //flushes after every score, so their temp file writes and renames overlap. Both start with the same name
+    //and score, which are two players' scores that have to get a row each
+    void CheckRacingHighScoreWriters()
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "MiniginBenchHighScores.txt";
+        const HighScoreEntry sharedEntry{ "ABC", 1000 };
+        constexpr int nrOfScoresPerStore{ static_cast<int>(HighScoreStore::m_NrOfEntries) / 2 - 1 };
+        const auto submitScores = [&sharedEntry](HighScoreStore& store, const std::string& prefix, int firstScore) {
+            store.Submit(sharedEntry.name, sharedEntry.score);
+            store.Flush();
+            for (int i = 0; i < nrOfScoresPerStore; ++i)
+            {
+                store.Submit(prefix + std::to_string(i), firstScore + i * 2);
+                store.Flush();
+            }
+        };
+        for (int round = 0; round < 20; ++round)
+        {
+            std::filesystem::remove(path);
+            {
+                HighScoreStore first{ path.string() };
+                HighScoreStore second{ path.string() };
+                std::thread firstWriter{ submitScores, std::ref(first), "A", 100 };
+                std::thread secondWriter{ submitScores, std::ref(second), "B", 101 };
+                firstWriter.join();
+                secondWriter.join();
+            }
+
+            std::ifstream inFile{ path };
+            std::vector<HighScoreEntry> entries{};
+            std::string line;
+            while (std::getline(inFile, line))
+            {
+                std::istringstream iss{ line };
+                HighScoreEntry entry{};
+                Bench::Check(static_cast<bool>(iss >> entry.name >> entry.score >> entry.id) && entry.id != 0 && iss.peek() == std::char_traits<char>::eof(),
+                    "every line a whole entry with an id, got \"" + line + '"');
+                entries.emplace_back(std::move(entry));
+            }
+            Bench::Check(entries.size() == HighScoreStore::m_NrOfEntries, "a full table, got " + std::to_string(entries.size()) + " lines");
+            const auto countEntries = [&entries](const HighScoreEntry& expected) {
+                return std::ranges::count_if(entries, [&expected](const HighScoreEntry& entry) { return entry.name == expected.name && entry.score == expected.score; });
+            };
+            const auto nrOfSharedEntries = countEntries(sharedEntry);
+            Bench::Check(nrOfSharedEntries == 2, "both submissions of ABC 1000 kept in round " + std::to_string(round) + ", got " + std::to_string(nrOfSharedEntries));
+            for (int i = 0; i < nrOfScoresPerStore; ++i)
+            {
+                for (const HighScoreEntry& expected : { HighScoreEntry{ "A" + std::to_string(i), 100 + i * 2 }, HighScoreEntry{ "B" + std::to_string(i), 101 + i * 2 } })
+                {
+                    Bench::Check(countEntries(expected) == 1, expected.name + ' ' + std::to_string(expected.score) + " kept once in round " + std::to_string(round));
+                }
+            }
+            Bench::Check(!std::filesystem::exists(path.string() + ".tmp") && !std::filesystem::exists(path.string() + ".lock"), "no temp file or lock left behind");
+        }
+        std::filesystem::remove(path);
+    }
+
+    [[nodiscard]] std::string DescribeDifference(const GameEngine::Snapshot& expected, const GameEngine::Snapshot& actual)
+    {
+        const auto [expectedIt, actualIt] = std::ranges::mismatch(expected.GetData(), actual.GetData());
+        return std::to_string(expected.GetSize()) + " vs " + std::to_string(actual.GetSize()) + " bytes, first difference at byte "
+            + std::to_string(expectedIt - expected.GetData().begin());
+    }
+
+    //Restoring a snapshot and playing the same frames again has to end in the same state, byte for byte. Level one's
+    //enemies fly in for the first seconds without firing, so no objects are created whose serial ids would differ
+    //between the two runs
+    void CheckSnapshotRoundTrip(GameEngine::Minigin& engine)
+    {
+        auto& galaga = Galaga::GetInstance();
+        EnemyAIManager::SetSeed(1234);
+        //planning cut short by the clock would make the two runs differ
+        EnemyAIManager::SetFrameBudget(std::chrono::hours{ 1 });
+        galaga.SetGameMode(GameMode::singlePlayer);
+        if (galaga.GetCurrentScene() != SceneId::levelOne) galaga.LoadScene(SceneId::levelOne);
+        for (int frame = 0; frame < 30; ++frame) engine.StepFrame(g_FrameTime);
+        GameEngine::Scene* scene = GameEngine::SceneManager::GetInstance().GetCurrentScene();
+        Bench::Check(scene != nullptr && galaga.GetCurrentScene() == SceneId::levelOne, "level one loaded");
+
+        constexpr int nrOfFrames{ 320 };
+        scene->SetDestroyedObjectRetention(nrOfFrames + 1);
+        GameEngine::Snapshot start{};
+        GameEngine::Snapshot played{};
+        GameEngine::Snapshot replayed{};
+        scene->SaveState(start);
+        for (int frame = 0; frame < nrOfFrames; ++frame) engine.StepFrame(g_FrameTime);
+        scene->SaveState(played);
+        Bench::Check(played.GetSize() != start.GetSize() || !std::ranges::equal(played.GetData(), start.GetData()), "the frames to change the scene");
+
+        Bench::Check(scene->LoadState(start), "every object of the snapshot restored");
+        scene->SaveState(replayed);
+        Bench::Check(std::ranges::equal(replayed.GetData(), start.GetData()), "the restored scene to save the snapshot it was restored from, "
+            + DescribeDifference(start, replayed));
+        replayed.Clear();
+        for (int frame = 0; frame < nrOfFrames; ++frame) engine.StepFrame(g_FrameTime);
+        scene->SaveState(replayed);
+        Bench::Check(std::ranges::equal(replayed.GetData(), played.GetData()), "the replayed frames to end in the played state, "
+            + DescribeDifference(played, replayed));
+    }
+
+    //Two sockets on localhost, what goes out of one has to come out of the other unchanged
+    void CheckUdpTransportOverLocalhost()
+    {
+        constexpr uint16_t firstPort{ 47'001 };
+        constexpr uint16_t secondPort{ 47'002 };
+        GameEngine::UdpTransport first{ firstPort, "127.0.0.1", secondPort };
+        GameEngine::UdpTransport second{ secondPort, "127.0.0.1", firstPort };
+        const std::vector<std::byte> sent{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 }, std::byte{ 255 } };
+        first.Send(sent);
+        std::vector<std::byte> received{};
+        bool isReceived = false;
+        for (int poll = 0; poll < 1000 && !isReceived; ++poll)
+        {
+            isReceived = second.Receive(received);
+            if (!isReceived) std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+        Bench::Check(isReceived, "the packet to arrive within a second");
+        Bench::Check(received == sent, "the packet to arrive unchanged");
+        Bench::Check(!first.Receive(received), "nothing to receive on an idle socket");
+    }
+
+    //Rendering faster than the session simulates leaves render frames without a simulated frame,
+    //a press that only lasts one of them still has to reach the next simulated frame
+    void CheckRollbackKeepsUnsimulatedInput()
+    {
+        constexpr float timeStep{ 1.f / 60.f };
+        constexpr Bench::RollbackPeers::InputWord fireBit{ 1 };
+        int nrOfPresses{};
+        {
+            Bench::RollbackPeers peers{ 0, timeStep };
+            peers.GetSession(0).BindAction(0, fireBit, std::make_unique<CountCommand>(&nrOfPresses));
+            const auto stepBoth = [&peers](int nrOfFrames) {
+                for (int frame = 0; frame < nrOfFrames; ++frame)
+                {
+                    peers.Step(0, timeStep);
+                    peers.Step(1, timeStep);
+                }
+            };
+            stepBoth(10);
+            Bench::Check(peers.GetSession(0).IsConnected() && peers.GetSession(1).IsConnected(), "the peers to connect");
+            //no time passed, so no frame is simulated
+            peers.Step(0, 0.f, fireBit);
+            stepBoth(10);
+        }
+        GameEngine::SceneManager::GetInstance().SetCurrentScene(static_cast<int>(Galaga::GetInstance().GetCurrentScene()));
+        Bench::Check(nrOfPresses == 1, "the press to run once, it ran " + std::to_string(nrOfPresses) + " times");
+    }
+}
+
+void Bench::RegisterChecks(Runner& runner, GameEngine::Minigin& engine)
+{
+    //the scene benchmarks rely on every frame seeing the same elapsed time
+    runner.AddCheck("Minigin/StepFrameUsesFixedElapsed", [&engine]() {
+        constexpr float frameTime{ 1.f / 160.f };
+        engine.StepFrame(frameTime);
+        Check(GameEngine::TimeManager::GetElapsed() == frameTime, "the fixed frame time as elapsed time");
+    });
+    runner.AddCheck("TrajectoryBatch/StepsInSameFrame", CheckTrajectoryStepsInSameFrame);
+    runner.AddCheck("Trajectory/FrameRateIndependence", CheckTrajectoryFrameRateIndependence);
+    runner.AddCheck("CollisionComponent/SweptHitAtAnyTickRate", CheckSweptCollisionAtAnyTickRate);
+    runner.AddCheck("CollisionComponent/ResetSweepSkipsTeleport", CheckResetSweepSkipsTeleport);
+    runner.AddCheck("CollisionMask/MatchesBruteForce", CheckCollisionMaskMatchesBruteForce);
+    runner.AddCheck("SpriteAnimator/MatchesPerSpriteUpdate", CheckSpriteAnimatorMatchesPerSpriteUpdate);
+    runner.AddCheck("Telemetry/SumsShardsAcrossThreads", CheckTelemetryAcrossThreads);
+    runner.AddCheck("SceneBlob/CompileSaveLoadRoundTrip", CheckSceneBlobRoundTrip);
+    runner.AddCheck("LatencyHistogram/Summary", CheckLatencyHistogramSummary);
+    runner.AddCheck("FramePacer/JitterAtRandomLoad", CheckFramePacerJitter);
+    runner.AddCheck("FramePacer/RestartsAfterOverrun", CheckFramePacerRestartsAfterOverrun);
+    runner.AddCheck("ParticleSystem/ParallelMatchesSerial", CheckParallelParticlesMatchSerial);
+    runner.AddCheck("Renderer/DrawsLayersInOrder", CheckRendererDrawsLayersInOrder);
+    runner.AddCheck("Renderer/CachedLayerMatchesDirectDraw", CheckCachedLayerMatchesDirectDraw);
+    runner.AddCheck("Subject/DisconnectDuringEmit", CheckDisconnectDuringEmit);
+    runner.AddCheck("FileWatcher/ReportsEachSaveOnce", CheckFileWatcherReportsEachSaveOnce);
+    runner.AddCheck("InputManager/ControllerHotPlug", CheckControllerHotPlug);
+    runner.AddCheck("EnemyRegistry/RemoveInAnyOrder", CheckEnemyRegistryRemoval);
+    runner.AddCheck("EnemyAIManager/OrderWaitsForCooldown", CheckAttackOrderWaitsForCooldown);
+    runner.AddCheck("EnemyAIManager/CostIsRecorded", CheckEnemyAICostIsRecorded);
+    runner.AddCheck("EnemyStates/TransitionsDoNotAllocate", CheckEnemyStateTransitionsDoNotAllocate);
+    runner.AddCheck("RotatingSprite/QueueSurvivesDestroyedSprites", CheckRotationQueueSurvivesDestroyedSprites);
+    runner.AddCheck("HighScoreStore/RacingWritersKeepEveryEntry", CheckRacingHighScoreWriters);
+    runner.AddCheck("Snapshot/SaveStepLoadStepRoundTrip", [&engine]() { CheckSnapshotRoundTrip(engine); });
+    runner.AddCheck("UdpTransport/SendsOverLocalhost", CheckUdpTransportOverLocalhost);
+    runner.AddCheck("RollbackSession/KeepsInputOfUnsimulatedFrames", CheckRollbackKeepsUnsimulatedInput);
+}
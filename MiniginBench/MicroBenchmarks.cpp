@@ -0,0 +1,568 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <glm/gtc/constants.hpp>
+
+#include "CollisionMask.h"
+#include "DataStructs.h"
+#include "EventData.h"
+#include "Initializers.h"
+#include "RotatingSprite.h"
+#include "SceneBlob.h"
+#include "SceneCompiler.h"
+#include "Components/CollisionComponent.h"
+#include "Components/SpriteComponent.h"
+#include "Components/TextComponent.h"
+#include "Components/TextureComponent.h"
+#include "Game components/Enemy components/EnemyComponent.h"
+#include "Game components/PlayerComponent.h"
+#include "Game observers/EnemyAIManager.h"
+#include "Game observers/EnemyRegistry.h"
+#include "Managers/CollisionManager.h"
+#include "Managers/ParticleSystem.h"
+#include "Managers/ResourceManager.h"
+#include "Managers/SpriteAnimator.h"
+#include "Managers/Telemetry.h"
+#include "Managers/TimeManager.h"
+#include "Sound/DerivedSoundSystems.h"
+#include "Subjects/GameObject.h"
+#include "Trajectory Logic/CompiledPath.h"
+#include "Trajectory Logic/Parsers.h"
+#include "Trajectory Logic/Trajectory.h"
+#include "Trajectory Logic/TrajectoryBatch.h"
+
+namespace
+{
+    //every benchmark that places things at random starts from the same seed, so runs compare like for like
+    constexpr unsigned int g_Seed{ 1234 };
+    constexpr float g_FrameTime{ 1.f / 160.f };
+
+    //components GetComponent has to look past
+    class FillerComponent final : public GameEngine::Component
+    {
+    public:
+        explicit FillerComponent(GameEngine::GameObject* gameObj) : Component(gameObj) {}
+    };
+    class TargetComponent final : public GameEngine::Component
+    {
+    public:
+        explicit TargetComponent(GameEngine::GameObject* gameObj) : Component(gameObj) {}
+    };
+
+    //The component is the last of nrOfComponents, the worst case of the linear search
+    void BenchmarkGetComponent(Bench::State& state)
+    {
+        GameEngine::GameObject gameObject{ 0 };
+        for (int64_t i = 1; i < state.GetArgument(); ++i) gameObject.AddComponent<FillerComponent>();
+        gameObject.AddComponent<TargetComponent>();
+        while (state.KeepRunning())
+        {
+            Bench::DoNotOptimize(gameObject.GetComponent<TargetComponent>());
+        }
+    }
+
+    //The argument is the number of 16x16 colliders spread over the window, the denser the more of them hit
+    void BenchmarkCheckCollisions(Bench::State& state)
+    {
+        std::mt19937 random{ g_Seed };
+        std::uniform_int_distribution<int> x{ 0, GameEngine::g_WindowRect.w - 16 };
+        std::uniform_int_distribution<int> y{ 0, GameEngine::g_WindowRect.h - 16 };
+        GameEngine::CollisionManager collisionManager{};
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            const SDL_Rect rect{ x(random), y(random), 16, 16 };
+            gameObject->SetPosition(static_cast<float>(rect.x), static_cast<float>(rect.y));
+            collisionManager.AddCollisionComponent(gameObject->AddComponent<GameEngine::CollisionComponent>(rect));
+        }
+        while (state.KeepRunning())
+        {
+            collisionManager.CheckCollisions();
+        }
+    }
+
+    //A 32x32 sprite against the 96x160 tractor beam, at 1024 places where their rects overlap. The argument is
+    //one in how many pixels is opaque: dense masks return on the first word, sparse ones mostly scan the whole overlap
+    void BenchmarkMaskOverlaps(Bench::State& state)
+    {
+        std::mt19937 random{ g_Seed };
+        const auto makeMask = [&random, &state](int width, int height) {
+            GameEngine::CollisionMask mask{ width, height };
+            std::uniform_int_distribution<int64_t> bit{ 0, state.GetArgument() - 1 };
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    if (bit(random) == 0) mask.SetBit(x, y);
+                }
+            }
+            return mask;
+        };
+        const GameEngine::CollisionMask sprite = makeMask(32, 32);
+        const GameEngine::CollisionMask beam = makeMask(96, 160);
+        std::uniform_int_distribution<int> x{ -31, 95 };
+        std::uniform_int_distribution<int> y{ -31, 159 };
+        std::vector<glm::ivec2> positions(1024);
+        for (auto& pos : positions) pos = { x(random), y(random) };
+        int nrOfHits{};
+        while (state.KeepRunning())
+        {
+            for (const auto& pos : positions) nrOfHits += sprite.Overlaps(pos, beam, {}) ? 1 : 0;
+        }
+        Bench::DoNotOptimize(nrOfHits);
+    }
+
+    //The argument is the number of receivers, half of them connected to the emitted event
+    void BenchmarkEmit(Bench::State& state)
+    {
+        struct OtherEvent {};
+        struct Receiver
+        {
+            void OnCollision(GameEngine::GameObject&, const GameEngine::CollisionEvent&) { ++nrOfEvents; }
+            void OnOther(GameEngine::GameObject&, const OtherEvent&) { ++nrOfEvents; }
+            uint64_t nrOfEvents{};
+        };
+        GameEngine::GameObject gameObject{ 0 };
+        std::vector<Receiver> receivers(static_cast<size_t>(state.GetArgument()));
+        for (size_t i = 0; i < receivers.size(); ++i)
+        {
+            if (i % 2 == 0) gameObject.Connect<GameEngine::CollisionEvent, &Receiver::OnCollision>(&receivers[i]);
+            else gameObject.Connect<OtherEvent, &Receiver::OnOther>(&receivers[i]);
+        }
+        while (state.KeepRunning())
+        {
+            gameObject.Emit(GameEngine::CollisionEvent{ &gameObject });
+        }
+        Bench::DoNotOptimize(receivers);
+    }
+
+    //The argument is the number of subjects, each watched by six receivers like an enemy is, and every one emits
+    //once per iteration, so the connections are read from all over memory the way a frame of collisions does
+    void BenchmarkEmitManySubjects(Bench::State& state)
+    {
+        struct Receiver
+        {
+            void OnCollision(GameEngine::GameObject&, const GameEngine::CollisionEvent&) { ++nrOfEvents; }
+            uint64_t nrOfEvents{};
+        };
+        constexpr int nrOfReceivers{ 6 };
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<Receiver> receivers(nrOfReceivers);
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            for (auto& receiver : receivers) gameObject->Connect<GameEngine::CollisionEvent, &Receiver::OnCollision>(&receiver);
+        }
+        while (state.KeepRunning())
+        {
+            for (const auto& gameObject : gameObjects) gameObject->Emit(GameEngine::CollisionEvent{ gameObject.get() });
+        }
+        Bench::DoNotOptimize(receivers);
+    }
+
+    //The argument is the number of sprites, spread over four layouts whose clocks tick every 1 to 15 frames at 60 Hz
+    void BenchmarkSpriteAnimator(Bench::State& state)
+    {
+        constexpr float intervals[]{ 1.f / 60.f, 0.05f, 0.1f, 0.25f };
+        GameEngine::SpriteAnimator animator{};
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            const auto sprite = gameObject->AddComponent<GameEngine::SpriteComponent>();
+            sprite->m_SpriteInfo = { { 0, static_cast<int>(i % 4) * 20 }, 16, 16, 4, 2, 0, static_cast<int>(i % 4), 1, intervals[i % 4] };
+            sprite->UpdateSrcRect();
+            animator.AddSprite(sprite);
+        }
+        GameEngine::TimeManager::SetElapsed(1.f / 60.f);
+        while (state.KeepRunning()) animator.Update();
+    }
+
+    //The argument is the depth of the chain, the root moves every iteration so the whole chain is recomputed
+    void BenchmarkGetWorldTransform(Bench::State& state)
+    {
+        std::vector<std::unique_ptr<GameEngine::GameObject>> chain{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            auto& gameObject = chain.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            gameObject->SetPosition(1.f, 2.f);
+            if (i > 0) gameObject->SetParent(chain[i - 1].get(), false);
+        }
+        GameEngine::GameObject* root = chain.front().get();
+        GameEngine::GameObject* leaf = chain.back().get();
+        float x{};
+        while (state.KeepRunning())
+        {
+            root->SetPosition(x, 0.f);
+            x += 1.f;
+            Bench::DoNotOptimize(leaf->GetWorldTransform());
+        }
+    }
+
+    //Argument 1 changes the text every iteration and renders it again, 0 measures the unchanged text
+    void BenchmarkTextUpdate(Bench::State& state)
+    {
+        const auto font = GameEngine::ResourceManager::GetInstance().LoadFont("Emulogic.ttf", 20);
+        GameEngine::GameObject gameObject{ 0 };
+        gameObject.AddComponent<GameEngine::TextureComponent>();
+        auto textComponent = gameObject.AddComponent<GameEngine::TextComponent>(font, "SCORE 0");
+        textComponent->Update();
+        const bool isChanging = state.GetArgument() != 0;
+        int score{};
+        while (state.KeepRunning())
+        {
+            if (isChanging) textComponent->SetText("SCORE " + std::to_string(++score));
+            textComponent->Update();
+        }
+    }
+
+    //The argument is the number of enemies flying the first stage of level one, stepped like a frame of the game
+    void BenchmarkTrajectoryUpdate(Bench::State& state)
+    {
+        constexpr float speed{ 200.f };
+        const auto stagePaths = Parser::ParseStagePaths("../Data/Formations/FormationTrajectories1.json");
+        const auto& path = stagePaths.front();
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<std::unique_ptr<Trajectory>> trajectories{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            const bool isMirrored = i % 2 != 0;
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            gameObject->SetPosition({ path->GetStartPosition(isMirrored), 0 });
+            auto& trajectory = trajectories.emplace_back(std::make_unique<Trajectory>());
+            //mirrored half the time and headed for different slots, like the enemies of a stage
+            trajectory->SetPath(path, isMirrored, { 32.f * static_cast<float>(i % 10), 100.f });
+        }
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        while (state.KeepRunning())
+        {
+            for (size_t i = 0; i < trajectories.size(); ++i)
+            {
+                //the ones that reached their slot fly the path again
+                if (trajectories[i]->IsComplete()) trajectories[i]->SetPath(path, i % 2 != 0, { 32.f * static_cast<float>(i % 10), 100.f });
+                trajectories[i]->Update(speed, gameObjects[i].get());
+            }
+            TrajectoryBatch::Step();
+        }
+    }
+
+    //The argument is the number of lanes, every lane flies an arc so the whole SIMD kernel runs.
+    //Only the step is timed, the submissions are what the trajectories do in their own update
+    void BenchmarkTrajectoryBatchStep(Bench::State& state)
+    {
+        const PathData pathData{ true, true, glm::pi<float>(), { 100.f, 100.f }, {} };
+        const CompiledPath path{ { &pathData, 1 }, { 200.f, 100.f } };
+        const PathSegment segment = path.GetSegment(0);
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<int> lanes{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            lanes.emplace_back(TrajectoryBatch::AcquireLane());
+            TrajectoryBatch::LoadSegment(lanes.back(), segment);
+        }
+        float distance{};
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            distance = distance < segment.length ? distance + 1.f : 0.f;
+            for (size_t i = 0; i < lanes.size(); ++i) TrajectoryBatch::Submit(lanes[i], gameObjects[i].get(), distance);
+            state.ResumeTiming();
+            TrajectoryBatch::Step();
+        }
+        for (const int lane : lanes) TrajectoryBatch::ReleaseLane(lane);
+    }
+
+    //The argument is the number of enemies turning this frame, like a formation flying its entry arcs.
+    //Queuing and resolving are timed together, they are what the enemies and SpriteRotationComponent do
+    void BenchmarkResolveRotations(Bench::State& state)
+    {
+        constexpr int nrOfDirections{ 64 };
+        std::vector<glm::vec2> directions{};
+        for (int i = 0; i < nrOfDirections; ++i)
+        {
+            const float angle = glm::two_pi<float>() * static_cast<float>(i) / nrOfDirections;
+            directions.emplace_back(std::cos(angle), std::sin(angle));
+        }
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<std::unique_ptr<RotatingSprite>> sprites{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            auto spriteComponent = gameObject->AddComponent<GameEngine::SpriteComponent>();
+            spriteComponent->m_SpriteInfo.m_Width = 16;
+            spriteComponent->m_SpriteInfo.m_Height = 16;
+            spriteComponent->m_SpriteInfo.m_Spacing = 2;
+            spriteComponent->m_SpriteInfo.m_NrOfCols = 7;
+            spriteComponent->m_SpriteInfo.m_NrOfRows = 1;
+            sprites.emplace_back(std::make_unique<RotatingSprite>(spriteComponent));
+        }
+        size_t frame{};
+        while (state.KeepRunning())
+        {
+            for (size_t i = 0; i < sprites.size(); ++i) sprites[i]->QueueRotation(directions[(i + frame) % nrOfDirections]);
+            RotatingSprite::ResolveQueuedRotations();
+            ++frame;
+        }
+    }
+
+    //The argument is the number of sprites. Every iteration queues all of them and destroys them before the
+    //queue is resolved, in the order they were queued, which is what tearing down a stage mid-frame does
+    void BenchmarkRotationQueueTeardown(Bench::State& state)
+    {
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<GameEngine::SpriteComponent*> spriteComponents{};
+        for (int64_t i = 0; i < state.GetArgument(); ++i)
+        {
+            auto& gameObject = gameObjects.emplace_back(std::make_unique<GameEngine::GameObject>(0));
+            auto spriteComponent = spriteComponents.emplace_back(gameObject->AddComponent<GameEngine::SpriteComponent>());
+            spriteComponent->m_SpriteInfo.m_Width = 16;
+            spriteComponent->m_SpriteInfo.m_Height = 16;
+            spriteComponent->m_SpriteInfo.m_Spacing = 2;
+            spriteComponent->m_SpriteInfo.m_NrOfRows = 1;
+        }
+        std::vector<std::unique_ptr<RotatingSprite>> sprites{};
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            for (GameEngine::SpriteComponent* spriteComponent : spriteComponents)
+            {
+                //the constructor folds the sheet into a single column
+                spriteComponent->m_SpriteInfo.m_NrOfCols = 7;
+                sprites.emplace_back(std::make_unique<RotatingSprite>(spriteComponent));
+            }
+            state.ResumeTiming();
+            for (const auto& sprite : sprites) sprite->QueueRotation(glm::vec2{ 1.f, 0.f });
+            sprites.clear();
+        }
+    }
+
+    //The argument is the number of enemies, spawned in the 6:3:1 bee, butterfly and boss mix of a stage.
+    //Destroying them isn't timed
+    void BenchmarkSpawnEnemies(Bench::State& state)
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        const auto nrOfEnemies = static_cast<size_t>(state.GetArgument());
+        while (state.KeepRunning())
+        {
+            auto bees = SpawnEnemies(EnemyId::bee, nrOfEnemies * 6 / 10, playerComponent);
+            auto butterflies = SpawnEnemies(EnemyId::butterfly, nrOfEnemies * 3 / 10, playerComponent);
+            auto bosses = SpawnEnemies(EnemyId::bossGalaga, nrOfEnemies / 10, playerComponent);
+            state.PauseTiming();
+            bees.clear();
+            butterflies.clear();
+            bosses.clear();
+            state.ResumeTiming();
+        }
+    }
+
+    //The argument is the number of enemies, in the stage mix. Every iteration registers all of them and
+    //removes them again in a shuffled order, which is what killing enemies in any order does
+    void BenchmarkEnemyRegistry(Bench::State& state)
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        const auto nrOfEnemies = static_cast<size_t>(state.GetArgument());
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<EnemyComponent*> enemies{};
+        for (const auto& [enemyId, count] : { std::pair{ EnemyId::bee, nrOfEnemies * 6 / 10 },
+            std::pair{ EnemyId::butterfly, nrOfEnemies * 3 / 10 }, std::pair{ EnemyId::bossGalaga, nrOfEnemies / 10 } })
+        {
+            for (auto& gameObject : SpawnEnemies(enemyId, count, playerComponent))
+            {
+                enemies.emplace_back(gameObject->GetComponent<EnemyComponent>());
+                gameObjects.emplace_back(std::move(gameObject));
+            }
+        }
+        //spawned enemies register themselves with the AI manager
+        for (EnemyComponent* enemy : enemies) EnemyAIManager::RemoveEnemy(enemy);
+        std::vector<EnemyComponent*> removalOrder{ enemies };
+        std::ranges::shuffle(removalOrder, std::mt19937{ g_Seed });
+        EnemyRegistry registry{};
+        while (state.KeepRunning())
+        {
+            for (EnemyComponent* enemy : enemies) registry.Add(enemy);
+            Bench::DoNotOptimize(registry.GetIdleBoss());
+            for (EnemyComponent* enemy : removalOrder) registry.Remove(enemy);
+        }
+    }
+
+    //The argument is the number of enemies, all idle in the formation. One update works through the order
+    //queue until every enemy is diving, scoring the idle candidates of each order. Sending them back is not timed
+    void BenchmarkAttackOrders(Bench::State& state)
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        const auto nrOfEnemies = static_cast<size_t>(state.GetArgument());
+        GameEngine::GameObject aiObject{ 0 };
+        const auto aiManager = aiObject.AddComponent<EnemyAIManager>();
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<EnemyComponent*> enemies{};
+        for (const auto& [enemyId, count] : { std::pair{ EnemyId::bee, nrOfEnemies * 6 / 10 },
+            std::pair{ EnemyId::butterfly, nrOfEnemies * 3 / 10 }, std::pair{ EnemyId::bossGalaga, nrOfEnemies / 10 } })
+        {
+            for (auto& gameObject : SpawnEnemies(enemyId, count, playerComponent))
+            {
+                const glm::ivec2 formationPos{ 20 * static_cast<int>(enemies.size() % 30), 20 * static_cast<int>(enemies.size() / 30) };
+                enemies.emplace_back(gameObject->GetComponent<EnemyComponent>());
+                enemies.back()->SetFormationPosition(formationPos);
+                gameObject->SetPosition(static_cast<float>(formationPos.x), static_cast<float>(formationPos.y));
+                aiManager->Observe(gameObject.get());
+                gameObjects.emplace_back(std::move(gameObject));
+            }
+        }
+        EnemyAIManager::SetSeed(g_Seed);
+        EnemyAIManager::SetFrameBudget(std::chrono::hours{ 1 });
+        EnemyAIManager::SetMaxConcurrentDivers(static_cast<int>(enemies.size()));
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            for (EnemyComponent* enemy : enemies)
+            {
+                enemy->GetInIdleState();
+                enemy->m_LastAttackTime = 0.f;
+            }
+            state.ResumeTiming();
+            aiManager->Update();
+        }
+        EnemyAIManager::SetMaxConcurrentDivers(1);
+    }
+
+    //The argument is the number of enemies, in the stage mix. Every iteration sends all of them on their
+    //attack run and back, so each enemy goes through two transitions that both compile a path
+    void BenchmarkEnemyStateTransitions(Bench::State& state)
+    {
+        const auto fighter = InitFighter();
+        const auto playerComponent = fighter->GetComponent<PlayerComponent>();
+        const auto nrOfEnemies = static_cast<size_t>(state.GetArgument());
+        std::vector<std::unique_ptr<GameEngine::GameObject>> gameObjects{};
+        std::vector<EnemyComponent*> enemies{};
+        for (const auto& [enemyId, count] : { std::pair{ EnemyId::bee, nrOfEnemies * 6 / 10 },
+            std::pair{ EnemyId::butterfly, nrOfEnemies * 3 / 10 }, std::pair{ EnemyId::bossGalaga, nrOfEnemies / 10 } })
+        {
+            for (auto& gameObject : SpawnEnemies(enemyId, count, playerComponent))
+            {
+                enemies.emplace_back(gameObject->GetComponent<EnemyComponent>());
+                enemies.back()->SetFormationPosition({ 100, 100 });
+                gameObjects.emplace_back(std::move(gameObject));
+            }
+        }
+        while (state.KeepRunning())
+        {
+            for (EnemyComponent* enemy : enemies) enemy->GetInAttackState();
+            for (EnemyComponent* enemy : enemies) enemy->GetInIdleState();
+        }
+    }
+
+    //The argument is the number of particles, all on one wrapping emitter so the count stays the same every
+    //frame. Serial runs the whole emitter on one core, the default steps it in chunks across the cores
+    void BenchmarkParticleUpdate(Bench::State& state, bool isParallel)
+    {
+        GameEngine::EmitterSettings settings{};
+        settings.minLifeTime = 0.6f;
+        settings.maxLifeTime = 1.6f;
+        settings.minSpeed = 150.f;
+        settings.maxSpeed = 650.f;
+        settings.acceleration = { 0.f, 100.f };
+        settings.isWrapping = true;
+        settings.bounds = { 0, 0, 672, 768 };
+        GameEngine::ParticleSystem particleSystem{};
+        if (!isParallel) particleSystem.SetParallelThreshold(SIZE_MAX);
+        particleSystem.Fill(particleSystem.AddEmitter(settings), static_cast<int>(state.GetArgument()));
+        GameEngine::TimeManager::SetElapsed(g_FrameTime);
+        while (state.KeepRunning()) particleSystem.Update();
+    }
+
+    //What every instrumented spot pays, the value walks through the exact and the log-linear buckets
+    void BenchmarkTelemetryRecord(Bench::State& state)
+    {
+        auto& telemetry = GameEngine::Telemetry::GetInstance();
+        const GameEngine::MetricId histogram = telemetry.RegisterHistogram("benchmark values");
+        uint64_t value{};
+        while (state.KeepRunning())
+        {
+            telemetry.Record(histogram, value);
+            value = (value * 7 + 13) % 1'000'000;
+        }
+    }
+
+    //Parsing the level scene file, which the game only does when the file is newer than its blob
+    void BenchmarkCompileScene(Bench::State& state)
+    {
+        while (state.KeepRunning())
+        {
+            const GameEngine::SceneBlob blob = GameEngine::SceneCompiler::Compile("../Data/Scenes/Level.json");
+            Bench::DoNotOptimize(blob);
+        }
+    }
+
+    //Reading the level's compiled blob, what loading the level costs otherwise
+    void BenchmarkLoadSceneBlob(Bench::State& state)
+    {
+        const std::string blobPath = (std::filesystem::temp_directory_path() / "MiniginBenchLevel.scene").string();
+        GameEngine::SceneCompiler::Compile("../Data/Scenes/Level.json", blobPath);
+        while (state.KeepRunning())
+        {
+            GameEngine::SceneBlob blob{};
+            blob.LoadFromFile(blobPath);
+            Bench::DoNotOptimize(blob);
+        }
+        std::filesystem::remove(blobPath);
+    }
+
+    //Sounds that are already waiting are merged, most calls only scan the pending queue
+    void BenchmarkPlaySound(Bench::State& state)
+    {
+        const std::string soundPaths{ "../Data/Audio/SoundPaths.txt" };
+        std::ifstream file(soundPaths);
+        int nrOfSounds{};
+        for (std::string line; std::getline(file, line);) ++nrOfSounds;
+        GameEngine::SdlSoundSystem soundSystem{};
+        soundSystem.FillSoundPaths(soundPaths);
+        int id{};
+        while (state.KeepRunning())
+        {
+            soundSystem.PlaySound(static_cast<GameEngine::SoundId>(id), 0);
+            id = (id + 1) % std::max(nrOfSounds, 1);
+        }
+    }
+}
+
+void Bench::RegisterMicroBenchmarks(Runner& runner)
+{
+    runner.Add("GameObject::GetComponent", BenchmarkGetComponent).Args({ 1, 4, 8 }).Iterations(2'000'000);
+    runner.Add("CollisionManager::CheckCollisions", BenchmarkCheckCollisions).Args({ 64, 256, 1024 }).Iterations(200);
+    runner.Add("CollisionMask::Overlaps", BenchmarkMaskOverlaps).Args({ 2, 50, 1'000 }).Iterations(2'000);
+    runner.Add("Subject::Emit", BenchmarkEmit).Args({ 1, 6, 32, 256 }).Iterations(2'000'000);
+    runner.Add("Subject::Emit/ManySubjects", BenchmarkEmitManySubjects).Args({ 1'000, 10'000 }).Iterations(1'000);
+    runner.Add("SpriteAnimator::Update", BenchmarkSpriteAnimator).Args({ 1'000, 50'000 }).Iterations(1'000);
+    runner.Add("GameObject::GetWorldTransform", BenchmarkGetWorldTransform).Args({ 1, 4, 16 }).Iterations(1'000'000);
+    runner.Add("TextComponent::Update", BenchmarkTextUpdate).Args({ 0, 1 }).Iterations(2'000);
+    runner.Add("Trajectory::Update", BenchmarkTrajectoryUpdate).Args({ 40, 1000 }).Iterations(2'000);
+    runner.Add("TrajectoryBatch::Step", BenchmarkTrajectoryBatchStep).Args({ 1'000, 10'000 }).Iterations(2'000);
+    runner.Add("RotatingSprite::ResolveQueuedRotations", BenchmarkResolveRotations).Args({ 1'000, 10'000 }).Iterations(2'000);
+    runner.Add("RotatingSprite/QueueTeardown", BenchmarkRotationQueueTeardown).Args({ 1'000, 10'000 }).Iterations(200);
+    runner.Add("SpawnEnemies", BenchmarkSpawnEnemies).Args({ 100, 1'000 }).Iterations(200);
+    runner.Add("EnemyRegistry::AddRemove", BenchmarkEnemyRegistry).Args({ 1'000, 10'000 }).Iterations(1'000);
+    runner.Add("EnemyAIManager::Update", BenchmarkAttackOrders).Args({ 100, 1'000 }).Iterations(100);
+    runner.Add("EnemyComponent::ChangeState", BenchmarkEnemyStateTransitions).Args({ 100, 1'000 }).Iterations(2'000);
+    runner.Add("ParticleSystem::Update", [](State& state) { BenchmarkParticleUpdate(state, true); }).Args({ 10'000, 100'000 }).Iterations(1'000);
+    runner.Add("ParticleSystem::Update/Serial", [](State& state) { BenchmarkParticleUpdate(state, false); }).Args({ 10'000, 100'000 }).Iterations(1'000);
+    runner.Add("SceneCompiler::Compile", BenchmarkCompileScene).Iterations(1'000);
+    runner.Add("SceneBlob::LoadFromFile", BenchmarkLoadSceneBlob).Iterations(1'000);
+    runner.Add("Telemetry::Record", BenchmarkTelemetryRecord).Iterations(2'000'000);
+    runner.Add("SdlSoundSystem::PlaySound", BenchmarkPlaySound).Iterations(100'000);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <functional>
+#include <memory>
+
+#include "Scene.h"
+#include "Managers/SceneManager.h"
+#include "Managers/TimeManager.h"
+#include "Network/DerivedTransports.h"
+#include "Network/RollbackSession.h"
+
+namespace Bench
+{
+    //Two rollback sessions on a loopback transport, each stepping a scene of its own. A session only simulates while
+    //its scene is the current one, so the scenes are added to the scene manager under ids the game doesn't use and
+    //every step makes the stepped peer's scene current. Whoever uses the peers sets the current scene back afterwards
+    class RollbackPeers final
+    {
+    public:
+        using InputWord = GameEngine::RollbackSession::InputWord;
+        static constexpr int g_FirstSceneId{ 1000 };
+
+        //fillScene adds the objects of both peers' scenes
+        RollbackPeers(int latencyInPolls, float timeStep, const std::function<void(GameEngine::Scene&)>& fillScene = {})
+        {
+            auto [firstTransport, secondTransport] = GameEngine::LoopbackTransport::CreatePair(latencyInPolls);
+            m_Transports = { std::move(firstTransport), std::move(secondTransport) };
+            for (int player{}; player < GameEngine::RollbackSession::g_NrOfPlayers; ++player)
+            {
+                auto scene = std::make_unique<GameEngine::Scene>();
+                if (fillScene) fillScene(*scene);
+                m_Scenes[player] = scene.get();
+                m_Sessions[player] = std::make_unique<GameEngine::RollbackSession>(scene.get(), m_Transports[player].get(), player, uint16_t{ 0 });
+                m_Sessions[player]->SetTimeStep(timeStep);
+                GameEngine::SceneManager::GetInstance().AddScene(g_FirstSceneId + player, std::move(scene));
+            }
+        }
+        RollbackPeers(const RollbackPeers& other) = delete;
+        RollbackPeers(RollbackPeers&& other) noexcept = delete;
+        RollbackPeers& operator=(const RollbackPeers& other) = delete;
+        RollbackPeers& operator=(RollbackPeers&& other) noexcept = delete;
+        ~RollbackPeers()
+        {
+            for (int player{}; player < GameEngine::RollbackSession::g_NrOfPlayers; ++player)
+            {
+                m_Sessions[player].reset();
+                GameEngine::SceneManager::GetInstance().RemoveScene(g_FirstSceneId + player);
+            }
+        }
+
+        //One render frame of the player, input is what the player holds during it
+        void Step(int player, float elapsed, InputWord input = 0)
+        {
+            GameEngine::SceneManager::GetInstance().SetCurrentScene(g_FirstSceneId + player);
+            GameEngine::TimeManager::SetElapsed(elapsed);
+            if (input != 0) m_Sessions[player]->RecordLocalInput(input);
+            m_Sessions[player]->Update();
+        }
+
+        [[nodiscard]] GameEngine::RollbackSession& GetSession(int player) const { return *m_Sessions[player]; }
+        [[nodiscard]] GameEngine::Scene& GetScene(int player) const { return *m_Scenes[player]; }
+    private:
+        std::array<std::unique_ptr<GameEngine::LoopbackTransport>, GameEngine::RollbackSession::g_NrOfPlayers> m_Transports{};
+        std::array<GameEngine::Scene*, GameEngine::RollbackSession::g_NrOfPlayers> m_Scenes{};
+        std::array<std::unique_ptr<GameEngine::RollbackSession>, GameEngine::RollbackSession::g_NrOfPlayers> m_Sessions{};
+    };
+}
@@ -0,0 +1,309 @@
+#include "Benchmark.h"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DataStructs.h"
+#include "Galaga.h"
+#include "Minigin.h"
+#include "RollbackPeers.h"
+#include "Scene.h"
+#include "Snapshot.h"
+#include "Components/Component.h"
+#include "Components/TextureComponent.h"
+#include "Game observers/EnemyAIManager.h"
+#include "Managers/SceneManager.h"
+#include "Managers/Telemetry.h"
+#include "Renderable/Renderer.h"
+#include "Subjects/GameObject.h"
+
+namespace
+{
+    constexpr unsigned int g_Seed{ 1234 };
+    //the frame rate the pacer aims for
+    constexpr float g_FrameTime{ 1.f / 160.f };
+    //lets the previous scene be removed and the new one settle before frames are timed
+    constexpr int g_NrOfWarmUpFrames{ 30 };
+
+    //Replaces the current scene, the same scene is left as it is since replacing it with itself would remove it
+    void LoadScene(SceneId sceneId)
+    {
+        auto& galaga = Galaga::GetInstance();
+        //attacks are drawn from a seeded engine and planned without a time budget, so every run plays the same frames
+        EnemyAIManager::SetSeed(g_Seed);
+        EnemyAIManager::SetFrameBudget(std::chrono::hours{ 1 });
+        //the levels and the scores shown afterwards depend on the mode, setting it loads level one
+        galaga.SetGameMode(GameMode::singlePlayer);
+        if (galaga.GetCurrentScene() != sceneId) galaga.LoadScene(sceneId);
+    }
+
+    //Times every frame of the current scene until the frames are done or the game moves on by itself,
+    //e.g. when the fighter runs out of lives
+    void RunFrames(Bench::State& state, GameEngine::Minigin& engine, SceneId sceneId)
+    {
+        auto& galaga = Galaga::GetInstance();
+        if (galaga.GetCurrentScene() != sceneId)
+        {
+            state.Stop("the scene couldn't be loaded");
+            return;
+        }
+        for (int frame = 0; frame < g_NrOfWarmUpFrames; ++frame) engine.StepFrame(g_FrameTime);
+        while (state.KeepRunning())
+        {
+            engine.StepFrame(g_FrameTime);
+            if (galaga.GetCurrentScene() != sceneId) state.Stop("the game moved on to another scene");
+        }
+    }
+
+    //Loads the scene and lets it settle, returns null after stopping the benchmark if it couldn't be loaded
+    [[nodiscard]] GameEngine::Scene* PrepareScene(Bench::State& state, GameEngine::Minigin& engine, SceneId sceneId)
+    {
+        LoadScene(sceneId);
+        if (Galaga::GetInstance().GetCurrentScene() != sceneId)
+        {
+            state.Stop("the scene couldn't be loaded");
+            return nullptr;
+        }
+        for (int frame = 0; frame < g_NrOfWarmUpFrames; ++frame) engine.StepFrame(g_FrameTime);
+        return GameEngine::SceneManager::GetInstance().GetCurrentScene();
+    }
+
+    //Moves its object every frame, all of its state is the object's transform
+    class DriftComponent final : public GameEngine::Component
+    {
+    public:
+        explicit DriftComponent(GameEngine::GameObject* gameObj) : Component(gameObj) {}
+        void Update() override
+        {
+            const glm::vec3 position = GetGameObjParent()->GetPosition();
+            GetGameObjParent()->SetPosition(position.x + 10.f * GameEngine::TimeManager::GetElapsed(), position.y);
+        }
+    };
+
+    //The remote peer changes its input every frame, so every packet that arrives shows the predictions of the frames
+    //since were wrong. What is timed is the local peer's update: rolling back and simulating those frames again
+    void BenchmarkRollback(Bench::State& state)
+    {
+        constexpr int latencyInPolls{ 4 };
+        const auto nrOfObjects = state.GetArgument();
+        Bench::RollbackPeers peers{ latencyInPolls, g_FrameTime, [nrOfObjects](GameEngine::Scene& scene) {
+            scene.ReserveObjects(static_cast<size_t>(nrOfObjects));
+            for (int64_t i = 0; i < nrOfObjects; ++i)
+            {
+                auto object = std::make_unique<GameEngine::GameObject>(0);
+                object->SetPosition(0.f, static_cast<float>(i));
+                object->AddComponent<DriftComponent>();
+                scene.AddObject(std::move(object));
+            }
+        } };
+        int frame{};
+        const auto stepRemote = [&peers, &frame]() {
+            peers.Step(1, g_FrameTime, static_cast<Bench::RollbackPeers::InputWord>(frame++ % 2 + 1));
+        };
+        //connects the peers and fills the rollback window
+        for (int warmUpFrame = 0; warmUpFrame < 30; ++warmUpFrame)
+        {
+            stepRemote();
+            peers.Step(0, g_FrameTime);
+        }
+        const int nrOfRollbacksBefore = peers.GetSession(0).GetTotalStats().nrOfRollbacks;
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            stepRemote();
+            state.ResumeTiming();
+            peers.Step(0, g_FrameTime);
+        }
+        const int nrOfRollbacks = peers.GetSession(0).GetTotalStats().nrOfRollbacks - nrOfRollbacksBefore;
+        GameEngine::SceneManager::GetInstance().SetCurrentScene(static_cast<int>(Galaga::GetInstance().GetCurrentScene()));
+        if (nrOfRollbacks == 0) state.Stop("the local peer never rolled back");
+    }
+
+    //Busy waits, like an update that keeps the simulation thread to itself
+    void SimulateUpdate(std::chrono::microseconds duration)
+    {
+        const auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+
+    //Each iteration records a frame of sprites and hands it to the render thread, which has to be done with the
+    //previous frame first. Without an update that times the render thread's frames, with one the update runs
+    //while the previous frame is drawn, so a frame takes the longer of the two instead of their sum.
+    //On a cached layer the sprites, which don't move, are drawn from the layer's texture
+    void BenchmarkSubmitFrame(Bench::State& state, std::chrono::microseconds updateTime, bool isOnCachedLayer = false)
+    {
+        //an id the game doesn't use
+        constexpr int sceneId{ 2001 };
+        const auto nrOfSprites = state.GetArgument();
+        auto scene = std::make_unique<GameEngine::Scene>();
+        scene->ReserveObjects(static_cast<size_t>(nrOfSprites));
+        for (int64_t i = 0; i < nrOfSprites; ++i)
+        {
+            auto object = std::make_unique<GameEngine::GameObject>(0);
+            object->SetPosition(static_cast<float>(i * 7 % 640), static_cast<float>(i * 13 % 580));
+            if (isOnCachedLayer) object->SetRenderLayer(GameEngine::RenderLayer::ui);
+            auto* pTexture = object->AddComponent<GameEngine::TextureComponent>("Galaga.png");
+            pTexture->m_SrcRect = SDL_Rect{ 0, 0, 16, 16 };
+            pTexture->m_DestRect = SDL_Rect{ 0, 0, 32, 32 };
+            scene->AddObject(std::move(object));
+        }
+        GameEngine::Scene* pScene = scene.get();
+        auto& sceneManager = GameEngine::SceneManager::GetInstance();
+        sceneManager.AddScene(sceneId, std::move(scene));
+        sceneManager.SetCurrentScene(sceneId);
+        pScene->Update();
+
+        auto& renderer = GameEngine::Renderer::GetInstance();
+        const bool wasCached = renderer.IsLayerCached(GameEngine::RenderLayer::ui);
+        renderer.SetLayerCaching(GameEngine::RenderLayer::ui, isOnCachedLayer);
+        const float updateTimeInMs = std::chrono::duration<float, std::milli>(updateTime).count();
+        while (state.KeepRunning())
+        {
+            SimulateUpdate(updateTime);
+            renderer.SubmitFrame(updateTimeInMs, std::chrono::high_resolution_clock::now());
+        }
+        renderer.SetLayerCaching(GameEngine::RenderLayer::ui, wasCached);
+        sceneManager.RemoveScene(sceneId);
+        sceneManager.SetCurrentScene(static_cast<int>(Galaga::GetInstance().GetCurrentScene()));
+    }
+
+    //frame times in us
+    void PrintSoakStats(const std::string& name, const std::vector<double>& frameTimes, uint64_t nrOfAllocations)
+    {
+        std::cout << name << ": " << frameTimes.size() << " frames"
+            << "  p50 " << Bench::GetPercentile(frameTimes, 50.0)
+            << " us  p95 " << Bench::GetPercentile(frameTimes, 95.0)
+            << " us  p99 " << Bench::GetPercentile(frameTimes, 99.0)
+            << " us  max " << Bench::GetPercentile(frameTimes, 100.0)
+            << " us  " << nrOfAllocations << " allocations" << std::endl;
+    }
+}
+
+void Bench::RegisterSceneBenchmarks(Runner& runner, GameEngine::Minigin& engine)
+{
+    constexpr uint64_t nrOfFrames{ 1'000 };
+    //the game starts in the start menu, it can't be loaded again
+    runner.Add("Scene/StartMenu", [&engine](State& state) {
+        RunFrames(state, engine, SceneId::startMenu);
+    }).Iterations(nrOfFrames).TimeEachIteration().RunOnce();
+
+    struct SceneBenchmark
+    {
+        const char* name;
+        SceneId sceneId;
+    };
+    //in the order the game plays them, so each one is loaded from the scene that normally comes before it
+    constexpr SceneBenchmark scenes[]{
+        { "Scene/LevelOne", SceneId::levelOne },
+        { "Scene/LevelTwo", SceneId::levelTwo },
+        { "Scene/LevelThree", SceneId::levelThree },
+        { "Scene/GameOver", SceneId::gameOver },
+        { "Scene/ChooseName", SceneId::chooseName },
+        { "Scene/StressLevel", SceneId::stressLevel } };
+    for (const SceneBenchmark& scene : scenes)
+    {
+        const SceneId sceneId = scene.sceneId;
+        runner.Add(scene.name, [&engine, sceneId](State& state) {
+            LoadScene(sceneId);
+            RunFrames(state, engine, sceneId);
+        }).Iterations(nrOfFrames).TimeEachIteration().RunOnce();
+    }
+
+    //the render thread's time per frame, then the same frames behind a 2 ms update
+    runner.Add("Renderer::SubmitFrame", [](State& state) {
+        BenchmarkSubmitFrame(state, std::chrono::microseconds{});
+    }).Args({ 1'000, 10'000 }).Iterations(200);
+    runner.Add("Renderer::SubmitFrame/After2msUpdate", [](State& state) {
+        BenchmarkSubmitFrame(state, std::chrono::milliseconds{ 2 });
+    }).Args({ 1'000, 10'000 }).Iterations(200);
+    //the same sprites drawn from a cached layer, compare with Renderer::SubmitFrame
+    runner.Add("Renderer::SubmitFrame/CachedLayer", [](State& state) {
+        BenchmarkSubmitFrame(state, std::chrono::microseconds{}, true);
+    }).Args({ 1'000, 10'000 }).Iterations(200);
+
+    runner.Add("RollbackSession::Update", BenchmarkRollback).Args({ 100, 1'000 }).Iterations(1'000);
+
+    //what a rollback pays every frame for its snapshot and on every rollback for the restore, on the stress level's enemies
+    runner.Add("Snapshot/SaveStressLevel", [&engine](State& state) {
+        GameEngine::Scene* scene = PrepareScene(state, engine, SceneId::stressLevel);
+        if (scene == nullptr) return;
+        GameEngine::Snapshot snapshot{};
+        //sizes the buffer, like the ring of snapshots a session reuses
+        scene->SaveState(snapshot);
+        while (state.KeepRunning())
+        {
+            snapshot.Clear();
+            scene->SaveState(snapshot);
+        }
+        DoNotOptimize(snapshot.GetSize());
+    }).Iterations(1'000);
+    runner.Add("Snapshot/LoadStressLevel", [&engine](State& state) {
+        GameEngine::Scene* scene = PrepareScene(state, engine, SceneId::stressLevel);
+        if (scene == nullptr) return;
+        GameEngine::Snapshot snapshot{};
+        scene->SaveState(snapshot);
+        bool isComplete = true;
+        while (state.KeepRunning())
+        {
+            isComplete &= scene->LoadState(snapshot);
+        }
+        if (!isComplete) state.Stop("some objects couldn't be restored");
+    }).Iterations(1'000);
+}
+
+void Bench::RunSoak(GameEngine::Minigin& engine, std::chrono::minutes duration)
+{
+    using Clock = std::chrono::steady_clock;
+    auto& galaga = Galaga::GetInstance();
+    //the frames that load the level and let it settle aren't counted, they are expected to allocate
+    const auto loadStressLevel = [&engine, &galaga]() {
+        LoadScene(SceneId::stressLevel);
+        if (galaga.GetCurrentScene() != SceneId::stressLevel) throw std::runtime_error("The stress level couldn't be loaded");
+        for (int frame = 0; frame < g_NrOfWarmUpFrames; ++frame) engine.StepFrame(g_FrameTime);
+    };
+    loadStressLevel();
+
+    std::vector<double> frameTimes{};
+    std::vector<double> minuteFrameTimes{};
+    uint64_t nrOfAllocations{};
+    uint64_t minuteNrOfAllocations{};
+    int nrOfReloads{};
+    int minute{};
+    const Clock::time_point end = Clock::now() + duration;
+    Clock::time_point nextReport = Clock::now() + std::chrono::minutes{ 1 };
+    while (Clock::now() < end)
+    {
+        //only StepFrame is inside the window, the pushes below are the soak's own allocations
+        const uint64_t allocationsBefore = GameEngine::Telemetry::GetNrOfAllocations();
+        const Clock::time_point frameStart = Clock::now();
+        engine.StepFrame(g_FrameTime);
+        const Clock::time_point frameEnd = Clock::now();
+        const uint64_t frameAllocations = GameEngine::Telemetry::GetNrOfAllocations() - allocationsBefore;
+
+        //the frame that cleared the level or lost the last life already built the next scene
+        if (galaga.GetCurrentScene() != SceneId::stressLevel)
+        {
+            ++nrOfReloads;
+            loadStressLevel();
+            continue;
+        }
+        const double frameTime = std::chrono::duration<double, std::micro>(frameEnd - frameStart).count();
+        frameTimes.push_back(frameTime);
+        minuteFrameTimes.push_back(frameTime);
+        nrOfAllocations += frameAllocations;
+        minuteNrOfAllocations += frameAllocations;
+
+        if (frameEnd >= nextReport)
+        {
+            PrintSoakStats("Minute " + std::to_string(++minute), minuteFrameTimes, minuteNrOfAllocations);
+            minuteFrameTimes.clear();
+            minuteNrOfAllocations = 0;
+            nextReport += std::chrono::minutes{ 1 };
+        }
+    }
+    PrintSoakStats("Soak/StressLevel", frameTimes, nrOfAllocations);
+    std::cout << "The stress level was reloaded " << nrOfReloads << " times\n";
+}
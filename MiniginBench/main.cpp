@@ -0,0 +1,122 @@
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "Benchmark.h"
+#include "Galaga.h"
+#include "Minigin.h"
+#include "Managers/AllocationTracking.h"
+
+namespace
+{
+    constexpr const char* g_Usage{
+        "MiniginBench [-filter <text>] [-repetitions <n>] [-out <results.json>] [-label <text>]\n"
+        "MiniginBench -check [-filter <text>]\n"
+        "MiniginBench -soak <minutes>\n"
+        "MiniginBench -compare <base.json> <new.json>\n" };
+
+    struct Options
+    {
+        //only the benchmarks or checks whose name contains the text, e.g. Scene/ or CheckCollisions
+        std::string filter{};
+        std::string outputPath{ "MiniginBench.json" };
+        //stored with the results, e.g. the commit that was measured
+        std::string label{};
+        int nrOfRepetitions{ 5 };
+        bool isChecking{ false };
+        //-soak plays the stress level for this many minutes instead of running the benchmarks
+        int nrOfSoakMinutes{};
+        //-compare prints how the medians of two earlier runs differ
+        std::string basePath{};
+        std::string newPath{};
+    };
+
+    [[nodiscard]] int ParsePositiveNumber(const std::string& argument, const std::string& value)
+    {
+        int number{};
+        size_t nrOfDigits{};
+        try
+        {
+            number = std::stoi(value, &nrOfDigits);
+        }
+        catch (const std::logic_error&)
+        {
+            nrOfDigits = 0;
+        }
+        if (nrOfDigits != value.size() || number < 1)
+            throw std::invalid_argument(argument + " needs a positive number, got " + value);
+        return number;
+    }
+
+    [[nodiscard]] Options ParseArguments(int argc, char* argv[])
+    {
+        Options options{};
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument{ argv[i] };
+            if (argument == "-check")
+            {
+                options.isChecking = true;
+                continue;
+            }
+            const int nrOfValues = argument == "-compare" ? 2 : 1;
+            if (i + nrOfValues >= argc) throw std::invalid_argument("Missing value for " + argument + '\n' + g_Usage);
+            const std::string value{ argv[++i] };
+            if (argument == "-filter") options.filter = value;
+            else if (argument == "-out") options.outputPath = value;
+            else if (argument == "-label") options.label = value;
+            else if (argument == "-repetitions") options.nrOfRepetitions = ParsePositiveNumber(argument, value);
+            else if (argument == "-soak") options.nrOfSoakMinutes = ParsePositiveNumber(argument, value);
+            else if (argument == "-compare")
+            {
+                options.basePath = value;
+                options.newPath = argv[++i];
+            }
+            else throw std::invalid_argument("Unknown argument " + argument + '\n' + g_Usage);
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const Options options = ParseArguments(argc, argv);
+        if (!options.basePath.empty())
+        {
+            Bench::Runner::Compare(options.basePath, options.newPath);
+            return 0;
+        }
+
+        GameEngine::Minigin engine("../Data/", true);
+        Galaga::GetInstance().LoadStartScene();
+
+        if (options.nrOfSoakMinutes > 0)
+        {
+            Bench::RunSoak(engine, std::chrono::minutes{ options.nrOfSoakMinutes });
+            return 0;
+        }
+
+        Bench::Runner runner{};
+        if (options.isChecking)
+        {
+            Bench::RegisterChecks(runner, engine);
+            const int nrOfFailures = runner.RunChecks(options.filter);
+            std::cout << nrOfFailures << " checks failed\n";
+            return nrOfFailures == 0 ? 0 : 1;
+        }
+        Bench::RegisterMicroBenchmarks(runner);
+        Bench::RegisterSceneBenchmarks(runner, engine);
+        runner.Run(options.filter, options.nrOfRepetitions);
+        runner.WriteJson(options.outputPath, options.label);
+        std::cout << "Results written to " << options.outputPath << '\n';
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}